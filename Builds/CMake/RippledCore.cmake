@@ -100,6 +100,7 @@ target_sources (xrpl_core PRIVATE
   src/ripple/protocol/impl/STInteger.cpp
   src/ripple/protocol/impl/STLedgerEntry.cpp
   src/ripple/protocol/impl/STObject.cpp
+  src/ripple/protocol/impl/STObjectView.cpp
   src/ripple/protocol/impl/STParsedJSON.cpp
   src/ripple/protocol/impl/STPathSet.cpp
   src/ripple/protocol/impl/STTx.cpp
@@ -259,6 +260,7 @@ install (
     src/ripple/protocol/STInteger.h
     src/ripple/protocol/STLedgerEntry.h
     src/ripple/protocol/STObject.h
+    src/ripple/protocol/STObjectView.h
     src/ripple/protocol/STParsedJSON.h
     src/ripple/protocol/STPathSet.h
     src/ripple/protocol/STTx.h
@@ -390,6 +392,7 @@ target_sources (rippled PRIVATE
   #]===============================]
   src/ripple/app/consensus/RCLConsensus.cpp
   src/ripple/app/consensus/RCLCxPeerPos.cpp
+  src/ripple/app/consensus/RCLStatePrefetch.cpp
   src/ripple/app/consensus/RCLValidations.cpp
   src/ripple/app/ledger/AcceptedLedger.cpp
   src/ripple/app/ledger/AcceptedLedgerTx.cpp
@@ -400,6 +403,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/ledger/LedgerHistory.cpp
   src/ripple/app/ledger/OrderBookDB.cpp
   src/ripple/app/ledger/TransactionStateSF.cpp
+  src/ripple/app/ledger/impl/BookIndex.cpp
   src/ripple/app/ledger/impl/BuildLedger.cpp
   src/ripple/app/ledger/impl/InboundLedger.cpp
   src/ripple/app/ledger/impl/InboundLedgers.cpp
@@ -414,7 +418,9 @@ target_sources (rippled PRIVATE
   src/ripple/app/ledger/impl/LedgerToJson.cpp
   src/ripple/app/ledger/impl/LocalTxs.cpp
   src/ripple/app/ledger/impl/OpenLedger.cpp
+  src/ripple/app/ledger/impl/OwnerIndex.cpp
   src/ripple/app/ledger/impl/SkipListAcquire.cpp
+  src/ripple/app/ledger/impl/StateExport.cpp
   src/ripple/app/ledger/impl/TimeoutCounter.cpp
   src/ripple/app/ledger/impl/TransactionAcquire.cpp
   src/ripple/app/ledger/impl/TransactionMaster.cpp
@@ -558,6 +564,7 @@ target_sources (rippled PRIVATE
   src/ripple/ledger/impl/ApplyViewBase.cpp
   src/ripple/ledger/impl/ApplyViewImpl.cpp
   src/ripple/ledger/impl/BookDirs.cpp
+  src/ripple/ledger/impl/CachedSLEs.cpp
   src/ripple/ledger/impl/CachedView.cpp
   src/ripple/ledger/impl/Directory.cpp
   src/ripple/ledger/impl/OpenView.cpp
@@ -569,6 +576,7 @@ target_sources (rippled PRIVATE
      main sources:
        subdir: net
   #]===============================]
+  src/ripple/net/impl/AccountSubscriptions.cpp
   src/ripple/net/impl/DatabaseDownloader.cpp
   src/ripple/net/impl/HTTPClient.cpp
   src/ripple/net/impl/HTTPDownloader.cpp
@@ -578,6 +586,8 @@ target_sources (rippled PRIVATE
   src/ripple/net/impl/RPCErr.cpp
   src/ripple/net/impl/RPCSub.cpp
   src/ripple/net/impl/RegisterSSLCerts.cpp
+  src/ripple/net/impl/StreamPublisher.cpp
+  src/ripple/net/impl/SubscriberList.cpp
   #[===============================[
      main sources:
        subdir: nodestore
@@ -665,6 +675,7 @@ target_sources (rippled PRIVATE
   src/ripple/rpc/handlers/LedgerData.cpp
   src/ripple/rpc/handlers/LedgerDiff.cpp
   src/ripple/rpc/handlers/LedgerEntry.cpp
+  src/ripple/rpc/handlers/LedgerExport.cpp
   src/ripple/rpc/handlers/LedgerHandler.cpp
   src/ripple/rpc/handlers/LedgerHeader.cpp
   src/ripple/rpc/handlers/LedgerRequest.cpp
@@ -707,6 +718,7 @@ target_sources (rippled PRIVATE
   src/ripple/rpc/impl/LegacyPathFind.cpp
   src/ripple/rpc/impl/RPCHandler.cpp
   src/ripple/rpc/impl/RPCHelpers.cpp
+  src/ripple/rpc/impl/ResultCache.cpp
   src/ripple/rpc/impl/Role.cpp
   src/ripple/rpc/impl/ServerHandler.cpp
   src/ripple/rpc/impl/ShardArchiveHandler.cpp
@@ -728,6 +740,7 @@ target_sources (rippled PRIVATE
   #]===============================]
   src/ripple/server/impl/JSONRPCUtil.cpp
   src/ripple/server/impl/Port.cpp
+  src/ripple/server/impl/StreamWriter.cpp
   #[===============================[
      main sources:
        subdir: shamap
@@ -754,6 +767,8 @@ if (tests)
     src/test/app/AMM_test.cpp
     src/test/app/AMMCalc_test.cpp
     src/test/app/AMMExtended_test.cpp
+    src/test/app/BookIndex_test.cpp
+    src/test/app/CanonicalTXSet_test.cpp
     src/test/app/Check_test.cpp
     src/test/app/Clawback_test.cpp
     src/test/app/CrossingLimits_test.cpp
@@ -779,11 +794,13 @@ if (tests)
     src/test/app/OfferStream_test.cpp
     src/test/app/Offer_test.cpp
     src/test/app/OversizeMeta_test.cpp
+    src/test/app/OwnerIndex_test.cpp
     src/test/app/Path_test.cpp
     src/test/app/PayChan_test.cpp
     src/test/app/PayStrand_test.cpp
     src/test/app/PseudoTx_test.cpp
     src/test/app/RCLCensorshipDetector_test.cpp
+    src/test/app/RCLStatePrefetch_test.cpp
     src/test/app/RCLValidations_test.cpp
     src/test/app/ReducedOffer_test.cpp
     src/test/app/Regression_test.cpp
@@ -791,6 +808,7 @@ if (tests)
     src/test/app/SetAuth_test.cpp
     src/test/app/SetRegularKey_test.cpp
     src/test/app/SetTrust_test.cpp
+    src/test/app/StateExport_test.cpp
     src/test/app/Taker_test.cpp
     src/test/app/TheoreticalQuality_test.cpp
     src/test/app/Ticket_test.cpp
@@ -887,6 +905,7 @@ if (tests)
     #]===============================]
     src/test/json/Object_test.cpp
     src/test/json/Output_test.cpp
+    src/test/json/ReadStrict_test.cpp
     src/test/json/Writer_test.cpp
     src/test/json/json_value_test.cpp
     #[===============================[
@@ -940,6 +959,7 @@ if (tests)
          subdir: ledger
     #]===============================]
     src/test/ledger/BookDirs_test.cpp
+    src/test/ledger/CachedSLEs_test.cpp
     src/test/ledger/Directory_test.cpp
     src/test/ledger/Invariants_test.cpp
     src/test/ledger/PaymentSandbox_test.cpp
@@ -950,7 +970,10 @@ if (tests)
        test sources:
          subdir: net
     #]===============================]
+    src/test/net/AccountSubscriptions_test.cpp
     src/test/net/DatabaseDownloader_test.cpp
+    src/test/net/PublishedJson_test.cpp
+    src/test/net/StreamPublisher_test.cpp
     #[===============================[
        test sources:
          subdir: nodestore
@@ -983,6 +1006,7 @@ if (tests)
        test sources:
          subdir: protocol
     #]===============================]
+    src/test/protocol/AmountArithmetic_test.cpp
     src/test/protocol/BuildInfo_test.cpp
     src/test/protocol/InnerObjectFormats_test.cpp
     src/test/protocol/Issue_test.cpp
@@ -990,15 +1014,21 @@ if (tests)
     src/test/protocol/Memo_test.cpp
     src/test/protocol/PublicKey_test.cpp
     src/test/protocol/Quality_test.cpp
+    src/test/protocol/SField_test.cpp
     src/test/protocol/STAccount_test.cpp
     src/test/protocol/STAmount_test.cpp
     src/test/protocol/STObject_test.cpp
+    src/test/protocol/STObjectTemplate_test.cpp
+    src/test/protocol/STObjectView_test.cpp
     src/test/protocol/STTx_test.cpp
+    src/test/protocol/STTxSignature_test.cpp
     src/test/protocol/STValidation_test.cpp
     src/test/protocol/SecretKey_test.cpp
     src/test/protocol/Seed_test.cpp
     src/test/protocol/SeqProxy_test.cpp
+    src/test/protocol/Serializer_test.cpp
     src/test/protocol/TER_test.cpp
+    src/test/protocol/tokens_test.cpp
     src/test/protocol/types_test.cpp
     #[===============================[
        test sources:
@@ -1028,6 +1058,7 @@ if (tests)
     src/test/rpc/KeyGeneration_test.cpp
     src/test/rpc/LedgerClosed_test.cpp
     src/test/rpc/LedgerData_test.cpp
+    src/test/rpc/LedgerExport_test.cpp
     src/test/rpc/LedgerRPC_test.cpp
     src/test/rpc/LedgerRequestRPC_test.cpp
     src/test/rpc/ManifestRPC_test.cpp
@@ -1037,6 +1068,7 @@ if (tests)
     src/test/rpc/OwnerInfo_test.cpp
     src/test/rpc/Peers_test.cpp
     src/test/rpc/ReportingETL_test.cpp
+    src/test/rpc/ResultCache_test.cpp
     src/test/rpc/Roles_test.cpp
     src/test/rpc/RPCCall_test.cpp
     src/test/rpc/RPCOverload_test.cpp
@@ -1057,6 +1089,7 @@ if (tests)
     #]===============================]
     src/test/server/ServerStatus_test.cpp
     src/test/server/Server_test.cpp
+    src/test/server/StreamWriter_test.cpp
     #[===============================[
        test sources:
          subdir: shamap
@@ -43,6 +43,7 @@
 #include <ripple/protocol/BuildInfo.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/digest.h>
+#include <ripple/protocol/jss.h>
 
 #include <algorithm>
 #include <mutex>
@@ -92,6 +93,7 @@ RCLConsensus::Adaptor::Adaptor(
               crypto_prng(),
               std::numeric_limits<std::uint64_t>::max() - 1))
     , nUnlVote_(validatorKeys_.nodeID, j_)
+    , prefetch_(app, journal)
 {
     assert(valCookie_ != 0);
 
@@ -237,6 +239,7 @@ void
 RCLConsensus::Adaptor::share(RCLTxSet const& txns)
 {
     inboundTransactions_.giveSet(txns.id(), txns.map_, false);
+    prefetch(txns);
 }
 
 std::optional<RCLTxSet>
@@ -244,6 +247,7 @@ RCLConsensus::Adaptor::acquireTxSet(RCLTxSet::ID const& setId)
 {
     if (auto txns = inboundTransactions_.getSet(setId, true))
     {
+        prefetch_.prefetch(txns);
         return RCLTxSet{std::move(txns)};
     }
     return std::nullopt;
@@ -363,6 +367,10 @@ RCLConsensus::Adaptor::onClose(
     // Now we need an immutable snapshot
     initialSet = initialSet->snapShot(false);
 
+    // Start warming the state our position will read while we converge.
+    prefetch_.startRound(prevLedger);
+    prefetch_.prefetch(initialSet);
+
     if (!wrongLCL)
     {
         LedgerIndex const seq = prevLedger->info().seq + 1;
@@ -485,8 +493,6 @@ RCLConsensus::Adaptor::doAccept(
 
     // We want to put transactions in an unpredictable but deterministic order:
     // we use the hash of the set.
-    //
-    // FIXME: Use a std::vector and a custom sorter instead of CanonicalTXSet?
     CanonicalTXSet retriableTxs{result.txns.map_->getHash().as_uint256()};
 
     JLOG(j_.debug()) << "Building canonical tx set: " << retriableTxs.key();
@@ -516,6 +522,8 @@ RCLConsensus::Adaptor::doAccept(
         result.roundTime.read(),
         failed);
 
+    prefetch_.finishRound(*built.ledger_);
+
     auto const newLCLHash = built.id();
     JLOG(j_.debug()) << "Built ledger #" << built.seq() << ": " << newLCLHash;
 
@@ -898,6 +906,7 @@ RCLConsensus::getJson(bool full) const
         ret = consensus_.getJson(full);
     }
     ret["validating"] = adaptor_.validating();
+    ret[jss::prefetch] = adaptor_.getPrefetchJson();
     return ret;
 }
 
@@ -931,6 +940,7 @@ RCLConsensus::gotTxSet(NetClock::time_point const& now, RCLTxSet const& txSet)
         JLOG(j_.error()) << "During consensus gotTxSet: " << mn.what();
         Rethrow();
     }
+    adaptor_.prefetch(txSet);
 }
 
 //! @see Consensus::simulate
@@ -958,6 +968,8 @@ RCLConsensus::Adaptor::preStartRound(
     RCLCxLedger const& prevLgr,
     hash_set<NodeID> const& nowTrusted)
 {
+    prefetch_.startRound(prevLgr.ledger_);
+
     // We have a key, we do not want out of sync validations after a restart
     // and are not amendment blocked.
     validating_ = validatorKeys_.publicKey.size() != 0 &&
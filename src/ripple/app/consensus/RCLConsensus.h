@@ -24,6 +24,7 @@
 #include <ripple/app/consensus/RCLCxLedger.h>
 #include <ripple/app/consensus/RCLCxPeerPos.h>
 #include <ripple/app/consensus/RCLCxTx.h>
+#include <ripple/app/consensus/RCLStatePrefetch.h>
 #include <ripple/app/misc/FeeVote.h>
 #include <ripple/app/misc/NegativeUNLVote.h>
 #include <ripple/basics/CountedObject.h>
@@ -87,6 +88,9 @@ class RCLConsensus
         RCLCensorshipDetector<TxID, LedgerIndex> censorshipDetector_;
         NegativeUNLVote nUnlVote_;
 
+        // Warms the state the ledger being built will read.
+        RCLStatePrefetch prefetch_;
+
     public:
         using Ledger_t = RCLCxLedger;
         using NodeID_t = NodeID;
@@ -178,6 +182,24 @@ class RCLConsensus
             return parms_;
         }
 
+        /** Start loading the state a transaction set will read if it is
+            applied on top of the ledger this round is building on.
+
+            @param txns The candidate transaction set.
+        */
+        void
+        prefetch(RCLTxSet const& txns)
+        {
+            prefetch_.prefetch(txns.map_);
+        }
+
+        /** Prefetch statistics of the last round. */
+        Json::Value
+        getPrefetchJson() const
+        {
+            return prefetch_.getJson();
+        }
+
     private:
         //---------------------------------------------------------------------
         // The following members implement the generic Consensus requirements
@@ -0,0 +1,320 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/consensus/RCLStatePrefetch.h>
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/main/Application.h>
+#include <ripple/basics/Log.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/jss.h>
+
+namespace ripple {
+
+RCLStatePrefetch::RCLStatePrefetch(Application& app, beast::Journal j)
+    : app_(app), j_(j)
+{
+}
+
+void
+RCLStatePrefetch::startRound(std::shared_ptr<Ledger const> const& prevLedger)
+{
+    std::lock_guard lock(mutex_);
+    if (ledger_ && prevLedger &&
+        ledger_->info().hash == prevLedger->info().hash)
+        return;
+
+    ++generation_;
+    ledger_ = prevLedger;
+    txs_.clear();
+    keys_.clear();
+    started_ = std::chrono::steady_clock::now();
+}
+
+void
+RCLStatePrefetch::prefetch(std::shared_ptr<SHAMap const> const& txSet)
+{
+    if (!txSet)
+        return;
+
+    std::uint64_t const generation = generation_;
+    app_.getJobQueue().addJob(
+        jtPREFETCH_STATE, "prefetchTxSet", [this, txSet, generation]() {
+            schedule(txSet, generation);
+        });
+}
+
+void
+RCLStatePrefetch::schedule(
+    std::shared_ptr<SHAMap const> const& txSet,
+    std::uint64_t generation)
+{
+    std::shared_ptr<Ledger const> ledger;
+    std::vector<boost::intrusive_ptr<SHAMapItem const>> items;
+
+    {
+        std::lock_guard lock(mutex_);
+        if (!ledger_ || generation != generation_)
+            return;
+
+        txSet->visitLeaves(
+            [&](boost::intrusive_ptr<SHAMapItem const> const& item) {
+                if (txs_.insert(item->key()).second)
+                    items.push_back(item);
+            });
+
+        ledger = ledger_;
+    }
+
+    if (items.empty())
+        return;
+
+    JLOG(j_.debug()) << "Prefetching state for " << items.size()
+                     << " transactions on ledger " << ledger->info().seq;
+
+    // Split the work into short jobs, so that one doesn't hold its thread
+    // for long and a new round abandons the rest sooner.
+    for (std::size_t i = 0; i < items.size(); i += chunkSize)
+    {
+        auto const last = std::min(items.size(), i + chunkSize);
+        std::vector<boost::intrusive_ptr<SHAMapItem const>> chunk(
+            items.begin() + i, items.begin() + last);
+
+        app_.getJobQueue().addJob(
+            jtPREFETCH_STATE,
+            "prefetchState",
+            [this, ledger, chunk = std::move(chunk), generation]() {
+                load(ledger, chunk, generation);
+            });
+    }
+}
+
+void
+RCLStatePrefetch::load(
+    std::shared_ptr<Ledger const> const& ledger,
+    std::vector<boost::intrusive_ptr<SHAMapItem const>> const& items,
+    std::uint64_t generation)
+{
+    hash_set<uint256> keys;
+
+    for (auto const& item : items)
+    {
+        // A new round started; this work is no longer useful.
+        if (generation != generation_)
+            return;
+
+        try
+        {
+            STTx const tx{SerialIter{item->slice()}};
+            keysFor(tx, *ledger, keys);
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.trace()) << "Unable to prefetch for " << item->key()
+                             << ": " << e.what();
+        }
+    }
+
+    std::lock_guard lock(mutex_);
+    if (generation == generation_)
+        keys_.insert(keys.begin(), keys.end());
+}
+
+void
+RCLStatePrefetch::touch(
+    Ledger const& ledger,
+    Keylet const& k,
+    hash_set<uint256>& keys)
+{
+    // Looking the entry up walks the state map, which loads the nodes
+    // along the way and keeps them in the tree, and in the node family's
+    // caches.
+    if (ledger.exists(k))
+        keys.insert(k.key);
+}
+
+std::shared_ptr<SLE const>
+RCLStatePrefetch::fetch(
+    Ledger const& ledger,
+    Keylet const& k,
+    hash_set<uint256>& keys)
+{
+    auto sle = ledger.read(k);
+    if (sle)
+        keys.insert(k.key);
+    return sle;
+}
+
+void
+RCLStatePrefetch::keysFor(
+    STTx const& tx,
+    Ledger const& ledger,
+    hash_set<uint256>& keys)
+{
+    auto const account = tx.getAccountID(sfAccount);
+
+    // Pseudo-transactions don't have a source account.
+    if (account == beast::zero)
+        return;
+
+    touch(ledger, keylet::account(account), keys);
+
+    std::optional<AccountID> destination;
+    if (tx.isFieldPresent(sfDestination))
+    {
+        destination = tx.getAccountID(sfDestination);
+        touch(ledger, keylet::account(*destination), keys);
+    }
+
+    for (auto const field :
+         {&sfAmount,
+          &sfSendMax,
+          &sfDeliverMin,
+          &sfLimitAmount,
+          &sfTakerPays,
+          &sfTakerGets})
+    {
+        if (!tx.isFieldPresent(*field))
+            continue;
+
+        auto const amount = tx.getFieldAmount(*field);
+        if (amount.native())
+            continue;
+
+        auto const& issue = amount.issue();
+        touch(ledger, keylet::account(issue.account), keys);
+        if (issue.account != account)
+            touch(ledger, keylet::line(account, issue), keys);
+        if (destination && issue.account != *destination)
+            touch(ledger, keylet::line(*destination, issue), keys);
+    }
+
+    if (tx.getTxnType() == ttOFFER_CREATE)
+    {
+        auto const& pays = tx.getFieldAmount(sfTakerPays).issue();
+        auto const& gets = tx.getFieldAmount(sfTakerGets).issue();
+
+        // The book the offer crosses, and the one it is placed in.
+        keysForBook(Book{gets, pays}, ledger, keys);
+        keysForBook(Book{pays, gets}, ledger, keys);
+    }
+}
+
+void
+RCLStatePrefetch::keysForBook(
+    Book const& book,
+    Ledger const& ledger,
+    hash_set<uint256>& keys)
+{
+    auto const base = getBookBase(book);
+    auto const first = ledger.succ(base, getQualityNext(base));
+    if (!first)
+        return;
+
+    auto const dir = fetch(ledger, keylet::page(*first), keys);
+    if (!dir)
+        return;
+
+    std::size_t count = 0;
+    for (auto const& index : dir->getFieldV256(sfIndexes))
+    {
+        if (++count > offersPerBook)
+            break;
+
+        auto const offer = fetch(ledger, keylet::offer(index), keys);
+        if (!offer)
+            continue;
+
+        // Crossing an offer checks that its owner can fund it.
+        auto const owner = offer->getAccountID(sfAccount);
+        touch(ledger, keylet::account(owner), keys);
+
+        auto const& funds = offer->getFieldAmount(sfTakerGets).issue();
+        if (!isXRP(funds) && funds.account != owner)
+            touch(ledger, keylet::line(owner, funds), keys);
+    }
+}
+
+void
+RCLStatePrefetch::finishRound(Ledger const& built)
+{
+    hash_set<uint256> touched;
+
+    for (auto const& [tx, meta] : built.txs)
+    {
+        if (!meta)
+            continue;
+
+        for (auto const& node : meta->getFieldArray(sfAffectedNodes))
+        {
+            // Entries created by the ledger can't have been prefetched.
+            if (node.getFName() != sfCreatedNode)
+                touched.insert(node.getFieldH256(sfLedgerIndex));
+        }
+    }
+
+    std::lock_guard lock(mutex_);
+
+    // Only report on the round that built this ledger.
+    if (!ledger_ || ledger_->info().hash != built.info().parentHash)
+        return;
+
+    Stats stats;
+    stats.seq = built.info().seq;
+    stats.transactions = txs_.size();
+    stats.prefetched = keys_.size();
+    stats.touched = touched.size();
+    for (auto const& key : touched)
+    {
+        if (keys_.count(key))
+            ++stats.hits;
+    }
+    stats.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started_);
+
+    JLOG(j_.debug()) << "Prefetch for ledger " << stats.seq << ": "
+                     << stats.hits << " of " << stats.touched
+                     << " modified entries were prefetched ("
+                     << stats.prefetched << " loaded)";
+
+    last_ = stats;
+}
+
+Json::Value
+RCLStatePrefetch::getJson() const
+{
+    Json::Value ret(Json::objectValue);
+
+    std::lock_guard lock(mutex_);
+    if (!last_)
+        return ret;
+
+    ret[jss::ledger_index] = last_->seq;
+    ret[jss::transactions] = static_cast<Json::UInt>(last_->transactions);
+    ret[jss::prefetched] = static_cast<Json::UInt>(last_->prefetched);
+    ret[jss::touched] = static_cast<Json::UInt>(last_->touched);
+    ret[jss::hits] = static_cast<Json::UInt>(last_->hits);
+    ret[jss::hit_rate] = last_->touched
+        ? static_cast<double>(last_->hits) / last_->touched
+        : 0.0;
+    ret[jss::elapsed_ms] = static_cast<Json::UInt>(last_->elapsed.count());
+    return ret;
+}
+
+}  // namespace ripple
@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_CONSENSUS_RCLSTATEPREFETCH_H_INCLUDED
+#define RIPPLE_APP_CONSENSUS_RCLSTATEPREFETCH_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/json/json_value.h>
+#include <ripple/protocol/Book.h>
+#include <ripple/protocol/Keylet.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/shamap/SHAMap.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace ripple {
+
+class Application;
+class Ledger;
+
+/** Warms the state that the next ledger close is expected to read.
+
+    While consensus converges on a transaction set, the ledger entries the
+    candidate transactions will touch when applied (account roots, trust
+    lines and the front of the order books that offers may cross) are read
+    from the previous ledger on the job queue. This pulls the nodes of the
+    state map on the way to them in from the node store. The ledger being
+    built shares those nodes with the previous one, so applying the
+    transactions to it finds them in memory.
+
+    Each round is tied to the ledger consensus is building on. Work that
+    was queued for an earlier round is abandoned as soon as a new round
+    starts.
+*/
+class RCLStatePrefetch
+{
+public:
+    RCLStatePrefetch(Application& app, beast::Journal j);
+
+    /** Start prefetching for a round building on top of the given ledger.
+
+        The statistics of the previous round, if any, are kept until the
+        round is finished.
+    */
+    void
+    startRound(std::shared_ptr<Ledger const> const& prevLedger);
+
+    /** Prefetch the state read by the transactions in a candidate set.
+
+        The set is read by a job, so this is cheap enough to call with the
+        consensus lock held. Transactions that were already prefetched this
+        round are skipped.
+
+        @param txSet The candidate set. It must not be modified afterwards.
+    */
+    void
+    prefetch(std::shared_ptr<SHAMap const> const& txSet);
+
+    /** Finish the round by comparing the prefetched entries with the ones
+        actually modified while building the ledger.
+
+        @param built The ledger consensus built. Its metadata determines
+                     which entries were touched.
+    */
+    void
+    finishRound(Ledger const& built);
+
+    /** Statistics of the most recently finished round. */
+    Json::Value
+    getJson() const;
+
+private:
+    // Queue jobs to prefetch for the transactions of a set that weren't
+    // prefetched for yet.
+    void
+    schedule(
+        std::shared_ptr<SHAMap const> const& txSet,
+        std::uint64_t generation);
+
+    void
+    load(
+        std::shared_ptr<Ledger const> const& ledger,
+        std::vector<boost::intrusive_ptr<SHAMapItem const>> const& items,
+        std::uint64_t generation);
+
+    // Collect the keys of the entries a transaction is expected to read.
+    void
+    keysFor(STTx const& tx, Ledger const& ledger, hash_set<uint256>& keys);
+
+    void
+    keysForBook(
+        Book const& book,
+        Ledger const& ledger,
+        hash_set<uint256>& keys);
+
+    // Load the nodes on the way to an entry.
+    void
+    touch(Ledger const& ledger, Keylet const& k, hash_set<uint256>& keys);
+
+    // Load an entry whose contents lead to others.
+    std::shared_ptr<SLE const>
+    fetch(Ledger const& ledger, Keylet const& k, hash_set<uint256>& keys);
+
+    // The number of transactions handed to each job.
+    static constexpr std::size_t chunkSize = 64;
+
+    // The number of offers loaded from the front of each order book.
+    static constexpr std::size_t offersPerBook = 16;
+
+    Application& app_;
+    beast::Journal const j_;
+
+    // Bumped at the start of every round, so that queued work for an
+    // earlier round can tell that it is no longer needed.
+    std::atomic<std::uint64_t> generation_{0};
+
+    mutable std::mutex mutex_;
+
+    // The ledger the round is building on.
+    std::shared_ptr<Ledger const> ledger_;
+
+    // Transactions and entries prefetched during the round.
+    hash_set<uint256> txs_;
+    hash_set<uint256> keys_;
+    std::chrono::steady_clock::time_point started_;
+
+    struct Stats
+    {
+        LedgerIndex seq = 0;
+        std::size_t transactions = 0;
+        std::size_t prefetched = 0;
+        std::size_t touched = 0;
+        std::size_t hits = 0;
+        std::chrono::milliseconds elapsed{0};
+    };
+
+    // Statistics of the last finished round.
+    std::optional<Stats> last_;
+};
+
+}  // namespace ripple
+
+#endif
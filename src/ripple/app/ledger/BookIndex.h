@@ -0,0 +1,183 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_BOOKINDEX_H_INCLUDED
+#define RIPPLE_APP_LEDGER_BOOKINDEX_H_INCLUDED
+
+#include <ripple/app/ledger/AcceptedLedger.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/json/json_value.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/Book.h>
+#include <ripple/protocol/STAmount.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** The offers of the books clients ask about, in the last published ledger.
+
+    The first request for a book against the last published ledger reads
+    the book from its directories. After that the book is brought forward
+    with each published ledger, from the offers that ledger's transactions
+    changed, so a request is answered without reading the ledger.
+
+    What the owners of offers hold is worked out once per ledger, when it's
+    first needed, and kept until their balances or the rules for them
+    change. Books that aren't asked about are dropped after a while, and
+    the least recently asked about are dropped when too many are kept.
+*/
+class BookIndex
+{
+public:
+    /** An offer, and how it's rendered. */
+    struct Offer
+    {
+        std::shared_ptr<SLE const> sle;
+        Json::Value json;
+    };
+
+    /** The offers at one quality, in the order the directory holds them. */
+    struct Level
+    {
+        STAmount rate;
+        std::string quality;
+        std::vector<std::shared_ptr<Offer const>> offers;
+    };
+
+    /** A book's levels by directory, best quality first. */
+    using Levels = std::map<uint256, std::shared_ptr<Level const>>;
+
+    /** What owners hold of one issue in one ledger, as it's needed. */
+    class Funds
+    {
+    public:
+        /** What the account holds, from compute if it's not known yet. */
+        template <class Compute>
+        STAmount
+        get(AccountID const& account, Compute&& compute)
+        {
+            {
+                std::lock_guard lock(mutex_);
+                if (auto const it = held_.find(account); it != held_.end())
+                    return it->second;
+            }
+            STAmount const amount = compute();
+            std::lock_guard lock(mutex_);
+            held_.emplace(account, amount);
+            return amount;
+        }
+
+    private:
+        friend class BookIndex;
+
+        std::mutex mutex_;
+        hash_map<AccountID, STAmount> held_;
+    };
+
+    /** A book in a ledger. */
+    struct Snapshot
+    {
+        std::shared_ptr<Levels const> levels;
+        std::shared_ptr<Funds> funds;
+    };
+
+    /** Published ledgers a book is kept for without being asked about. */
+    static constexpr LedgerIndex keepLedgers = 256;
+
+    /** The most books kept. The least recently asked about go first. */
+    static constexpr std::size_t maxBooks = 512;
+
+    /** The most offers kept, over all books. A book with more isn't kept. */
+    static constexpr std::size_t maxOffers = 100000;
+
+    explicit BookIndex(
+        beast::Journal j,
+        std::size_t books = maxBooks,
+        std::size_t offers = maxOffers);
+
+    /** The book in a ledger, if the ledger is the last one published.
+
+        A book that isn't kept yet is read from the ledger, and kept.
+    */
+    std::optional<Snapshot>
+    find(ReadView const& ledger, Book const& book);
+
+    /** Bring the books forward to a newly published ledger.
+
+        If the ledger doesn't follow the last one, the books are dropped
+        and kept again, from this ledger, as they're asked about.
+    */
+    void
+    update(AcceptedLedger const& accepted);
+
+    /** Read a book from a ledger's directories. */
+    static std::shared_ptr<Levels const>
+    read(ReadView const& ledger, Book const& book);
+
+    /** The number of books kept, and of their offers. */
+    std::pair<std::size_t, std::size_t>
+    size();
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<Levels const> levels;
+        std::size_t offers;
+        LedgerIndex used;
+    };
+
+    struct State
+    {
+        uint256 hash;
+        LedgerIndex seq = 0;
+        hash_map<Book, Entry> books;
+        std::size_t offers = 0;
+        hash_map<Issue, std::shared_ptr<Funds>> funds;
+    };
+
+    std::shared_ptr<Funds>
+    funds(Issue const& issue);
+
+    // Bring the state forward to the accepted ledger, which follows it.
+    void
+    advance(State& next, AcceptedLedger const& accepted) const;
+
+    // Drop the least recently used books until what's kept, and the given
+    // number of books and offers more, is in bounds.
+    void
+    trim(State& state, std::size_t books, std::size_t offers) const;
+
+    beast::Journal const j_;
+    std::size_t const maxBooks_;
+    std::size_t const maxOffers_;
+
+    std::mutex mutex_;
+    State state_;
+};
+
+}  // namespace ripple
+
+#endif
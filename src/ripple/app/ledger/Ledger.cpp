@@ -466,6 +466,31 @@ Ledger::read(Keylet const& k) const
     return sle;
 }
 
+std::optional<STObjectView>
+Ledger::readLazy(Keylet const& k) const
+{
+    if (k.key == beast::zero)
+    {
+        assert(false);
+        return std::nullopt;
+    }
+    auto const& item = stateMap_.peekItem(k.key);
+    if (!item)
+        return std::nullopt;
+
+    // The view keeps the item alive.
+    STObjectView view(
+        item->slice(),
+        std::shared_ptr<void const>(item.get(), [item](void const*) {}));
+
+    auto const type = safe_cast<LedgerEntryType>(view[sfLedgerEntryType]);
+    if (!k.check(type))
+        return std::nullopt;
+    if (auto const format = LedgerFormats::getInstance().findByType(type))
+        view.setTemplate(format->getSOTemplate());
+    return view;
+}
+
 //------------------------------------------------------------------------------
 
 auto
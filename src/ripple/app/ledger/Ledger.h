@@ -28,6 +28,7 @@
 #include <ripple/protocol/Book.h>
 #include <ripple/protocol/Indexes.h>
 #include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/STObjectView.h>
 #include <ripple/protocol/Serializer.h>
 #include <ripple/protocol/TxMeta.h>
 #include <ripple/shamap/SHAMap.h>
@@ -185,6 +186,15 @@ public:
     std::shared_ptr<SLE const>
     read(Keylet const& k) const override;
 
+    /** Read a state entry without deserializing it.
+
+        The view refers to the entry as stored in the state map, and only
+        deserializes the fields that are read from it. It is much cheaper
+        than read when only a few fields are needed.
+    */
+    std::optional<STObjectView>
+    readLazy(Keylet const& k) const;
+
     std::unique_ptr<sles_type::iter_base>
     slesBegin() const override;
 
@@ -163,12 +163,28 @@ private:
     trigger(ScopedLockType& sl);
 
     /**
-     * Try to build more ledgers
+     * Start acquiring more deltas and, if the next delta is ready, schedule
+     * a job to build ledgers
      * @param sl  lock. this function must be called with the lock
      */
     void
     tryAdvance(ScopedLockType& sl);
 
+    /**
+     * Start acquiring the deltas that are within MAX_DELTAS_IN_FLIGHT of the
+     * next ledger to build
+     * @param sl  lock. this function must be called with the lock
+     */
+    void
+    requestDeltas(ScopedLockType& sl);
+
+    /**
+     * Build ledgers in order, for as long as their deltas are ready
+     * @note runs in a job, and does not hold the lock while building
+     */
+    void
+    build();
+
     InboundLedgers& inboundLedgers_;
     LedgerReplayer& replayer_;
     TaskParameter parameter_;
@@ -176,7 +192,12 @@ private:
     std::shared_ptr<SkipListAcquire> skipListAcquirer_;
     std::shared_ptr<Ledger const> parent_ = {};
     uint32_t deltaToBuild_ = 0;  // should not build until have parent
+    uint32_t deltaToRequest_ = 0;
     std::vector<std::shared_ptr<LedgerDeltaAcquire>> deltas_;
+    // a build job is queued or running
+    bool building_ = false;
+    // a delta became ready while the build job was running
+    bool buildAgain_ = false;
 
     friend class test::LedgerReplayClient;
 };
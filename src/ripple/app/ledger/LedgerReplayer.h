@@ -25,6 +25,8 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/beast/utility/Journal.h>
 
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -64,6 +66,13 @@ std::uint32_t constexpr MAX_TASK_SIZE = 256;
 
 // to limit the number of LedgerReplay related jobs in JobQueue
 std::uint32_t constexpr MAX_QUEUED_TASKS = 100;
+
+// for LedgerReplayTask to limit the number of ledger deltas, per task, that
+// are being acquired or are waiting for their parent ledger to be built
+std::uint32_t constexpr MAX_DELTAS_IN_FLIGHT = 32;
+
+// for LedgerReplayer to measure the replay throughput
+auto constexpr THROUGHPUT_WINDOW = std::chrono::seconds{10};
 }  // namespace LedgerReplayParameters
 
 /**
@@ -118,6 +127,14 @@ public:
         LedgerInfo const& info,
         std::map<std::uint32_t, std::shared_ptr<STTx const>>&& txns);
 
+    /** Record that a LedgerReplayTask built a ledger from a delta */
+    void
+    onLedgerBuilt();
+
+    /** Replay progress and throughput, reported by fetch_info */
+    Json::Value
+    getJson() const;
+
     /** Remove completed tasks */
     void
     sweep();
@@ -131,6 +148,10 @@ private:
     hash_map<uint256, std::weak_ptr<LedgerDeltaAcquire>> deltas_;
     hash_map<uint256, std::weak_ptr<SkipListAcquire>> skipLists_;
 
+    // when the ledgers built in the last THROUGHPUT_WINDOW were built
+    std::deque<std::chrono::steady_clock::time_point> recentBuilds_;
+    std::uint64_t totalBuilt_ = 0;
+
     Application& app_;
     InboundLedgers& inboundLedgers_;
     std::unique_ptr<PeerSetBuilder> peerSetBuilder_;
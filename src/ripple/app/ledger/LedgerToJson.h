@@ -66,6 +66,16 @@ struct LedgerFill
 void
 addJson(Json::Value&, LedgerFill const&);
 
+/** Like the above, with other members of the Json::Object.
+
+    Each transaction and state entry is written as it's produced, so that
+    the description of a whole ledger is never in memory. The members are
+    written in key order, as a Json::Value would write them, so that the
+    two are written the same.
+ */
+void
+addJson(Json::Object&, LedgerFill const&, Json::Value members);
+
 /** Return a new Json::Value representing the ledger with given options.*/
 Json::Value
 getJson(LedgerFill const&);
@@ -30,7 +30,10 @@
 namespace ripple {
 
 OrderBookDB::OrderBookDB(Application& app)
-    : app_(app), seq_(0), j_(app.journal("OrderBookDB"))
+    : app_(app)
+    , seq_(0)
+    , j_(app.journal("OrderBookDB"))
+    , bookIndex_(app.journal("BookIndex"))
 {
 }
 
@@ -250,7 +253,7 @@ void
 OrderBookDB::processTxn(
     std::shared_ptr<ReadView const> const& ledger,
     const AcceptedLedgerTx& alTx,
-    Json::Value const& jvObj)
+    PublishedJson const& msg)
 {
     std::lock_guard sl(mLock);
 
@@ -277,7 +280,7 @@ OrderBookDB::processTxn(
                             {data->getFieldAmount(sfTakerGets).issue(),
                              data->getFieldAmount(sfTakerPays).issue()});
                         if (listeners)
-                            listeners->publish(jvObj, havePublished);
+                            listeners->publish(msg, havePublished);
                     }
                 };
 
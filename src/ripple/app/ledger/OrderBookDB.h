@@ -21,6 +21,7 @@
 #define RIPPLE_APP_LEDGER_ORDERBOOKDB_H_INCLUDED
 
 #include <ripple/app/ledger/AcceptedLedgerTx.h>
+#include <ripple/app/ledger/BookIndex.h>
 #include <ripple/app/ledger/BookListeners.h>
 #include <ripple/app/main/Application.h>
 #include <mutex>
@@ -58,12 +59,19 @@ public:
     BookListeners::pointer
     makeBookListeners(Book const&);
 
+    /** The offers of the books clients ask about. */
+    BookIndex&
+    bookIndex()
+    {
+        return bookIndex_;
+    }
+
     // see if this txn effects any orderbook
     void
     processTxn(
         std::shared_ptr<ReadView const> const& ledger,
         const AcceptedLedgerTx& alTx,
-        Json::Value const& jvObj);
+        PublishedJson const& msg);
 
 private:
     Application& app_;
@@ -83,6 +91,8 @@ private:
     std::atomic<std::uint32_t> seq_;
 
     beast::Journal const j_;
+
+    BookIndex bookIndex_;
 };
 
 }  // namespace ripple
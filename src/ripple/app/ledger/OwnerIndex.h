@@ -0,0 +1,224 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_OWNERINDEX_H_INCLUDED
+#define RIPPLE_APP_LEDGER_OWNERINDEX_H_INCLUDED
+
+#include <ripple/app/ledger/AcceptedLedger.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <vector>
+
+namespace ripple {
+
+class Application;
+
+/** What the accounts with the largest owner directories own, by type.
+
+    Listing what a large account owns of one type, its trust lines say,
+    otherwise means reading every page of its directory and every entry on
+    them. The index keeps, for each account whose directory held at least
+    a minimum number of entries when the index was built, where each of
+    its entries is in the directory, by type.
+
+    Entries are kept in the order the directory holds them, so markers
+    work the same whether a request is answered from the index or by
+    walking the directory.
+
+    The index is built from the first ledger published, and brought forward
+    with each published ledger from the directory pages its transactions
+    changed. If a ledger doesn't follow the last one, it's built again.
+*/
+class OwnerIndex
+{
+public:
+    /** Where an entry is in its owner's directory. */
+    struct Position
+    {
+        std::uint64_t page = 0;
+        uint256 key;
+
+        friend bool
+        operator<(Position const& lhs, Position const& rhs)
+        {
+            if (lhs.page != rhs.page)
+                return lhs.page < rhs.page;
+            return lhs.key < rhs.key;
+        }
+
+        friend bool
+        operator==(Position const& lhs, Position const& rhs)
+        {
+            return lhs.page == rhs.page && lhs.key == rhs.key;
+        }
+    };
+
+    /** Ledgers published while the index is built that are kept to bring
+        it forward with once it is. If more are published, the index is
+        no longer kept. */
+    static constexpr std::size_t maxPending = 256;
+
+    /** Create an index.
+
+        @param minEntries The entries an owner's directory must hold to
+                          be indexed. 0 disables the index.
+    */
+    OwnerIndex(Application& app, std::size_t minEntries, beast::Journal j);
+
+    /** Whether the index is kept. */
+    bool
+    enabled() const
+    {
+        return minEntries_ != 0;
+    }
+
+    /** A stretch of an account's directory. */
+    struct Window
+    {
+        // The entries of the types asked for, in directory order.
+        std::vector<Position> found;
+
+        // The last entry in the stretch, of any type.
+        std::optional<Position> last;
+
+        // The entry after the stretch, if it doesn't reach the end.
+        std::optional<Position> next;
+    };
+
+    /** Where what an account owns of some types is in a stretch of its
+        directory.
+
+        The stretch is the entries a walk of the directory would visit, of
+        every type, so a limit means the same whether a request is answered
+        from the index or by walking the directory.
+
+        @param ledger The ledger to answer for.
+        @param account The owner.
+        @param types The types of entry to find.
+        @param start The position to start at. If it has a key, it must be
+                     an entry of the directory.
+        @param inclusive Whether the entry at start is in the stretch.
+        @param limit The number of entries in the stretch.
+
+        @return The entries of the types in the stretch, or nothing if the
+                ledger isn't the one the index is for, the account isn't
+                indexed, or start isn't an entry of the directory. The
+                directory must then be walked instead.
+    */
+    std::optional<Window>
+    find(
+        ReadView const& ledger,
+        AccountID const& account,
+        std::vector<LedgerEntryType> const& types,
+        Position const& start,
+        bool inclusive,
+        std::size_t limit) const;
+
+    /** The number of a page of an account's directory, if it's indexed. */
+    std::optional<std::uint64_t>
+    page(
+        ReadView const& ledger,
+        AccountID const& account,
+        uint256 const& key) const;
+
+    /** Bring the index forward to a newly published ledger.
+
+        If the ledger doesn't follow the last one, the index is built again
+        from it, in the background unless the server is standalone.
+    */
+    void
+    update(std::shared_ptr<AcceptedLedger> const& accepted);
+
+    /** Build the index from a ledger. */
+    void
+    build(std::shared_ptr<ReadView const> const& ledger);
+
+    /** The number of accounts indexed. */
+    std::size_t
+    size() const;
+
+private:
+    struct Owner
+    {
+        // The directory's pages, and their numbers.
+        hash_map<uint256, std::uint64_t> pages;
+        std::map<LedgerEntryType, std::set<Position>> entries;
+    };
+
+    struct State
+    {
+        uint256 hash;
+        LedgerIndex seq = 0;
+        hash_map<AccountID, Owner> owners;
+    };
+
+    // A page of an indexed owner's directory a ledger changed.
+    struct Page
+    {
+        AccountID owner;
+        uint256 key;
+        bool deleted = false;
+        // The page's number and entries, unless it can't be indexed.
+        std::optional<std::uint64_t> number;
+        std::vector<std::pair<uint256, LedgerEntryType>> entries;
+    };
+
+    State
+    read(ReadView const& ledger) const;
+
+    // Read an owner's directory, if it can be indexed.
+    static std::optional<Owner>
+    readOwner(ReadView const& ledger, AccountID const& account);
+
+    // The pages of indexed owners' directories the ledger changed.
+    static std::vector<Page>
+    changes(State const& state, AcceptedLedger const& accepted);
+
+    // Bring the state forward with the changes of a ledger that follows it.
+    void
+    apply(State& state, LedgerInfo const& info, std::vector<Page> const& pages)
+        const;
+
+    Application& app_;
+    std::size_t const minEntries_;
+    beast::Journal const j_;
+
+    std::shared_mutex mutable mutex_;
+    State state_;
+
+    // Ledgers published while the index is built.
+    bool building_ = false;
+    std::deque<std::shared_ptr<AcceptedLedger>> pending_;
+
+    // Whether a build fell too far behind to keep the index.
+    bool abandoned_ = false;
+};
+
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_STATEEXPORT_H_INCLUDED
+#define RIPPLE_APP_LEDGER_STATEEXPORT_H_INCLUDED
+
+#include <ripple/basics/Slice.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/shamap/SHAMap.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+/** Reads the state of a ledger as raw binary records, in key order.
+
+    Each record is the 32 byte key of a state entry, the size of the entry
+    in four bytes, most significant first, and then the entry in its
+    canonical binary form.
+
+    Each of the subtrees below the root of the state map is read a few
+    blocks ahead of the blocks being taken, by jtCLIENT_EXPORT jobs, so
+    that fetching the nodes of one subtree overlaps with the others. The
+    job type's limit caps how many subtrees are read at once, over all
+    exports. A subtree whose turn comes before a job has read it is read
+    by the caller of next() instead.
+
+    The map must outlive the export.
+*/
+class StateExport
+{
+public:
+    /** Bytes of records in each block. */
+    static constexpr std::size_t blockSize = 64 * 1024;
+
+    /** Blocks read ahead of the one taken, in each subtree. */
+    static constexpr std::size_t blocksAhead = 4;
+
+    /** Start reading the entries whose keys come after a key. */
+    StateExport(JobQueue& jobQueue, SHAMap const& map, uint256 const& after);
+
+    /** Stops reading, and waits for the jobs that were reading. */
+    ~StateExport();
+
+    StateExport(StateExport const&) = delete;
+    StateExport&
+    operator=(StateExport const&) = delete;
+
+    /** The next block of records, or an empty block after the last.
+
+        @throws SHAMapMissingNode if part of the map isn't available.
+    */
+    std::string
+    next();
+
+    /** The number of records in the blocks taken so far. */
+    std::size_t
+    entries() const
+    {
+        return entries_;
+    }
+
+    /** Add a record to a block. */
+    static void
+    append(std::string& block, uint256 const& key, Slice data);
+
+private:
+    struct Branch;
+
+    // Stop reading, and wait for the jobs that were.
+    void
+    stop();
+
+    // Queue a job to read ahead in a branch, if it needs one. Called with
+    // the branch's mutex held.
+    void
+    schedule(Branch& branch);
+
+    // Read a branch that the caller has marked as being read.
+    void
+    read(Branch& branch);
+
+    // Read blocks until the branch is far enough ahead. Returns true once
+    // all of it has been read.
+    bool
+    fill(Branch& branch);
+
+    JobQueue& jobQueue_;
+    SHAMap const& map_;
+    std::vector<std::unique_ptr<Branch>> branches_;
+    std::atomic<bool> stop_{false};
+
+    // Jobs queued and not yet finished.
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    int jobs_ = 0;
+
+    std::size_t current_ = 0;
+    std::size_t entries_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
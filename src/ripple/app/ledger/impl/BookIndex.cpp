@@ -0,0 +1,387 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/BookIndex.h>
+#include <ripple/basics/Log.h>
+#include <ripple/ledger/View.h>
+#include <ripple/protocol/Indexes.h>
+#include <algorithm>
+
+namespace ripple {
+
+namespace {
+
+std::shared_ptr<BookIndex::Offer const>
+makeOffer(std::shared_ptr<SLE const> sle)
+{
+    auto json = sle->getJson(JsonOptions::none);
+    return std::make_shared<BookIndex::Offer const>(
+        BookIndex::Offer{std::move(sle), std::move(json)});
+}
+
+std::shared_ptr<BookIndex::Level>
+makeLevel(uint256 const& dir)
+{
+    auto level = std::make_shared<BookIndex::Level>();
+    level->rate = amountFromQuality(getQuality(dir));
+    level->quality = level->rate.getText();
+    return level;
+}
+
+std::size_t
+countOffers(BookIndex::Levels const& levels)
+{
+    std::size_t count = 0;
+    for (auto const& [dir, level] : levels)
+        count += level->offers.size();
+    return count;
+}
+
+// An offer a transaction created, modified or deleted.
+struct Change
+{
+    SField const& type;
+    uint256 key;
+    uint256 dir;
+};
+
+}  // namespace
+
+BookIndex::BookIndex(beast::Journal j, std::size_t books, std::size_t offers)
+    : j_(j), maxBooks_(books), maxOffers_(offers)
+{
+}
+
+std::optional<BookIndex::Snapshot>
+BookIndex::find(ReadView const& ledger, Book const& book)
+{
+    if (ledger.open())
+        return std::nullopt;
+
+    auto const& hash = ledger.info().hash;
+    {
+        std::lock_guard lock(mutex_);
+        if (state_.seq == 0 || state_.hash != hash)
+            return std::nullopt;
+        if (auto const it = state_.books.find(book); it != state_.books.end())
+        {
+            it->second.used = state_.seq;
+            return Snapshot{it->second.levels, funds(book.out)};
+        }
+    }
+
+    auto const levels = read(ledger, book);
+    auto const offers = countOffers(*levels);
+
+    std::lock_guard lock(mutex_);
+    if (state_.hash != hash)
+        return Snapshot{levels, std::make_shared<Funds>()};
+    if (maxBooks_ == 0 || offers > maxOffers_)
+    {
+        JLOG(j_.debug()) << "Not keeping " << book << ": " << offers
+                         << " offers";
+        return Snapshot{levels, funds(book.out)};
+    }
+    if (state_.books.count(book) == 0)
+    {
+        trim(state_, 1, offers);
+        state_.books.emplace(book, Entry{levels, offers, state_.seq});
+        state_.offers += offers;
+        JLOG(j_.debug()) << "Keeping " << book << " from " << state_.seq
+                         << ": " << levels->size() << " qualities, "
+                         << offers << " offers";
+    }
+    return Snapshot{levels, funds(book.out)};
+}
+
+std::shared_ptr<BookIndex::Funds>
+BookIndex::funds(Issue const& issue)
+{
+    auto& funds = state_.funds[issue];
+    if (!funds)
+        funds = std::make_shared<Funds>();
+    return funds;
+}
+
+std::pair<std::size_t, std::size_t>
+BookIndex::size()
+{
+    std::lock_guard lock(mutex_);
+    return {state_.books.size(), state_.offers};
+}
+
+void
+BookIndex::trim(State& state, std::size_t books, std::size_t offers) const
+{
+    while (!state.books.empty() &&
+           (state.books.size() + books > maxBooks_ ||
+            state.offers + offers > maxOffers_))
+    {
+        auto const lru = std::min_element(
+            state.books.begin(),
+            state.books.end(),
+            [](auto const& lhs, auto const& rhs) {
+                return lhs.second.used < rhs.second.used;
+            });
+        JLOG(j_.debug()) << "Dropping " << lru->first << ": not asked about "
+                         << "since " << lru->second.used;
+        state.offers -= lru->second.offers;
+        state.books.erase(lru);
+    }
+}
+
+std::shared_ptr<BookIndex::Levels const>
+BookIndex::read(ReadView const& ledger, Book const& book)
+{
+    auto levels = std::make_shared<Levels>();
+    auto tip = getBookBase(book);
+    auto const end = getQualityNext(tip);
+    while (auto const dir = ledger.succ(tip, end))
+    {
+        tip = *dir;
+        auto level = makeLevel(tip);
+        std::shared_ptr<SLE const> page;
+        unsigned int index;
+        uint256 entry;
+        for (bool more = cdirFirst(ledger, tip, page, index, entry); more;
+             more = cdirNext(ledger, tip, page, index, entry))
+        {
+            if (auto sle = ledger.read(keylet::offer(entry)))
+                level->offers.push_back(makeOffer(std::move(sle)));
+        }
+        if (!level->offers.empty())
+            levels->emplace(tip, std::move(level));
+    }
+    return levels;
+}
+
+void
+BookIndex::update(AcceptedLedger const& accepted)
+{
+    auto const& ledger = *accepted.getLedger();
+    auto const& info = ledger.info();
+
+    State next;
+    {
+        std::lock_guard lock(mutex_);
+        if (state_.seq == 0 || state_.hash != info.parentHash)
+        {
+            if (!state_.books.empty())
+                JLOG(j_.info()) << "Dropping " << state_.books.size()
+                                << " books: " << info.seq
+                                << " doesn't follow " << state_.seq;
+            state_ = State{info.hash, info.seq};
+            return;
+        }
+        next = state_;
+    }
+    next.hash = info.hash;
+    next.seq = info.seq;
+
+    try
+    {
+        advance(next, accepted);
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.warn()) << "Dropping books at " << info.seq << ": "
+                        << e.what();
+        next = State{info.hash, info.seq};
+    }
+
+    std::lock_guard lock(mutex_);
+    state_ = std::move(next);
+}
+
+void
+BookIndex::advance(State& next, AcceptedLedger const& accepted) const
+{
+    auto const& ledger = *accepted.getLedger();
+    auto const& info = ledger.info();
+
+    // What the ledger's transactions changed that the books and funds
+    // depend on.
+    hash_map<Book, std::vector<Change>> changes;
+    hash_map<Issue, hash_set<AccountID>> touched;
+    hash_set<AccountID> issuers;
+    bool rules = false;
+    for (auto const& tx : accepted)
+    {
+        for (auto const& node : tx->getMeta().getNodes())
+        {
+            auto const data = dynamic_cast<STObject const*>(
+                node.peekAtPField(
+                    node.getFName() == sfCreatedNode ? sfNewFields
+                                                     : sfFinalFields));
+            if (!data)
+                continue;
+
+            switch (node.getFieldU16(sfLedgerEntryType))
+            {
+                case ltOFFER: {
+                    Book const book{
+                        data->getFieldAmount(sfTakerPays).issue(),
+                        data->getFieldAmount(sfTakerGets).issue()};
+                    if (next.books.count(book) != 0)
+                        changes[book].push_back(
+                            {node.getFName(),
+                             node.getFieldH256(sfLedgerIndex),
+                             data->getFieldH256(sfBookDirectory)});
+                    break;
+                }
+                case ltACCOUNT_ROOT: {
+                    auto const account = data->getAccountID(sfAccount);
+                    touched[xrpIssue()].insert(account);
+                    issuers.insert(account);
+                    break;
+                }
+                case ltRIPPLE_STATE: {
+                    auto const& low = data->getFieldAmount(sfLowLimit);
+                    auto const& high = data->getFieldAmount(sfHighLimit);
+                    touched[{low.getCurrency(), high.getIssuer()}].insert(
+                        low.getIssuer());
+                    touched[{low.getCurrency(), low.getIssuer()}].insert(
+                        high.getIssuer());
+                    break;
+                }
+                case ltFEE_SETTINGS:
+                case ltAMENDMENTS:
+                    rules = true;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    for (auto it = next.books.begin(); it != next.books.end();)
+    {
+        if (it->second.used + keepLedgers < info.seq)
+        {
+            next.offers -= it->second.offers;
+            it = next.books.erase(it);
+        }
+        else
+            ++it;
+    }
+
+    for (auto const& [book, list] : changes)
+    {
+        auto const it = next.books.find(book);
+        if (it == next.books.end())
+            continue;
+
+        auto levels = std::make_shared<Levels>(*it->second.levels);
+        hash_map<uint256, std::shared_ptr<Level>> edited;
+        auto edit = [&](uint256 const& dir) -> Level& {
+            auto& level = edited[dir];
+            if (!level)
+            {
+                auto const at = levels->find(dir);
+                level = at == levels->end()
+                    ? makeLevel(dir)
+                    : std::make_shared<Level>(*at->second);
+                (*levels)[dir] = level;
+            }
+            return *level;
+        };
+
+        // Offers this ledger created and deleted again.
+        hash_set<uint256> gone;
+        bool consistent = true;
+        for (auto const& change : list)
+        {
+            auto& offers = edit(change.dir).offers;
+            auto const at =
+                std::find_if(offers.begin(), offers.end(), [&](auto const& o) {
+                    return o->sle->key() == change.key;
+                });
+            if (change.type == sfDeletedNode)
+            {
+                if (at != offers.end())
+                    offers.erase(at);
+                else
+                    consistent = consistent && gone.count(change.key) != 0;
+                continue;
+            }
+
+            auto sle = ledger.read(keylet::offer(change.key));
+            if (!sle)
+            {
+                // A later transaction deletes it.
+                gone.insert(change.key);
+                continue;
+            }
+            if (change.type == sfCreatedNode && at == offers.end())
+                offers.push_back(makeOffer(std::move(sle)));
+            else if (change.type == sfModifiedNode && at != offers.end())
+                *at = makeOffer(std::move(sle));
+            else
+                consistent = false;
+        }
+
+        if (!consistent)
+        {
+            JLOG(j_.warn()) << "Dropping " << book << " at " << info.seq
+                            << ": its offers don't match the ledger's";
+            next.offers -= it->second.offers;
+            next.books.erase(it);
+            continue;
+        }
+        for (auto const& [dir, level] : edited)
+        {
+            if (level->offers.empty())
+                levels->erase(dir);
+        }
+        auto const offers = countOffers(*levels);
+        next.offers = next.offers - it->second.offers + offers;
+        it->second.offers = offers;
+        it->second.levels = std::move(levels);
+    }
+    trim(next, 0, 0);
+
+    for (auto it = next.funds.begin(); it != next.funds.end();)
+    {
+        auto const& [issue, funds] = *it;
+        if (rules || (!isXRP(issue) && issuers.count(issue.account) != 0))
+        {
+            it = next.funds.erase(it);
+            continue;
+        }
+        if (auto const t = touched.find(issue); t != touched.end())
+        {
+            // Readers of the previous ledger may still add to its funds,
+            // including for accounts this ledger touched, so this ledger's
+            // can't be the same object.
+            auto fresh = std::make_shared<Funds>();
+            {
+                std::lock_guard lock(funds->mutex_);
+                for (auto const& [account, amount] : funds->held_)
+                {
+                    if (t->second.count(account) == 0)
+                        fresh->held_.emplace(account, amount);
+                }
+            }
+            it->second = std::move(fresh);
+        }
+        ++it;
+    }
+}
+
+}  // namespace ripple
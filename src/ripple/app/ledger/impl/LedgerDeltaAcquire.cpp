@@ -58,6 +58,9 @@ void
 LedgerDeltaAcquire::init(int numPeers)
 {
     ScopedLockType sl(mtx_);
+    if (started_)
+        return;
+    started_ = true;
     if (!isDone())
     {
         trigger(numPeers, sl);
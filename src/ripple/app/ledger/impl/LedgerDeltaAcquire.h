@@ -75,6 +75,7 @@ public:
     /**
      * Start the LedgerDeltaAcquire task
      * @param numPeers  number of peers to try initially
+     * @note calling this more than once has no effect
      */
     void
     init(int numPeers);
@@ -156,6 +157,7 @@ private:
     std::set<InboundLedger::Reason> reasons_;
     std::uint32_t noFeaturePeerCount = 0;
     bool fallBack_ = false;
+    bool started_ = false;
 
     friend class LedgerReplayTask;  // for asserts only
     friend class test::LedgerReplayClient;
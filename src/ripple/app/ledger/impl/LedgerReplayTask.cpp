@@ -190,35 +190,104 @@ LedgerReplayTask::tryAdvance(ScopedLockType& sl)
                            << ", totalDeltas=" << deltas_.size() << ", parent "
                            << (parent_ ? parent_->info().hash : uint256());
 
-    bool shouldTry = parent_ && parameter_.full_ &&
-        parameter_.totalLedgers_ - 1 == deltas_.size();
-    if (!shouldTry)
+    if (!parameter_.full_ || parameter_.totalLedgers_ - 1 != deltas_.size())
         return;
 
-    try
+    // Deltas are acquired while the ledgers before them are built.
+    requestDeltas(sl);
+    if (!parent_ || isDone())
+        return;
+
+    if (building_)
     {
-        for (; deltaToBuild_ < deltas_.size(); ++deltaToBuild_)
-        {
-            auto& delta = deltas_[deltaToBuild_];
-            assert(parent_->seq() + 1 == delta->ledgerSeq_);
-            if (auto l = delta->tryBuild(parent_); l)
-            {
-                JLOG(journal_.debug())
-                    << "Task " << hash_ << " got ledger " << l->info().hash
-                    << " deltaIndex=" << deltaToBuild_
-                    << " totalDeltas=" << deltas_.size();
-                parent_ = l;
-            }
-            else
-                return;
-        }
+        buildAgain_ = true;
+        return;
+    }
 
+    if (deltaToBuild_ == deltas_.size())
+    {
         complete_ = true;
         JLOG(journal_.info()) << "Completed " << hash_;
+        return;
     }
-    catch (std::runtime_error const&)
+
+    // Build off the thread that delivered the delta, so that acquiring and
+    // verifying the next deltas is not held up by applying this one.
+    building_ = true;
+    std::weak_ptr<LedgerReplayTask> wptr = shared_from_this();
+    if (!app_.getJobQueue().addJob(
+            jtREPLAY_TASK, "LedgerReplayTask::build", [wptr]() {
+                if (auto sptr = wptr.lock(); sptr)
+                    sptr->build();
+            }))
     {
-        failed_ = true;
+        building_ = false;
+    }
+}
+
+void
+LedgerReplayTask::requestDeltas(ScopedLockType& sl)
+{
+    while (deltaToRequest_ < deltas_.size() &&
+           deltaToRequest_ <
+               deltaToBuild_ + LedgerReplayParameters::MAX_DELTAS_IN_FLIGHT)
+    {
+        // init may complete the delta right away and call back into this
+        // task, so advance the index first.
+        auto const& delta = deltas_[deltaToRequest_++];
+        delta->init(1);
+    }
+}
+
+void
+LedgerReplayTask::build()
+{
+    ScopedLockType sl(mtx_);
+    while (!isDone() && deltaToBuild_ < deltas_.size())
+    {
+        auto const delta = deltas_[deltaToBuild_];
+        auto const parent = parent_;
+        assert(parent->seq() + 1 == delta->ledgerSeq_);
+        buildAgain_ = false;
+
+        std::shared_ptr<Ledger const> l;
+        sl.unlock();
+        try
+        {
+            l = delta->tryBuild(parent);
+        }
+        catch (std::runtime_error const&)
+        {
+            sl.lock();
+            failed_ = true;
+            building_ = false;
+            return;
+        }
+        if (l)
+            replayer_.onLedgerBuilt();
+        sl.lock();
+
+        if (!l)
+        {
+            if (buildAgain_)
+                continue;
+            break;
+        }
+
+        JLOG(journal_.debug())
+            << "Task " << hash_ << " got ledger " << l->info().hash
+            << " deltaIndex=" << deltaToBuild_
+            << " totalDeltas=" << deltas_.size();
+        parent_ = l;
+        ++deltaToBuild_;
+        requestDeltas(sl);
+    }
+
+    building_ = false;
+    if (!isDone() && deltaToBuild_ == deltas_.size())
+    {
+        complete_ = true;
+        JLOG(journal_.info()) << "Completed " << hash_;
     }
 }
 
@@ -21,6 +21,7 @@
 #include <ripple/app/ledger/impl/LedgerDeltaAcquire.h>
 #include <ripple/app/ledger/impl/SkipListAcquire.h>
 #include <ripple/core/JobQueue.h>
+#include <ripple/protocol/jss.h>
 
 namespace ripple {
 
@@ -140,7 +141,6 @@ LedgerReplayer::createDeltas(std::shared_ptr<LedgerReplayTask> task)
              ++seq, ++skipListItem)
         {
             std::shared_ptr<LedgerDeltaAcquire> delta;
-            bool newDelta = false;
             {
                 std::lock_guard<std::mutex> lock(mtx_);
                 if (app_.isStopping())
@@ -158,13 +158,12 @@ LedgerReplayer::createDeltas(std::shared_ptr<LedgerReplayTask> task)
                         seq,
                         peerSetBuilder_->build());
                     deltas_[*skipListItem] = delta;
-                    newDelta = true;
                 }
             }
 
+            // the task starts acquiring the delta once it is close enough
+            // to the ledgers being built
             task->addDelta(delta);
-            if (newDelta)
-                delta->init(1);
         }
     }
 }
@@ -215,6 +214,47 @@ LedgerReplayer::gotReplayDelta(
         delta->processData(info, std::move(txns));
 }
 
+void
+LedgerReplayer::onLedgerBuilt()
+{
+    auto const now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mtx_);
+    ++totalBuilt_;
+    recentBuilds_.push_back(now);
+    while (now - recentBuilds_.front() >
+           LedgerReplayParameters::THROUGHPUT_WINDOW)
+        recentBuilds_.pop_front();
+}
+
+Json::Value
+LedgerReplayer::getJson() const
+{
+    using namespace std::chrono;
+    auto const now = steady_clock::now();
+
+    Json::Value ret(Json::objectValue);
+    std::lock_guard<std::mutex> lock(mtx_);
+    ret[jss::tasks] = static_cast<Json::UInt>(tasks_.size());
+    ret[jss::deltas] = static_cast<Json::UInt>(deltas_.size());
+    ret[jss::ledgers_built] = static_cast<Json::UInt>(totalBuilt_);
+
+    // Ledgers per second, over the part of the window since the first
+    // ledger in it was built.
+    auto const recent = std::count_if(
+        recentBuilds_.begin(), recentBuilds_.end(), [&](auto const& t) {
+            return now - t <= LedgerReplayParameters::THROUGHPUT_WINDOW;
+        });
+    double rate = 0;
+    if (recent != 0)
+    {
+        auto const span = std::max<duration<double>>(
+            now - recentBuilds_[recentBuilds_.size() - recent], seconds{1});
+        rate = recent / span.count();
+    }
+    ret[jss::ledgers_per_sec] = rate;
+    return ret;
+}
+
 void
 LedgerReplayer::sweep()
 {
@@ -24,6 +24,7 @@
 #include <ripple/core/Pg.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/DeliveredAmount.h>
+#include <cstring>
 
 namespace ripple {
 
@@ -47,6 +48,30 @@ isBinary(LedgerFill const& fill)
     return fill.options & LedgerFill::binary;
 }
 
+// Whether the client the ledger is written for has gone away.
+bool
+isStopped(LedgerFill const& fill)
+{
+    return fill.context && fill.context->stopped && fill.context->stopped();
+}
+
+// A Json::Value writes its members in key order, but a Json::Object writes
+// them in the order they're added. Write, and remove, the members of from
+// whose keys come before key, so that a member that's written as it's
+// produced can go among them where a Json::Value would put it.
+void
+writeBefore(Json::Object& to, Json::Value& from, Json::StaticString key)
+{
+    while (from.size() != 0)
+    {
+        std::string const name = from.begin().memberName();
+        if (std::strcmp(name.c_str(), key.c_str()) >= 0)
+            return;
+        to[name] = from[name];
+        from.removeMember(name);
+    }
+}
+
 template <class Object>
 void
 fillJson(Object& json, bool closed, LedgerInfo const& info, bool bFull)
@@ -173,6 +198,8 @@ fillJsonTx(Object& json, LedgerFill const& fill)
         auto appendAll = [&](auto const& txs) {
             for (auto& i : txs)
             {
+                if (isStopped(fill))
+                    break;
                 txns.append(
                     fillJsonTx(fill, bBinary, bExpanded, i.first, i.second));
             }
@@ -209,6 +236,8 @@ fillJsonState(Object& json, LedgerFill const& fill)
 
     for (auto const& sle : ledger.sles)
     {
+        if (isStopped(fill))
+            break;
         if (fill.type == ltANY || sle->getType() == fill.type)
         {
             if (binary)
@@ -275,6 +304,33 @@ fillJson(Object& json, LedgerFill const& fill)
         fillJsonState(json, fill);
 }
 
+// Like the above, with the transactions and state written as they're
+// produced, and the rest in key order around them.
+void
+fillJson(Json::Object& json, LedgerFill const& fill)
+{
+    auto bFull = isFull(fill);
+    Json::Value header(Json::objectValue);
+    if (isBinary(fill))
+        fillJsonBinary(header, !fill.ledger.open(), fill.ledger.info());
+    else
+        fillJson(header, !fill.ledger.open(), fill.ledger.info(), bFull);
+
+    if (bFull || fill.options & LedgerFill::dumpState)
+    {
+        writeBefore(json, header, jss::accountState);
+        fillJsonState(json, fill);
+    }
+
+    if (bFull || fill.options & LedgerFill::dumpTxrp)
+    {
+        writeBefore(json, header, jss::transactions);
+        fillJsonTx(json, fill);
+    }
+
+    Json::copyFrom(json, header);
+}
+
 }  // namespace
 
 void
@@ -287,6 +343,20 @@ addJson(Json::Value& json, LedgerFill const& fill)
         fillJsonQueue(json, fill);
 }
 
+void
+addJson(Json::Object& json, LedgerFill const& fill, Json::Value members)
+{
+    if ((fill.options & LedgerFill::dumpQueue) && !fill.txQueue.empty())
+        fillJsonQueue(members, fill);
+
+    writeBefore(json, members, jss::ledger);
+    {
+        auto&& object = Json::addObject(json, jss::ledger);
+        fillJson(object, fill);
+    }
+    Json::copyFrom(json, members);
+}
+
 Json::Value
 getJson(LedgerFill const& fill)
 {
@@ -0,0 +1,495 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/OwnerIndex.h>
+#include <ripple/app/main/Application.h>
+#include <ripple/basics/Log.h>
+#include <ripple/basics/safe_cast.h>
+#include <ripple/core/Config.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/Protocol.h>
+#include <algorithm>
+
+namespace ripple {
+
+namespace {
+
+// The type of a ledger entry, without deserializing it if that can be
+// avoided.
+std::optional<LedgerEntryType>
+entryType(ReadView const& ledger, uint256 const& key)
+{
+    if (auto const lazy = dynamic_cast<Ledger const*>(&ledger))
+    {
+        if (auto const view = lazy->readLazy(keylet::child(key)))
+            return safe_cast<LedgerEntryType>((*view)[sfLedgerEntryType]);
+        return std::nullopt;
+    }
+    if (auto const sle = ledger.read(keylet::child(key)))
+        return sle->getType();
+    return std::nullopt;
+}
+
+// The number of a directory page, which its key is made from.
+std::optional<std::uint64_t>
+pageNumber(ReadView const& ledger, SLE const& page)
+{
+    auto const root = page.getFieldH256(sfRootIndex);
+    if (page.key() == root)
+        return 0;
+
+    // A page is added with the number after the page before it.
+    auto const previous = page.getFieldU64(sfIndexPrevious);
+    if (keylet::page(root, previous + 1).key == page.key())
+        return previous + 1;
+
+    // But pages between them may have been removed since.
+    auto const sle = ledger.read(keylet::page(root, previous));
+    if (!sle)
+        return std::nullopt;
+    auto const next = sle->getFieldU64(sfIndexNext);
+    if (keylet::page(root, next).key == page.key())
+        return next;
+    return std::nullopt;
+}
+
+}  // namespace
+
+OwnerIndex::OwnerIndex(
+    Application& app,
+    std::size_t minEntries,
+    beast::Journal j)
+    : app_(app), minEntries_(minEntries), j_(j)
+{
+}
+
+std::optional<OwnerIndex::Window>
+OwnerIndex::find(
+    ReadView const& ledger,
+    AccountID const& account,
+    std::vector<LedgerEntryType> const& types,
+    Position const& start,
+    bool inclusive,
+    std::size_t limit) const
+{
+    if (!enabled() || ledger.open())
+        return std::nullopt;
+
+    std::shared_lock lock(mutex_);
+    if (state_.seq == 0 || state_.hash != ledger.info().hash)
+        return std::nullopt;
+    auto const it = state_.owners.find(account);
+    if (it == state_.owners.end())
+        return std::nullopt;
+    auto const& entries = it->second.entries;
+
+    if (start.key.isNonZero() &&
+        std::none_of(entries.begin(), entries.end(), [&](auto const& e) {
+            return e.second.count(start) != 0;
+        }))
+        return std::nullopt;
+
+    // Walk the entries of every type, merged in directory order, and keep
+    // those of the types asked for.
+    using iterator = std::set<Position>::const_iterator;
+    struct Cursor
+    {
+        iterator iter;
+        iterator end;
+        bool wanted;
+    };
+    std::vector<Cursor> cursors;
+    cursors.reserve(entries.size());
+    for (auto const& [type, positions] : entries)
+    {
+        auto const iter = inclusive ? positions.lower_bound(start)
+                                    : positions.upper_bound(start);
+        if (iter != positions.end())
+            cursors.push_back(
+                {iter,
+                 positions.end(),
+                 std::find(types.begin(), types.end(), type) != types.end()});
+    }
+
+    Window window;
+    for (std::size_t n = 0; !cursors.empty(); ++n)
+    {
+        auto const least = std::min_element(
+            cursors.begin(), cursors.end(), [](auto const& a, auto const& b) {
+                return *a.iter < *b.iter;
+            });
+        if (n == limit)
+        {
+            window.next = *least->iter;
+            break;
+        }
+        window.last = *least->iter;
+        if (least->wanted)
+            window.found.push_back(*least->iter);
+        if (++least->iter == least->end)
+            cursors.erase(least);
+    }
+    return window;
+}
+
+std::optional<std::uint64_t>
+OwnerIndex::page(
+    ReadView const& ledger,
+    AccountID const& account,
+    uint256 const& key) const
+{
+    if (!enabled() || ledger.open())
+        return std::nullopt;
+
+    std::shared_lock lock(mutex_);
+    if (state_.seq == 0 || state_.hash != ledger.info().hash)
+        return std::nullopt;
+    auto const it = state_.owners.find(account);
+    if (it == state_.owners.end())
+        return std::nullopt;
+    auto const page = it->second.pages.find(key);
+    if (page == it->second.pages.end())
+        return std::nullopt;
+    return page->second;
+}
+
+void
+OwnerIndex::update(std::shared_ptr<AcceptedLedger> const& accepted)
+{
+    if (!enabled())
+        return;
+
+    auto const& info = accepted->getLedger()->info();
+
+    bool rebuild = false;
+    {
+        std::unique_lock lock(mutex_);
+        if (abandoned_)
+            return;
+        if (building_)
+        {
+            // A build that falls this far behind would only be followed by
+            // another: give up on the index, and walk directories instead.
+            if (pending_.size() >= maxPending)
+            {
+                JLOG(j_.warn()) << "Not keeping the index: building it took "
+                                << "longer than " << maxPending << " ledgers";
+                abandoned_ = true;
+                pending_.clear();
+                state_ = State{};
+                return;
+            }
+            pending_.push_back(accepted);
+            return;
+        }
+        rebuild = state_.seq == 0 || state_.hash != info.parentHash;
+        building_ = rebuild;
+    }
+
+    if (!rebuild)
+    {
+        try
+        {
+            std::vector<Page> pages;
+            {
+                std::shared_lock lock(mutex_);
+                pages = changes(state_, *accepted);
+            }
+            std::unique_lock lock(mutex_);
+            apply(state_, info, pages);
+            return;
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.warn()) << "Rebuilding at " << info.seq << ": "
+                            << e.what();
+        }
+
+        std::unique_lock lock(mutex_);
+        state_ = State{};
+        building_ = true;
+    }
+
+    auto const ledger = accepted->getLedger();
+    if (app_.config().standalone())
+        build(ledger);
+    else
+        app_.getJobQueue().addJob(
+            jtOWNER_INDEX,
+            "OwnerIndex::build: " + std::to_string(info.seq),
+            [this, ledger]() { build(ledger); });
+}
+
+void
+OwnerIndex::build(std::shared_ptr<ReadView const> const& ledger)
+{
+    JLOG(j_.info()) << "Building from " << ledger->seq();
+
+    State state;
+    try
+    {
+        state = read(*ledger);
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.warn()) << "Building from " << ledger->seq()
+                        << " failed: " << e.what();
+    }
+
+    // Bring the new state forward with the ledgers published since.
+    for (;;)
+    {
+        std::shared_ptr<AcceptedLedger> next;
+        {
+            std::unique_lock lock(mutex_);
+            if (abandoned_)
+            {
+                building_ = false;
+                return;
+            }
+            if (pending_.empty())
+            {
+                JLOG(j_.info()) << "Built at " << state.seq << ": "
+                                << state.owners.size() << " accounts";
+                state_ = std::move(state);
+                building_ = false;
+                return;
+            }
+            next = std::move(pending_.front());
+            pending_.pop_front();
+        }
+
+        auto const& info = next->getLedger()->info();
+        if (state.seq == 0 || state.hash != info.parentHash)
+            continue;
+        try
+        {
+            apply(state, info, changes(state, *next));
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.warn()) << "Building at " << info.seq
+                            << " failed: " << e.what();
+            state = State{};
+        }
+    }
+}
+
+std::size_t
+OwnerIndex::size() const
+{
+    std::shared_lock lock(mutex_);
+    return state_.owners.size();
+}
+
+OwnerIndex::State
+OwnerIndex::read(ReadView const& ledger) const
+{
+    // How many entries each owner's directory holds. A directory that fits
+    // on its root page is too small to be indexed.
+    bool const skipRoots = minEntries_ > dirNodeMaxEntries;
+    hash_map<AccountID, std::size_t> sizes;
+    auto const count = [&](auto const& entry, uint256 const& key) {
+        if (safe_cast<LedgerEntryType>(entry[sfLedgerEntryType]) !=
+            ltDIR_NODE)
+            return;
+        auto const owner = entry[~sfOwner];
+        if (!owner)
+            return;
+        if (skipRoots && entry[sfRootIndex] == key &&
+            entry[~sfIndexPrevious].value_or(0) == 0)
+            return;
+        sizes[*owner] += entry[sfIndexes].size();
+    };
+
+    if (auto const lazy = dynamic_cast<Ledger const*>(&ledger))
+    {
+        // Only directory pages are deserialized, and only the fields that
+        // are read from them.
+        for (auto const& item : lazy->stateMap())
+        {
+            if (app_.isStopping())
+                return {};
+            count(STObjectView(item.slice(), nullptr), item.key());
+        }
+    }
+    else
+    {
+        for (auto const& sle : ledger.sles)
+        {
+            if (app_.isStopping())
+                return {};
+            count(*sle, sle->key());
+        }
+    }
+
+    State state{ledger.info().hash, ledger.info().seq, {}};
+    for (auto const& [account, size] : sizes)
+    {
+        if (size < minEntries_)
+            continue;
+        if (auto owner = readOwner(ledger, account))
+            state.owners.emplace(account, std::move(*owner));
+        else
+            JLOG(j_.debug()) << "Not indexing " << account
+                             << ": its directory isn't sorted";
+    }
+    return state;
+}
+
+std::optional<OwnerIndex::Owner>
+OwnerIndex::readOwner(ReadView const& ledger, AccountID const& account)
+{
+    auto const root = keylet::ownerDir(account);
+    Owner owner;
+    std::uint64_t number = 0;
+    for (;;)
+    {
+        auto const page = ledger.read(keylet::page(root, number));
+        if (!page)
+            return std::nullopt;
+
+        // Pages written before directories were sorted are walked instead.
+        auto const& indexes = page->getFieldV256(sfIndexes);
+        if (!std::is_sorted(indexes.begin(), indexes.end()))
+            return std::nullopt;
+
+        for (auto const& key : indexes)
+        {
+            auto const type = entryType(ledger, key);
+            if (!type)
+                return std::nullopt;
+            owner.entries[*type].insert({number, key});
+        }
+        owner.pages.emplace(page->key(), number);
+
+        auto const next = page->getFieldU64(sfIndexNext);
+        if (next == 0)
+            return owner;
+        if (next <= number)
+            return std::nullopt;
+        number = next;
+    }
+}
+
+std::vector<OwnerIndex::Page>
+OwnerIndex::changes(State const& state, AcceptedLedger const& accepted)
+{
+    auto const& ledger = *accepted.getLedger();
+
+    std::vector<Page> pages;
+    hash_set<uint256> seen;
+    for (auto const& tx : accepted)
+    {
+        for (auto const& node : tx->getMeta().getNodes())
+        {
+            if (node.getFieldU16(sfLedgerEntryType) != ltDIR_NODE)
+                continue;
+
+            auto const data = dynamic_cast<STObject const*>(
+                node.peekAtPField(
+                    node.getFName() == sfCreatedNode ? sfNewFields
+                                                     : sfFinalFields));
+            if (!data || !data->isFieldPresent(sfOwner))
+                continue;
+
+            Page page{
+                data->getAccountID(sfOwner), node.getFieldH256(sfLedgerIndex)};
+            if (state.owners.count(page.owner) == 0 ||
+                !seen.insert(page.key).second)
+                continue;
+
+            // What the page holds once all of the ledger's transactions
+            // are applied.
+            auto const sle = ledger.read(keylet::page(page.key));
+            page.deleted = !sle;
+            if (sle)
+            {
+                auto const& indexes = sle->getFieldV256(sfIndexes);
+                if (std::is_sorted(indexes.begin(), indexes.end()))
+                    page.number = pageNumber(ledger, *sle);
+                for (auto const& key : indexes)
+                {
+                    if (!page.number)
+                        break;
+                    if (auto const type = entryType(ledger, key))
+                        page.entries.emplace_back(key, *type);
+                    else
+                        page.number.reset();
+                }
+            }
+            pages.push_back(std::move(page));
+        }
+    }
+    return pages;
+}
+
+void
+OwnerIndex::apply(
+    State& state,
+    LedgerInfo const& info,
+    std::vector<Page> const& pages) const
+{
+    for (auto const& page : pages)
+    {
+        auto const it = state.owners.find(page.owner);
+        if (it == state.owners.end())
+            continue;
+        auto& owner = it->second;
+
+        if (!page.deleted && !page.number)
+        {
+            JLOG(j_.debug()) << "Not indexing " << page.owner << " after "
+                             << info.seq << ": page " << page.key
+                             << " can't be indexed";
+            state.owners.erase(it);
+            continue;
+        }
+
+        std::uint64_t number;
+        if (page.deleted)
+        {
+            auto const known = owner.pages.find(page.key);
+            if (known == owner.pages.end())
+                continue;
+            number = known->second;
+            owner.pages.erase(known);
+        }
+        else
+        {
+            number = *page.number;
+            owner.pages[page.key] = number;
+        }
+
+        // What the index held on the page is replaced by what it holds now.
+        for (auto& [type, positions] : owner.entries)
+            positions.erase(
+                positions.lower_bound({number}),
+                positions.lower_bound({number + 1}));
+        for (auto const& [key, type] : page.entries)
+            owner.entries[type].insert({number, key});
+    }
+
+    state.hash = info.hash;
+    state.seq = info.seq;
+}
+
+}  // namespace ripple
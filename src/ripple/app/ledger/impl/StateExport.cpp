@@ -0,0 +1,251 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/StateExport.h>
+#include <deque>
+#include <exception>
+
+namespace ripple {
+
+// The blocks read from one subtree, waiting to be taken.
+struct StateExport::Branch
+{
+    int const index;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::pair<std::string, std::size_t>> blocks;
+
+    // The key of the last entry read.
+    uint256 last;
+
+    // A job to read the branch is queued, or it's being read.
+    bool queued = false;
+    bool reading = false;
+
+    bool done = false;
+    std::exception_ptr error;
+
+    Branch(int index, uint256 const& after) : index(index), last(after)
+    {
+    }
+};
+
+StateExport::StateExport(
+    JobQueue& jobQueue,
+    SHAMap const& map,
+    uint256 const& after)
+    : jobQueue_(jobQueue), map_(map)
+{
+    int const first = after.data()[0] >> 4;
+    branches_.reserve(16 - first);
+    for (int i = first; i < 16; ++i)
+    {
+        // Start each subtree after the key before its first key, except
+        // for the one the key is in.
+        uint256 start = after;
+        if (i != first)
+        {
+            start.zero();
+            start.data()[0] = static_cast<std::uint8_t>(i << 4);
+            --start;
+        }
+        branches_.push_back(std::make_unique<Branch>(i, start));
+    }
+
+    try
+    {
+        for (auto& branch : branches_)
+        {
+            std::lock_guard lock(branch->mutex);
+            schedule(*branch);
+        }
+    }
+    catch (...)
+    {
+        stop();
+        throw;
+    }
+}
+
+StateExport::~StateExport()
+{
+    stop();
+}
+
+void
+StateExport::stop()
+{
+    stop_ = true;
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this] { return jobs_ == 0; });
+}
+
+std::string
+StateExport::next()
+{
+    while (current_ < branches_.size())
+    {
+        auto& branch = *branches_[current_];
+        std::unique_lock lock(branch.mutex);
+        if (branch.blocks.empty() && !branch.done && !branch.reading)
+        {
+            // Rather than wait for a job that hasn't started, read the
+            // branch here.
+            branch.queued = false;
+            branch.reading = true;
+            lock.unlock();
+            read(branch);
+            lock.lock();
+        }
+        branch.cv.wait(
+            lock, [&] { return !branch.blocks.empty() || branch.done; });
+        if (!branch.blocks.empty())
+        {
+            auto [block, count] = std::move(branch.blocks.front());
+            branch.blocks.pop_front();
+            schedule(branch);
+            entries_ += count;
+            return std::move(block);
+        }
+        if (branch.error)
+            std::rethrow_exception(branch.error);
+        ++current_;
+    }
+    return {};
+}
+
+void
+StateExport::append(std::string& block, uint256 const& key, Slice data)
+{
+    auto const size = static_cast<std::uint32_t>(data.size());
+    char const prefix[4] = {
+        static_cast<char>(size >> 24),
+        static_cast<char>(size >> 16),
+        static_cast<char>(size >> 8),
+        static_cast<char>(size)};
+    block.append(reinterpret_cast<char const*>(key.data()), key.size());
+    block.append(prefix, sizeof(prefix));
+    block.append(reinterpret_cast<char const*>(data.data()), data.size());
+}
+
+void
+StateExport::schedule(Branch& branch)
+{
+    if (stop_ || branch.queued || branch.reading || branch.done ||
+        branch.blocks.size() >= blocksAhead)
+        return;
+
+    {
+        std::lock_guard lock(mutex_);
+        ++jobs_;
+    }
+    branch.queued = true;
+
+    auto const added =
+        jobQueue_.addJob(jtCLIENT_EXPORT, "StateExport", [this, &branch] {
+            bool mine = false;
+            {
+                std::lock_guard lock(branch.mutex);
+                mine = branch.queued && !branch.reading;
+                branch.queued = false;
+                branch.reading = mine;
+            }
+            if (mine)
+                read(branch);
+
+            // Nothing of the export may be used once this is done.
+            std::lock_guard lock(mutex_);
+            if (--jobs_ == 0)
+                cv_.notify_all();
+        });
+    if (!added)
+    {
+        // Left for next() to read.
+        branch.queued = false;
+        std::lock_guard lock(mutex_);
+        --jobs_;
+    }
+}
+
+void
+StateExport::read(Branch& branch)
+{
+    bool done = false;
+    std::exception_ptr error;
+    try
+    {
+        done = fill(branch);
+    }
+    catch (...)
+    {
+        done = true;
+        error = std::current_exception();
+    }
+
+    std::lock_guard lock(branch.mutex);
+    branch.reading = false;
+    branch.done = done;
+    branch.error = error;
+    branch.cv.notify_all();
+}
+
+bool
+StateExport::fill(Branch& branch)
+{
+    // Hand over a block. Returns true if the branch is far enough ahead.
+    auto push = [&](std::string&& block,
+                    std::size_t count,
+                    uint256 const& key) {
+        std::lock_guard lock(branch.mutex);
+        branch.blocks.emplace_back(std::move(block), count);
+        branch.last = key;
+        branch.cv.notify_all();
+        return branch.blocks.size() >= blocksAhead;
+    };
+
+    std::string block;
+    std::size_t count = 0;
+    uint256 last;
+    auto const end = map_.end();
+    for (auto i = map_.upper_bound(branch.last);
+         i != end && (i->key().data()[0] >> 4) == branch.index;
+         ++i)
+    {
+        if (stop_)
+            return false;
+        if (block.empty())
+            block.reserve(blockSize + i->size() + 36);
+        append(block, i->key(), i->slice());
+        ++count;
+        last = i->key();
+        if (block.size() >= blockSize)
+        {
+            if (push(std::move(block), count, last))
+                return false;
+            block.clear();
+            count = 0;
+        }
+    }
+    if (count != 0)
+        push(std::move(block), count, last);
+    return true;
+}
+
+}  // namespace ripple
@@ -26,6 +26,7 @@
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/app/ledger/OpenLedger.h>
 #include <ripple/app/ledger/OrderBookDB.h>
+#include <ripple/app/ledger/OwnerIndex.h>
 #include <ripple/app/ledger/PendingSaves.h>
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/Application.h>
@@ -70,6 +71,7 @@
 #include <ripple/protocol/Protocol.h>
 #include <ripple/protocol/STParsedJSON.h>
 #include <ripple/resource/Fees.h>
+#include <ripple/rpc/ResultCache.h>
 #include <ripple/rpc/ShardArchiveHandler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/shamap/NodeFamily.h>
@@ -185,6 +187,7 @@ public:
 
     NodeCache m_tempNodeCache;
     CachedSLEs cachedSLEs_;
+    RPC::ResultCache rpcResultCache_;
     std::pair<PublicKey, SecretKey> nodeIdentity_;
     ValidatorKeys const validatorKeys_;
 
@@ -197,6 +200,7 @@ public:
     std::unique_ptr<RPC::ShardArchiveHandler> shardArchiveHandler_;
     // VFALCO TODO Make OrderBookDB abstract
     OrderBookDB m_orderBookDB;
+    OwnerIndex ownerIndex_;
     std::unique_ptr<PathRequests> m_pathRequests;
     std::unique_ptr<LedgerMaster> m_ledgerMaster;
     std::unique_ptr<LedgerCleaner> ledgerCleaner_;
@@ -342,12 +346,9 @@ public:
               stopwatch(),
               logs_->journal("TaggedCache"))
 
-        , cachedSLEs_(
-              "Cached SLEs",
-              0,
-              std::chrono::minutes(1),
-              stopwatch(),
-              logs_->journal("CachedSLEs"))
+        , cachedSLEs_(std::chrono::minutes(1), stopwatch())
+
+        , rpcResultCache_(config_->RPC_CACHE_SIZE, config_->RPC_CACHE_COMMANDS)
 
         , validatorKeys_(*config_, m_journal)
 
@@ -369,6 +370,11 @@ public:
 
         , m_orderBookDB(*this)
 
+        , ownerIndex_(
+              *this,
+              config_->OWNER_INDEX_MIN_ENTRIES,
+              logs_->journal("OwnerIndex"))
+
         , m_pathRequests(std::make_unique<PathRequests>(
               *this,
               logs_->journal("PathRequest"),
@@ -790,6 +796,18 @@ public:
         return cachedSLEs_;
     }
 
+    RPC::ResultCache&
+    getRPCResultCache() override
+    {
+        return rpcResultCache_;
+    }
+
+    OwnerIndex&
+    getOwnerIndex() override
+    {
+        return ownerIndex_;
+    }
+
     AmendmentTable&
     getAmendmentTable() override
     {
@@ -48,6 +48,7 @@ namespace perf {
 class PerfLog;
 }
 namespace RPC {
+class ResultCache;
 class ShardArchiveHandler;
 }
 
@@ -64,7 +65,7 @@ template <
 class TaggedCache;
 class STLedgerEntry;
 using SLE = STLedgerEntry;
-using CachedSLEs = TaggedCache<uint256, SLE const>;
+class CachedSLEs;
 
 class CollectorManager;
 class Family;
@@ -85,6 +86,7 @@ class ValidatorKeys;
 class NetworkOPs;
 class OpenLedger;
 class OrderBookDB;
+class OwnerIndex;
 class Overlay;
 class PathRequests;
 class PendingSaves;
@@ -182,6 +184,10 @@ public:
     getTempNodeCache() = 0;
     virtual CachedSLEs&
     cachedSLEs() = 0;
+    virtual RPC::ResultCache&
+    getRPCResultCache() = 0;
+    virtual OwnerIndex&
+    getOwnerIndex() = 0;
     virtual AmendmentTable&
     getAmendmentTable() = 0;
     virtual HashRouter&
@@ -18,6 +18,8 @@
 //==============================================================================
 
 #include <ripple/app/misc/CanonicalTXSet.h>
+#include <algorithm>
+#include <cassert>
 
 namespace ripple {
 
@@ -51,11 +53,64 @@ CanonicalTXSet::accountKey(AccountID const& account)
 void
 CanonicalTXSet::insert(std::shared_ptr<STTx const> const& txn)
 {
-    map_.insert(std::make_pair(
+    entries_.emplace_back(
         Key(accountKey(txn->getAccountID(sfAccount)),
             txn->getSeqProxy(),
             txn->getTransactionID()),
-        txn));
+        txn);
+}
+
+void
+CanonicalTXSet::sort() const
+{
+    if (sorted_ == entries_.size())
+        return;
+
+    auto const byKey = [](value_type const& lhs, value_type const& rhs) {
+        return lhs.first < rhs.first;
+    };
+
+    auto const mid = entries_.begin() + sorted_;
+    std::sort(mid, entries_.end(), byKey);
+    std::inplace_merge(entries_.begin(), mid, entries_.end(), byKey);
+
+    // Drop erased entries and duplicates. Copies of a transaction have the
+    // same key, so they are adjacent and any one of them can be kept.
+    auto out = entries_.begin();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it)
+    {
+        if (!it->second)
+            continue;
+
+        if (out != entries_.begin() && std::prev(out)->first == it->first)
+            continue;
+
+        if (out != it)
+            *out = std::move(*it);
+        ++out;
+    }
+    entries_.erase(out, entries_.end());
+    sorted_ = entries_.size();
+    erased_ = 0;
+}
+
+auto
+CanonicalTXSet::begin() const -> const_iterator
+{
+    sort();
+    return {entries_.cbegin(), entries_.cend()};
+}
+
+auto
+CanonicalTXSet::erase(const_iterator const& it) -> const_iterator
+{
+    auto const index = it.it_ - entries_.cbegin();
+    assert(index < sorted_ && entries_[index].second);
+
+    entries_[index].second.reset();
+    ++erased_;
+
+    return {entries_.cbegin() + index + 1, entries_.cend()};
 }
 
 std::shared_ptr<STTx const>
@@ -74,13 +129,47 @@ CanonicalTXSet::popAcctTransaction(std::shared_ptr<STTx const> const& tx)
     std::shared_ptr<STTx const> result;
     uint256 const effectiveAccount{accountKey(tx->getAccountID(sfAccount))};
 
+    sort();
+
     Key const after(effectiveAccount, tx->getSeqProxy(), beast::zero);
-    auto const itrNext{map_.lower_bound(after)};
-    if (itrNext != map_.end() &&
+    auto itrNext = std::lower_bound(
+        entries_.begin(),
+        entries_.end(),
+        after,
+        [](value_type const& entry, Key const& key) {
+            return entry.first < key;
+        });
+
+    // Skip over transactions that were already erased.
+    while (itrNext != entries_.end() && !itrNext->second &&
+           itrNext->first.getAccount() == effectiveAccount)
+        ++itrNext;
+
+    if (itrNext != entries_.end() &&
         itrNext->first.getAccount() == effectiveAccount)
     {
         result = std::move(itrNext->second);
-        map_.erase(itrNext);
+        ++erased_;
+    }
+
+    return result;
+}
+
+std::vector<CanonicalTXSet::AccountRange>
+CanonicalTXSet::accounts()
+{
+    std::vector<AccountRange> result;
+
+    auto it = begin();
+    auto const last = end();
+    while (it != last)
+    {
+        auto const first = it;
+        auto const& account = first->first.getAccount();
+        do
+            ++it;
+        while (it != last && it->first.getAccount() == account);
+        result.emplace_back(first, it);
     }
 
     return result;
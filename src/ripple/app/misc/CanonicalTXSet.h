@@ -24,6 +24,10 @@
 #include <ripple/protocol/RippleLedgerHash.h>
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/SeqProxy.h>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace ripple {
 
@@ -33,6 +37,16 @@ namespace ripple {
 
     - Puts transactions from the same account in SeqProxy order
 
+    The transactions are kept in a flat vector. Insertions are appended and
+    sorted into place the next time the set is inspected, so building a set
+    costs a single sort. Erasing leaves a tombstone in place, which keeps
+    iterators valid while the set is traversed; tombstones are skipped, and
+    are dropped when newly inserted transactions are sorted in.
+
+    @note insert() invalidates all outstanding iterators.
+
+    @note Reading a set can sort it, so a set that is shared between
+          threads must be locked even to read it.
 */
 // VFALCO TODO rename to SortedTxSet
 class CanonicalTXSet : public CountedObject<CanonicalTXSet>
@@ -105,8 +119,87 @@ private:
     accountKey(AccountID const& account);
 
 public:
-    using const_iterator =
-        std::map<Key, std::shared_ptr<STTx const>>::const_iterator;
+    // An entry whose transaction is null has been erased.
+    using value_type = std::pair<Key, std::shared_ptr<STTx const>>;
+
+    /** Iterates over the transactions in canonical order.
+
+        Erased entries are skipped.
+    */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = CanonicalTXSet::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type const*;
+        using reference = value_type const&;
+
+        const_iterator() = default;
+
+        reference
+        operator*() const
+        {
+            return *it_;
+        }
+
+        pointer
+        operator->() const
+        {
+            return &*it_;
+        }
+
+        const_iterator&
+        operator++()
+        {
+            ++it_;
+            skip();
+            return *this;
+        }
+
+        const_iterator
+        operator++(int)
+        {
+            auto ret = *this;
+            ++(*this);
+            return ret;
+        }
+
+        friend bool
+        operator==(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return lhs.it_ == rhs.it_;
+        }
+
+        friend bool
+        operator!=(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return lhs.it_ != rhs.it_;
+        }
+
+    private:
+        friend class CanonicalTXSet;
+
+        using base_type = std::vector<value_type>::const_iterator;
+
+        const_iterator(base_type it, base_type end) : it_(it), end_(end)
+        {
+            skip();
+        }
+
+        void
+        skip()
+        {
+            while (it_ != end_ && !it_->second)
+                ++it_;
+        }
+
+        base_type it_;
+        base_type end_;
+    };
+
+    /** The transactions of a single account, in canonical order. */
+    using AccountRange = std::pair<const_iterator, const_iterator>;
 
 public:
     explicit CanonicalTXSet(LedgerHash const& saltHash) : salt_(saltHash)
@@ -126,40 +219,54 @@ public:
     std::shared_ptr<STTx const>
     popAcctTransaction(std::shared_ptr<STTx const> const& tx);
 
+    /** Split the set into runs of transactions from the same account.
+
+        Runs are returned in canonical order. The transactions within a run
+        must be applied in order, but runs of different accounts do not
+        share a sender.
+    */
+    std::vector<AccountRange>
+    accounts();
+
     void
     reset(LedgerHash const& salt)
     {
         salt_ = salt;
-        map_.clear();
+        entries_.clear();
+        sorted_ = 0;
+        erased_ = 0;
     }
 
+    /** Erase the transaction at the given position.
+
+        The entry is marked as erased rather than removed, so other
+        iterators remain valid.
+
+        @return An iterator to the next transaction.
+    */
     const_iterator
-    erase(const_iterator const& it)
-    {
-        return map_.erase(it);
-    }
+    erase(const_iterator const& it);
 
     const_iterator
-    begin() const
-    {
-        return map_.begin();
-    }
+    begin() const;
 
     const_iterator
     end() const
     {
-        return map_.end();
+        return {entries_.cend(), entries_.cend()};
     }
 
     size_t
     size() const
     {
-        return map_.size();
+        sort();
+        return entries_.size() - erased_;
     }
+
     bool
     empty() const
     {
-        return map_.empty();
+        return size() == 0;
     }
 
     uint256 const&
@@ -169,7 +276,19 @@ public:
     }
 
 private:
-    std::map<Key, std::shared_ptr<STTx const>> map_;
+    // Sort newly inserted entries into place, dropping duplicates and
+    // erased entries. This doesn't change the contents of the set, so the
+    // accessors that observe the order do it even when the set is const.
+    void
+    sort() const;
+
+    // Entries [0, sorted_) are in canonical order; the rest are appended
+    // in insertion order and are sorted by sort().
+    std::vector<value_type> mutable entries_;
+    std::size_t mutable sorted_ = 0;
+
+    // The number of entries that have been erased but not yet removed.
+    std::size_t mutable erased_ = 0;
 
     // Used to salt the accounts so people can't mine for low account numbers
     uint256 salt_;
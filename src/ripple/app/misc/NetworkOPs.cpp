@@ -26,6 +26,7 @@
 #include <ripple/app/ledger/LocalTxs.h>
 #include <ripple/app/ledger/OpenLedger.h>
 #include <ripple/app/ledger/OrderBookDB.h>
+#include <ripple/app/ledger/OwnerIndex.h>
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/LoadManager.h>
 #include <ripple/app/misc/AmendmentTable.h>
@@ -52,7 +53,10 @@
 #include <ripple/crypto/RFC1751.h>
 #include <ripple/crypto/csprng.h>
 #include <ripple/json/to_string.h>
+#include <ripple/net/AccountSubscriptions.h>
 #include <ripple/net/RPCErr.h>
+#include <ripple/net/StreamPublisher.h>
+#include <ripple/net/SubscriberList.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/overlay/Cluster.h>
 #include <ripple/overlay/Overlay.h>
@@ -245,6 +249,7 @@ public:
               validatorKeys,
               app_.logs().journal("LedgerConsensus"))
         , m_ledgerMaster(ledgerMaster)
+        , mPublisher(job_queue, app_.journal("StreamPublisher"))
         , m_job_queue(job_queue)
         , m_standalone(standalone)
         , minPeerCount_(start_valid ? 0 : minPeerCount)
@@ -477,13 +482,9 @@ public:
         hash_set<AccountID> const& vnaAccountIDs,
         bool rt) override;
 
-    // Just remove the subscription from the tracking
-    // not from the InfoSub. Needed for InfoSub destruction
+    // Needed for InfoSub destruction
     void
-    unsubAccountInternal(
-        std::uint64_t seq,
-        hash_set<AccountID> const& vnaAccountIDs,
-        bool rt) override;
+    unsubAccountInternal(std::uint64_t seq, bool rt) override;
 
     error_code_i
     subAccountHistory(InfoSub::ref ispListener, AccountID const& account)
@@ -632,13 +633,13 @@ private:
     void
     pubAccountTransaction(
         std::shared_ptr<ReadView const> const& ledger,
-        AcceptedLedgerTx const& transaction);
+        AcceptedLedgerTx const& transaction,
+        std::shared_ptr<PublishedJson const> const& msg);
 
     void
     pubProposedAccountTransaction(
-        std::shared_ptr<ReadView const> const& ledger,
         std::shared_ptr<STTx const> const& transaction,
-        TER result);
+        std::shared_ptr<PublishedJson const> const& msg);
 
     void
     pubServer();
@@ -649,8 +650,6 @@ private:
     getHostId(bool forAdmin);
 
 private:
-    using SubMapType = hash_map<std::uint64_t, InfoSub::wptr>;
-    using SubInfoMapType = hash_map<AccountID, SubMapType>;
     using subRpcMapType = hash_map<std::string, InfoSub::pointer>;
 
     /*
@@ -735,8 +734,8 @@ private:
 
     LedgerMaster& m_ledgerMaster;
 
-    SubInfoMapType mSubAccount;
-    SubInfoMapType mSubRTAccount;
+    AccountSubscriptions mSubAccount;
+    AccountSubscriptions mSubRTAccount;
 
     subRpcMapType mRpcSubMap;
 
@@ -756,7 +755,13 @@ private:
         sLastEntry = sBookChanges  // as this name implies, any new entry
                                    // must be ADDED ABOVE this one
     };
-    std::array<SubMapType, SubTypes::sLastEntry + 1> mStreamMaps;
+    std::array<SubscriberList, SubTypes::sLastEntry + 1> mStreamMaps;
+
+    // Sends what's published to the streams and accounts.
+    StreamPublisher mPublisher;
+
+    void
+    publish(SubTypes stream, std::shared_ptr<PublishedJson const> const& msg);
 
     ServerFeeSummary mLastFeeSummary;
 
@@ -811,7 +816,23 @@ private:
                   "Tracking_transitions"))
             , full_transitions(
                   collector->make_gauge("State_Accounting", "Full_transitions"))
+            , account_latency(
+                  collector->make_event("Subscriptions", "accounts_latency"))
         {
+            char const* const streams[] = {
+                "ledger",
+                "manifests",
+                "server",
+                "transactions",
+                "transactions_proposed",
+                "validations",
+                "peer_status",
+                "consensus",
+                "book_changes"};
+            static_assert(std::size(streams) == SubTypes::sLastEntry + 1);
+            for (std::size_t i = 0; i < std::size(streams); ++i)
+                stream_latency[i] = collector->make_event(
+                    "Subscriptions", std::string(streams[i]) + "_latency");
         }
 
         beast::insight::Hook hook;
@@ -826,6 +847,11 @@ private:
         beast::insight::Gauge syncing_transitions;
         beast::insight::Gauge tracking_transitions;
         beast::insight::Gauge full_transitions;
+
+        // How long after being published a message reached its subscribers.
+        std::array<beast::insight::Event, SubTypes::sLastEntry + 1>
+            stream_latency;
+        beast::insight::Event account_latency;
     };
 
     std::mutex m_statsMutex;  // Mutex to lock m_stats
@@ -1950,9 +1976,6 @@ NetworkOPsImp::consensusViewChange()
 void
 NetworkOPsImp::pubManifest(Manifest const& mo)
 {
-    // VFALCO consider std::shared_mutex
-    std::lock_guard sl(mSubLock);
-
     if (!mStreamMaps[sManifests].empty())
     {
         Json::Value jvObj(Json::objectValue);
@@ -1970,19 +1993,7 @@ NetworkOPsImp::pubManifest(Manifest const& mo)
             jvObj[jss::domain] = mo.domain;
         jvObj[jss::manifest] = strHex(mo.serialized);
 
-        for (auto i = mStreamMaps[sManifests].begin();
-             i != mStreamMaps[sManifests].end();)
-        {
-            if (auto p = i->second.lock())
-            {
-                p->send(jvObj, true);
-                ++i;
-            }
-            else
-            {
-                i = mStreamMaps[sManifests].erase(i);
-            }
-        }
+        publish(sManifests, std::make_shared<PublishedJson>(std::move(jvObj)));
     }
 }
 
@@ -2029,10 +2040,6 @@ trunc32(std::uint64_t v)
 void
 NetworkOPsImp::pubServer()
 {
-    // VFALCO TODO Don't hold the lock across calls to send...make a copy of the
-    //             list into a local array while holding the lock then release
-    //             the lock and call send on everyone.
-    //
     std::lock_guard sl(mSubLock);
 
     if (!mStreamMaps[sServer].empty())
@@ -2073,60 +2080,27 @@ NetworkOPsImp::pubServer()
 
         mLastFeeSummary = f;
 
-        for (auto i = mStreamMaps[sServer].begin();
-             i != mStreamMaps[sServer].end();)
-        {
-            InfoSub::pointer p = i->second.lock();
-
-            // VFALCO TODO research the possibility of using thread queues and
-            //             linearizing the deletion of subscribers with the
-            //             sending of JSON data.
-            if (p)
-            {
-                p->send(jvObj, true);
-                ++i;
-            }
-            else
-            {
-                i = mStreamMaps[sServer].erase(i);
-            }
-        }
+        publish(sServer, std::make_shared<PublishedJson>(std::move(jvObj)));
     }
 }
 
 void
 NetworkOPsImp::pubConsensus(ConsensusPhase phase)
 {
-    std::lock_guard sl(mSubLock);
-
-    auto& streamMap = mStreamMaps[sConsensusPhase];
-    if (!streamMap.empty())
+    if (!mStreamMaps[sConsensusPhase].empty())
     {
         Json::Value jvObj(Json::objectValue);
         jvObj[jss::type] = "consensusPhase";
         jvObj[jss::consensus] = to_string(phase);
 
-        for (auto i = streamMap.begin(); i != streamMap.end();)
-        {
-            if (auto p = i->second.lock())
-            {
-                p->send(jvObj, true);
-                ++i;
-            }
-            else
-            {
-                i = streamMap.erase(i);
-            }
-        }
+        publish(
+            sConsensusPhase, std::make_shared<PublishedJson>(std::move(jvObj)));
     }
 }
 
 void
 NetworkOPsImp::pubValidation(std::shared_ptr<STValidation> const& val)
 {
-    // VFALCO consider std::shared_mutex
-    std::lock_guard sl(mSubLock);
-
     if (!mStreamMaps[sValidations].empty())
     {
         Json::Value jvObj(Json::objectValue);
@@ -2197,48 +2171,21 @@ NetworkOPsImp::pubValidation(std::shared_ptr<STValidation> const& val)
             reserveIncXRP && reserveIncXRP->native())
             jvObj[jss::reserve_inc] = reserveIncXRP->xrp().jsonClipped();
 
-        for (auto i = mStreamMaps[sValidations].begin();
-             i != mStreamMaps[sValidations].end();)
-        {
-            if (auto p = i->second.lock())
-            {
-                p->send(jvObj, true);
-                ++i;
-            }
-            else
-            {
-                i = mStreamMaps[sValidations].erase(i);
-            }
-        }
+        publish(
+            sValidations, std::make_shared<PublishedJson>(std::move(jvObj)));
     }
 }
 
 void
 NetworkOPsImp::pubPeerStatus(std::function<Json::Value(void)> const& func)
 {
-    std::lock_guard sl(mSubLock);
-
     if (!mStreamMaps[sPeerStatus].empty())
     {
         Json::Value jvObj(func());
 
         jvObj[jss::type] = "peerStatusChange";
 
-        for (auto i = mStreamMaps[sPeerStatus].begin();
-             i != mStreamMaps[sPeerStatus].end();)
-        {
-            InfoSub::pointer p = i->second.lock();
-
-            if (p)
-            {
-                p->send(jvObj, true);
-                ++i;
-            }
-            else
-            {
-                i = mStreamMaps[sPeerStatus].erase(i);
-            }
-        }
+        publish(sPeerStatus, std::make_shared<PublishedJson>(std::move(jvObj)));
     }
 }
 
@@ -2649,6 +2596,7 @@ NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
 
     accounting_.json(info);
     info[jss::uptime] = UptimeClock::now().time_since_epoch().count();
+    info[jss::published_dropped] = std::to_string(mPublisher.dropped());
     if (!app_.config().reporting())
     {
         info[jss::jq_trans_overflow] =
@@ -2729,29 +2677,13 @@ NetworkOPsImp::pubProposedTransaction(
     std::shared_ptr<STTx const> const& transaction,
     TER result)
 {
-    Json::Value jvObj = transJson(*transaction, result, false, ledger);
-
-    {
-        std::lock_guard sl(mSubLock);
+    // The account streams are sent the same message.
+    auto const msg = std::make_shared<PublishedJson const>(
+        transJson(*transaction, result, false, ledger));
 
-        auto it = mStreamMaps[sRTTransactions].begin();
-        while (it != mStreamMaps[sRTTransactions].end())
-        {
-            InfoSub::pointer p = it->second.lock();
+    publish(sRTTransactions, msg);
 
-            if (p)
-            {
-                p->send(jvObj, true);
-                ++it;
-            }
-            else
-            {
-                it = mStreamMaps[sRTTransactions].erase(it);
-            }
-        }
-    }
-
-    pubProposedAccountTransaction(ledger, transaction, result);
+    pubProposedAccountTransaction(transaction, msg);
 }
 
 void
@@ -2762,25 +2694,8 @@ NetworkOPsImp::forwardProposedTransaction(Json::Value const& jvObj)
     // etl process writes a validated ledger
     if (jvObj[jss::validated].asBool())
         return;
-    {
-        std::lock_guard sl(mSubLock);
 
-        auto it = mStreamMaps[sRTTransactions].begin();
-        while (it != mStreamMaps[sRTTransactions].end())
-        {
-            InfoSub::pointer p = it->second.lock();
-
-            if (p)
-            {
-                p->send(jvObj, true);
-                ++it;
-            }
-            else
-            {
-                it = mStreamMaps[sRTTransactions].erase(it);
-            }
-        }
-    }
+    publish(sRTTransactions, std::make_shared<PublishedJson>(jvObj));
 
     forwardProposedAccountTransaction(jvObj);
 }
@@ -2788,41 +2703,22 @@ NetworkOPsImp::forwardProposedTransaction(Json::Value const& jvObj)
 void
 NetworkOPsImp::forwardValidation(Json::Value const& jvObj)
 {
-    std::lock_guard sl(mSubLock);
-
-    for (auto i = mStreamMaps[sValidations].begin();
-         i != mStreamMaps[sValidations].end();)
-    {
-        if (auto p = i->second.lock())
-        {
-            p->send(jvObj, true);
-            ++i;
-        }
-        else
-        {
-            i = mStreamMaps[sValidations].erase(i);
-        }
-    }
+    publish(sValidations, std::make_shared<PublishedJson>(jvObj));
 }
 
 void
 NetworkOPsImp::forwardManifest(Json::Value const& jvObj)
 {
-    std::lock_guard sl(mSubLock);
+    publish(sManifests, std::make_shared<PublishedJson>(jvObj));
+}
 
-    for (auto i = mStreamMaps[sManifests].begin();
-         i != mStreamMaps[sManifests].end();)
-    {
-        if (auto p = i->second.lock())
-        {
-            p->send(jvObj, true);
-            ++i;
-        }
-        else
-        {
-            i = mStreamMaps[sManifests].erase(i);
-        }
-    }
+void
+NetworkOPsImp::publish(
+    SubTypes stream,
+    std::shared_ptr<PublishedJson const> const& msg)
+{
+    mPublisher.publish(
+        mStreamMaps[stream].snapshot(), msg, m_stats.stream_latency[stream]);
 }
 
 static void
@@ -2875,31 +2771,8 @@ NetworkOPsImp::forwardProposedAccountTransaction(Json::Value const& jvObj)
     {
         std::lock_guard sl(mSubLock);
 
-        if (!mSubRTAccount.empty())
-        {
-            for (auto const& affectedAccount : accounts)
-            {
-                auto simiIt = mSubRTAccount.find(affectedAccount);
-                if (simiIt != mSubRTAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
-
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iProposed;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-            }
-        }
+        for (auto const& affectedAccount : accounts)
+            iProposed += mSubRTAccount.find(affectedAccount, notify);
     }
     JLOG(m_journal.trace()) << "forwardProposedAccountTransaction:"
                             << " iProposed=" << iProposed;
@@ -2928,13 +2801,14 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
 
     assert(alpAccepted->getLedger().get() == lpAccepted.get());
 
+    app_.getOrderBookDB().bookIndex().update(*alpAccepted);
+    app_.getOwnerIndex().update(alpAccepted);
+
     {
         JLOG(m_journal.debug())
             << "Publishing ledger " << lpAccepted->info().seq << " "
             << lpAccepted->info().hash;
 
-        std::lock_guard sl(mSubLock);
-
         if (!mStreamMaps[sLedger].empty())
         {
             Json::Value jvObj(Json::objectValue);
@@ -2961,39 +2835,20 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
                     app_.getLedgerMaster().getCompleteLedgers();
             }
 
-            auto it = mStreamMaps[sLedger].begin();
-            while (it != mStreamMaps[sLedger].end())
-            {
-                InfoSub::pointer p = it->second.lock();
-                if (p)
-                {
-                    p->send(jvObj, true);
-                    ++it;
-                }
-                else
-                    it = mStreamMaps[sLedger].erase(it);
-            }
+            publish(sLedger, std::make_shared<PublishedJson>(std::move(jvObj)));
         }
 
         if (!mStreamMaps[sBookChanges].empty())
         {
-            Json::Value jvObj = ripple::RPC::computeBookChanges(lpAccepted);
-
-            auto it = mStreamMaps[sBookChanges].begin();
-            while (it != mStreamMaps[sBookChanges].end())
-            {
-                InfoSub::pointer p = it->second.lock();
-                if (p)
-                {
-                    p->send(jvObj, true);
-                    ++it;
-                }
-                else
-                    it = mStreamMaps[sBookChanges].erase(it);
-            }
+            publish(
+                sBookChanges,
+                std::make_shared<PublishedJson>(
+                    ripple::RPC::computeBookChanges(lpAccepted)));
         }
 
         {
+            std::lock_guard sl(mSubLock);
+
             static bool firstTime = true;
             if (firstTime)
             {
@@ -3139,49 +2994,25 @@ NetworkOPsImp::pubValidatedTransaction(
         RPC::insertDeliveredAmount(jvObj[jss::meta], *ledger, stTxn, meta);
     }
 
-    {
-        std::lock_guard sl(mSubLock);
+    // The transaction and account streams and the book listeners are all
+    // sent the same message, rendered once however many subscribers it
+    // goes to.
+    auto const msg = std::make_shared<PublishedJson const>(std::move(jvObj));
 
-        auto it = mStreamMaps[sTransactions].begin();
-        while (it != mStreamMaps[sTransactions].end())
-        {
-            InfoSub::pointer p = it->second.lock();
-
-            if (p)
-            {
-                p->send(jvObj, true);
-                ++it;
-            }
-            else
-                it = mStreamMaps[sTransactions].erase(it);
-        }
-
-        it = mStreamMaps[sRTTransactions].begin();
-
-        while (it != mStreamMaps[sRTTransactions].end())
-        {
-            InfoSub::pointer p = it->second.lock();
-
-            if (p)
-            {
-                p->send(jvObj, true);
-                ++it;
-            }
-            else
-                it = mStreamMaps[sRTTransactions].erase(it);
-        }
-    }
+    publish(sTransactions, msg);
+    publish(sRTTransactions, msg);
 
     if (transaction.getResult() == tesSUCCESS)
-        app_.getOrderBookDB().processTxn(ledger, transaction, jvObj);
+        app_.getOrderBookDB().processTxn(ledger, transaction, *msg);
 
-    pubAccountTransaction(ledger, transaction);
+    pubAccountTransaction(ledger, transaction, msg);
 }
 
 void
 NetworkOPsImp::pubAccountTransaction(
     std::shared_ptr<ReadView const> const& ledger,
-    AcceptedLedgerTx const& transaction)
+    AcceptedLedgerTx const& transaction,
+    std::shared_ptr<PublishedJson const> const& msg)
 {
     hash_set<InfoSub::pointer> notify;
     int iProposed = 0;
@@ -3197,44 +3028,8 @@ NetworkOPsImp::pubAccountTransaction(
         {
             for (auto const& affectedAccount : transaction.getAffected())
             {
-                if (auto simiIt = mSubRTAccount.find(affectedAccount);
-                    simiIt != mSubRTAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
-
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iProposed;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-
-                if (auto simiIt = mSubAccount.find(affectedAccount);
-                    simiIt != mSubAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
-
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iAccepted;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
+                iProposed += mSubRTAccount.find(affectedAccount, notify);
+                iAccepted += mSubAccount.find(affectedAccount, notify);
 
                 if (auto histoIt = mSubAccountHistory.find(affectedAccount);
                     histoIt != mSubAccountHistory.end())
@@ -3272,23 +3067,21 @@ NetworkOPsImp::pubAccountTransaction(
         << "pubAccountTransaction: "
         << "proposed=" << iProposed << ", accepted=" << iAccepted;
 
-    if (!notify.empty() || !accountHistoryNotify.empty())
+    if (!notify.empty())
     {
-        auto const& stTxn = transaction.getTxn();
-
-        Json::Value jvObj =
-            transJson(*stTxn, transaction.getResult(), true, ledger);
-
-        {
-            auto const& meta = transaction.getMeta();
-
-            jvObj[jss::meta] = meta.getJson(JsonOptions::none);
-            RPC::insertDeliveredAmount(jvObj[jss::meta], *ledger, stTxn, meta);
-        }
-
+        auto subscribers = std::make_shared<
+            std::vector<SubscriberList::Subscriber>>();
+        subscribers->reserve(notify.size());
         for (InfoSub::ref isrListener : notify)
-            isrListener->send(jvObj, true);
+            subscribers->push_back({isrListener->getSeq(), isrListener});
+        mPublisher.publish(
+            std::move(subscribers), msg, m_stats.account_latency);
+    }
 
+    if (!accountHistoryNotify.empty())
+    {
+        // Each of these is sent its own position in the history.
+        Json::Value jvObj = msg->json();
         assert(!jvObj.isMember(jss::account_history_tx_stream));
         for (auto& info : accountHistoryNotify)
         {
@@ -3303,9 +3096,8 @@ NetworkOPsImp::pubAccountTransaction(
 
 void
 NetworkOPsImp::pubProposedAccountTransaction(
-    std::shared_ptr<ReadView const> const& ledger,
     std::shared_ptr<STTx const> const& tx,
-    TER result)
+    std::shared_ptr<PublishedJson const> const& msg)
 {
     hash_set<InfoSub::pointer> notify;
     int iProposed = 0;
@@ -3322,39 +3114,27 @@ NetworkOPsImp::pubProposedAccountTransaction(
             !mSubAccountHistory.empty())
         {
             for (auto const& affectedAccount : tx->getMentionedAccounts())
-            {
-                if (auto simiIt = mSubRTAccount.find(affectedAccount);
-                    simiIt != mSubRTAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
-
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iProposed;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-            }
+                iProposed += mSubRTAccount.find(affectedAccount, notify);
         }
     }
 
     JLOG(m_journal.trace()) << "pubProposedAccountTransaction: " << iProposed;
 
-    if (!notify.empty() || !accountHistoryNotify.empty())
+    if (!notify.empty())
     {
-        Json::Value jvObj = transJson(*tx, result, false, ledger);
-
+        auto subscribers = std::make_shared<
+            std::vector<SubscriberList::Subscriber>>();
+        subscribers->reserve(notify.size());
         for (InfoSub::ref isrListener : notify)
-            isrListener->send(jvObj, true);
+            subscribers->push_back({isrListener->getSeq(), isrListener});
+        mPublisher.publish(
+            std::move(subscribers), msg, m_stats.account_latency);
+    }
 
+    if (!accountHistoryNotify.empty())
+    {
+        // Each of these is sent its own position in the history.
+        Json::Value jvObj = msg->json();
         assert(!jvObj.isMember(jss::account_history_tx_stream));
         for (auto& info : accountHistoryNotify)
         {
@@ -3377,35 +3157,14 @@ NetworkOPsImp::subAccount(
     hash_set<AccountID> const& vnaAccountIDs,
     bool rt)
 {
-    SubInfoMapType& subMap = rt ? mSubRTAccount : mSubAccount;
-
-    for (auto const& naAccountID : vnaAccountIDs)
-    {
-        JLOG(m_journal.trace())
-            << "subAccount: account: " << toBase58(naAccountID);
-
-        isrListener->insertSubAccountInfo(naAccountID, rt);
-    }
+    std::vector<AccountID> accounts(vnaAccountIDs.begin(), vnaAccountIDs.end());
 
     std::lock_guard sl(mSubLock);
 
-    for (auto const& naAccountID : vnaAccountIDs)
-    {
-        auto simIterator = subMap.find(naAccountID);
-        if (simIterator == subMap.end())
-        {
-            // Not found, note that account has a new single listner.
-            SubMapType usisElement;
-            usisElement[isrListener->getSeq()] = isrListener;
-            // VFALCO NOTE This is making a needless copy of naAccountID
-            subMap.insert(simIterator, make_pair(naAccountID, usisElement));
-        }
-        else
-        {
-            // Found, note that the account has another listener.
-            simIterator->second[isrListener->getSeq()] = isrListener;
-        }
-    }
+    auto const added = (rt ? mSubRTAccount : mSubAccount)
+                           .insert(isrListener, std::move(accounts));
+    JLOG(m_journal.trace()) << "subAccount: " << isrListener->getSeq()
+                            << " follows " << added << " more accounts";
 }
 
 void
@@ -3414,42 +3173,20 @@ NetworkOPsImp::unsubAccount(
     hash_set<AccountID> const& vnaAccountIDs,
     bool rt)
 {
-    for (auto const& naAccountID : vnaAccountIDs)
-    {
-        // Remove from the InfoSub
-        isrListener->deleteSubAccountInfo(naAccountID, rt);
-    }
+    std::vector<AccountID> accounts(vnaAccountIDs.begin(), vnaAccountIDs.end());
+
+    std::lock_guard sl(mSubLock);
 
-    // Remove from the server
-    unsubAccountInternal(isrListener->getSeq(), vnaAccountIDs, rt);
+    (rt ? mSubRTAccount : mSubAccount)
+        .erase(isrListener->getSeq(), std::move(accounts));
 }
 
 void
-NetworkOPsImp::unsubAccountInternal(
-    std::uint64_t uSeq,
-    hash_set<AccountID> const& vnaAccountIDs,
-    bool rt)
+NetworkOPsImp::unsubAccountInternal(std::uint64_t uSeq, bool rt)
 {
     std::lock_guard sl(mSubLock);
 
-    SubInfoMapType& subMap = rt ? mSubRTAccount : mSubAccount;
-
-    for (auto const& naAccountID : vnaAccountIDs)
-    {
-        auto simIterator = subMap.find(naAccountID);
-
-        if (simIterator != subMap.end())
-        {
-            // Found
-            simIterator->second.erase(uSeq);
-
-            if (simIterator->second.empty())
-            {
-                // Don't need hash entry.
-                subMap.erase(simIterator);
-            }
-        }
-    }
+    (rt ? mSubRTAccount : mSubAccount).erase(uSeq);
 }
 
 void
@@ -3966,27 +3703,20 @@ NetworkOPsImp::subLedger(InfoSub::ref isrListener, Json::Value& jvResult)
             app_.getLedgerMaster().getCompleteLedgers();
     }
 
-    std::lock_guard sl(mSubLock);
-    return mStreamMaps[sLedger]
-        .emplace(isrListener->getSeq(), isrListener)
-        .second;
+    return mStreamMaps[sLedger].insert(isrListener);
 }
 
 // <-- bool: true=added, false=already there
 bool
 NetworkOPsImp::subBookChanges(InfoSub::ref isrListener)
 {
-    std::lock_guard sl(mSubLock);
-    return mStreamMaps[sBookChanges]
-        .emplace(isrListener->getSeq(), isrListener)
-        .second;
+    return mStreamMaps[sBookChanges].insert(isrListener);
 }
 
 // <-- bool: true=erased, false=was not there
 bool
 NetworkOPsImp::unsubLedger(std::uint64_t uSeq)
 {
-    std::lock_guard sl(mSubLock);
     return mStreamMaps[sLedger].erase(uSeq);
 }
 
@@ -3994,7 +3724,6 @@ NetworkOPsImp::unsubLedger(std::uint64_t uSeq)
 bool
 NetworkOPsImp::unsubBookChanges(std::uint64_t uSeq)
 {
-    std::lock_guard sl(mSubLock);
     return mStreamMaps[sBookChanges].erase(uSeq);
 }
 
@@ -4002,17 +3731,13 @@ NetworkOPsImp::unsubBookChanges(std::uint64_t uSeq)
 bool
 NetworkOPsImp::subManifests(InfoSub::ref isrListener)
 {
-    std::lock_guard sl(mSubLock);
-    return mStreamMaps[sManifests]
-        .emplace(isrListener->getSeq(), isrListener)
-        .second;
+    return mStreamMaps[sManifests].insert(isrListener);
 }
 
 // <-- bool: true=erased, false=was not there
 bool
 NetworkOPsImp::unsubManifests(std::uint64_t uSeq)
 {
-    std::lock_guard sl(mSubLock);
     return mStreamMaps[sManifests].erase(uSeq);
 }
 
@@ -4040,17 +3765,13 @@ NetworkOPsImp::subServer(
     jvResult[jss::pubkey_node] =
         toBase58(TokenType::NodePublic, app_.nodeIdentity().first);
 
-    std::lock_guard sl(mSubLock);
-    return mStreamMaps[sServer]
-        .emplace(isrListener->getSeq(), isrListener)
-        .second;
+    return mStreamMaps[sServer].insert(isrListener);
 }
 
 // <-- bool: true=erased, false=was not there
 bool
 NetworkOPsImp::unsubServer(std::uint64_t uSeq)
 {
-    std::lock_guard sl(mSubLock);
     return mStreamMaps[sServer].erase(uSeq);
 }
 
@@ -4058,17 +3779,13 @@ NetworkOPsImp::unsubServer(std::uint64_t uSeq)
 bool
 NetworkOPsImp::subTransactions(InfoSub::ref isrListener)
 {
-    std::lock_guard sl(mSubLock);
-    return mStreamMaps[sTransactions]
-        .emplace(isrListener->getSeq(), isrListener)
-        .second;
+    return mStreamMaps[sTransactions].insert(isrListener);
 }
 
 // <-- bool: true=erased, false=was not there
 bool
 NetworkOPsImp::unsubTransactions(std::uint64_t uSeq)
 {
-    std::lock_guard sl(mSubLock);
     return mStreamMaps[sTransactions].erase(uSeq);
 }
 
@@ -4076,17 +3793,13 @@ NetworkOPsImp::unsubTransactions(std::uint64_t uSeq)
 bool
 NetworkOPsImp::subRTTransactions(InfoSub::ref isrListener)
 {
-    std::lock_guard sl(mSubLock);
-    return mStreamMaps[sRTTransactions]
-        .emplace(isrListener->getSeq(), isrListener)
-        .second;
+    return mStreamMaps[sRTTransactions].insert(isrListener);
 }
 
 // <-- bool: true=erased, false=was not there
 bool
 NetworkOPsImp::unsubRTTransactions(std::uint64_t uSeq)
 {
-    std::lock_guard sl(mSubLock);
     return mStreamMaps[sRTTransactions].erase(uSeq);
 }
 
@@ -4094,10 +3807,7 @@ NetworkOPsImp::unsubRTTransactions(std::uint64_t uSeq)
 bool
 NetworkOPsImp::subValidations(InfoSub::ref isrListener)
 {
-    std::lock_guard sl(mSubLock);
-    return mStreamMaps[sValidations]
-        .emplace(isrListener->getSeq(), isrListener)
-        .second;
+    return mStreamMaps[sValidations].insert(isrListener);
 }
 
 void
@@ -4110,7 +3820,6 @@ NetworkOPsImp::stateAccounting(Json::Value& obj)
 bool
 NetworkOPsImp::unsubValidations(std::uint64_t uSeq)
 {
-    std::lock_guard sl(mSubLock);
     return mStreamMaps[sValidations].erase(uSeq);
 }
 
@@ -4118,17 +3827,13 @@ NetworkOPsImp::unsubValidations(std::uint64_t uSeq)
 bool
 NetworkOPsImp::subPeerStatus(InfoSub::ref isrListener)
 {
-    std::lock_guard sl(mSubLock);
-    return mStreamMaps[sPeerStatus]
-        .emplace(isrListener->getSeq(), isrListener)
-        .second;
+    return mStreamMaps[sPeerStatus].insert(isrListener);
 }
 
 // <-- bool: true=erased, false=was not there
 bool
 NetworkOPsImp::unsubPeerStatus(std::uint64_t uSeq)
 {
-    std::lock_guard sl(mSubLock);
     return mStreamMaps[sPeerStatus].erase(uSeq);
 }
 
@@ -4136,17 +3841,13 @@ NetworkOPsImp::unsubPeerStatus(std::uint64_t uSeq)
 bool
 NetworkOPsImp::subConsensus(InfoSub::ref isrListener)
 {
-    std::lock_guard sl(mSubLock);
-    return mStreamMaps[sConsensusPhase]
-        .emplace(isrListener->getSeq(), isrListener)
-        .second;
+    return mStreamMaps[sConsensusPhase].insert(isrListener);
 }
 
 // <-- bool: true=erased, false=was not there
 bool
 NetworkOPsImp::unsubConsensus(std::uint64_t uSeq)
 {
-    std::lock_guard sl(mSubLock);
     return mStreamMaps[sConsensusPhase].erase(uSeq);
 }
 
@@ -4184,9 +3885,9 @@ NetworkOPsImp::tryRemoveRpcSub(std::string const& strUrl)
 
     // check to see if any of the stream maps still hold a weak reference to
     // this entry before removing
-    for (SubMapType const& map : mStreamMaps)
+    for (SubscriberList const& subscribers : mStreamMaps)
     {
-        if (map.find(pInfo->getSeq()) != map.end())
+        if (subscribers.contains(pInfo->getSeq()))
             return false;
     }
     mRpcSubMap.erase(strUrl);
@@ -4240,6 +3941,138 @@ NetworkOPsImp::getBookPage(
     auto const rate = transferRate(view, book.out.account);
     auto viewJ = app_.journal("View");
 
+    // The book as it's kept for the last published ledger, if that's the
+    // ledger asked about.
+    auto const indexed = app_.getOrderBookDB().bookIndex().find(view, book);
+
+    auto holds = [&](AccountID const& uOfferOwnerID) {
+        auto saOwnerFunds = accountHolds(
+            view,
+            uOfferOwnerID,
+            book.out.currency,
+            book.out.account,
+            fhZERO_IF_FROZEN,
+            viewJ);
+
+        if (saOwnerFunds < beast::zero)
+        {
+            // Treat negative funds as zero.
+
+            saOwnerFunds.clear();
+        }
+        return saOwnerFunds;
+    };
+
+    auto addOffer = [&](SLE const& sleOffer,
+                        Json::Value const& jvOffer,
+                        STAmount const& saDirRate,
+                        std::string const& quality) {
+        auto const uOfferOwnerID = sleOffer.getAccountID(sfAccount);
+        auto const& saTakerGets = sleOffer.getFieldAmount(sfTakerGets);
+        auto const& saTakerPays = sleOffer.getFieldAmount(sfTakerPays);
+        STAmount saOwnerFunds;
+        bool firstOwnerOffer(true);
+
+        if (book.out.account == uOfferOwnerID)
+        {
+            // If an offer is selling issuer's own IOUs, it is fully
+            // funded.
+            saOwnerFunds = saTakerGets;
+        }
+        else if (bGlobalFreeze)
+        {
+            // If either asset is globally frozen, consider all offers
+            // that aren't ours to be totally unfunded
+            saOwnerFunds.clear(book.out);
+        }
+        else
+        {
+            auto umBalanceEntry = umBalance.find(uOfferOwnerID);
+            if (umBalanceEntry != umBalance.end())
+            {
+                // Found in running balance table.
+
+                saOwnerFunds = umBalanceEntry->second;
+                firstOwnerOffer = false;
+            }
+            else if (indexed)
+            {
+                saOwnerFunds = indexed->funds->get(
+                    uOfferOwnerID, [&] { return holds(uOfferOwnerID); });
+            }
+            else
+            {
+                // Did not find balance in table.
+
+                saOwnerFunds = holds(uOfferOwnerID);
+            }
+        }
+
+        // Include all offers funded and unfunded
+        Json::Value& jvOf = jvOffers.append(jvOffer);
+
+        STAmount saTakerGetsFunded;
+        STAmount saOwnerFundsLimit = saOwnerFunds;
+        Rate offerRate = parityRate;
+
+        if (rate != parityRate
+            // Have a tranfer fee.
+            && uTakerID != book.out.account
+            // Not taking offers of own IOUs.
+            && book.out.account != uOfferOwnerID)
+        // Offer owner not issuing ownfunds
+        {
+            // Need to charge a transfer fee to offer owner.
+            offerRate = rate;
+            saOwnerFundsLimit = divide(saOwnerFunds, offerRate);
+        }
+
+        if (saOwnerFundsLimit >= saTakerGets)
+        {
+            // Sufficient funds no shenanigans.
+            saTakerGetsFunded = saTakerGets;
+        }
+        else
+        {
+            // Only provide, if not fully funded.
+
+            saTakerGetsFunded = saOwnerFundsLimit;
+
+            saTakerGetsFunded.setJson(jvOf[jss::taker_gets_funded]);
+            std::min(
+                saTakerPays,
+                multiply(saTakerGetsFunded, saDirRate, saTakerPays.issue()))
+                .setJson(jvOf[jss::taker_pays_funded]);
+        }
+
+        STAmount saOwnerPays = (parityRate == offerRate)
+            ? saTakerGetsFunded
+            : std::min(saOwnerFunds, multiply(saTakerGetsFunded, offerRate));
+
+        umBalance[uOfferOwnerID] = saOwnerFunds - saOwnerPays;
+
+        jvOf[jss::quality] = quality;
+
+        if (firstOwnerOffer)
+            jvOf[jss::owner_funds] = saOwnerFunds.getText();
+    };
+
+    if (indexed)
+    {
+        for (auto const& [dir, level] : *indexed->levels)
+        {
+            for (auto const& offer : level->offers)
+            {
+                if (iLimit-- == 0)
+                    return;
+                addOffer(*offer->sle, offer->json, level->rate, level->quality);
+            }
+        }
+        return;
+    }
+
+    std::string quality;
+
     while (!bDone && iLimit-- > 0)
     {
         if (bDirectAdvance)
@@ -4263,6 +4096,7 @@ NetworkOPsImp::getBookPage(
             {
                 uTipIndex = sleOfferDir->key();
                 saDirRate = amountFromQuality(getQuality(uTipIndex));
+                quality = saDirRate.getText();
 
                 cdirFirst(view, uTipIndex, sleOfferDir, uBookEntry, offerIndex);
 
@@ -4279,105 +4113,11 @@ NetworkOPsImp::getBookPage(
 
             if (sleOffer)
             {
-                auto const uOfferOwnerID = sleOffer->getAccountID(sfAccount);
-                auto const& saTakerGets = sleOffer->getFieldAmount(sfTakerGets);
-                auto const& saTakerPays = sleOffer->getFieldAmount(sfTakerPays);
-                STAmount saOwnerFunds;
-                bool firstOwnerOffer(true);
-
-                if (book.out.account == uOfferOwnerID)
-                {
-                    // If an offer is selling issuer's own IOUs, it is fully
-                    // funded.
-                    saOwnerFunds = saTakerGets;
-                }
-                else if (bGlobalFreeze)
-                {
-                    // If either asset is globally frozen, consider all offers
-                    // that aren't ours to be totally unfunded
-                    saOwnerFunds.clear(book.out);
-                }
-                else
-                {
-                    auto umBalanceEntry = umBalance.find(uOfferOwnerID);
-                    if (umBalanceEntry != umBalance.end())
-                    {
-                        // Found in running balance table.
-
-                        saOwnerFunds = umBalanceEntry->second;
-                        firstOwnerOffer = false;
-                    }
-                    else
-                    {
-                        // Did not find balance in table.
-
-                        saOwnerFunds = accountHolds(
-                            view,
-                            uOfferOwnerID,
-                            book.out.currency,
-                            book.out.account,
-                            fhZERO_IF_FROZEN,
-                            viewJ);
-
-                        if (saOwnerFunds < beast::zero)
-                        {
-                            // Treat negative funds as zero.
-
-                            saOwnerFunds.clear();
-                        }
-                    }
-                }
-
-                Json::Value jvOffer = sleOffer->getJson(JsonOptions::none);
-
-                STAmount saTakerGetsFunded;
-                STAmount saOwnerFundsLimit = saOwnerFunds;
-                Rate offerRate = parityRate;
-
-                if (rate != parityRate
-                    // Have a tranfer fee.
-                    && uTakerID != book.out.account
-                    // Not taking offers of own IOUs.
-                    && book.out.account != uOfferOwnerID)
-                // Offer owner not issuing ownfunds
-                {
-                    // Need to charge a transfer fee to offer owner.
-                    offerRate = rate;
-                    saOwnerFundsLimit = divide(saOwnerFunds, offerRate);
-                }
-
-                if (saOwnerFundsLimit >= saTakerGets)
-                {
-                    // Sufficient funds no shenanigans.
-                    saTakerGetsFunded = saTakerGets;
-                }
-                else
-                {
-                    // Only provide, if not fully funded.
-
-                    saTakerGetsFunded = saOwnerFundsLimit;
-
-                    saTakerGetsFunded.setJson(jvOffer[jss::taker_gets_funded]);
-                    std::min(
-                        saTakerPays,
-                        multiply(
-                            saTakerGetsFunded, saDirRate, saTakerPays.issue()))
-                        .setJson(jvOffer[jss::taker_pays_funded]);
-                }
-
-                STAmount saOwnerPays = (parityRate == offerRate)
-                    ? saTakerGetsFunded
-                    : std::min(
-                          saOwnerFunds, multiply(saTakerGetsFunded, offerRate));
-
-                umBalance[uOfferOwnerID] = saOwnerFunds - saOwnerPays;
-
-                // Include all offers funded and unfunded
-                Json::Value& jvOf = jvOffers.append(jvOffer);
-                jvOf[jss::quality] = saDirRate.getText();
-
-                if (firstOwnerOffer)
-                    jvOf[jss::owner_funds] = saOwnerFunds.getText();
+                addOffer(
+                    *sleOffer,
+                    sleOffer->getJson(JsonOptions::none),
+                    saDirRate,
+                    quality);
             }
             else
             {
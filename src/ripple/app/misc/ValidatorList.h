@@ -748,6 +748,9 @@ private:
         @param hash Optional hash of the data parameters.
             Defaults to uninitialized
 
+        @param preverified Optional result of an earlier check of the
+            signature, and the key it was checked against
+
         @return `ListDisposition::accepted`, plus some of the publisher
             information, if list was successfully applied
 
@@ -764,7 +767,23 @@ private:
         std::uint32_t version,
         std::string siteUri,
         std::optional<uint256> const& hash,
-        lock_guard const&);
+        lock_guard const&,
+        std::optional<std::pair<PublicKey, bool>> const& preverified = {});
+
+    /** Check the signatures of several published lists at once
+
+        Each blob is checked against the signing key in its manifest, or
+        in the global manifest if it has none. Blobs whose manifest can not
+        be parsed or whose publisher is not trusted are not checked.
+
+        @return For each blob, the key it was checked against and whether
+            the signature is valid.
+    */
+    std::vector<std::optional<std::pair<PublicKey, bool>>>
+    verifySignatures(
+        lock_guard const&,
+        std::string const& globalManifest,
+        std::vector<ValidatorBlobInfo> const& blobs) const;
 
     void
     updatePublisherList(
@@ -856,7 +875,8 @@ private:
         PublicKey& pubKey,
         std::string const& manifest,
         std::string const& blob,
-        std::string const& signature);
+        std::string const& signature,
+        std::optional<std::pair<PublicKey, bool>> const& preverified = {});
 
     /** Stop trusting publisher's list of keys.
 
@@ -934,9 +934,17 @@ ValidatorList::applyLists(
 
     std::lock_guard lock{mutex_};
 
+    // A collection may carry several blobs; check all of their
+    // signatures up front so they can be verified as a batch.
+    auto const preverified = blobs.size() > 1
+        ? verifySignatures(lock, manifest, blobs)
+        : std::vector<std::optional<std::pair<PublicKey, bool>>>(
+              blobs.size());
+
     PublisherListStats result;
-    for (auto const& blobInfo : blobs)
+    for (std::size_t i = 0; i < blobs.size(); ++i)
     {
+        auto const& blobInfo = blobs[i];
         auto stats = applyList(
             manifest,
             blobInfo.manifest,
@@ -945,7 +953,8 @@ ValidatorList::applyLists(
             version,
             siteUri,
             hash,
-            lock);
+            lock,
+            preverified[i]);
 
         if (stats.bestDisposition() < result.bestDisposition() ||
             (stats.bestDisposition() == result.bestDisposition() &&
@@ -992,6 +1001,52 @@ ValidatorList::applyLists(
     return result;
 }
 
+std::vector<std::optional<std::pair<PublicKey, bool>>>
+ValidatorList::verifySignatures(
+    ValidatorList::lock_guard const&,
+    std::string const& globalManifest,
+    std::vector<ValidatorBlobInfo> const& blobs) const
+{
+    std::vector<std::optional<std::pair<PublicKey, bool>>> result(
+        blobs.size());
+
+    // Keep the decoded data alive for as long as the batch refers to it.
+    std::vector<std::size_t> index;
+    std::vector<std::string> data;
+    std::vector<Blob> sigs;
+    std::vector<SignedMessage> batch;
+    index.reserve(blobs.size());
+    data.reserve(blobs.size());
+    sigs.reserve(blobs.size());
+    batch.reserve(blobs.size());
+
+    for (std::size_t i = 0; i < blobs.size(); ++i)
+    {
+        auto const& blobInfo = blobs[i];
+        auto const m = deserializeManifest(
+            base64_decode(blobInfo.manifest ? *blobInfo.manifest
+                                            : globalManifest));
+        if (!m || m->revoked() || !publisherLists_.count(m->masterKey))
+            continue;
+
+        auto sig = strUnHex(blobInfo.signature);
+        if (!sig)
+            continue;
+
+        index.push_back(i);
+        data.push_back(base64_decode(blobInfo.blob));
+        sigs.push_back(std::move(*sig));
+        batch.push_back(
+            {m->signingKey, makeSlice(data.back()), makeSlice(sigs.back())});
+    }
+
+    auto const valid = verifyBatch(batch);
+    for (std::size_t i = 0; i < index.size(); ++i)
+        result[index[i]].emplace(batch[i].publicKey, valid[i]);
+
+    return result;
+}
+
 void
 ValidatorList::updatePublisherList(
     PublicKey const& pubKey,
@@ -1065,14 +1120,16 @@ ValidatorList::applyList(
     std::uint32_t version,
     std::string siteUri,
     std::optional<uint256> const& hash,
-    ValidatorList::lock_guard const& lock)
+    ValidatorList::lock_guard const& lock,
+    std::optional<std::pair<PublicKey, bool>> const& preverified)
 {
     using namespace std::string_literals;
 
     Json::Value list;
     PublicKey pubKey;
     auto const& manifest = localManifest ? *localManifest : globalManifest;
-    auto const result = verify(lock, list, pubKey, manifest, blob, signature);
+    auto const result =
+        verify(lock, list, pubKey, manifest, blob, signature, preverified);
     if (result > ListDisposition::pending)
     {
         if (publisherLists_.count(pubKey))
@@ -1262,7 +1319,8 @@ ValidatorList::verify(
     PublicKey& pubKey,
     std::string const& manifest,
     std::string const& blob,
-    std::string const& signature)
+    std::string const& signature,
+    std::optional<std::pair<PublicKey, bool>> const& preverified)
 {
     auto m = deserializeManifest(base64_decode(manifest));
 
@@ -1286,11 +1344,18 @@ ValidatorList::verify(
 
     auto const sig = strUnHex(signature);
     auto const data = base64_decode(blob);
-    if (!sig ||
-        !ripple::verify(
-            publisherManifests_.getSigningKey(pubKey),
-            makeSlice(data),
-            makeSlice(*sig)))
+    if (!sig)
+        return ListDisposition::invalid;
+
+    // Applying the manifest may have changed the signing key, in which
+    // case an earlier check is not useful.
+    auto const signingKey = publisherManifests_.getSigningKey(pubKey);
+    if (preverified && preverified->first == signingKey)
+    {
+        if (!preverified->second)
+            return ListDisposition::invalid;
+    }
+    else if (!ripple::verify(signingKey, makeSlice(data), makeSlice(*sig)))
         return ListDisposition::invalid;
 
     Json::Reader r;
@@ -46,6 +46,7 @@
 #include <ripple/app/tx/impl/SetRegularKey.h>
 #include <ripple/app/tx/impl/SetSignerList.h>
 #include <ripple/app/tx/impl/SetTrust.h>
+#include <ripple/basics/PerfLog.h>
 
 namespace ripple {
 
@@ -626,15 +627,21 @@ doApply(PreclaimResult const& preclaimResult, Application& app, OpenView& view)
     {
         if (!preclaimResult.likelyToClaimFee)
             return {preclaimResult.ter, false};
-        ApplyContext ctx(
-            app,
-            view,
-            preclaimResult.tx,
-            preclaimResult.ter,
-            calculateBaseFee(view, preclaimResult.tx),
-            preclaimResult.flags,
-            preclaimResult.j);
-        return invoke_apply(ctx);
+        auto const spills = detail::stHeapSpills;
+        std::pair<TER, bool> result;
+        {
+            ApplyContext ctx(
+                app,
+                view,
+                preclaimResult.tx,
+                preclaimResult.ter,
+                calculateBaseFee(view, preclaimResult.tx),
+                preclaimResult.flags,
+                preclaimResult.j);
+            result = invoke_apply(ctx);
+        }
+        app.getPerfLog().txApply(detail::stHeapSpills - spills);
+        return result;
     }
     catch (std::exception const& e)
     {
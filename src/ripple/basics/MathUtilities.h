@@ -21,8 +21,11 @@
 #define RIPPLE_BASICS_MATHUTILITIES_H_INCLUDED
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 
 namespace ripple {
 
@@ -63,6 +66,60 @@ static_assert(calculatePercent(50'000'000, 100'000'000) == 50);
 static_assert(calculatePercent(50'000'001, 100'000'000) == 51);
 static_assert(calculatePercent(99'999'999, 100'000'000) == 100);
 
+namespace detail {
+
+inline constexpr auto powersOfTen = [] {
+    std::array<std::uint64_t, 20> result{};
+    std::uint64_t p = 1;
+    for (auto& r : result)
+    {
+        r = p;
+        p *= 10;
+    }
+    return result;
+}();
+
+}  // namespace detail
+
+/** Return 10 raised to the power n, for n in [0, 19]. */
+constexpr std::uint64_t
+powerOfTen(int n)
+{
+    assert(n >= 0 && n < int(detail::powersOfTen.size()));
+    return detail::powersOfTen[n];
+}
+
+/** Return the number of decimal digits in v.
+ *
+ * Counts the bits with a single instruction and converts the count to
+ * decimal digits, rather than dividing by ten until nothing is left.
+ *
+ * @note Zero has no digits.
+ * */
+constexpr int
+decimalDigits(std::uint64_t v)
+{
+    // 1233 / 4096 is slightly more than log10(2), so this is either the
+    // number of digits or one less.
+    int const d = ((64 - std::countl_zero(v)) * 1233) >> 12;
+    return d + (v >= detail::powersOfTen[d]);
+}
+
+// unit tests
+static_assert(powerOfTen(0) == 1);
+static_assert(powerOfTen(15) == 1'000'000'000'000'000);
+static_assert(powerOfTen(19) == 10'000'000'000'000'000'000ull);
+static_assert(decimalDigits(0) == 0);
+static_assert(decimalDigits(1) == 1);
+static_assert(decimalDigits(9) == 1);
+static_assert(decimalDigits(10) == 2);
+static_assert(decimalDigits(999'999'999'999'999) == 15);
+static_assert(decimalDigits(1'000'000'000'000'000) == 16);
+static_assert(decimalDigits(9'999'999'999'999'999) == 16);
+static_assert(decimalDigits(9'999'999'999'999'999'999ull) == 19);
+static_assert(decimalDigits(10'000'000'000'000'000'000ull) == 20);
+static_assert(decimalDigits(18'446'744'073'709'551'615ull) == 20);
+
 }  // namespace ripple
 
 #endif
@@ -138,6 +138,16 @@ public:
     virtual void
     jobFinish(JobType const type, microseconds dur, int instance) = 0;
 
+    /**
+     * Log a transaction being applied to a ledger
+     *
+     * @param spills Number of serialized objects that were too large for
+     *               their inline buffers, and spilled to the heap, while
+     *               applying it
+     */
+    virtual void
+    txApply(std::uint64_t spills) = 0;
+
     /**
      * Render performance counters in Json
      *
@@ -51,24 +51,6 @@ template <class Iterator>
 std::optional<Blob>
 strUnHex(std::size_t strSize, Iterator begin, Iterator end)
 {
-    static constexpr std::array<int, 256> const unxtab = []() {
-        std::array<int, 256> t{};
-
-        for (auto& x : t)
-            x = -1;
-
-        for (int i = 0; i < 10; ++i)
-            t['0' + i] = i;
-
-        for (int i = 0; i < 6; ++i)
-        {
-            t['A' + i] = 10 + i;
-            t['a' + i] = 10 + i;
-        }
-
-        return t;
-    }();
-
     Blob out;
 
     out.reserve((strSize + 1) / 2);
@@ -77,9 +59,9 @@ strUnHex(std::size_t strSize, Iterator begin, Iterator end)
 
     if (strSize & 1)
     {
-        int c = unxtab[*iter++];
+        auto const c = detail::hexValue(*iter++);
 
-        if (c < 0)
+        if (c > 0xF)
             return {};
 
         out.push_back(c);
@@ -87,14 +69,14 @@ strUnHex(std::size_t strSize, Iterator begin, Iterator end)
 
     while (iter != end)
     {
-        int cHigh = unxtab[*iter++];
+        auto const cHigh = detail::hexValue(*iter++);
 
-        if (cHigh < 0)
+        if (cHigh > 0xF)
             return {};
 
-        int cLow = unxtab[*iter++];
+        auto const cLow = detail::hexValue(*iter++);
 
-        if (cLow < 0)
+        if (cLow > 0xF)
             return {};
 
         out.push_back(static_cast<unsigned char>((cHigh << 4) | cLow));
@@ -201,17 +201,7 @@ private:
         auto hexCharToUInt = [](char c,
                                 std::uint32_t shift,
                                 std::uint32_t& accum) -> ParseResult {
-            std::uint32_t nibble = 0xFFu;
-            if (c < '0' || c > 'f')
-                return ParseResult::badChar;
-
-            if (c >= 'a')
-                nibble = static_cast<std::uint32_t>(c - 'a' + 0xA);
-            else if (c >= 'A')
-                nibble = static_cast<std::uint32_t>(c - 'A' + 0xA);
-            else if (c <= '9')
-                nibble = static_cast<std::uint32_t>(c - '0');
-
+            std::uint32_t const nibble = detail::hexValue(c);
             if (nibble > 0xFu)
                 return ParseResult::badChar;
 
@@ -326,11 +316,12 @@ public:
     constexpr int
     signum() const
     {
+        // OR the words together rather than branching on each of them.
+        std::uint32_t any = 0;
         for (int i = 0; i < WIDTH; i++)
-            if (data_[i] != 0)
-                return 1;
+            any |= data_[i];
 
-        return 0;
+        return any != 0;
     }
 
     bool
@@ -561,6 +552,34 @@ operator<=>(base_uint<Bits, Tag> const& lhs, base_uint<Bits, Tag> const& rhs)
     // FIXME: use std::lexicographical_compare_three_way once support is
     //        added to MacOS.
 
+    if (!std::is_constant_evaluated())
+    {
+        // Compare eight bytes at a time. Read as big endian numbers, the
+        // first of those that differs orders the values, like a byte
+        // would.
+        auto const* l = lhs.data();
+        auto const* r = rhs.data();
+        std::size_t i = 0;
+        for (; i + 8 <= lhs.size(); i += 8)
+        {
+            std::uint64_t a, b;
+            std::memcpy(&a, l + i, 8);
+            std::memcpy(&b, r + i, 8);
+            if (a != b)
+                return boost::endian::big_to_native(a) <=>
+                    boost::endian::big_to_native(b);
+        }
+        if (i != lhs.size())
+        {
+            std::uint32_t a, b;
+            std::memcpy(&a, l + i, 4);
+            std::memcpy(&b, r + i, 4);
+            return boost::endian::big_to_native(a) <=>
+                boost::endian::big_to_native(b);
+        }
+        return std::strong_ordering::equal;
+    }
+
     auto const ret = std::mismatch(lhs.cbegin(), lhs.cend(), rhs.cbegin());
 
     // a == b
@@ -575,6 +594,8 @@ template <std::size_t Bits, typename Tag>
 [[nodiscard]] inline constexpr bool
 operator==(base_uint<Bits, Tag> const& lhs, base_uint<Bits, Tag> const& rhs)
 {
+    if (!std::is_constant_evaluated())
+        return std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
     return (lhs <=> rhs) == 0;
 }
 
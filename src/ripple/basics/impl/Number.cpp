@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/basics/MathUtilities.h>
 #include <ripple/basics/Number.h>
 #include <boost/predef.h>
 #include <algorithm>
@@ -26,7 +27,8 @@
 #include <type_traits>
 #include <utility>
 
-#ifdef BOOST_COMP_MSVC
+// BOOST_COMP_MSVC is always defined, as zero for other compilers.
+#if BOOST_COMP_MSVC
 #include <boost/multiprecision/cpp_int.hpp>
 using uint128_t = boost::multiprecision::uint128_t;
 #else   // !defined(_MSVC_LANG)
@@ -78,6 +80,11 @@ public:
     void
     push(unsigned d) noexcept;
 
+    // add the n low order digits of m, least significant first, and
+    // return the digits that are left
+    std::uint64_t
+    push(std::uint64_t m, unsigned n) noexcept;
+
     // recover a digit
     unsigned
     pop() noexcept;
@@ -115,6 +122,28 @@ Number::Guard::push(unsigned d) noexcept
     digits_ |= (d & 0x0000'0000'0000'000FULL) << 60;
 }
 
+inline std::uint64_t
+Number::Guard::push(std::uint64_t m, unsigned n) noexcept
+{
+    for (; n != 0 && m != 0; --n)
+    {
+        push(static_cast<unsigned>(m % 10));
+        m /= 10;
+    }
+    // Pushing zeros only shifts the digits towards the sticky bit
+    if (n >= 16)
+    {
+        xbit_ = xbit_ || digits_ != 0;
+        digits_ = 0;
+    }
+    else if (n != 0)
+    {
+        xbit_ = xbit_ || (digits_ & ((1ull << (4 * n)) - 1)) != 0;
+        digits_ >>= 4 * n;
+    }
+    return m;
+}
+
 inline unsigned
 Number::Guard::pop() noexcept
 {
@@ -180,10 +209,17 @@ Number::normalize()
     auto m = static_cast<std::make_unsigned_t<rep>>(mantissa_);
     if (negative)
         m = -m;
-    while ((m < minMantissa) && (exponent_ > minExponent))
+    if (m < minMantissa)
     {
-        m *= 10;
-        --exponent_;
+        // Scale up in one step rather than a digit at a time
+        auto const shift = static_cast<int>(std::min<std::int64_t>(
+            decimalDigits(minMantissa) - decimalDigits(m),
+            std::int64_t{exponent_} - minExponent));
+        if (shift > 0)
+        {
+            m *= powerOfTen(shift);
+            exponent_ -= shift;
+        }
     }
     Guard g;
     if (negative)
@@ -257,23 +293,15 @@ Number::operator+=(Number const& y)
     {
         if (xn == -1)
             g.set_negative();
-        do
-        {
-            g.push(xm % 10);
-            xm /= 10;
-            ++xe;
-        } while (xe < ye);
+        xm = g.push(xm, ye - xe);
+        xe = ye;
     }
     else if (xe > ye)
     {
         if (yn == -1)
             g.set_negative();
-        do
-        {
-            g.push(ym % 10);
-            ym /= 10;
-            ++ye;
-        } while (xe > ye);
+        ym = g.push(ym, xe - ye);
+        ye = xe;
     }
     if (xn == yn)
     {
@@ -397,6 +425,17 @@ Number::operator*=(Number const& y)
     Guard g;
     if (zn == -1)
         g.set_negative();
+    // Both mantissas have 16 digits, so the product has 31 or 32. Drop
+    // the 15 low order digits with a single division, and then the last
+    // one, if any, with the loop below.
+    {
+        constexpr auto digits = decimalDigits(minMantissa) - 1;
+        constexpr std::uint64_t p = powerOfTen(digits);
+        uint128_t const q = zm / p;
+        g.push(static_cast<std::uint64_t>(zm - q * p), digits);
+        zm = q;
+        ze += digits;
+    }
     while (zm > maxMantissa)
     {
         // The following is optimization for:
@@ -23,8 +23,51 @@
 #include <boost/algorithm/hex.hpp>
 #include <boost/endian/conversion.hpp>
 
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
 namespace ripple {
 
+namespace detail {
+
+// The two uppercase hex digits of every byte value, in order.
+inline constexpr std::array<char, 512> hexPairs = []() {
+    constexpr char digits[] = "0123456789ABCDEF";
+    std::array<char, 512> t{};
+    for (int i = 0; i < 256; ++i)
+    {
+        t[2 * i] = digits[i >> 4];
+        t[2 * i + 1] = digits[i & 0xF];
+    }
+    return t;
+}();
+
+// The value of every hex digit, either case. Anything else maps to 0xFF.
+inline constexpr std::array<std::uint8_t, 256> hexValues = []() {
+    std::array<std::uint8_t, 256> t{};
+    for (auto& x : t)
+        x = 0xFF;
+    for (int i = 0; i < 10; ++i)
+        t['0' + i] = i;
+    for (int i = 0; i < 6; ++i)
+    {
+        t['A' + i] = 10 + i;
+        t['a' + i] = 10 + i;
+    }
+    return t;
+}();
+
+constexpr std::uint8_t
+hexValue(char c)
+{
+    return hexValues[static_cast<unsigned char>(c)];
+}
+
+}  // namespace detail
+
 template <class FwdIt>
 std::string
 strHex(FwdIt begin, FwdIt end)
@@ -35,8 +78,25 @@ strHex(FwdIt begin, FwdIt end)
             std::forward_iterator_tag>::value,
         "FwdIt must be a forward iterator");
     std::string result;
-    result.reserve(2 * std::distance(begin, end));
-    boost::algorithm::hex(begin, end, std::back_inserter(result));
+    if constexpr (
+        sizeof(typename std::iterator_traits<FwdIt>::value_type) == 1)
+    {
+        // Bytes are looked up two digits at a time, straight into place.
+        result.resize(2 * std::distance(begin, end));
+        char* out = result.data();
+        for (; begin != end; ++begin, out += 2)
+        {
+            auto const pair =
+                &detail::hexPairs[2 * static_cast<unsigned char>(*begin)];
+            out[0] = pair[0];
+            out[1] = pair[1];
+        }
+    }
+    else
+    {
+        result.reserve(2 * std::distance(begin, end));
+        boost::algorithm::hex(begin, end, std::back_inserter(result));
+    }
     return result;
 }
 
@@ -28,6 +28,9 @@
 #include <ripple/consensus/LedgerTrie.h>
 #include <ripple/protocol/PublicKey.h>
 
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <type_traits>
@@ -351,7 +354,217 @@ class Validations
     // Is NOT managed by the mutex_ above
     Adaptor adaptor_;
 
+    // Trusted full validations indexed by ledger id. A null entry means the
+    // ledger has none.
+    using TrustedMap =
+        hash_map<ID, std::shared_ptr<std::vector<Validation> const>>;
+
+    // The trusted full validations, kept in step with byLedger_ under
+    // mutex_: those of the ledgers that changed since trustedBase_ was
+    // built, and the rest in trustedBase_, which snapshots share.
+    std::shared_ptr<TrustedMap const> trustedBase_ =
+        std::make_shared<TrustedMap const>();
+    TrustedMap trustedChanged_;
+
+    // When the validation sets of ledgers were last read from a snapshot,
+    // to be touched in byLedger_ the next time it's written. Guarded by
+    // touchedMutex_, which is never held for longer than an insert.
+    std::mutex touchedMutex_;
+    hash_map<ID, std::chrono::steady_clock::time_point> touched_;
+
+    // Whether anything a snapshot holds changed since the last one. Set
+    // under mutex_, and read without it by queries.
+    std::atomic<bool> dirty_{true};
+
+    /** An immutable view of the trusted validations and the preferred
+        branch, so that common queries do not have to wait on mutex_.
+
+        A snapshot is published by the first query after an update, so a
+        burst of updates is published once.
+    */
+    struct Snapshot
+    {
+        std::shared_ptr<TrustedMap const> trustedBase;
+        TrustedMap trustedChanged;
+
+        // The trie's preferred branch when the snapshot was taken
+        std::optional<SpanTip<Ledger>> preferred;
+
+        // The preferred branch can only be taken from the snapshot while
+        // no current validation has gone stale and no ledgers needed by
+        // the trie are still being acquired.
+        bool acquiring = false;
+        NetClock::time_point publishedAt;
+        NetClock::time_point staleAt;
+
+        bool
+        fresh(NetClock::time_point now) const
+        {
+            return !acquiring && now >= publishedAt && now < staleAt;
+        }
+
+        std::shared_ptr<std::vector<Validation> const>
+        trusted(ID const& ledgerID) const
+        {
+            if (auto it = trustedChanged.find(ledgerID);
+                it != trustedChanged.end())
+                return it->second;
+            if (auto it = trustedBase->find(ledgerID);
+                it != trustedBase->end())
+                return it->second;
+            return {};
+        }
+    };
+
+    // Guards only the snapshot_ pointer, which is never held for longer
+    // than it takes to copy it.
+    mutable std::mutex snapshotMutex_;
+    std::shared_ptr<Snapshot const> snapshot_;
+
 private:
+    // The trusted full validations among a ledger's validations, or null
+    // if there are none
+    static std::shared_ptr<std::vector<Validation> const>
+    trustedOf(hash_map<NodeID, Validation> const& validations)
+    {
+        std::vector<Validation> trusted;
+        for (auto const& [_, val] : validations)
+        {
+            (void)_;
+            if (val.trusted() && val.full())
+                trusted.push_back(val);
+        }
+
+        if (trusted.empty())
+            return {};
+        return std::make_shared<std::vector<Validation> const>(
+            std::move(trusted));
+    }
+
+    // Recompute the trusted full validations of a ledger from byLedger_
+    void
+    updateTrusted(std::lock_guard<Mutex> const&, ID const& ledgerID)
+    {
+        auto it = byLedger_.find(ledgerID);
+        trustedChanged_[ledgerID] =
+            it != byLedger_.end() ? trustedOf(it->second) : nullptr;
+        dirty_ = true;
+    }
+
+    // Recompute the trusted full validations of every ledger
+    void
+    updateTrusted(std::lock_guard<Mutex> const&)
+    {
+        auto base = std::make_shared<TrustedMap>();
+        for (auto const& [ledgerID, validations] : byLedger_)
+        {
+            if (auto trusted = trustedOf(validations))
+                base->emplace(ledgerID, std::move(trusted));
+        }
+        trustedBase_ = std::move(base);
+        trustedChanged_.clear();
+        dirty_ = true;
+    }
+
+    // Refresh the validation sets of the ledgers that queries read without
+    // the lock since it was last held, so they don't expire while in use
+    void
+    touchRead(std::lock_guard<Mutex> const&)
+    {
+        hash_map<ID, std::chrono::steady_clock::time_point> touched;
+        {
+            std::lock_guard lock{touchedMutex_};
+            touched.swap(touched_);
+        }
+
+        auto const now = byLedger_.clock().now();
+        for (auto const& [ledgerID, readAt] : touched)
+        {
+            // A set read this long ago would have expired by now even if it
+            // had been touched when it was read.
+            if (now - readAt >= parms_.validationSET_EXPIRES)
+                continue;
+            if (auto it = byLedger_.find(ledgerID); it != byLedger_.end())
+                byLedger_.touch(it);
+        }
+    }
+
+    // Publish a new snapshot if anything changed since the last one
+    void
+    publish(std::lock_guard<Mutex> const&)
+    {
+        if (!dirty_)
+            return;
+
+        // Fold the changed ledgers into a new base once there are enough of
+        // them, so that a snapshot copies few entries while the cost of
+        // building the base is spread over the changes since the last one.
+        if (trustedChanged_.size() > trustedBase_->size() / 4)
+        {
+            auto base = std::make_shared<TrustedMap>(*trustedBase_);
+            for (auto& [ledgerID, trusted] : trustedChanged_)
+            {
+                if (trusted)
+                    (*base)[ledgerID] = std::move(trusted);
+                else
+                    base->erase(ledgerID);
+            }
+            trustedBase_ = std::move(base);
+            trustedChanged_.clear();
+        }
+
+        auto snap = std::make_shared<Snapshot>();
+        snap->trustedBase = trustedBase_;
+        snap->trustedChanged = trustedChanged_;
+        if (auto preferred = trie_.getPreferred(localSeqEnforcer_.largest()))
+            snap->preferred.emplace(std::move(*preferred));
+        snap->acquiring = !acquiring_.empty();
+        snap->publishedAt = adaptor_.now();
+
+        // A validation stops being current once it is older than
+        // validationCURRENT_EARLY; as time moves forward that is the only
+        // way a current validation can become stale.
+        snap->staleAt = NetClock::time_point::max();
+        for (auto const& [_, val] : current_)
+        {
+            (void)_;
+            snap->staleAt = std::min<NetClock::time_point>(
+                snap->staleAt, val.signTime() + parms_.validationCURRENT_EARLY);
+        }
+
+        {
+            std::lock_guard lock{snapshotMutex_};
+            snapshot_ = std::move(snap);
+        }
+        dirty_ = false;
+    }
+
+    // The latest snapshot, published first if anything changed since the
+    // last one.
+    std::shared_ptr<Snapshot const>
+    snapshot()
+    {
+        if (dirty_)
+            publish(std::lock_guard{mutex_});
+
+        std::lock_guard lock{snapshotMutex_};
+        return snapshot_;
+    }
+
+    // The trusted full validations of a ledger, from the latest snapshot.
+    // The ledger's validation set is touched when byLedger_ is next written.
+    std::shared_ptr<std::vector<Validation> const>
+    trustedForLedger(ID const& ledgerID)
+    {
+        // The clock is never changed, so it can be read without mutex_.
+        auto const now = byLedger_.clock().now();
+        {
+            std::lock_guard lock{touchedMutex_};
+            touched_[ledgerID] = now;
+        }
+        return snapshot()->trusted(ledgerID);
+    }
+
     // Remove support of a validated ledger
     void
     removeTrie(
@@ -377,6 +590,7 @@ private:
                 lastLedger_.erase(nodeID);
             }
         }
+        dirty_ = true;
     }
 
     // Check if any pending acquire ledger requests are complete
@@ -412,6 +626,7 @@ private:
             it->second = ledger;
         }
         trie_.insert(ledger);
+        dirty_ = true;
     }
 
     /** Process a new validation
@@ -449,6 +664,7 @@ private:
         }
 
         checkAcquired(lock);
+        dirty_ = true;
 
         std::pair<Seq, ID> valPair{val.seq(), val.ledgerID()};
         auto it = acquiring_.find(valPair);
@@ -530,37 +746,6 @@ private:
         }
     }
 
-    /** Iterate the set of validations associated with a given ledger id
-
-        @param lock Existing lock on mutex_
-        @param ledgerID The identifier of the ledger
-        @param pre Invokable with signature(std::size_t)
-        @param f Invokable with signature (NodeID const &, Validation const &)
-
-        @note The invokable `pre` is called prior to iterating validations. The
-              argument is the number of times `f` will be called.
-        @warning The invokable f is expected to be a simple transformation of
-       its arguments and will be called with mutex_ under lock.
-    */
-    template <class Pre, class F>
-    void
-    byLedger(
-        std::lock_guard<Mutex> const&,
-        ID const& ledgerID,
-        Pre&& pre,
-        F&& f)
-    {
-        auto it = byLedger_.find(ledgerID);
-        if (it != byLedger_.end())
-        {
-            // Update set time since it is being used
-            byLedger_.touch(it);
-            pre(it->second.size());
-            for (auto const& [key, val] : it->second)
-                f(key, val);
-        }
-    }
-
 public:
     /** Constructor
 
@@ -607,7 +792,13 @@ public:
     canValidateSeq(Seq const s)
     {
         std::lock_guard lock{mutex_};
-        return localSeqEnforcer_(byLedger_.clock().now(), s, parms_);
+        auto const largest = localSeqEnforcer_.largest();
+        auto const result =
+            localSeqEnforcer_(byLedger_.clock().now(), s, parms_);
+        // The preferred branch depends on the largest sequence we issued
+        if (localSeqEnforcer_.largest() != largest)
+            dirty_ = true;
+        return result;
     }
 
     /** Add a new validation
@@ -626,6 +817,7 @@ public:
 
         {
             std::lock_guard lock{mutex_};
+            touchRead(lock);
 
             // Check that validation sequence is greater than any non-expired
             // validations sequence from that validator; if it's not, perform
@@ -679,6 +871,7 @@ public:
             }
 
             byLedger_[val.ledgerID()].insert_or_assign(nodeID, val);
+            updateTrusted(lock, val.ledgerID());
 
             auto const [it, inserted] = current_.emplace(nodeID, val);
             if (!inserted)
@@ -693,7 +886,9 @@ public:
                         updateTrie(lock, nodeID, val, old);
                 }
                 else
+                {
                     return ValStatus::stale;
+                }
             }
             else if (val.trusted())
             {
@@ -729,6 +924,7 @@ public:
         auto const start = std::chrono::steady_clock::now();
         {
             std::lock_guard lock{mutex_};
+            touchRead(lock);
             if (toKeep_)
             {
                 // We only need to refresh the keep range when it's just about
@@ -770,6 +966,8 @@ public:
 
             beast::expire(byLedger_, parms_.validationSET_EXPIRES);
             beast::expire(bySequence_, parms_.validationSET_EXPIRES);
+
+            updateTrusted(lock);
         }
         JLOG(j.debug())
             << "Validations sets sweep lock duration "
@@ -822,6 +1020,8 @@ public:
                 }
             }
         }
+
+        updateTrusted(lock);
     }
 
     Json::Value
@@ -846,33 +1046,47 @@ public:
     std::optional<std::pair<Seq, ID>>
     getPreferred(Ledger const& curr)
     {
-        std::lock_guard lock{mutex_};
-        std::optional<SpanTip<Ledger>> preferred =
-            withTrie(lock, [this](LedgerTrie<Ledger>& trie) {
-                return trie.getPreferred(localSeqEnforcer_.largest());
-            });
-        // No trusted validations to determine branch
-        if (!preferred)
+        std::optional<SpanTip<Ledger>> preferred;
+
+        if (auto const snap = snapshot(); snap->fresh(adaptor_.now()))
         {
-            // fall back to majority over acquiring ledgers
-            auto it = std::max_element(
-                acquiring_.begin(),
-                acquiring_.end(),
-                [](auto const& a, auto const& b) {
-                    std::pair<Seq, ID> const& aKey = a.first;
-                    typename hash_set<NodeID>::size_type const& aSize =
-                        a.second.size();
-                    std::pair<Seq, ID> const& bKey = b.first;
-                    typename hash_set<NodeID>::size_type const& bSize =
-                        b.second.size();
-                    // order by number of trusted peers validating that ledger
-                    // break ties with ledger ID
-                    return std::tie(aSize, aKey.second) <
-                        std::tie(bSize, bKey.second);
-                });
-            if (it != acquiring_.end())
-                return it->first;
-            return std::nullopt;
+            // Nothing was being acquired when the snapshot was taken, so
+            // there is no fallback if the trie is empty.
+            if (!snap->preferred)
+                return std::nullopt;
+            preferred.emplace(*snap->preferred);
+        }
+        else
+        {
+            std::lock_guard lock{mutex_};
+            if (auto tip = withTrie(lock, [this](LedgerTrie<Ledger>& trie) {
+                    return trie.getPreferred(localSeqEnforcer_.largest());
+                }))
+                preferred.emplace(std::move(*tip));
+
+            // No trusted validations to determine branch
+            if (!preferred)
+            {
+                // fall back to majority over acquiring ledgers
+                auto it = std::max_element(
+                    acquiring_.begin(),
+                    acquiring_.end(),
+                    [](auto const& a, auto const& b) {
+                        std::pair<Seq, ID> const& aKey = a.first;
+                        typename hash_set<NodeID>::size_type const& aSize =
+                            a.second.size();
+                        std::pair<Seq, ID> const& bKey = b.first;
+                        typename hash_set<NodeID>::size_type const& bSize =
+                            b.second.size();
+                        // order by number of trusted peers validating that
+                        // ledger break ties with ledger ID
+                        return std::tie(aSize, aKey.second) <
+                            std::tie(bSize, bKey.second);
+                    });
+                if (it != acquiring_.end())
+                    return it->first;
+                return std::nullopt;
+            }
         }
 
         // If we are the parent of the preferred ledger, stick with our
@@ -1033,17 +1247,9 @@ public:
     std::size_t
     numTrustedForLedger(ID const& ledgerID)
     {
-        std::size_t count = 0;
-        std::lock_guard lock{mutex_};
-        byLedger(
-            lock,
-            ledgerID,
-            [&](std::size_t) {},  // nothing to reserve
-            [&](NodeID const&, Validation const& v) {
-                if (v.trusted() && v.full())
-                    ++count;
-            });
-        return count;
+        if (auto const trusted = trustedForLedger(ledgerID))
+            return trusted->size();
+        return 0;
     }
 
     /**  Get trusted full validations for a specific ledger
@@ -1056,16 +1262,15 @@ public:
     getTrustedForLedger(ID const& ledgerID, Seq const& seq)
     {
         std::vector<WrappedValidationType> res;
-        std::lock_guard lock{mutex_};
-        byLedger(
-            lock,
-            ledgerID,
-            [&](std::size_t numValidations) { res.reserve(numValidations); },
-            [&](NodeID const&, Validation const& v) {
-                if (v.trusted() && v.full() && v.seq() == seq)
+        if (auto const trusted = trustedForLedger(ledgerID))
+        {
+            res.reserve(trusted->size());
+            for (auto const& v : *trusted)
+            {
+                if (v.seq() == seq)
                     res.emplace_back(v.unwrap());
-            });
-
+            }
+        }
         return res;
     }
 
@@ -1079,21 +1284,18 @@ public:
     fees(ID const& ledgerID, std::uint32_t baseFee)
     {
         std::vector<std::uint32_t> res;
-        std::lock_guard lock{mutex_};
-        byLedger(
-            lock,
-            ledgerID,
-            [&](std::size_t numValidations) { res.reserve(numValidations); },
-            [&](NodeID const&, Validation const& v) {
-                if (v.trusted() && v.full())
-                {
-                    std::optional<std::uint32_t> loadFee = v.loadFee();
-                    if (loadFee)
-                        res.push_back(*loadFee);
-                    else
-                        res.push_back(baseFee);
-                }
-            });
+        if (auto const trusted = trustedForLedger(ledgerID))
+        {
+            res.reserve(trusted->size());
+            for (auto const& v : *trusted)
+            {
+                std::optional<std::uint32_t> loadFee = v.loadFee();
+                if (loadFee)
+                    res.push_back(*loadFee);
+                else
+                    res.push_back(baseFee);
+            }
+        }
         return res;
     }
 
@@ -1104,6 +1306,7 @@ public:
     {
         std::lock_guard lock{mutex_};
         current_.clear();
+        dirty_ = true;
     }
 
     /** Return quantity of lagging proposers, and remove online proposers
@@ -1126,8 +1329,9 @@ public:
     {
         std::size_t laggards = 0;
 
+        std::lock_guard lock{mutex_};
         current(
-            std::lock_guard{mutex_},
+            lock,
             [](std::size_t) {},
             [&](NodeID const&, Validation const& v) {
                 if (adaptor_.now() <
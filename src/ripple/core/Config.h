@@ -292,6 +292,15 @@ public:
     // Enable the beta API version
     bool BETA_RPC_API = false;
 
+    // Bytes of RPC results against validated ledgers to keep, and the
+    // commands whose results are kept. 0 keeps none.
+    std::size_t RPC_CACHE_SIZE = 0;
+    std::vector<std::string> RPC_CACHE_COMMANDS;
+
+    // The entries an owner directory must hold for what the account owns
+    // to be indexed. 0 indexes none.
+    std::size_t OWNER_INDEX_MIN_ENTRIES = 0;
+
     // First, attempt to load the latest ledger directly from disk.
     bool FAST_LOAD = false;
 
@@ -44,10 +44,12 @@ enum JobType {
     jtPUBOLDLEDGER,       // An old ledger has been accepted
     jtCLIENT,             // A placeholder for the priority of all jtCLIENT jobs
     jtCLIENT_SUBSCRIBE,   // A websocket subscription by a client
+    jtCLIENT_PUBLISH,     // Published messages sent to subscribed clients
     jtCLIENT_FEE_CHANGE,  // Subscription for fee change by a client
     jtCLIENT_CONSENSUS,   // Subscription for consensus state change by a client
     jtCLIENT_ACCT_HIST,   // Subscription for account history by a client
     jtCLIENT_SHARD,       // Client request for shard archiving
+    jtCLIENT_EXPORT,      // Read ledger state for a client's ledger_export
     jtCLIENT_RPC,         // Client RPC request
     jtCLIENT_WEBSOCKET,   // Client websocket request
     jtRPC,                // A websocket command from the client
@@ -55,6 +57,8 @@ enum JobType {
     jtVALIDATION_ut,      // A validation from an untrusted source
     jtMANIFEST,           // A validator's manifest
     jtUPDATE_PF,          // Update pathfinding requests
+    jtOWNER_INDEX,        // Index what the largest accounts own
+    jtPREFETCH_STATE,     // Load state the next ledger close will read
     jtTRANSACTION_l,      // A local transaction
     jtREPLAY_REQ,         // Peer request a ledger delta or a skip list
     jtLEDGER_REQ,         // Peer request ledger/txnset data
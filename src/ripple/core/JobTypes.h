@@ -81,14 +81,18 @@ private:
         add(jtLEDGER_DATA,       "ledgerData",                  3,     0ms,     0ms);
         add(jtCLIENT,            "clientCommand",        maxLimit,  2000ms,  5000ms);
         add(jtCLIENT_SUBSCRIBE,  "clientSubscribe",      maxLimit,  2000ms,  5000ms);
+        add(jtCLIENT_PUBLISH,    "clientPublish",               1,  2000ms,  5000ms);
         add(jtCLIENT_FEE_CHANGE, "clientFeeChange",      maxLimit,  2000ms,  5000ms);
         add(jtCLIENT_CONSENSUS,  "clientConsensus",      maxLimit,  2000ms,  5000ms);
         add(jtCLIENT_ACCT_HIST,  "clientAccountHistory", maxLimit,  2000ms,  5000ms);
         add(jtCLIENT_SHARD,      "clientShardArchive",   maxLimit,  2000ms,  5000ms);
+        add(jtCLIENT_EXPORT,     "clientLedgerExport",          4,     0ms,     0ms);
         add(jtCLIENT_RPC,        "clientRPC",            maxLimit,  2000ms,  5000ms);
         add(jtCLIENT_WEBSOCKET,  "clientWebsocket",      maxLimit,  2000ms,  5000ms);
         add(jtRPC,               "RPC",                  maxLimit,     0ms,     0ms);
         add(jtUPDATE_PF,         "updatePaths",                 1,     0ms,     0ms);
+        add(jtOWNER_INDEX,       "buildOwnerIndex",             1,     0ms,     0ms);
+        add(jtPREFETCH_STATE,    "prefetchState",               1,     0ms,     0ms);
         add(jtTRANSACTION,       "transaction",          maxLimit,   250ms,  1000ms);
         add(jtBATCH,             "batch",                maxLimit,   250ms,  1000ms);
         add(jtADVANCE,           "advanceLedger",        maxLimit,     0ms,     0ms);
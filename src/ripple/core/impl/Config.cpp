@@ -828,6 +828,32 @@ Config::loadFromString(std::string const& fileContents)
     if (getSingleSection(secConfig, SECTION_BETA_RPC_API, strTemp, j_))
         BETA_RPC_API = beast::lexicalCastThrow<bool>(strTemp);
 
+    if (exists(SECTION_RPC_CACHE))
+    {
+        auto sec = section(SECTION_RPC_CACHE);
+        RPC_CACHE_SIZE = sec.value_or<std::size_t>("size_mb", 64) << 20;
+        auto const commands = sec.value_or<std::string>(
+            "commands",
+            "account_currencies,account_info,account_lines,book_offers,"
+            "gateway_balances,ledger_entry");
+        boost::algorithm::split(
+            RPC_CACHE_COMMANDS,
+            commands,
+            boost::algorithm::is_any_of(", "),
+            boost::algorithm::token_compress_on);
+        RPC_CACHE_COMMANDS.erase(
+            std::remove(
+                RPC_CACHE_COMMANDS.begin(), RPC_CACHE_COMMANDS.end(), ""),
+            RPC_CACHE_COMMANDS.end());
+    }
+
+    if (exists(SECTION_OWNER_INDEX))
+    {
+        auto const sec = section(SECTION_OWNER_INDEX);
+        OWNER_INDEX_MIN_ENTRIES =
+            sec.value_or<std::size_t>("min_entries", 1000);
+    }
+
     // Do not load trusted validator configuration for standalone mode
     if (!RUN_STANDALONE)
     {
@@ -215,9 +215,8 @@ void
 doCopyFrom(Object& to, Json::Value const& from)
 {
     assert(from.isObjectOrNull());
-    auto members = from.getMemberNames();
-    for (auto& m : members)
-        to[m] = from[m];
+    for (auto it = from.begin(); it != from.end(); ++it)
+        to[it.memberName()] = *it;
 }
 
 }  // namespace
@@ -72,11 +72,10 @@ outputJson(Json::Value const& value, Writer& writer)
 
         case Json::objectValue: {
             writer.startRoot(Writer::object);
-            auto members = value.getMemberNames();
-            for (auto const& tag : members)
+            for (auto it = value.begin(); it != value.end(); ++it)
             {
-                writer.rawSet(tag);
-                outputJson(value[tag], writer);
+                writer.rawSet(it.memberName());
+                outputJson(*it, writer);
             }
             writer.finish();
             break;
@@ -23,6 +23,8 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <istream>
 #include <string>
 
@@ -951,6 +953,364 @@ Reader::getFormatedErrorMessages() const
     return formattedMessage;
 }
 
+// Strict reading
+// //////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Reads the documents that readStrict accepts. Every way in which a
+// document could differ from those, or be read differently by Reader,
+// makes it give up, and leaves the document to Reader.
+class StrictReader
+{
+public:
+    StrictReader(char const* begin, char const* end)
+        : current_(begin), end_(end)
+    {
+    }
+
+    bool
+    read(Value& root)
+    {
+        skipSpaces();
+        if (current_ == end_ || (*current_ != '{' && *current_ != '['))
+            return false;
+
+        Value value;
+        if (!readValue(value, 0))
+            return false;
+
+        skipSpaces();
+        if (current_ != end_)
+            return false;
+
+        root = std::move(value);
+        return true;
+    }
+
+private:
+    // Whether any byte of a word is a quote or a backslash, which are the
+    // only characters that end a run of plain characters in a string.
+    static bool
+    hasSpecialByte(std::uint64_t word)
+    {
+        constexpr std::uint64_t ones = 0x0101010101010101;
+        constexpr std::uint64_t highs = 0x8080808080808080;
+        auto const hasZeroByte = [](std::uint64_t x) {
+            return ((x - ones) & ~x & highs) != 0;
+        };
+        return hasZeroByte(word ^ (ones * '"')) ||
+            hasZeroByte(word ^ (ones * '\\'));
+    }
+
+    void
+    skipSpaces()
+    {
+        while (current_ != end_ &&
+               (*current_ == ' ' || *current_ == '\n' || *current_ == '\r' ||
+                *current_ == '\t'))
+            ++current_;
+    }
+
+    bool
+    consume(char c)
+    {
+        skipSpaces();
+        if (current_ == end_ || *current_ != c)
+            return false;
+        ++current_;
+        return true;
+    }
+
+    bool
+    match(char const* word, std::size_t length)
+    {
+        if (static_cast<std::size_t>(end_ - current_) < length ||
+            std::memcmp(current_, word, length) != 0)
+            return false;
+        current_ += length;
+        return true;
+    }
+
+    bool
+    readValue(Value& value, unsigned depth)
+    {
+        if (depth > Reader::nest_limit)
+            return false;
+
+        skipSpaces();
+        if (current_ == end_)
+            return false;
+
+        switch (*current_)
+        {
+            case '{':
+                ++current_;
+                return readObject(value, depth);
+
+            case '[':
+                ++current_;
+                return readArray(value, depth);
+
+            case '"':
+                ++current_;
+                if (!readString(text_))
+                    return false;
+                value = text_;
+                return true;
+
+            case 't':
+                value = true;
+                return match("true", 4);
+
+            case 'f':
+                value = false;
+                return match("false", 5);
+
+            case 'n':
+                value = Value();
+                return match("null", 4);
+
+            default:
+                return readNumber(value);
+        }
+    }
+
+    bool
+    readObject(Value& value, unsigned depth)
+    {
+        value = Value(objectValue);
+        if (consume('}'))
+            return true;
+
+        do
+        {
+            if (!consume('"') || !readString(name_) || !consume(':'))
+                return false;
+
+            // Reader rejects objects that repeat a name.
+            auto const size = value.size();
+            auto& member = value[name_];
+            if (value.size() == size || !readValue(member, depth + 1))
+                return false;
+        } while (consume(','));
+
+        return consume('}');
+    }
+
+    bool
+    readArray(Value& value, unsigned depth)
+    {
+        value = Value(arrayValue);
+        if (consume(']'))
+            return true;
+
+        do
+        {
+            if (!readValue(value.append(Value()), depth + 1))
+                return false;
+        } while (consume(','));
+
+        return consume(']');
+    }
+
+    // Reads the rest of a string whose opening quote has been read.
+    bool
+    readString(std::string& decoded)
+    {
+        decoded.clear();
+
+        for (;;)
+        {
+            auto const plain = current_;
+            while (end_ - current_ >= 8)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, current_, sizeof(word));
+                if (hasSpecialByte(word))
+                    break;
+                current_ += 8;
+            }
+            while (current_ != end_ && *current_ != '"' && *current_ != '\\')
+                ++current_;
+            decoded.append(plain, current_);
+
+            if (current_ == end_)
+                return false;
+
+            if (*current_++ == '"')
+                return true;
+
+            if (current_ == end_)
+                return false;
+
+            switch (*current_++)
+            {
+                case '"':
+                    decoded += '"';
+                    break;
+                case '/':
+                    decoded += '/';
+                    break;
+                case '\\':
+                    decoded += '\\';
+                    break;
+                case 'b':
+                    decoded += '\b';
+                    break;
+                case 'f':
+                    decoded += '\f';
+                    break;
+                case 'n':
+                    decoded += '\n';
+                    break;
+                case 'r':
+                    decoded += '\r';
+                    break;
+                case 't':
+                    decoded += '\t';
+                    break;
+                case 'u': {
+                    unsigned int unicode;
+                    if (!readHex4(unicode))
+                        return false;
+
+                    // Reader pairs a high surrogate with whatever escape
+                    // follows it, so this does as well.
+                    if (unicode >= 0xD800 && unicode <= 0xDBFF)
+                    {
+                        unsigned int low;
+                        if (!match("\\u", 2) || !readHex4(low))
+                            return false;
+                        unicode =
+                            0x10000 + ((unicode & 0x3FF) << 10) + (low & 0x3FF);
+                    }
+                    decoded += codePointToUTF8(unicode);
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+    }
+
+    bool
+    readHex4(unsigned int& unicode)
+    {
+        if (end_ - current_ < 4)
+            return false;
+
+        unicode = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            char const c = *current_++;
+            unicode *= 16;
+            if (c >= '0' && c <= '9')
+                unicode += c - '0';
+            else if (c >= 'a' && c <= 'f')
+                unicode += c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                unicode += c - 'A' + 10;
+            else
+                return false;
+        }
+        return true;
+    }
+
+    static bool
+    isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    bool
+    readNumber(Value& value)
+    {
+        auto const start = current_;
+        bool const negative = *current_ == '-';
+        if (negative)
+            ++current_;
+
+        // No leading zeroes, which Reader reads as decimal.
+        if (current_ == end_ || !isDigit(*current_) ||
+            (*current_ == '0' && current_ + 1 != end_ &&
+             isDigit(current_[1])))
+            return false;
+
+        // Past the range of integers, digits only matter to doubles.
+        std::int64_t integer = 0;
+        while (current_ != end_ && isDigit(*current_))
+        {
+            if (integer <= Value::maxUInt)
+                integer = integer * 10 + (*current_ - '0');
+            ++current_;
+        }
+
+        bool isDouble = false;
+        if (current_ != end_ && *current_ == '.')
+        {
+            isDouble = true;
+            ++current_;
+            if (current_ == end_ || !isDigit(*current_))
+                return false;
+            while (current_ != end_ && isDigit(*current_))
+                ++current_;
+        }
+        if (current_ != end_ && (*current_ == 'e' || *current_ == 'E'))
+        {
+            isDouble = true;
+            ++current_;
+            if (current_ != end_ && (*current_ == '+' || *current_ == '-'))
+                ++current_;
+            if (current_ == end_ || !isDigit(*current_))
+                return false;
+            while (current_ != end_ && isDigit(*current_))
+                ++current_;
+        }
+
+        if (isDouble)
+        {
+            // Converted as Reader converts them, which sscanf does with
+            // strtod.
+            std::string const text(start, current_);
+            value = std::strtod(text.c_str(), nullptr);
+            return true;
+        }
+
+        // Reader rejects integers out of range, rather than reading them
+        // as doubles.
+        if (integer > Value::maxUInt)
+            return false;
+
+        if (negative)
+        {
+            if (-integer < Value::minInt)
+                return false;
+            value = static_cast<Value::Int>(-integer);
+        }
+        else if (integer <= Value::maxInt)
+            value = static_cast<Value::Int>(integer);
+        else
+            value = static_cast<Value::UInt>(integer);
+        return true;
+    }
+
+    char const* current_;
+    char const* const end_;
+
+    // Reused for each string and member name.
+    std::string text_;
+    std::string name_;
+};
+
+}  // namespace
+
+bool
+readStrict(char const* begin, char const* end, Value& root)
+{
+    return StrictReader(begin, end).read(root);
+}
+
 std::istream&
 operator>>(std::istream& sin, Value& root)
 {
@@ -22,6 +22,8 @@
 #include <ripple/json/impl/json_assert.h>
 #include <ripple/json/json_writer.h>
 #include <ripple/json/to_string.h>
+#include <algorithm>
+#include <tuple>
 
 namespace Json {
 
@@ -132,8 +134,10 @@ Value::CZString::~CZString()
 bool
 Value::CZString::operator<(const CZString& other) const
 {
+    // Keys that are static strings, like the ones in jss, are often the
+    // very same string.
     if (cstr_ && other.cstr_)
-        return strcmp(cstr_, other.cstr_) < 0;
+        return cstr_ != other.cstr_ && strcmp(cstr_, other.cstr_) < 0;
 
     return index_ < other.index_;
 }
@@ -142,7 +146,7 @@ bool
 Value::CZString::operator==(const CZString& other) const
 {
     if (cstr_ && other.cstr_)
-        return strcmp(cstr_, other.cstr_) == 0;
+        return cstr_ == other.cstr_ || strcmp(cstr_, other.cstr_) == 0;
 
     return index_ == other.index_;
 }
@@ -165,6 +169,263 @@ Value::CZString::isStaticString() const
     return index_ == noDuplication;
 }
 
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// class Value::ObjectValues
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+bool
+Value::ObjectValues::iterator::sorted() const
+{
+    if (j_ == owner_->added_.size())
+        return true;
+    if (i_ == owner_->index_.size())
+        return false;
+    return owner_->index_[i_]->first < owner_->added_[j_]->first;
+}
+
+Value::ObjectValues::iterator&
+Value::ObjectValues::iterator::operator--()
+{
+    // The member before is the greater of the two before each position.
+    if (j_ == 0 ||
+        (i_ != 0 &&
+         owner_->added_[j_ - 1]->first < owner_->index_[i_ - 1]->first))
+        --i_;
+    else
+        --j_;
+    return *this;
+}
+
+Value::ObjectValues::ObjectValues(ObjectValues const& other)
+{
+    index_.reserve(other.size());
+
+    // What doesn't fit in the first block goes in one block of its own.
+    if (other.size() > inlineSize)
+    {
+        more_.emplace_back();
+        more_.back().values.reserve(other.size() - inlineSize);
+    }
+
+    for (auto const member : other)
+        index_.push_back(&emplace(member->first, member->second));
+}
+
+template <class... Args>
+Value::ObjectValues::value_type&
+Value::ObjectValues::emplace(Args&&... args)
+{
+    if (!free_.empty())
+    {
+        auto const place = free_.back();
+        free_.pop_back();
+        std::destroy_at(place);
+        try
+        {
+            std::construct_at(place, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            std::construct_at(place, 0, Value());
+            free_.push_back(place);
+            throw;
+        }
+        if (auto const block = blockOf(place))
+            ++block->live;
+        return *place;
+    }
+
+    if (first_.size() < first_.capacity())
+    {
+        first_.emplace_back(std::forward<Args>(args)...);
+        return first_.back();
+    }
+
+    // Blocks are only added to, never reallocated, so that members don't
+    // move.
+    if (more_.empty() ||
+        more_.back().values.size() == more_.back().values.capacity())
+    {
+        auto const capacity = more_.empty()
+            ? 2 * inlineSize
+            : 2 * more_.back().values.capacity();
+        more_.emplace_back();
+        more_.back().values.reserve(capacity);
+    }
+    auto& block = more_.back();
+    block.values.emplace_back(std::forward<Args>(args)...);
+    ++block.live;
+    return block.values.back();
+}
+
+Value::ObjectValues::Block*
+Value::ObjectValues::blockOf(value_type const* member)
+{
+    std::less<value_type const*> const less;
+    for (auto& block : more_)
+    {
+        auto const& values = block.values;
+        if (!less(member, values.data()) &&
+            less(member, values.data() + values.size()))
+            return &block;
+    }
+    return nullptr;
+}
+
+void
+Value::ObjectValues::merge()
+{
+    // Merge from the end, so that each member moves once.
+    auto const size = index_.size();
+    index_.resize(size + added_.size());
+    auto out = index_.end();
+    auto from = index_.begin() + size;
+    for (auto added = added_.end(); added != added_.begin();)
+    {
+        if (from != index_.begin() &&
+            (*std::prev(added))->first < (*std::prev(from))->first)
+            *--out = *--from;
+        else
+            *--out = *--added;
+    }
+    added_.clear();
+}
+
+void
+Value::ObjectValues::release()
+{
+    std::less<value_type const*> const less;
+    while (!more_.empty() && more_.back().live == 0 && free_.size() > size())
+    {
+        auto const& values = more_.back().values;
+        free_.erase(
+            std::remove_if(
+                free_.begin(),
+                free_.end(),
+                [&](value_type const* place) {
+                    return !less(place, values.data()) &&
+                        less(place, values.data() + values.size());
+                }),
+            free_.end());
+        more_.pop_back();
+    }
+}
+
+Value::ObjectValues::value_type&
+Value::ObjectValues::operator[](std::size_t pos) const
+{
+    if (added_.empty())
+        return *index_[pos];
+    return **std::next(begin(), pos);
+}
+
+Value::ObjectValues::value_type&
+Value::ObjectValues::back() const
+{
+    return **std::prev(end());
+}
+
+Value::ObjectValues::iterator
+Value::ObjectValues::lower_bound(CZString const& key) const
+{
+    auto const less = [](value_type const* member, CZString const& k) {
+        return member->first < k;
+    };
+    return {
+        this,
+        static_cast<std::size_t>(
+            std::lower_bound(index_.begin(), index_.end(), key, less) -
+            index_.begin()),
+        static_cast<std::size_t>(
+            std::lower_bound(added_.begin(), added_.end(), key, less) -
+            added_.begin())};
+}
+
+Value::ObjectValues::iterator
+Value::ObjectValues::find(CZString const& key) const
+{
+    auto const it = lower_bound(key);
+    if (it != end() && (*it)->first == key)
+        return it;
+    return end();
+}
+
+Value::ObjectValues::value_type&
+Value::ObjectValues::insert(iterator pos, CZString const& key)
+{
+    auto& member = emplace(std::piecewise_construct, std::tie(key), std::tie());
+
+    // Each index is sorted, so the member can go into either, at the
+    // position in it that pos has.
+    if (pos.i_ == index_.size() || index_.size() < smallSize)
+    {
+        index_.insert(index_.begin() + pos.i_, &member);
+        return member;
+    }
+
+    added_.insert(added_.begin() + pos.j_, &member);
+    if (added_.size() * added_.size() > index_.size())
+        merge();
+    return member;
+}
+
+void
+Value::ObjectValues::erase(iterator pos)
+{
+    auto const member = *pos;
+    if (pos.sorted())
+        index_.erase(index_.begin() + pos.i_);
+    else
+        added_.erase(added_.begin() + pos.j_);
+
+    if (empty())
+    {
+        clear();
+        return;
+    }
+
+    // The member and its key are released now, and its place is kept for
+    // the next member added, so that other members stay where they are.
+    std::destroy_at(member);
+    std::construct_at(member, 0, Value());
+    if (auto const block = blockOf(member))
+        --block->live;
+    free_.push_back(member);
+    release();
+}
+
+void
+Value::ObjectValues::clear()
+{
+    index_.clear();
+    added_.clear();
+    free_.clear();
+    more_.clear();
+    first_.clear();
+}
+
+bool
+operator==(Value::ObjectValues const& x, Value::ObjectValues const& y)
+{
+    return std::equal(
+        x.begin(), x.end(), y.begin(), y.end(), [](auto a, auto b) {
+            return *a == *b;
+        });
+}
+
+bool
+operator<(Value::ObjectValues const& x, Value::ObjectValues const& y)
+{
+    return std::lexicographical_compare(
+        x.begin(), x.end(), y.begin(), y.end(), [](auto a, auto b) {
+            return *a < *b;
+        });
+}
+
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
@@ -717,11 +978,7 @@ Value::size() const
 
         case arrayValue:  // size of the array is highest index + 1
             if (!value_.map_->empty())
-            {
-                ObjectValues::const_iterator itLast = value_.map_->end();
-                --itLast;
-                return (*itLast).first.index() + 1;
-            }
+                return value_.map_->back().first.index() + 1;
 
             return 0;
 
@@ -776,14 +1033,21 @@ Value::operator[](UInt index)
         *this = Value(arrayValue);
 
     CZString key(index);
-    ObjectValues::iterator it = value_.map_->lower_bound(key);
+    auto& map = *value_.map_;
 
-    if (it != value_.map_->end() && (*it).first == key)
-        return (*it).second;
+    // Elements are almost always added at the end.
+    if (map.empty() || map.back().first < key)
+        return map.insert(map.end(), key).second;
 
-    ObjectValues::value_type defaultValue(key, null);
-    it = value_.map_->insert(it, defaultValue);
-    return (*it).second;
+    if (index < map.size() && map[index].first == key)
+        return map[index].second;
+
+    auto const it = map.lower_bound(key);
+
+    if ((*it)->first == key)
+        return (*it)->second;
+
+    return map.insert(it, key).second;
 }
 
 const Value&
@@ -795,12 +1059,18 @@ Value::operator[](UInt index) const
         return null;
 
     CZString key(index);
-    ObjectValues::const_iterator it = value_.map_->find(key);
+    auto const& map = *value_.map_;
 
-    if (it == value_.map_->end())
+    // Unless elements were skipped, each is at its own index.
+    if (index < map.size() && map[index].first == key)
+        return map[index].second;
+
+    auto const it = map.find(key);
+
+    if (it == map.end())
         return null;
 
-    return (*it).second;
+    return (*it)->second;
 }
 
 Value&
@@ -819,15 +1089,12 @@ Value::resolveReference(const char* key, bool isStatic)
 
     CZString actualKey(
         key, isStatic ? CZString::noDuplication : CZString::duplicateOnCopy);
-    ObjectValues::iterator it = value_.map_->lower_bound(actualKey);
+    auto const it = value_.map_->lower_bound(actualKey);
 
-    if (it != value_.map_->end() && (*it).first == actualKey)
-        return (*it).second;
+    if (it != value_.map_->end() && (*it)->first == actualKey)
+        return (*it)->second;
 
-    ObjectValues::value_type defaultValue(actualKey, null);
-    it = value_.map_->insert(it, defaultValue);
-    Value& value = (*it).second;
-    return value;
+    return value_.map_->insert(it, actualKey).second;
 }
 
 Value
@@ -852,12 +1119,12 @@ Value::operator[](const char* key) const
         return null;
 
     CZString actualKey(key, CZString::noDuplication);
-    ObjectValues::const_iterator it = value_.map_->find(actualKey);
+    auto const it = value_.map_->find(actualKey);
 
     if (it == value_.map_->end())
         return null;
 
-    return (*it).second;
+    return (*it)->second;
 }
 
 Value&
@@ -912,12 +1179,12 @@ Value::removeMember(const char* key)
         return null;
 
     CZString actualKey(key, CZString::noDuplication);
-    ObjectValues::iterator it = value_.map_->find(actualKey);
+    auto const it = value_.map_->find(actualKey);
 
     if (it == value_.map_->end())
         return null;
 
-    Value old(it->second);
+    Value old(std::move((*it)->second));
     value_.map_->erase(it);
     return old;
 }
@@ -954,11 +1221,9 @@ Value::getMemberNames() const
 
     Members members;
     members.reserve(value_.map_->size());
-    ObjectValues::const_iterator it = value_.map_->begin();
-    ObjectValues::const_iterator itEnd = value_.map_->end();
 
-    for (; it != itEnd; ++it)
-        members.push_back(std::string((*it).first.c_str()));
+    for (auto const member : *value_.map_)
+        members.push_back(std::string(member->first.c_str()));
 
     return members;
 }
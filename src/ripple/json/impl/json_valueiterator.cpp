@@ -44,7 +44,7 @@ ValueIteratorBase::ValueIteratorBase(
 Value&
 ValueIteratorBase::deref() const
 {
-    return current_->second;
+    return (*current_)->second;
 }
 
 void
@@ -63,28 +63,13 @@ ValueIteratorBase::difference_type
 ValueIteratorBase::computeDistance(const SelfType& other) const
 {
     // Iterator for null value are initialized using the default
-    // constructor, which initialize current_ to the default
-    // std::map::iterator. As begin() and end() are two instance
-    // of the default std::map::iterator, they can not be compared.
-    // To allow this, we handle this comparison specifically.
+    // constructor, which leaves current_ singular.
     if (isNull_ && other.isNull_)
     {
         return 0;
     }
 
-    // Usage of std::distance is not portable (does not compile with Sun Studio
-    // 12 RogueWave STL, which is the one used by default). Using a portable
-    // hand-made version for non random iterator instead:
-    //   return difference_type( std::distance( current_, other.current_ ) );
-    difference_type myDistance = 0;
-
-    for (Value::ObjectValues::iterator it = current_; it != other.current_;
-         ++it)
-    {
-        ++myDistance;
-    }
-
-    return myDistance;
+    return difference_type(other.current_ - current_);
 }
 
 bool
@@ -107,7 +92,7 @@ ValueIteratorBase::copy(const SelfType& other)
 Value
 ValueIteratorBase::key() const
 {
-    const Value::CZString czstring = (*current_).first;
+    auto const& czstring = (*current_)->first;
 
     if (czstring.c_str())
     {
@@ -123,7 +108,7 @@ ValueIteratorBase::key() const
 UInt
 ValueIteratorBase::index() const
 {
-    const Value::CZString czstring = (*current_).first;
+    auto const& czstring = (*current_)->first;
 
     if (!czstring.c_str())
         return czstring.index();
@@ -134,7 +119,7 @@ ValueIteratorBase::index() const
 const char*
 ValueIteratorBase::memberName() const
 {
-    const char* name = (*current_).first.c_str();
+    const char* name = (*current_)->first.c_str();
     return name ? name : "";
 }
 
@@ -243,21 +243,16 @@ FastWriter::writeValue(const Value& value)
         break;
 
         case objectValue: {
-            Value::Members members(value.getMemberNames());
             document_ += "{";
 
-            for (Value::Members::iterator it = members.begin();
-                 it != members.end();
-                 ++it)
+            for (auto it = value.begin(); it != value.end(); ++it)
             {
-                std::string const& name = *it;
-
-                if (it != members.begin())
+                if (it != value.begin())
                     document_ += ",";
 
-                document_ += valueToQuotedString(name.c_str());
+                document_ += valueToQuotedString(it.memberName());
                 document_ += ":";
-                writeValue(value[name]);
+                writeValue(*it);
             }
 
             document_ += "}";
@@ -318,25 +313,21 @@ StyledWriter::writeValue(const Value& value)
             break;
 
         case objectValue: {
-            Value::Members members(value.getMemberNames());
-
-            if (members.empty())
+            if (value.size() == 0)
                 pushValue("{}");
             else
             {
                 writeWithIndent("{");
                 indent();
-                Value::Members::iterator it = members.begin();
+                auto it = value.begin();
 
                 while (true)
                 {
-                    std::string const& name = *it;
-                    const Value& childValue = value[name];
-                    writeWithIndent(valueToQuotedString(name.c_str()));
+                    writeWithIndent(valueToQuotedString(it.memberName()));
                     document_ += " : ";
-                    writeValue(childValue);
+                    writeValue(*it);
 
-                    if (++it == members.end())
+                    if (++it == value.end())
                         break;
 
                     document_ += ",";
@@ -540,25 +531,21 @@ StyledStreamWriter::writeValue(const Value& value)
             break;
 
         case objectValue: {
-            Value::Members members(value.getMemberNames());
-
-            if (members.empty())
+            if (value.size() == 0)
                 pushValue("{}");
             else
             {
                 writeWithIndent("{");
                 indent();
-                Value::Members::iterator it = members.begin();
+                auto it = value.begin();
 
                 while (true)
                 {
-                    std::string const& name = *it;
-                    const Value& childValue = value[name];
-                    writeWithIndent(valueToQuotedString(name.c_str()));
+                    writeWithIndent(valueToQuotedString(it.memberName()));
                     *document_ << " : ";
-                    writeValue(childValue);
+                    writeValue(*it);
 
-                    if (++it == members.end())
+                    if (++it == value.end())
                         break;
 
                     *document_ << ",";
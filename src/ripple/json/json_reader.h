@@ -25,7 +25,9 @@
 #include <ripple/json/json_forwards.h>
 #include <ripple/json/json_value.h>
 #include <boost/asio/buffer.hpp>
+#include <iterator>
 #include <stack>
+#include <string>
 
 namespace Json {
 
@@ -219,6 +221,52 @@ Reader::parse(Value& root, BufferSequence const& bs)
     return parse(s, root);
 }
 
+/** Read a JSON document quickly, or decline to.
+
+    Reads strict JSON, with no comments, whose root is an object or an
+    array, in a single pass that skips over the plain characters of
+    strings a word at a time. Anything else, or anything that Reader
+    would read differently, is declined: this returns false and leaves
+    root alone, and the caller should read the document with Reader,
+    for the forms only it accepts and for its error messages.
+
+    A document this reads, Reader reads to the same value.
+*/
+bool
+readStrict(char const* begin, char const* end, Value& root);
+
+inline bool
+readStrict(std::string const& document, Value& root)
+{
+    return readStrict(
+        document.data(), document.data() + document.size(), root);
+}
+
+/** Read a JSON document from a buffer sequence quickly, or decline to.
+
+    A document in a single buffer is read where it is.
+*/
+template <class BufferSequence>
+bool
+readStrict(Value& root, BufferSequence const& bs)
+{
+    using namespace boost::asio;
+    auto const first = buffer_sequence_begin(bs);
+    auto const last = buffer_sequence_end(bs);
+    if (first != last && std::next(first) == last)
+    {
+        const_buffer const b(*first);
+        auto const data = static_cast<char const*>(b.data());
+        return readStrict(data, data + b.size(), root);
+    }
+
+    std::string s;
+    s.reserve(buffer_size(bs));
+    for (auto const& b : bs)
+        s.append(buffer_cast<char const*>(b), buffer_size(b));
+    return readStrict(s, root);
+}
+
 /** \brief Read from 'sin' into 'root'.
 
  Always keep comments from the input JSON.
@@ -21,9 +21,13 @@
 #define RIPPLE_JSON_JSON_VALUE_H_INCLUDED
 
 #include <ripple/json/json_forwards.h>
+#include <boost/container/small_vector.hpp>
+#include <boost/container/static_vector.hpp>
 #include <cstring>
+#include <iterator>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 /** \brief JSON (JavaScript Object Notation).
@@ -191,7 +195,7 @@ private:
     };
 
 public:
-    using ObjectValues = std::map<CZString, Value>;
+    class ObjectValues;
 
 public:
     /** \brief Create a default Value of the given type.
@@ -463,6 +467,225 @@ operator>=(const Value& x, const Value& y)
     return !(x < y);
 }
 
+/** The members of an object or the elements of an array.
+
+    Members are kept in blocks that never move: the first few inside this
+    object, and more in blocks that double in size. This takes one
+    allocation for most of the small objects that responses are made of,
+    rather than one per member, and references to members stay valid as
+    others are added or erased, as they did when members were nodes of a
+    map. The place of an erased member is reused by the next one added.
+
+    The members are listed by key in an index, which is what lookups
+    search and iterators walk. The keys of array elements are their
+    indexes. Members added to a large object out of key order are listed
+    in a second, smaller index until there are enough of them to merge
+    into the first, so that adding one doesn't move the whole index.
+*/
+class Value::ObjectValues
+{
+public:
+    using value_type = std::pair<CZString const, Value>;
+
+    /** A position in the members, in key order. */
+    class iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = ObjectValues::value_type*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type const*;
+        using reference = value_type const&;
+
+        iterator() = default;
+
+        reference
+        operator*() const
+        {
+            return sorted() ? owner_->index_[i_] : owner_->added_[j_];
+        }
+
+        pointer
+        operator->() const
+        {
+            return &**this;
+        }
+
+        iterator&
+        operator++()
+        {
+            if (sorted())
+                ++i_;
+            else
+                ++j_;
+            return *this;
+        }
+
+        iterator
+        operator++(int)
+        {
+            auto const it = *this;
+            ++*this;
+            return it;
+        }
+
+        iterator&
+        operator--();
+
+        iterator
+        operator--(int)
+        {
+            auto const it = *this;
+            --*this;
+            return it;
+        }
+
+        friend bool
+        operator==(iterator const& x, iterator const& y)
+        {
+            return x.i_ == y.i_ && x.j_ == y.j_;
+        }
+
+        friend bool
+        operator!=(iterator const& x, iterator const& y)
+        {
+            return !(x == y);
+        }
+
+        friend difference_type
+        operator-(iterator const& x, iterator const& y)
+        {
+            return difference_type(x.i_ + x.j_) -
+                difference_type(y.i_ + y.j_);
+        }
+
+    private:
+        friend class ObjectValues;
+
+        iterator(ObjectValues const* owner, std::size_t i, std::size_t j)
+            : owner_(owner), i_(i), j_(j)
+        {
+        }
+
+        // Whether the member is in index_, rather than in added_.
+        bool
+        sorted() const;
+
+        ObjectValues const* owner_ = nullptr;
+        std::size_t i_ = 0;
+        std::size_t j_ = 0;
+    };
+
+    using const_iterator = iterator;
+
+    ObjectValues() = default;
+    ObjectValues(ObjectValues const& other);
+    ObjectValues&
+    operator=(ObjectValues const&) = delete;
+
+    std::size_t
+    size() const
+    {
+        return index_.size() + added_.size();
+    }
+
+    bool
+    empty() const
+    {
+        return size() == 0;
+    }
+
+    iterator
+    begin() const
+    {
+        return {this, 0, 0};
+    }
+
+    iterator
+    end() const
+    {
+        return {this, index_.size(), added_.size()};
+    }
+
+    /** The member at a position in key order.
+
+        This takes time in proportion to the position if members were
+        added out of order.
+    */
+    value_type&
+    operator[](std::size_t pos) const;
+
+    /** The member with the greatest key. */
+    value_type&
+    back() const;
+
+    /** The first member whose key is not less than the given one. */
+    iterator
+    lower_bound(CZString const& key) const;
+
+    /** The member with the given key, or end(). */
+    iterator
+    find(CZString const& key) const;
+
+    /** Add a member before the given position in the index. */
+    value_type&
+    insert(iterator pos, CZString const& key);
+
+    void
+    erase(iterator pos);
+
+    void
+    clear();
+
+    friend bool
+    operator==(ObjectValues const& x, ObjectValues const& y);
+
+    friend bool
+    operator<(ObjectValues const& x, ObjectValues const& y);
+
+private:
+    struct Block
+    {
+        std::vector<value_type> values;
+
+        // The values that aren't the places of erased members.
+        std::size_t live = 0;
+    };
+
+    template <class... Args>
+    value_type&
+    emplace(Args&&... args);
+
+    // The block of more_ a member is in, or nullptr if it's in first_.
+    Block*
+    blockOf(value_type const* member);
+
+    // Merge added_ into index_.
+    void
+    merge();
+
+    // Drop the blocks at the end that hold only erased members, once
+    // those outnumber the members.
+    void
+    release();
+
+    static constexpr std::size_t inlineSize = 4;
+
+    // Objects with fewer members keep them all in index_.
+    static constexpr std::size_t smallSize = 32;
+
+    boost::container::static_vector<value_type, inlineSize> first_;
+    std::vector<Block> more_;
+
+    // The places of erased members, to reuse.
+    std::vector<value_type*> free_;
+
+    // The members, sorted by key. Members added out of order to a large
+    // object are in added_, also sorted, until they are merged.
+    boost::container::small_vector<value_type*, inlineSize> index_;
+    std::vector<value_type*> added_;
+};
+
 /** \brief Experimental do not use: Allocator to customize member name and
  * string value memory management done by Value.
  *
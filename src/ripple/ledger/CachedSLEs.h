@@ -20,12 +20,152 @@
 #ifndef RIPPLE_LEDGER_CACHEDSLES_H_INCLUDED
 #define RIPPLE_LEDGER_CACHEDSLES_H_INCLUDED
 
-#include <ripple/basics/TaggedCache.h>
 #include <ripple/basics/base_uint.h>
+#include <ripple/basics/hardened_hash.h>
+#include <ripple/beast/clock/abstract_clock.h>
 #include <ripple/protocol/STLedgerEntry.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 namespace ripple {
-using CachedSLEs = TaggedCache<uint256, SLE const>;
+
+/** A cache of ledger entries, keyed by the digest of their contents.
+
+    Entries with the same digest are identical, so one cache is shared by
+    every ledger and view. It is read far more often than it is written,
+    and concurrently by path finding, RPC and the open ledger. To keep
+    those threads from serializing on it, the cache is split into shards
+    that each have their own reader-writer lock: a hit only takes its
+    shard's lock in shared mode, and threads reading different entries
+    rarely use the same lock at all.
+
+    Entries that haven't been fetched for the expiration time are removed
+    by sweep.
+*/
+class CachedSLEs
+{
+public:
+    using clock_type = beast::abstract_clock<std::chrono::steady_clock>;
+
+    CachedSLEs(clock_type::duration expiration, clock_type& clock);
+
+    CachedSLEs(CachedSLEs const&) = delete;
+    CachedSLEs&
+    operator=(CachedSLEs const&) = delete;
+
+    /** Fetch an entry from the cache.
+
+        If the digest was not found, Handler will be called with this
+        signature:
+            std::shared_ptr<SLE const>(void)
+        and what it returns, if anything, is added to the cache.
+    */
+    template <class Handler>
+    std::shared_ptr<SLE const>
+    fetch(uint256 const& digest, Handler const& h);
+
+    /** Returns the fraction of cache hits. */
+    double
+    rate() const;
+
+    /** Returns the number of entries in the cache. */
+    std::size_t
+    size() const;
+
+    /** Remove the entries that expired. */
+    void
+    sweep();
+
+private:
+    static constexpr std::size_t shardCount = 16;
+
+    struct Entry
+    {
+        std::shared_ptr<SLE const> sle;
+
+        // When the entry was last fetched. Updated by readers, which only
+        // hold the shard's lock in shared mode.
+        std::atomic<clock_type::rep> lastAccess;
+
+        Entry(std::shared_ptr<SLE const> sle_, clock_type::rep now)
+            : sle(std::move(sle_)), lastAccess(now)
+        {
+        }
+    };
+
+    // Each shard gets its own cache lines, so that a thread taking one
+    // shard's lock doesn't slow down the threads using the others.
+    struct alignas(64) Shard
+    {
+        std::shared_mutex mutable mutex;
+        std::unordered_map<uint256, Entry, hardened_hash<>> map;
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+    };
+
+    Shard&
+    shardFor(uint256 const& digest)
+    {
+        // The digest is a hash, so any of its bytes will do.
+        return shards_[*digest.begin() % shardCount];
+    }
+
+    clock_type::rep
+    now() const
+    {
+        return clock_.now().time_since_epoch().count();
+    }
+
+    void
+    touch(Entry& entry, clock_type::rep now)
+    {
+        // Only write when the time changed noticeably, so that threads
+        // reading a popular entry don't keep invalidating each other's
+        // copy of it.
+        auto const last = entry.lastAccess.load(std::memory_order_relaxed);
+        if (now - last > touchResolution_)
+            entry.lastAccess.store(now, std::memory_order_relaxed);
+    }
+
+    clock_type& clock_;
+    clock_type::rep const expiration_;
+    clock_type::rep const touchResolution_;
+    std::array<Shard, shardCount> shards_;
+};
+
+template <class Handler>
+std::shared_ptr<SLE const>
+CachedSLEs::fetch(uint256 const& digest, Handler const& h)
+{
+    auto& shard = shardFor(digest);
+    {
+        std::shared_lock lock(shard.mutex);
+        if (auto const it = shard.map.find(digest); it != shard.map.end())
+        {
+            shard.hits.fetch_add(1, std::memory_order_relaxed);
+            touch(it->second, now());
+            return it->second.sle;
+        }
+    }
+
+    std::shared_ptr<SLE const> sle = h();
+    if (!sle)
+        return {};
+
+    std::unique_lock lock(shard.mutex);
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+    auto const [it, inserted] =
+        shard.map.try_emplace(digest, std::move(sle), now());
+    if (!inserted)
+        touch(it->second, now());
+    return it->second.sle;
 }
 
+}  // namespace ripple
+
 #endif  // RIPPLE_LEDGER_CACHEDSLES_H_INCLUDED
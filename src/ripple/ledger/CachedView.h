@@ -23,10 +23,12 @@
 #include <ripple/basics/hardened_hash.h>
 #include <ripple/ledger/CachedSLEs.h>
 #include <ripple/ledger/ReadView.h>
-#include <map>
+#include <array>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <type_traits>
+#include <unordered_map>
 
 namespace ripple {
 
@@ -37,11 +39,24 @@ class CachedViewImpl : public DigestAwareReadView
 private:
     DigestAwareReadView const& base_;
     CachedSLEs& cache_;
-    std::mutex mutable mutex_;
-    std::unordered_map<
-        key_type,
-        std::shared_ptr<SLE const>,
-        hardened_hash<>> mutable map_;
+
+    // The entries read through this view. Many threads read the same
+    // view, so the entries are split into shards with a reader-writer
+    // lock each: readers rarely use the same lock, and once an entry is
+    // in the map, reading it only takes the lock in shared mode.
+    static constexpr std::size_t shardCount = 16;
+
+    struct alignas(64) Shard
+    {
+        std::shared_mutex mutex;
+        std::unordered_map<
+            key_type,
+            std::shared_ptr<SLE const>,
+            hardened_hash<>>
+            map;
+    };
+
+    std::array<Shard, shardCount> mutable shards_;
 
 public:
     CachedViewImpl() = delete;
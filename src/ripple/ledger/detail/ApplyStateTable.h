@@ -20,6 +20,7 @@
 #ifndef RIPPLE_LEDGER_APPLYSTATETABLE_H_INCLUDED
 #define RIPPLE_LEDGER_APPLYSTATETABLE_H_INCLUDED
 
+#include <ripple/basics/ByteUtilities.h>
 #include <ripple/basics/XRPAmount.h>
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/ledger/OpenView.h>
@@ -27,6 +28,8 @@
 #include <ripple/ledger/ReadView.h>
 #include <ripple/protocol/TER.h>
 #include <ripple/protocol/TxMeta.h>
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
 #include <memory>
 
 namespace ripple {
@@ -46,13 +49,36 @@ private:
         modify,
     };
 
-    using items_t = std::map<key_type, std::pair<Action, std::shared_ptr<SLE>>>;
-
+    // Like RawStateTable, allocate the table's nodes from a buffer that is
+    // released in one go when the transaction is done with it.
+    using item_t = std::pair<Action, std::shared_ptr<SLE>>;
+    using items_t = std::map<
+        key_type,
+        item_t,
+        std::less<key_type>,
+        boost::container::pmr::polymorphic_allocator<
+            std::pair<const key_type, item_t>>>;
+
+    // monotonic_resource_ must outlive `items_`. Make a pointer so it may be
+    // easily moved.
+    std::unique_ptr<boost::container::pmr::monotonic_buffer_resource>
+        monotonic_resource_;
     items_t items_;
     XRPAmount dropsDestroyed_{0};
 
 public:
-    ApplyStateTable() = default;
+    // Initial size of the buffer, enough for the entries touched by all
+    // but the largest transactions.
+    static constexpr size_t initialBufferSize = kilobytes(4);
+
+    ApplyStateTable()
+        : monotonic_resource_{std::make_unique<
+              boost::container::pmr::monotonic_buffer_resource>(
+              initialBufferSize)}
+        , items_{monotonic_resource_.get()}
+    {
+    }
+
     ApplyStateTable(ApplyStateTable&&) = default;
 
     ApplyStateTable(ApplyStateTable const&) = delete;
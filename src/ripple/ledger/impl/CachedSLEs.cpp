@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/ledger/CachedSLEs.h>
+#include <vector>
+
+namespace ripple {
+
+CachedSLEs::CachedSLEs(clock_type::duration expiration, clock_type& clock)
+    : clock_(clock)
+    , expiration_(expiration.count())
+    // Recording the access time to within a sixteenth of the expiration
+    // is plenty to tell what expired.
+    , touchResolution_(expiration.count() / 16)
+{
+}
+
+double
+CachedSLEs::rate() const
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    for (auto const& shard : shards_)
+    {
+        hits += shard.hits.load(std::memory_order_relaxed);
+        misses += shard.misses.load(std::memory_order_relaxed);
+    }
+
+    auto const tot = hits + misses;
+    if (tot == 0)
+        return 0;
+    return double(hits) / tot;
+}
+
+std::size_t
+CachedSLEs::size() const
+{
+    std::size_t n = 0;
+    for (auto const& shard : shards_)
+    {
+        std::shared_lock lock(shard.mutex);
+        n += shard.map.size();
+    }
+    return n;
+}
+
+void
+CachedSLEs::sweep()
+{
+    auto const expired = now() - expiration_;
+
+    // Release the entries after unlocking, so that the shard isn't held
+    // while they're destroyed.
+    std::vector<std::shared_ptr<SLE const>> stale;
+
+    for (auto& shard : shards_)
+    {
+        {
+            std::unique_lock lock(shard.mutex);
+            for (auto it = shard.map.begin(); it != shard.map.end();)
+            {
+                if (it->second.lastAccess.load(std::memory_order_relaxed) <=
+                    expired)
+                {
+                    stale.push_back(std::move(it->second.sle));
+                    it = shard.map.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+        stale.clear();
+    }
+}
+
+}  // namespace ripple
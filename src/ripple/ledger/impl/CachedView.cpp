@@ -33,10 +33,12 @@ CachedViewImpl::exists(Keylet const& k) const
 std::shared_ptr<SLE const>
 CachedViewImpl::read(Keylet const& k) const
 {
+    // Keys are hashes, so any of their bytes will do to pick a shard.
+    auto& shard = shards_[*k.key.begin() % shardCount];
     {
-        std::lock_guard lock(mutex_);
-        auto const iter = map_.find(k.key);
-        if (iter != map_.end())
+        std::shared_lock lock(shard.mutex);
+        auto const iter = shard.map.find(k.key);
+        if (iter != shard.map.end())
         {
             if (!iter->second || !k.check(*iter->second))
                 return nullptr;
@@ -47,15 +49,15 @@ CachedViewImpl::read(Keylet const& k) const
     if (!digest)
         return nullptr;
     auto sle = cache_.fetch(*digest, [&]() { return base_.read(k); });
-    std::lock_guard lock(mutex_);
-    auto const er = map_.emplace(k.key, sle);
+    std::lock_guard lock(shard.mutex);
+    auto const er = shard.map.emplace(k.key, sle);
     auto const& iter = er.first;
     bool const inserted = er.second;
     if (iter->second && !k.check(*iter->second))
     {
         if (!inserted)
         {
-            // On entry, this function did not find this key in map_. Now
+            // On entry, this function did not find this key in the map. Now
             // something (another thread?) has inserted the sle into the map and
             // it has the wrong type.
             LogicError("CachedView::read: wrong type");
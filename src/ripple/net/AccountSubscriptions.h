@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NET_ACCOUNTSUBSCRIPTIONS_H_INCLUDED
+#define RIPPLE_NET_ACCOUNTSUBSCRIPTIONS_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/net/InfoSub.h>
+#include <ripple/protocol/AccountID.h>
+#include <boost/container/small_vector.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace ripple {
+
+/** Which subscribers follow which accounts.
+
+    Most subscribers follow a few accounts, and are indexed by account. A
+    subscriber may also follow hundreds of thousands of them, the way a
+    wallet service does. Past compactThreshold accounts, a subscriber's
+    accounts are taken out of the shared index and kept in a sorted array of
+    its own, with a Bloom filter in front that rules out nearly every
+    account it doesn't follow before the array is searched. That costs about
+    24 bytes an account rather than a hash table node or two.
+
+    The index isn't synchronized: the caller serializes access to it.
+*/
+class AccountSubscriptions
+{
+public:
+    /** The accounts past which a subscriber gets an array of its own. */
+    static constexpr std::size_t compactThreshold = 256;
+
+    AccountSubscriptions() = default;
+
+    AccountSubscriptions(AccountSubscriptions const&) = delete;
+    AccountSubscriptions&
+    operator=(AccountSubscriptions const&) = delete;
+
+    /** Follow accounts.
+
+        @return The number of accounts that weren't already followed.
+    */
+    std::size_t
+    insert(InfoSub::ref sub, std::vector<AccountID> accounts);
+
+    /** Stop following accounts.
+
+        @return The number of accounts that were followed.
+    */
+    std::size_t
+    erase(std::uint64_t seq, std::vector<AccountID> accounts);
+
+    /** Stop following every account. */
+    void
+    erase(std::uint64_t seq);
+
+    /** Add the subscribers that follow an account to a set.
+
+        Subscribers that have gone away are skipped.
+
+        @return The number of subscribers that follow the account.
+    */
+    std::size_t
+    find(AccountID const& account, hash_set<InfoSub::pointer>& notify) const;
+
+    bool
+    empty() const
+    {
+        return subscribers_.empty();
+    }
+
+    /** The number of accounts followed, counted once per subscriber. */
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /** The number of subscribers with an array of their own. */
+    std::size_t
+    compactSubscribers() const
+    {
+        return compact_.size();
+    }
+
+private:
+    // A Bloom filter over a subscriber's accounts. Account IDs are hashes
+    // already, so their bits are used as they are.
+    class Filter
+    {
+    public:
+        explicit Filter(std::vector<AccountID> const& accounts);
+
+        void
+        insert(AccountID const& account);
+
+        bool
+        mayContain(AccountID const& account) const;
+
+        // The accounts it was sized for.
+        std::size_t
+        capacity() const
+        {
+            return capacity_;
+        }
+
+    private:
+        std::size_t capacity_;
+        std::vector<std::uint64_t> bits_;
+    };
+
+    struct Subscriber
+    {
+        InfoSub::wptr sub;
+
+        // Sorted.
+        std::vector<AccountID> accounts;
+
+        // Set while the accounts are kept out of byAccount_.
+        std::optional<Filter> filter;
+    };
+
+    void
+    expand(std::uint64_t seq, Subscriber& s);
+
+    void
+    unindex(std::uint64_t seq, AccountID const& account);
+
+    hash_map<std::uint64_t, Subscriber> subscribers_;
+
+    // Who follows an account, of the subscribers without a filter.
+    hash_map<AccountID, boost::container::small_vector<std::uint64_t, 1>>
+        byAccount_;
+
+    // The subscribers with a filter. Entries of subscribers_ don't move.
+    std::vector<Subscriber const*> compact_;
+
+    std::size_t size_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
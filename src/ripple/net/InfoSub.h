@@ -26,7 +26,9 @@
 #include <ripple/protocol/Book.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/resource/Consumer.h>
+#include <memory>
 #include <mutex>
+#include <string>
 
 namespace ripple {
 
@@ -46,6 +48,37 @@ public:
     doStatus(Json::Value const&) = 0;
 };
 
+/** A JSON message published to subscribers.
+
+    The same message is often sent to many subscribers. Those that send it
+    as text share one rendering of it, made when the first of them asks
+    for it, rather than each rendering their own. The rendering is made
+    without locking, so a message is published from one thread at a time.
+*/
+class PublishedJson
+{
+public:
+    explicit PublishedJson(Json::Value jv);
+
+    PublishedJson(PublishedJson const&) = delete;
+    PublishedJson&
+    operator=(PublishedJson const&) = delete;
+
+    Json::Value const&
+    json() const
+    {
+        return jv_;
+    }
+
+    /** The message as compact JSON text. */
+    std::shared_ptr<std::string const> const&
+    text() const;
+
+private:
+    Json::Value const jv_;
+    std::shared_ptr<std::string const> mutable text_;
+};
+
 /** Manages a client's subscription to data feeds.
  */
 class InfoSub : public CountedObject<InfoSub>
@@ -87,12 +120,9 @@ public:
             bool realTime) = 0;
 
         // for use during InfoSub destruction
-        // Removes only from the server
+        // Removes every account the listener follows
         virtual void
-        unsubAccountInternal(
-            std::uint64_t uListener,
-            hash_set<AccountID> const& vnaAccountIDs,
-            bool realTime) = 0;
+        unsubAccountInternal(std::uint64_t uListener, bool realTime) = 0;
 
         /**
          * subscribe an account's new transactions and retrieve the account's
@@ -201,18 +231,16 @@ public:
     virtual void
     send(Json::Value const& jvObj, bool broadcast) = 0;
 
+    /** Send a message that is published to many subscribers. */
+    virtual void
+    send(PublishedJson const& msg, bool broadcast);
+
     std::uint64_t
     getSeq();
 
     void
     onSendEmpty();
 
-    void
-    insertSubAccountInfo(AccountID const& account, bool rt);
-
-    void
-    deleteSubAccountInfo(AccountID const& account, bool rt);
-
     // return false if already subscribed to this account
     bool
     insertSubAccountHistory(AccountID const& account);
@@ -235,8 +263,6 @@ protected:
 private:
     Consumer m_consumer;
     Source& m_source;
-    hash_set<AccountID> realTimeSubscriptions_;
-    hash_set<AccountID> normalSubscriptions_;
     std::shared_ptr<InfoSubRequest> request_;
     std::uint64_t mSeq;
     hash_set<AccountID> accountHistorySubscriptions_;
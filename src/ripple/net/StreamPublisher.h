@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NET_STREAMPUBLISHER_H_INCLUDED
+#define RIPPLE_NET_STREAMPUBLISHER_H_INCLUDED
+
+#include <ripple/basics/Log.h>
+#include <ripple/beast/insight/Event.h>
+#include <ripple/net/InfoSub.h>
+#include <ripple/net/SubscriberList.h>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace ripple {
+
+class JobQueue;
+
+/** Sends published messages to their subscribers.
+
+    Sending a message to every subscriber of a busy stream takes a while,
+    and the code that publishes it is often holding locks others need. The
+    publisher takes the sending off that thread: a message is queued with a
+    snapshot of its subscribers, and one job at a time sends the queued
+    messages in the order they were published. Whatever streams a client
+    subscribes to, it is sent their messages in that order.
+
+    If the messages are published faster than they can be sent, the queue
+    is kept to a limit by dropping the oldest of them, as a port whose
+    send_queue_policy is "drop" does for each of its clients.
+*/
+class StreamPublisher
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    /** The number of messages queued by default before the oldest are
+        dropped. */
+    static constexpr std::size_t defaultLimit = 10000;
+
+    StreamPublisher(
+        JobQueue& jobQueue,
+        beast::Journal journal,
+        std::size_t limit = defaultLimit);
+
+    StreamPublisher(StreamPublisher const&) = delete;
+    StreamPublisher&
+    operator=(StreamPublisher const&) = delete;
+
+    /** Queue a message to be sent to subscribers.
+
+        The message is rendered before this returns, so the caller can go on
+        sending it to others itself.
+
+        @param subscribers Who to send the message to.
+        @param msg The message.
+        @param latency Told how long it took from now until the message was
+                       handed to the last of the subscribers.
+    */
+    void
+    publish(
+        SubscriberList::Snapshot subscribers,
+        std::shared_ptr<PublishedJson const> msg,
+        beast::insight::Event latency);
+
+    /** The number of messages waiting to be sent. */
+    std::size_t
+    size() const;
+
+    /** The number of messages that were dropped rather than sent. */
+    std::uint64_t
+    dropped() const;
+
+private:
+    struct Item
+    {
+        SubscriberList::Snapshot subscribers;
+        std::shared_ptr<PublishedJson const> msg;
+        beast::insight::Event latency;
+        clock_type::time_point published;
+    };
+
+    void
+    send();
+
+    JobQueue& jobQueue_;
+    beast::Journal const j_;
+    std::size_t const limit_;
+
+    std::mutex mutable mutex_;
+    std::deque<Item> queue_;
+    bool sending_ = false;
+    std::uint64_t dropped_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NET_SUBSCRIBERLIST_H_INCLUDED
+#define RIPPLE_NET_SUBSCRIBERLIST_H_INCLUDED
+
+#include <ripple/net/InfoSub.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+/** The subscribers to one stream.
+
+    A message is sent to a snapshot of the list, taken without waiting on
+    anything but the pointer swap, so no lock is held while it's sent.
+    Subscribing and unsubscribing, which are rare next to publishing, copy
+    the list rather than change it in place, and a snapshot stays as it was
+    taken.
+*/
+class SubscriberList
+{
+public:
+    struct Subscriber
+    {
+        std::uint64_t seq;
+        InfoSub::wptr sub;
+    };
+
+    /** The subscribers at some moment, ordered by sequence. */
+    using Snapshot = std::shared_ptr<std::vector<Subscriber> const>;
+
+    SubscriberList();
+
+    SubscriberList(SubscriberList const&) = delete;
+    SubscriberList&
+    operator=(SubscriberList const&) = delete;
+
+    /** Add a subscriber.
+
+        @return `false` if it was already subscribed.
+    */
+    bool
+    insert(InfoSub::ref sub);
+
+    /** Remove a subscriber.
+
+        @return `false` if it wasn't subscribed.
+    */
+    bool
+    erase(std::uint64_t seq);
+
+    bool
+    contains(std::uint64_t seq) const;
+
+    Snapshot
+    snapshot() const;
+
+    bool
+    empty() const
+    {
+        return snapshot()->empty();
+    }
+
+private:
+    // Changes are made one at a time, to a copy. mutex_ guards only the
+    // pointer, so a snapshot never waits for a copy to be made.
+    std::mutex writeMutex_;
+    std::mutex mutable mutex_;
+    Snapshot list_;
+};
+
+}  // namespace ripple
+
+#endif
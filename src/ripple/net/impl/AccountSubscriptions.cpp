@@ -0,0 +1,266 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/net/AccountSubscriptions.h>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace ripple {
+
+namespace {
+
+// With these, about one account in a thousand that a subscriber doesn't
+// follow gets past a full filter.
+constexpr std::size_t bitsPerAccount = 16;
+constexpr std::uint64_t hashes = 6;
+
+void
+sortUnique(std::vector<AccountID>& accounts)
+{
+    std::sort(accounts.begin(), accounts.end());
+    accounts.erase(
+        std::unique(accounts.begin(), accounts.end()), accounts.end());
+}
+
+template <class F>
+void
+forEachBit(AccountID const& account, std::size_t bits, F&& f)
+{
+    static_assert(AccountID::bytes >= 16);
+    std::uint64_t h1;
+    std::uint64_t h2;
+    std::memcpy(&h1, account.data(), sizeof(h1));
+    std::memcpy(&h2, account.data() + sizeof(h1), sizeof(h2));
+    h2 |= 1;
+    for (std::uint64_t i = 0; i < hashes; ++i)
+        f((h1 + i * h2) % bits);
+}
+
+}  // namespace
+
+AccountSubscriptions::Filter::Filter(std::vector<AccountID> const& accounts)
+    : capacity_(std::max(2 * accounts.size(), compactThreshold))
+    , bits_((capacity_ * bitsPerAccount + 63) / 64)
+{
+    for (auto const& account : accounts)
+        insert(account);
+}
+
+void
+AccountSubscriptions::Filter::insert(AccountID const& account)
+{
+    forEachBit(account, bits_.size() * 64, [this](std::size_t bit) {
+        bits_[bit / 64] |= std::uint64_t(1) << (bit % 64);
+    });
+}
+
+bool
+AccountSubscriptions::Filter::mayContain(AccountID const& account) const
+{
+    bool found = true;
+    forEachBit(account, bits_.size() * 64, [&](std::size_t bit) {
+        found = found && (bits_[bit / 64] >> (bit % 64)) & 1;
+    });
+    return found;
+}
+
+//------------------------------------------------------------------------------
+
+std::size_t
+AccountSubscriptions::insert(InfoSub::ref sub, std::vector<AccountID> accounts)
+{
+    sortUnique(accounts);
+    auto const seq = sub->getSeq();
+    auto& s = subscribers_[seq];
+    s.sub = sub;
+
+    std::vector<AccountID> added;
+    std::set_difference(
+        accounts.begin(),
+        accounts.end(),
+        s.accounts.begin(),
+        s.accounts.end(),
+        std::back_inserter(added));
+    if (added.empty())
+    {
+        if (s.accounts.empty())
+            subscribers_.erase(seq);
+        return 0;
+    }
+
+    std::vector<AccountID> merged;
+    merged.reserve(s.accounts.size() + added.size());
+    std::merge(
+        s.accounts.begin(),
+        s.accounts.end(),
+        added.begin(),
+        added.end(),
+        std::back_inserter(merged));
+    size_ += added.size();
+
+    if (s.filter)
+    {
+        s.accounts = std::move(merged);
+        if (s.accounts.size() > s.filter->capacity())
+            s.filter.emplace(s.accounts);
+        else
+        {
+            for (auto const& account : added)
+                s.filter->insert(account);
+        }
+    }
+    else if (merged.size() > compactThreshold)
+    {
+        // Only the accounts followed before are in the shared index.
+        for (auto const& account : s.accounts)
+            unindex(seq, account);
+        s.accounts = std::move(merged);
+        s.filter.emplace(s.accounts);
+        compact_.push_back(&s);
+    }
+    else
+    {
+        s.accounts = std::move(merged);
+        for (auto const& account : added)
+            byAccount_[account].push_back(seq);
+    }
+    return added.size();
+}
+
+std::size_t
+AccountSubscriptions::erase(std::uint64_t seq, std::vector<AccountID> accounts)
+{
+    auto const it = subscribers_.find(seq);
+    if (it == subscribers_.end())
+        return 0;
+    auto& s = it->second;
+
+    sortUnique(accounts);
+    std::vector<AccountID> kept;
+    kept.reserve(s.accounts.size());
+    std::set_difference(
+        s.accounts.begin(),
+        s.accounts.end(),
+        accounts.begin(),
+        accounts.end(),
+        std::back_inserter(kept));
+    auto const removed = s.accounts.size() - kept.size();
+    if (removed == 0)
+        return 0;
+
+    if (!s.filter)
+    {
+        for (auto const& account : accounts)
+        {
+            if (std::binary_search(
+                    s.accounts.begin(), s.accounts.end(), account))
+                unindex(seq, account);
+        }
+    }
+    s.accounts = std::move(kept);
+    size_ -= removed;
+
+    if (s.accounts.empty())
+    {
+        if (s.filter)
+            std::erase(compact_, &s);
+        subscribers_.erase(it);
+    }
+    else if (s.filter)
+    {
+        // Removed accounts stay in the filter until it's rebuilt.
+        if (s.accounts.size() <= compactThreshold / 2)
+            expand(seq, s);
+        else if (s.accounts.size() < s.filter->capacity() / 4)
+            s.filter.emplace(s.accounts);
+    }
+    return removed;
+}
+
+void
+AccountSubscriptions::erase(std::uint64_t seq)
+{
+    auto const it = subscribers_.find(seq);
+    if (it == subscribers_.end())
+        return;
+    auto& s = it->second;
+
+    if (s.filter)
+        std::erase(compact_, &s);
+    else
+    {
+        for (auto const& account : s.accounts)
+            unindex(seq, account);
+    }
+    size_ -= s.accounts.size();
+    subscribers_.erase(it);
+}
+
+std::size_t
+AccountSubscriptions::find(
+    AccountID const& account,
+    hash_set<InfoSub::pointer>& notify) const
+{
+    std::size_t found = 0;
+    auto const add = [&](Subscriber const& s) {
+        if (auto p = s.sub.lock())
+        {
+            notify.insert(std::move(p));
+            ++found;
+        }
+    };
+
+    if (auto const it = byAccount_.find(account); it != byAccount_.end())
+    {
+        for (auto const seq : it->second)
+            add(subscribers_.at(seq));
+    }
+
+    for (auto const s : compact_)
+    {
+        if (s->filter->mayContain(account) &&
+            std::binary_search(s->accounts.begin(), s->accounts.end(), account))
+            add(*s);
+    }
+    return found;
+}
+
+void
+AccountSubscriptions::expand(std::uint64_t seq, Subscriber& s)
+{
+    std::erase(compact_, &s);
+    s.filter.reset();
+    for (auto const& account : s.accounts)
+        byAccount_[account].push_back(seq);
+}
+
+void
+AccountSubscriptions::unindex(std::uint64_t seq, AccountID const& account)
+{
+    auto const it = byAccount_.find(account);
+    if (it == byAccount_.end())
+        return;
+    auto& seqs = it->second;
+    seqs.erase(std::remove(seqs.begin(), seqs.end(), seq), seqs.end());
+    if (seqs.empty())
+        byAccount_.erase(it);
+}
+
+}  // namespace ripple
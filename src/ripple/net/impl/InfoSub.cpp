@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/json/json_writer.h>
 #include <ripple/net/InfoSub.h>
 #include <atomic>
 
@@ -33,6 +34,26 @@ namespace ripple {
 // code assumes this node is synched (and will continue to do so until
 // there's a functional network.
 
+PublishedJson::PublishedJson(Json::Value jv) : jv_(std::move(jv))
+{
+}
+
+std::shared_ptr<std::string const> const&
+PublishedJson::text() const
+{
+    if (!text_)
+    {
+        std::string text;
+        Json::stream(jv_, [&text](void const* data, std::size_t n) {
+            text.append(static_cast<char const*>(data), n);
+        });
+        text_ = std::make_shared<std::string const>(std::move(text));
+    }
+    return text_;
+}
+
+//------------------------------------------------------------------------------
+
 InfoSub::InfoSub(Source& source) : m_source(source), mSeq(assign_id())
 {
 }
@@ -53,18 +74,19 @@ InfoSub::~InfoSub()
     m_source.unsubPeerStatus(mSeq);
     m_source.unsubConsensus(mSeq);
 
-    // Use the internal unsubscribe so that it won't call
-    // back to us and modify its own parameter
-    if (!realTimeSubscriptions_.empty())
-        m_source.unsubAccountInternal(mSeq, realTimeSubscriptions_, true);
-
-    if (!normalSubscriptions_.empty())
-        m_source.unsubAccountInternal(mSeq, normalSubscriptions_, false);
+    m_source.unsubAccountInternal(mSeq, true);
+    m_source.unsubAccountInternal(mSeq, false);
 
     for (auto const& account : accountHistorySubscriptions_)
         m_source.unsubAccountHistoryInternal(mSeq, account, false);
 }
 
+void
+InfoSub::send(PublishedJson const& msg, bool broadcast)
+{
+    send(msg.json(), broadcast);
+}
+
 Resource::Consumer&
 InfoSub::getConsumer()
 {
@@ -82,28 +104,6 @@ InfoSub::onSendEmpty()
 {
 }
 
-void
-InfoSub::insertSubAccountInfo(AccountID const& account, bool rt)
-{
-    std::lock_guard sl(mLock);
-
-    if (rt)
-        realTimeSubscriptions_.insert(account);
-    else
-        normalSubscriptions_.insert(account);
-}
-
-void
-InfoSub::deleteSubAccountInfo(AccountID const& account, bool rt)
-{
-    std::lock_guard sl(mLock);
-
-    if (rt)
-        realTimeSubscriptions_.erase(account);
-    else
-        normalSubscriptions_.erase(account);
-}
-
 bool
 InfoSub::insertSubAccountHistory(AccountID const& account)
 {
@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/core/JobQueue.h>
+#include <ripple/net/StreamPublisher.h>
+#include <cassert>
+
+namespace ripple {
+
+StreamPublisher::StreamPublisher(
+    JobQueue& jobQueue,
+    beast::Journal journal,
+    std::size_t limit)
+    : jobQueue_(jobQueue), j_(journal), limit_(limit)
+{
+    assert(limit_ > 0);
+}
+
+void
+StreamPublisher::publish(
+    SubscriberList::Snapshot subscribers,
+    std::shared_ptr<PublishedJson const> msg,
+    beast::insight::Event latency)
+{
+    if (subscribers->empty())
+        return;
+
+    // Rendered here, since the text isn't guarded and the caller may need
+    // it while the message is being sent.
+    msg->text();
+
+    std::lock_guard lock(mutex_);
+    if (queue_.size() >= limit_)
+    {
+        // The subscribers are too slow to keep up: drop the oldest
+        // message rather than let the queue grow without bound.
+        queue_.pop_front();
+        if (dropped_++ == 0)
+            JLOG(j_.warn()) << "Dropping messages: subscribers are too slow.";
+    }
+    queue_.push_back(
+        {std::move(subscribers),
+         std::move(msg),
+         std::move(latency),
+         clock_type::now()});
+    if (sending_)
+        return;
+
+    sending_ = true;
+    if (!jobQueue_.addJob(jtCLIENT_PUBLISH, "StreamPublisher", [this]() {
+            send();
+        }))
+    {
+        // Shutting down: the subscribers are going away too.
+        queue_.clear();
+        sending_ = false;
+    }
+}
+
+std::size_t
+StreamPublisher::size() const
+{
+    std::lock_guard lock(mutex_);
+    return queue_.size();
+}
+
+std::uint64_t
+StreamPublisher::dropped() const
+{
+    std::lock_guard lock(mutex_);
+    return dropped_;
+}
+
+void
+StreamPublisher::send()
+{
+    for (;;)
+    {
+        Item item;
+        {
+            std::lock_guard lock(mutex_);
+            if (queue_.empty())
+            {
+                sending_ = false;
+                return;
+            }
+            item = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        std::size_t sent = 0;
+        for (auto const& subscriber : *item.subscribers)
+        {
+            if (auto p = subscriber.sub.lock())
+            {
+                p->send(*item.msg, true);
+                ++sent;
+            }
+        }
+
+        auto const elapsed = clock_type::now() - item.published;
+        item.latency.notify(elapsed);
+        JLOG(j_.trace())
+            << "Sent to " << sent << " subscribers in "
+            << std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+                   .count()
+            << "us";
+    }
+}
+
+}  // namespace ripple
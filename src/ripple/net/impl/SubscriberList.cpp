@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/net/SubscriberList.h>
+#include <algorithm>
+
+namespace ripple {
+
+namespace {
+
+struct BySeq
+{
+    bool
+    operator()(SubscriberList::Subscriber const& s, std::uint64_t seq) const
+    {
+        return s.seq < seq;
+    }
+};
+
+}  // namespace
+
+SubscriberList::SubscriberList()
+    : list_(std::make_shared<std::vector<Subscriber> const>())
+{
+}
+
+bool
+SubscriberList::insert(InfoSub::ref sub)
+{
+    std::lock_guard writeLock(writeMutex_);
+    auto const seq = sub->getSeq();
+    auto const current = snapshot();
+    auto const& list = *current;
+    auto const it = std::lower_bound(list.begin(), list.end(), seq, BySeq{});
+    if (it != list.end() && it->seq == seq)
+        return false;
+
+    auto next = std::make_shared<std::vector<Subscriber>>();
+    next->reserve(list.size() + 1);
+    next->insert(next->end(), list.begin(), it);
+    next->push_back({seq, sub});
+    next->insert(next->end(), it, list.end());
+
+    std::lock_guard lock(mutex_);
+    list_ = std::move(next);
+    return true;
+}
+
+bool
+SubscriberList::erase(std::uint64_t seq)
+{
+    std::lock_guard writeLock(writeMutex_);
+    auto const current = snapshot();
+    auto const& list = *current;
+    auto const it = std::lower_bound(list.begin(), list.end(), seq, BySeq{});
+    if (it == list.end() || it->seq != seq)
+        return false;
+
+    auto next = std::make_shared<std::vector<Subscriber>>();
+    next->reserve(list.size() - 1);
+    next->insert(next->end(), list.begin(), it);
+    next->insert(next->end(), std::next(it), list.end());
+
+    std::lock_guard lock(mutex_);
+    list_ = std::move(next);
+    return true;
+}
+
+bool
+SubscriberList::contains(std::uint64_t seq) const
+{
+    auto const list = snapshot();
+    auto const it = std::lower_bound(list->begin(), list->end(), seq, BySeq{});
+    return it != list->end() && it->seq == seq;
+}
+
+SubscriberList::Snapshot
+SubscriberList::snapshot() const
+{
+    std::lock_guard lock(mutex_);
+    return list_;
+}
+
+}  // namespace ripple
@@ -161,11 +161,28 @@ PerfLogImp::Counters::countersJson() const
         jqobj[jss::total] = totalJqJson;
     }
 
+    Json::Value applyobj(Json::objectValue);
+    {
+        Apply value;
+        {
+            std::lock_guard lock(apply_.mutex);
+            value = apply_.value;
+        }
+        if (value.applied)
+        {
+            applyobj[jss::applied] = std::to_string(value.applied);
+            applyobj[jss::spills] = std::to_string(value.spills);
+            applyobj[jss::max_spills] = std::to_string(value.maxSpills);
+        }
+    }
+
     Json::Value counters(Json::objectValue);
     // Be kind to reporting tools and let them expect rpc and jq objects
     // even if empty.
     counters[jss::rpc] = rpcobj;
     counters[jss::job_queue] = jqobj;
+    if (applyobj.size())
+        counters[jss::apply] = applyobj;
     return counters;
 }
 
@@ -433,6 +450,16 @@ PerfLogImp::jobFinish(JobType const type, microseconds dur, int instance)
         counters_.jobs_[instance] = {jtINVALID, steady_time_point()};
 }
 
+void
+PerfLogImp::txApply(std::uint64_t spills)
+{
+    std::lock_guard lock(counters_.apply_.mutex);
+    auto& value = counters_.apply_.value;
+    ++value.applied;
+    value.spills += spills;
+    value.maxSpills = std::max(value.maxSpills, spills);
+}
+
 void
 PerfLogImp::resizeJobs(int const resize)
 {
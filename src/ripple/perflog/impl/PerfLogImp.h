@@ -104,10 +104,23 @@ class PerfLogImp : public PerfLog
             microseconds runningDuration{0};
         };
 
+        /**
+         * Transaction apply counters.
+         */
+        struct Apply
+        {
+            std::uint64_t applied{0};
+            // Serialized objects spilled to the heap while applying, in
+            // total and by the single most expensive transaction.
+            std::uint64_t spills{0};
+            std::uint64_t maxSpills{0};
+        };
+
         // rpc_ and jq_ do not need mutex protection because all
         // keys and values are created before more threads are started.
         std::unordered_map<std::string, Locked<Rpc>> rpc_;
         std::unordered_map<JobType, Locked<Jq>> jq_;
+        Locked<Apply> apply_;
         std::vector<std::pair<JobType, steady_time_point>> jobs_;
         mutable std::mutex jobsMutex_;
         std::unordered_map<std::uint64_t, MethodStart> methods_;
@@ -183,6 +196,9 @@ public:
     void
     jobFinish(JobType const type, microseconds dur, int instance) override;
 
+    void
+    txApply(std::uint64_t spills) override;
+
     Json::Value
     countersJson() const override
     {
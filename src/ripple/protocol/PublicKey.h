@@ -30,7 +30,9 @@
 #include <cstring>
 #include <optional>
 #include <ostream>
+#include <span>
 #include <utility>
+#include <vector>
 
 namespace ripple {
 
@@ -257,6 +259,37 @@ verify(
     Slice const& sig,
     bool mustBeFullyCanonical = true) noexcept;
 
+/** A signature over a message, to be checked with verifyBatch. */
+struct SignedMessage
+{
+    PublicKey publicKey;
+    Slice message;
+    Slice signature;
+    bool mustBeFullyCanonical = true;
+};
+
+/** Verify a batch of signatures on messages.
+
+    Ed25519 signatures in the batch are checked together, which is
+    considerably cheaper per signature than checking them one at a time.
+    If the combined check fails, every Ed25519 signature in the failing
+    group is checked individually, so the invalid ones can be identified.
+    Signatures of other key types are checked individually.
+
+    @note A signature that passes verify() always passes verifyBatch().
+          The converse only holds for honestly generated signatures: a
+          signature deliberately built around a small-order point can be
+          rejected by verify() and still, with small probability, pass the
+          randomized batch check. Do not use this where every server must
+          reach the same conclusion about the same signature (for example,
+          when deciding whether a transaction is valid).
+
+    @return A vector with one entry per element of the batch, in the
+            same order, which is true if that signature is valid.
+*/
+[[nodiscard]] std::vector<bool>
+verifyBatch(std::span<SignedMessage const> batch);
+
 /** Calculate the 160-bit node ID from a node public key. */
 NodeID
 calcNodeID(PublicKey const&);
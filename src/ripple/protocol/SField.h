@@ -23,9 +23,11 @@
 #include <ripple/basics/safe_cast.h>
 #include <ripple/json/json_value.h>
 
+#include <array>
 #include <cstdint>
 #include <map>
 #include <utility>
+#include <vector>
 
 namespace ripple {
 
@@ -265,8 +267,20 @@ public:
     compare(const SField& f1, const SField& f2);
 
 private:
+    // Add a newly constructed field to the registry.
+    void
+    registerField();
+
     static int num;
+
+    // Every field, by code.
     static std::map<int, SField const*> knownCodeToField;
+
+    // The fields whose type and value both fit in a byte, which includes
+    // every field that can be serialized, indexed by type and then by
+    // value. This is where getField looks first: it is called for every
+    // field of every object that is deserialized.
+    static std::array<std::vector<SField const*>, 256> knownTypeToFields;
 };
 
 /** A field with a type known at compile time. */
@@ -26,6 +26,7 @@
 #include <initializer_list>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 namespace ripple {
 
@@ -138,9 +139,22 @@ public:
         return elements_[indices_[sf.getNum()]].style();
     }
 
+    /** The positions of the fields, in the order they are serialized.
+
+        Fields are serialized sorted by field code. An object that has
+        this template keeps its fields in template order, so it can be
+        serialized by visiting them in this order, without sorting.
+    */
+    std::vector<int> const&
+    serializationOrder() const
+    {
+        return serializationOrder_;
+    }
+
 private:
     std::vector<SOElement> elements_;
     std::vector<int> indices_;  // field num -> index
+    std::vector<int> serializationOrder_;
 };
 
 }  // namespace ripple
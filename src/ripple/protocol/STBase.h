@@ -23,6 +23,7 @@
 #include <ripple/basics/contract.h>
 #include <ripple/protocol/SField.h>
 #include <ripple/protocol/Serializer.h>
+#include <cstdint>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -35,7 +36,16 @@ enum class JsonOptions { none = 0, include_date = 1 };
 
 namespace detail {
 class STVar;
-}
+
+/** The number of serialized objects this thread has spilled to the heap
+    because they were too large for an STVar's inline buffer. Other heap
+    allocations aren't counted.
+
+    Only ever increases. Callers measure a piece of work by the difference
+    between the values before and after it.
+*/
+inline thread_local std::uint64_t stHeapSpills = 0;
+}  // namespace detail
 
 // VFALCO TODO fix this restriction on copy assignment.
 //
@@ -166,7 +176,10 @@ STBase::emplace(std::size_t n, void* buf, T&& val)
 {
     using U = std::decay_t<T>;
     if (sizeof(U) > n)
+    {
+        ++detail::stHeapSpills;
         return new U(std::forward<T>(val));
+    }
     return new (buf) U(std::forward<T>(val));
 }
 
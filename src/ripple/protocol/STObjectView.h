@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PROTOCOL_STOBJECTVIEW_H_INCLUDED
+#define RIPPLE_PROTOCOL_STOBJECTVIEW_H_INCLUDED
+
+#include <ripple/basics/Slice.h>
+#include <ripple/protocol/STAccount.h>
+#include <ripple/protocol/STBlob.h>
+#include <ripple/protocol/STObject.h>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace ripple {
+
+/** A read-only view of a serialized STObject.
+
+    Constructing an STObject deserializes, and allocates, every one of its
+    fields. Code that only reads a couple of fields of a ledger entry, or
+    that only needs its type to decide whether it is interested, can use a
+    view instead: the view does not copy the serialized data, locates the
+    fields the first time one of them is accessed, and only deserializes
+    the fields that are read.
+
+    The view holds a reference to whatever owns the data, typically the
+    SHAMapItem of a ledger entry, so it remains valid for as long as the
+    view exists.
+
+    A view can't be modified. To change the object, deserialize it in full
+    with toObject, or construct an STLedgerEntry from slice().
+
+    A view is meant to be used by a single thread at a time.
+*/
+class STObjectView
+{
+public:
+    /** Create a view.
+
+        @param data The serialized object, without an enclosing field ID.
+        @param owner Keeps the memory referenced by data alive.
+    */
+    STObjectView(Slice data, std::shared_ptr<void const> owner);
+
+    /** Use the given template to supply the values of absent fields.
+
+        Fields that the template marks soeDEFAULT read as their default
+        value when they are not present, as they would in an STObject
+        that has the template applied.
+    */
+    void
+    setTemplate(SOTemplate const& type)
+    {
+        type_ = &type;
+    }
+
+    /** The serialized object. */
+    Slice
+    slice() const
+    {
+        return data_;
+    }
+
+    /** The number of fields in the object. */
+    std::size_t
+    size() const
+    {
+        return index().size();
+    }
+
+    bool
+    isFieldPresent(SField const& field) const;
+
+    /** The serialized value of a field, without its field ID.
+
+        @return std::nullopt if the field is not present.
+    */
+    std::optional<Slice>
+    peekField(SField const& field) const;
+
+    /** Get the value of a field.
+
+        @throws STObject::FieldErr if the field is not present and the
+                template doesn't give it a default.
+    */
+    template <class T>
+    std::decay_t<typename T::value_type>
+    operator[](TypedField<T> const& f) const;
+
+    /** Get the value of a field as a std::optional. */
+    template <class T>
+    std::optional<std::decay_t<typename T::value_type>>
+    operator[](OptionaledField<T> const& of) const;
+
+    /** Deserialize the whole object. */
+    STObject
+    toObject(SField const& name) const;
+
+private:
+    struct Entry
+    {
+        int code;
+
+        // The value of the field, after its field ID.
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    std::vector<Entry> const&
+    index() const;
+
+    std::optional<Slice>
+    find(SField const& field) const;
+
+    [[noreturn]] void
+    missing(SField const& field) const;
+
+    // Whether an absent field should read as its default value.
+    bool
+    defaulted(SField const& field) const;
+
+    Slice data_;
+    std::shared_ptr<void const> owner_;
+    SOTemplate const* type_ = nullptr;
+
+    // The location of each field, sorted by field code. Built on first
+    // access.
+    mutable std::optional<std::vector<Entry>> index_;
+};
+
+//------------------------------------------------------------------------------
+
+template <class T>
+std::decay_t<typename T::value_type>
+STObjectView::operator[](TypedField<T> const& f) const
+{
+    if (auto const v = (*this)[~f])
+        return *v;
+
+    if (!defaulted(f))
+        missing(f);
+
+    return {};
+}
+
+template <class T>
+std::optional<std::decay_t<typename T::value_type>>
+STObjectView::operator[](OptionaledField<T> const& of) const
+{
+    auto const value = find(*of.f);
+    if (!value)
+        return std::nullopt;
+
+    if constexpr (std::is_same_v<T, STBlob>)
+    {
+        // Return the blob in place, rather than a copy of it.
+        SerialIter sit(*value);
+        auto const size = sit.getVLDataLength();
+        return Slice(value->data() + (value->size() - size), size);
+    }
+    else
+    {
+        SerialIter sit(*value);
+        T const field(sit, *of.f);
+        return field.value();
+    }
+}
+
+}  // namespace ripple
+
+#endif
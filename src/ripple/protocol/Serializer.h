@@ -36,6 +36,14 @@
 
 namespace ripple {
 
+/** Assembles serialized data.
+
+    Serializers are created and destroyed constantly, to serialize objects
+    for hashing, storage and relaying. Rather than allocate a buffer for
+    each, a serializer takes its buffer from a small pool kept by the
+    thread, and returns it there when it is destroyed. A buffer that is
+    moved out of the serializer, using modData, is not returned.
+*/
 class Serializer
 {
 private:
@@ -43,21 +51,22 @@ private:
     Blob mData;
 
 public:
-    explicit Serializer(int n = 256)
-    {
-        mData.reserve(n);
-    }
+    /** Create an empty serializer.
 
-    Serializer(void const* data, std::size_t size)
-    {
-        mData.resize(size);
+        @param n The number of bytes that the caller expects to add.
+    */
+    explicit Serializer(int n = 256);
 
-        if (size)
-        {
-            assert(data != nullptr);
-            std::memcpy(mData.data(), data, size);
-        }
-    }
+    Serializer(void const* data, std::size_t size);
+
+    Serializer(Serializer const&) = default;
+    Serializer(Serializer&&) = default;
+    Serializer&
+    operator=(Serializer const&) = default;
+    Serializer&
+    operator=(Serializer&&) = default;
+
+    ~Serializer();
 
     Slice
     slice() const noexcept
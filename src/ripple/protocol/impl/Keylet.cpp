@@ -25,15 +25,21 @@ namespace ripple {
 bool
 Keylet::check(STLedgerEntry const& sle) const
 {
-    assert(sle.getType() != ltANY || sle.getType() != ltCHILD);
+    return check(sle.getType());
+}
+
+bool
+Keylet::check(LedgerEntryType t) const
+{
+    assert(t != ltANY || t != ltCHILD);
 
     if (type == ltANY)
         return true;
 
     if (type == ltCHILD)
-        return sle.getType() != ltDIR_NODE;
+        return t != ltDIR_NODE;
 
-    return sle.getType() == type;
+    return t == type;
 }
 
 }  // namespace ripple
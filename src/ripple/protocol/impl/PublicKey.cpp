@@ -299,6 +299,66 @@ verify(
     return false;
 }
 
+std::vector<bool>
+verifyBatch(std::span<SignedMessage const> batch)
+{
+    std::vector<bool> result(batch.size(), false);
+
+    // Indexes into the batch of the Ed25519 signatures that can be
+    // checked together, and the arguments for ed25519_sign_open_batch.
+    std::vector<std::size_t> index;
+    std::vector<unsigned char const*> m;
+    std::vector<std::size_t> mlen;
+    std::vector<unsigned char const*> pk;
+    std::vector<unsigned char const*> rs;
+
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        auto const& item = batch[i];
+        auto const type = publicKeyType(item.publicKey);
+
+        if (type == KeyType::ed25519)
+        {
+            if (!ed25519Canonical(item.signature))
+                continue;
+
+            // As in verify, skip the 0xED prefix byte of the key.
+            index.push_back(i);
+            m.push_back(item.message.data());
+            mlen.push_back(item.message.size());
+            pk.push_back(item.publicKey.data() + 1);
+            rs.push_back(item.signature.data());
+        }
+        else if (type)
+        {
+            result[i] = verify(
+                item.publicKey,
+                item.message,
+                item.signature,
+                item.mustBeFullyCanonical);
+        }
+    }
+
+    if (!index.empty())
+    {
+        // If a group fails the combined check, ed25519-donna falls back
+        // to checking each of the group's signatures on its own.
+        std::vector<int> valid(index.size(), 0);
+        ed25519_sign_open_batch(
+            m.data(),
+            mlen.data(),
+            pk.data(),
+            rs.data(),
+            index.size(),
+            valid.data());
+
+        for (std::size_t i = 0; i < index.size(); ++i)
+            result[index[i]] = valid[i] == 1;
+    }
+
+    return result;
+}
+
 NodeID
 calcNodeID(PublicKey const& pk)
 {
@@ -29,6 +29,7 @@ namespace ripple {
 SField::IsSigning const SField::notSigning;
 int SField::num = 0;
 std::map<int, SField const*> SField::knownCodeToField;
+std::array<std::vector<SField const*>, 256> SField::knownTypeToFields;
 
 // Give only this translation unit permission to construct SFields
 struct SField::private_access_tag_t
@@ -399,7 +400,7 @@ SField::SField(
     , signingField(signing)
     , jsonName(fieldName.c_str())
 {
-    knownCodeToField[fieldCode] = this;
+    registerField();
 }
 
 SField::SField(private_access_tag_t, int fc)
@@ -410,13 +411,45 @@ SField::SField(private_access_tag_t, int fc)
     , fieldNum(++num)
     , signingField(IsSigning::yes)
     , jsonName(fieldName.c_str())
+{
+    registerField();
+}
+
+void
+SField::registerField()
 {
     knownCodeToField[fieldCode] = this;
+
+    if (fieldCode < 0)
+        return;
+
+    auto const type = static_cast<std::size_t>(fieldCode >> 16);
+    auto const value = static_cast<std::size_t>(fieldCode & 0xffff);
+    if (type < knownTypeToFields.size() && value < 256)
+    {
+        auto& fields = knownTypeToFields[type];
+        if (fields.size() <= value)
+            fields.resize(value + 1, nullptr);
+        fields[value] = this;
+    }
 }
 
 SField const&
 SField::getField(int code)
 {
+    if (code >= 0)
+    {
+        auto const type = static_cast<std::size_t>(code >> 16);
+        auto const value = static_cast<std::size_t>(code & 0xffff);
+        if (type < knownTypeToFields.size() && value < 256)
+        {
+            auto const& fields = knownTypeToFields[type];
+            if (value < fields.size() && fields[value])
+                return *fields[value];
+            return sfInvalid;
+        }
+    }
+
     auto it = knownCodeToField.find(code);
 
     if (it != knownCodeToField.end())
@@ -18,6 +18,8 @@
 //==============================================================================
 
 #include <ripple/protocol/SOTemplate.h>
+#include <algorithm>
+#include <numeric>
 
 namespace ripple {
 
@@ -50,6 +52,16 @@ SOTemplate::SOTemplate(
         //
         indices_[sField.getNum()] = i;
     }
+
+    serializationOrder_.resize(elements_.size());
+    std::iota(serializationOrder_.begin(), serializationOrder_.end(), 0);
+    std::sort(
+        serializationOrder_.begin(),
+        serializationOrder_.end(),
+        [this](int lhs, int rhs) {
+            return elements_[lhs].sField().fieldCode <
+                elements_[rhs].sField().fieldCode;
+        });
 }
 
 int
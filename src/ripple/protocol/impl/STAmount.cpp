@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/basics/Log.h>
+#include <ripple/basics/MathUtilities.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/safe_cast.h>
 #include <ripple/beast/core/LexicalCast.h>
@@ -26,12 +27,19 @@
 #include <ripple/protocol/UintTypes.h>
 #include <ripple/protocol/jss.h>
 #include <boost/algorithm/string.hpp>
-#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/predef.h>
 #include <boost/regex.hpp>
 #include <iostream>
 #include <iterator>
 #include <memory>
 
+#if BOOST_COMP_MSVC
+#include <boost/multiprecision/cpp_int.hpp>
+using uint128_t = boost::multiprecision::uint128_t;
+#else
+using uint128_t = __uint128_t;
+#endif
+
 namespace ripple {
 
 namespace {
@@ -786,10 +794,13 @@ STAmount::canonicalize()
         return;
     }
 
-    while ((mValue < cMinValue) && (mOffset > cMinOffset))
+    if (mValue < cMinValue && mOffset > cMinOffset)
     {
-        mValue *= 10;
-        --mOffset;
+        auto const shift = std::min(
+            decimalDigits(cMinValue) - decimalDigits(mValue),
+            mOffset - cMinOffset);
+        mValue *= powerOfTen(shift);
+        mOffset -= shift;
     }
 
     while (mValue > cMaxValue)
@@ -1110,9 +1121,7 @@ muldiv(
     std::uint64_t multiplicand,
     std::uint64_t divisor)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    uint128_t ret = uint128_t(multiplier) * multiplicand;
     ret /= divisor;
 
     if (ret > std::numeric_limits<std::uint64_t>::max())
@@ -1132,9 +1141,7 @@ muldiv_round(
     std::uint64_t divisor,
     std::uint64_t rounding)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    uint128_t ret = uint128_t(multiplier) * multiplicand;
     ret += rounding;
     ret /= divisor;
 
@@ -1149,6 +1156,20 @@ muldiv_round(
     return static_cast<uint64_t>(ret);
 }
 
+// Bring the mantissa of a native amount into the range of the mantissas
+// of issued amounts.
+static void
+normalizeNative(std::uint64_t& value, int& offset)
+{
+    if (value < STAmount::cMinValue)
+    {
+        auto const shift =
+            decimalDigits(STAmount::cMinValue) - decimalDigits(value);
+        value *= powerOfTen(shift);
+        offset -= shift;
+    }
+}
+
 STAmount
 divide(STAmount const& num, STAmount const& den, Issue const& issue)
 {
@@ -1164,23 +1185,10 @@ divide(STAmount const& num, STAmount const& den, Issue const& issue)
     int denOffset = den.exponent();
 
     if (num.native())
-    {
-        while (numVal < STAmount::cMinValue)
-        {
-            // Need to bring into range
-            numVal *= 10;
-            --numOffset;
-        }
-    }
+        normalizeNative(numVal, numOffset);
 
     if (den.native())
-    {
-        while (denVal < STAmount::cMinValue)
-        {
-            denVal *= 10;
-            --denOffset;
-        }
-    }
+        normalizeNative(denVal, denOffset);
 
     // We divide the two mantissas (each is between 10^15
     // and 10^16). To maintain precision, we multiply the
@@ -1225,22 +1233,10 @@ multiply(STAmount const& v1, STAmount const& v2, Issue const& issue)
     int offset2 = v2.exponent();
 
     if (v1.native())
-    {
-        while (value1 < STAmount::cMinValue)
-        {
-            value1 *= 10;
-            --offset1;
-        }
-    }
+        normalizeNative(value1, offset1);
 
     if (v2.native())
-    {
-        while (value2 < STAmount::cMinValue)
-        {
-            value2 *= 10;
-            --offset2;
-        }
-    }
+        normalizeNative(value2, offset2);
 
     // We multiply the two mantissas (each is between 10^15
     // and 10^16), so their product is in the 10^30 to 10^32
@@ -1432,22 +1428,10 @@ mulRoundImpl(
     int offset1 = v1.exponent(), offset2 = v2.exponent();
 
     if (v1.native())
-    {
-        while (value1 < STAmount::cMinValue)
-        {
-            value1 *= 10;
-            --offset1;
-        }
-    }
+        normalizeNative(value1, offset1);
 
     if (v2.native())
-    {
-        while (value2 < STAmount::cMinValue)
-        {
-            value2 *= 10;
-            --offset2;
-        }
-    }
+        normalizeNative(value2, offset2);
 
     bool const resultNegative = v1.negative() != v2.negative();
 
@@ -1535,22 +1519,10 @@ divRoundImpl(
     int numOffset = num.exponent(), denOffset = den.exponent();
 
     if (num.native())
-    {
-        while (numVal < STAmount::cMinValue)
-        {
-            numVal *= 10;
-            --numOffset;
-        }
-    }
+        normalizeNative(numVal, numOffset);
 
     if (den.native())
-    {
-        while (denVal < STAmount::cMinValue)
-        {
-            denVal *= 10;
-            --denOffset;
-        }
-    }
+        normalizeNative(denVal, denOffset);
 
     bool const resultNegative = (num.negative() != den.negative());
 
@@ -124,24 +124,38 @@ STObject::applyTemplate(const SOTemplate& type)
     };
 
     mType = &type;
+
+    // Find where each of the template's fields is, in a single pass. A
+    // field that isn't in the template, or that appears a second time, is
+    // left over.
+    std::vector<int> from(type.size(), -1);
+    STBase const* leftover = nullptr;
+    for (std::size_t i = 0; i < v_.size(); ++i)
+    {
+        auto const& field = v_[i]->getFName();
+        auto const index = type.getIndex(field);
+        if (index != -1 && from[index] == -1)
+            from[index] = i;
+        else if (!leftover && !field.isDiscardable())
+            leftover = &v_[i].get();
+    }
+
     decltype(v_) v;
     v.reserve(type.size());
-    for (auto const& e : type)
+    auto elem = type.begin();
+    for (std::size_t index = 0; index < type.size(); ++index, ++elem)
     {
-        auto const iter =
-            std::find_if(v_.begin(), v_.end(), [&](detail::STVar const& b) {
-                return b.get().getFName() == e.sField();
-            });
-        if (iter != v_.end())
+        auto const& e = *elem;
+        if (from[index] != -1)
         {
-            if ((e.style() == soeDEFAULT) && iter->get().isDefault())
+            auto& field = v_[from[index]];
+            if ((e.style() == soeDEFAULT) && field->isDefault())
             {
                 throwFieldErr(
                     e.sField().fieldName,
                     "may not be explicitly set to default.");
             }
-            v.emplace_back(std::move(*iter));
-            v_.erase(iter);
+            v.emplace_back(std::move(field));
         }
         else
         {
@@ -152,15 +166,14 @@ STObject::applyTemplate(const SOTemplate& type)
             v.emplace_back(detail::nonPresentObject, e.sField());
         }
     }
-    for (auto const& e : v_)
+
+    // Anything left over in the object must be discardable
+    if (leftover)
     {
-        // Anything left over in the object must be discardable
-        if (!e->getFName().isDiscardable())
-        {
-            throwFieldErr(
-                e->getFName().getName(), "found in disallowed location.");
-        }
+        throwFieldErr(
+            leftover->getFName().getName(), "found in disallowed location.");
     }
+
     // Swap the template matching data in for the old data,
     // freeing any leftover junk
     v_.swap(v);
@@ -181,6 +194,11 @@ STObject::set(SerialIter& sit, int depth)
 {
     bool reachedEndOfObject = false;
 
+    // Canonically serialized objects have their fields sorted by field
+    // code, which rules out duplicates without sorting them again.
+    bool sorted = true;
+    int lastCode = 0;
+
     v_.clear();
 
     // Consume data in the pipe until we run out or reach the end
@@ -216,6 +234,10 @@ STObject::set(SerialIter& sit, int depth)
             Throw<std::runtime_error>("Unknown field");
         }
 
+        if (fn.fieldCode <= lastCode)
+            sorted = false;
+        lastCode = fn.fieldCode;
+
         // Unflatten the field
         v_.emplace_back(sit, fn, depth + 1);
 
@@ -226,15 +248,18 @@ STObject::set(SerialIter& sit, int depth)
 
     // We want to ensure that the deserialized object does not contain any
     // duplicate fields. This is a key invariant:
-    auto const sf = getSortedFields(*this, withAllFields);
+    if (!sorted)
+    {
+        auto const sf = getSortedFields(*this, withAllFields);
 
-    auto const dup = std::adjacent_find(
-        sf.cbegin(), sf.cend(), [](STBase const* lhs, STBase const* rhs) {
-            return lhs->getFName() == rhs->getFName();
-        });
+        auto const dup = std::adjacent_find(
+            sf.cbegin(), sf.cend(), [](STBase const* lhs, STBase const* rhs) {
+                return lhs->getFName() == rhs->getFName();
+            });
 
-    if (dup != sf.cend())
-        Throw<std::runtime_error>("Duplicate field detected");
+        if (dup != sf.cend())
+            Throw<std::runtime_error>("Duplicate field detected");
+    }
 
     return reachedEndOfObject;
 }
@@ -786,26 +811,44 @@ STObject::operator==(const STObject& obj) const
 void
 STObject::add(Serializer& s, WhichFields whichFields) const
 {
-    // Depending on whichFields, signing fields are either serialized or
-    // not.  Then fields are added to the Serializer sorted by fieldCode.
-    std::vector<STBase const*> const fields{
-        getSortedFields(*this, whichFields)};
-
-    // insert sorted
-    for (STBase const* const field : fields)
-    {
+    auto const addField = [&s](STBase const& field) {
         // When we serialize an object inside another object,
         // the type associated by rule with this field name
         // must be OBJECT, or the object cannot be deserialized
-        SerializedTypeID const sType{field->getSType()};
+        SerializedTypeID const sType{field.getSType()};
         assert(
             (sType != STI_OBJECT) ||
-            (field->getFName().fieldType == STI_OBJECT));
-        field->addFieldID(s);
-        field->add(s);
+            (field.getFName().fieldType == STI_OBJECT));
+        field.addFieldID(s);
+        field.add(s);
         if (sType == STI_ARRAY || sType == STI_OBJECT)
             s.addFieldID(sType, 1);
+    };
+
+    // An object with a template holds exactly the template's fields, in
+    // template order, and the template knows which order they are
+    // serialized in.
+    if (mType && v_.size() == mType->size())
+    {
+        for (int const index : mType->serializationOrder())
+        {
+            STBase const& field = v_[index].get();
+            assert(field.getFName() == (mType->begin() + index)->sField());
+            if ((field.getSType() != STI_NOTPRESENT) &&
+                field.getFName().shouldInclude(whichFields))
+                addField(field);
+        }
+        return;
     }
+
+    // Depending on whichFields, signing fields are either serialized or
+    // not.  Then fields are added to the Serializer sorted by fieldCode.
+    std::vector<STBase const*> const fields{
+        getSortedFields(*this, whichFields)};
+
+    // insert sorted
+    for (STBase const* const field : fields)
+        addField(*field);
 }
 
 std::vector<STBase const*>
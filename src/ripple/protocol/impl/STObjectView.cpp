@@ -0,0 +1,240 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/protocol/STObjectView.h>
+#include <algorithm>
+
+namespace ripple {
+
+namespace {
+
+void
+skipObject(SerialIter& sit, int depth);
+
+// Advance past the value of a field without deserializing it, where that
+// can be done cheaply.
+void
+skipValue(SerialIter& sit, SField const& field, int depth)
+{
+    switch (field.fieldType)
+    {
+        case STI_UINT8:
+            sit.skip(1);
+            break;
+        case STI_UINT16:
+            sit.skip(2);
+            break;
+        case STI_UINT32:
+            sit.skip(4);
+            break;
+        case STI_UINT64:
+            sit.skip(8);
+            break;
+        case STI_UINT128:
+            sit.skip(16);
+            break;
+        case STI_UINT160:
+            sit.skip(20);
+            break;
+        case STI_UINT256:
+            sit.skip(32);
+            break;
+        case STI_AMOUNT:
+            // Issued currency amounts are followed by the currency and the
+            // issuer.
+            if ((sit.get64() & STAmount::cNotNative) != 0)
+                sit.skip(40);
+            break;
+        case STI_VL:
+        case STI_ACCOUNT:
+        case STI_VECTOR256:
+            sit.skip(sit.getVLDataLength());
+            break;
+        case STI_OBJECT:
+            skipObject(sit, depth + 1);
+            break;
+        case STI_ARRAY:
+            if (depth > 10)
+                Throw<std::runtime_error>(
+                    "Maximum nesting depth of STArray exceeded");
+            for (;;)
+            {
+                int type;
+                int name;
+                sit.getFieldID(type, name);
+
+                if (type == STI_ARRAY && name == 1)
+                    break;
+
+                if (type == STI_OBJECT && name == 1)
+                    Throw<std::runtime_error>(
+                        "Illegal end-of-object marker in array");
+
+                auto const& fn = SField::getField(type, name);
+                if (fn.isInvalid() || fn.fieldType != STI_OBJECT)
+                    Throw<std::runtime_error>("Non-object in array");
+
+                skipObject(sit, depth + 1);
+            }
+            break;
+        default:
+            // Rarely seen in ledger entries; parse the value to find where
+            // it ends.
+            (void)detail::STVar(sit, field, depth);
+            break;
+    }
+}
+
+void
+skipObject(SerialIter& sit, int depth)
+{
+    if (depth > 10)
+        Throw<std::runtime_error>("Maximum nesting depth of STObject exceeded");
+
+    for (;;)
+    {
+        int type;
+        int name;
+        sit.getFieldID(type, name);
+
+        if (type == STI_OBJECT && name == 1)
+            return;
+
+        if (type == STI_ARRAY && name == 1)
+            Throw<std::runtime_error>("Illegal end-of-array marker in object");
+
+        auto const& fn = SField::getField(type, name);
+        if (fn.isInvalid())
+            Throw<std::runtime_error>("Unknown field");
+
+        skipValue(sit, fn, depth);
+    }
+}
+
+}  // namespace
+
+STObjectView::STObjectView(Slice data, std::shared_ptr<void const> owner)
+    : data_(data), owner_(std::move(owner))
+{
+}
+
+auto
+STObjectView::index() const -> std::vector<Entry> const&
+{
+    if (index_)
+        return *index_;
+
+    std::vector<Entry> entries;
+    SerialIter sit(data_);
+
+    while (!sit.empty())
+    {
+        int type;
+        int name;
+        sit.getFieldID(type, name);
+
+        // Like STObject, reject the markers that only belong in nested
+        // objects and arrays.
+        if ((type == STI_OBJECT || type == STI_ARRAY) && name == 1)
+            Throw<std::runtime_error>("Illegal end marker in object");
+
+        auto const& fn = SField::getField(type, name);
+        if (fn.isInvalid())
+            Throw<std::runtime_error>("Unknown field");
+
+        auto const offset = data_.size() - sit.getBytesLeft();
+        skipValue(sit, fn, 0);
+        auto const size = data_.size() - sit.getBytesLeft() - offset;
+
+        entries.push_back(
+            {fn.fieldCode,
+             static_cast<std::uint32_t>(offset),
+             static_cast<std::uint32_t>(size)});
+    }
+
+    // Canonically serialized objects are already in order.
+    auto const byCode = [](Entry const& a, Entry const& b) {
+        return a.code < b.code;
+    };
+    if (!std::is_sorted(entries.begin(), entries.end(), byCode))
+        std::sort(entries.begin(), entries.end(), byCode);
+
+    if (std::adjacent_find(
+            entries.begin(), entries.end(), [](Entry const& a, Entry const& b) {
+                return a.code == b.code;
+            }) != entries.end())
+        Throw<std::runtime_error>("Duplicate field detected");
+
+    index_ = std::move(entries);
+    return *index_;
+}
+
+std::optional<Slice>
+STObjectView::find(SField const& field) const
+{
+    auto const& idx = index();
+    auto const it = std::lower_bound(
+        idx.begin(), idx.end(), field.fieldCode, [](Entry const& e, int code) {
+            return e.code < code;
+        });
+    if (it == idx.end() || it->code != field.fieldCode)
+        return std::nullopt;
+    return Slice(data_.data() + it->offset, it->size);
+}
+
+bool
+STObjectView::isFieldPresent(SField const& field) const
+{
+    return find(field).has_value();
+}
+
+std::optional<Slice>
+STObjectView::peekField(SField const& field) const
+{
+    return find(field);
+}
+
+bool
+STObjectView::defaulted(SField const& field) const
+{
+    if (!type_)
+        return false;
+
+    return type_->getIndex(field) >= 0 && type_->style(field) == soeDEFAULT;
+}
+
+void
+STObjectView::missing(SField const& field) const
+{
+    if (type_ && type_->getIndex(field) >= 0 &&
+        type_->style(field) == soeOPTIONAL)
+        Throw<STObject::FieldErr>("Missing optional field: " + field.getName());
+    Throw<STObject::FieldErr>("Missing field: " + field.getName());
+}
+
+STObject
+STObjectView::toObject(SField const& name) const
+{
+    SerialIter sit(data_);
+    if (type_)
+        return STObject(*type_, sit, name);
+    return STObject(sit, name);
+}
+
+}  // namespace ripple
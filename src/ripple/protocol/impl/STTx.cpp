@@ -35,6 +35,7 @@
 #include <ripple/protocol/jss.h>
 #include <boost/format.hpp>
 #include <array>
+#include <cstring>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -151,13 +152,13 @@ STTx::getMentionedAccounts() const
     return list;
 }
 
-static Blob
+static Serializer
 getSigningData(STTx const& that)
 {
     Serializer s;
     s.add32(HashPrefix::txSign);
     that.addWithoutSigningFields(s);
-    return s.getData();
+    return s;
 }
 
 uint256
@@ -199,7 +200,7 @@ STTx::sign(PublicKey const& publicKey, SecretKey const& secretKey)
 {
     auto const data = getSigningData(*this);
 
-    auto const sig = ripple::sign(publicKey, secretKey, makeSlice(data));
+    auto const sig = ripple::sign(publicKey, secretKey, data.slice());
 
     setFieldVL(sfTxnSignature, sig);
     tid_ = getHash(HashPrefix::transactionID);
@@ -309,11 +310,11 @@ STTx::checkSingleSign(RequireFullyCanonicalSig requireCanonicalSig) const
         if (publicKeyType(makeSlice(spk)))
         {
             Blob const signature = getFieldVL(sfTxnSignature);
-            Blob const data = getSigningData(*this);
+            Serializer const data = getSigningData(*this);
 
             validSig = verify(
                 PublicKey(makeSlice(spk)),
-                makeSlice(data),
+                data.slice(),
                 makeSlice(signature),
                 fullyCanonical);
         }
@@ -351,10 +352,12 @@ STTx::checkMultiSign(
         signers.size() > maxMultiSigners(&rules))
         return Unexpected("Invalid Signers array size.");
 
-    // We can ease the computational load inside the loop a bit by
-    // pre-constructing part of the data that we hash.  Fill a Serializer
-    // with the stuff that stays constant from signature to signature.
-    Serializer const dataStart{startMultiSigningData(*this)};
+    // Each signer signs the same data followed by their own account ID.
+    // Serialize it once, with room for the account ID at the end, and
+    // fill in each signer's account ID in turn.
+    Serializer data{startMultiSigningData(*this)};
+    auto const signingIDOffset = data.size();
+    finishMultiSigningData(AccountID{}, data);
 
     // We also use the sfAccount field inside the loop.  Get it once.
     auto const txnAccountID = getAccountID(sfAccount);
@@ -389,8 +392,10 @@ STTx::checkMultiSign(
         bool validSig = false;
         try
         {
-            Serializer s = dataStart;
-            finishMultiSigningData(accountID, s);
+            std::memcpy(
+                static_cast<std::uint8_t*>(data.getDataPtr()) + signingIDOffset,
+                accountID.data(),
+                accountID.size());
 
             auto spk = signer.getFieldVL(sfSigningPubKey);
 
@@ -400,7 +405,7 @@ STTx::checkMultiSign(
 
                 validSig = verify(
                     PublicKey(makeSlice(spk)),
-                    s.slice(),
+                    data.slice(),
                     makeSlice(signature),
                     fullyCanonical);
             }
@@ -126,7 +126,10 @@ private:
     construct(Args&&... args)
     {
         if (sizeof(T) > max_size)
+        {
+            ++stHeapSpills;
             p_ = new T(std::forward<Args>(args)...);
+        }
         else
             p_ = new (&d_) T(std::forward<Args>(args)...);
     }
@@ -25,6 +25,84 @@
 
 namespace ripple {
 
+namespace {
+
+// The buffers of destroyed serializers, for reuse by the next ones created
+// on the same thread.
+class BufferPool
+{
+    // Enough for the serializers that are alive at once on a thread.
+    static constexpr std::size_t maxBuffers = 16;
+
+    // Don't hold on to the occasional very large buffer.
+    static constexpr std::size_t maxCapacity = 64 * 1024;
+
+    std::vector<Blob> buffers_;
+
+public:
+    ~BufferPool();
+
+    Blob
+    get(std::size_t size)
+    {
+        Blob b;
+        if (!buffers_.empty())
+        {
+            b = std::move(buffers_.back());
+            buffers_.pop_back();
+        }
+        b.reserve(size);
+        return b;
+    }
+
+    void
+    put(Blob& b)
+    {
+        if (b.capacity() == 0 || b.capacity() > maxCapacity ||
+            buffers_.size() == maxBuffers)
+            return;
+
+        b.clear();
+        buffers_.push_back(std::move(b));
+    }
+};
+
+thread_local BufferPool pool;
+
+// Serializers may be destroyed after the thread's pool, for instance when
+// they are owned by objects with static storage duration.
+thread_local bool poolDestroyed = false;
+
+BufferPool::~BufferPool()
+{
+    poolDestroyed = true;
+}
+
+}  // namespace
+
+Serializer::Serializer(int n)
+    : mData(poolDestroyed ? Blob{} : pool.get(n))
+{
+}
+
+Serializer::Serializer(void const* data, std::size_t size)
+    : mData(poolDestroyed ? Blob{} : pool.get(size))
+{
+    mData.resize(size);
+
+    if (size)
+    {
+        assert(data != nullptr);
+        std::memcpy(mData.data(), data, size);
+    }
+}
+
+Serializer::~Serializer()
+{
+    if (!poolDestroyed)
+        pool.put(mData);
+}
+
 int
 Serializer::add16(std::uint16_t i)
 {
@@ -21,6 +21,7 @@
 #include <ripple/protocol/digest.h>
 #include <ripple/protocol/tokens.h>
 #include <boost/container/small_vector.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <memory>
@@ -94,13 +95,19 @@ namespace detail {
  * Copyright (c) 2014 The Bitcoin Core developers
  * Distributed under the MIT software license, see the accompanying
  * file COPYING or http://www.opensource.org/licenses/mit-license.php.
+ *
+ * Rather than one byte or one digit at a time, they work with several:
+ * numbers are kept in limbs of five base58 digits when encoding and of
+ * 32 bits when decoding, so each step of the conversion multiplies by a
+ * whole chunk of the input. That takes a fraction of the steps, and the
+ * intermediate products fit comfortably in 64 bits.
  */
-static std::string
-encodeBase58(
-    void const* message,
-    std::size_t size,
-    void* temp,
-    std::size_t temp_size)
+
+// 58^5, the base of the limbs that encoding accumulates.
+static constexpr std::uint64_t b58Limb = 58ull * 58 * 58 * 58 * 58;
+
+std::string
+encodeBase58(void const* message, std::size_t size)
 {
     auto pbegin = reinterpret_cast<unsigned char const*>(message);
     auto const pend = pbegin + size;
@@ -113,40 +120,65 @@ encodeBase58(
         zeroes++;
     }
 
-    auto const b58begin = reinterpret_cast<unsigned char*>(temp);
-    auto const b58end = b58begin + temp_size;
-
-    std::fill(b58begin, b58end, 0);
-
+    // The value in base 58^5, least significant limb first. Input is
+    // taken four bytes at a time, starting with whatever doesn't fill a
+    // whole chunk.
+    boost::container::small_vector<std::uint32_t, 16> limbs;
+    auto chunk = (pend - pbegin) % 4;
+    if (chunk == 0)
+        chunk = 4;
     while (pbegin != pend)
     {
-        int carry = *pbegin;
-        // Apply "b58 = b58 * 256 + ch".
-        for (auto iter = b58end; iter != b58begin; --iter)
+        std::uint64_t carry = 0;
+        for (auto const end = pbegin + chunk; pbegin != end; ++pbegin)
+            carry = (carry << 8) | *pbegin;
+        auto const shift = 8 * chunk;
+        chunk = 4;
+
+        // Apply "limbs = limbs * 256^chunk + carry".
+        for (auto& limb : limbs)
         {
-            carry += 256 * (iter[-1]);
-            iter[-1] = carry % 58;
-            carry /= 58;
+            carry += std::uint64_t{limb} << shift;
+            limb = static_cast<std::uint32_t>(carry % b58Limb);
+            carry /= b58Limb;
+        }
+        while (carry != 0)
+        {
+            limbs.push_back(static_cast<std::uint32_t>(carry % b58Limb));
+            carry /= b58Limb;
         }
-        assert(carry == 0);
-        pbegin++;
     }
 
-    // Skip leading zeroes in base58 result.
-    auto iter = b58begin;
-    while (iter != b58end && *iter == 0)
-        ++iter;
-
-    // Translate the result into a string.
+    // Translate the result into a string, skipping the leading zeroes
+    // of the most significant limb.
     std::string str;
-    str.reserve(zeroes + (b58end - iter));
+    str.reserve(zeroes + 5 * limbs.size());
     str.assign(zeroes, alphabetForward[0]);
-    while (iter != b58end)
-        str += alphabetForward[*(iter++)];
+    if (limbs.empty())
+        return str;
+
+    char digits[5];
+    auto toDigits = [&digits](std::uint32_t limb) {
+        for (int i = 4; i >= 0; --i)
+        {
+            digits[i] = alphabetForward[limb % 58];
+            limb /= 58;
+        }
+    };
+    toDigits(limbs.back());
+    auto first = std::find_if(std::begin(digits), std::end(digits), [](char c) {
+        return c != alphabetForward[0];
+    });
+    str.append(first, std::end(digits));
+    for (auto iter = limbs.rbegin() + 1; iter != limbs.rend(); ++iter)
+    {
+        toDigits(*iter);
+        str.append(digits, 5);
+    }
     return str;
 }
 
-static std::string
+std::string
 decodeBase58(std::string const& s)
 {
     auto psz = reinterpret_cast<unsigned char const*>(s.c_str());
@@ -163,33 +195,52 @@ decodeBase58(std::string const& s)
     if (remain > 64)
         return {};
 
-    // Allocate enough space in big-endian base256 representation.
-    // log(58) / log(256), rounded up.
-    std::vector<unsigned char> b256(remain * 733 / 1000 + 1);
+    // The value in base 2^32, least significant limb first. Input is
+    // taken five digits at a time, starting with whatever doesn't fill a
+    // whole chunk.
+    boost::container::small_vector<std::uint32_t, 16> limbs;
+    auto chunk = remain % 5;
+    if (chunk == 0)
+        chunk = 5;
     while (remain > 0)
     {
-        auto carry = alphabetReverse[*psz];
-        if (carry == -1)
-            return {};
-        // Apply "b256 = b256 * 58 + carry".
-        for (auto iter = b256.rbegin(); iter != b256.rend(); ++iter)
+        std::uint64_t carry = 0;
+        std::uint64_t scale = 1;
+        for (std::size_t i = 0; i < chunk; ++i)
         {
-            carry += 58 * *iter;
-            *iter = carry % 256;
-            carry /= 256;
+            auto const digit = alphabetReverse[*psz++];
+            if (digit == -1)
+                return {};
+            carry = carry * 58 + digit;
+            scale *= 58;
         }
-        assert(carry == 0);
-        ++psz;
-        --remain;
+        remain -= chunk;
+        chunk = 5;
+
+        // Apply "limbs = limbs * 58^chunk + carry".
+        for (auto& limb : limbs)
+        {
+            carry += limb * scale;
+            limb = static_cast<std::uint32_t>(carry);
+            carry >>= 32;
+        }
+        if (carry != 0)
+            limbs.push_back(static_cast<std::uint32_t>(carry));
     }
-    // Skip leading zeroes in b256.
-    auto iter = std::find_if(
-        b256.begin(), b256.end(), [](unsigned char c) { return c != 0; });
+
+    // Lay the limbs out big-endian, skipping the leading zeroes of the
+    // most significant one.
     std::string result;
-    result.reserve(zeroes + (b256.end() - iter));
+    result.reserve(zeroes + 4 * limbs.size());
     result.assign(zeroes, 0x00);
-    while (iter != b256.end())
-        result.push_back(*(iter++));
+    int shift = 24;
+    while (!limbs.empty() && (limbs.back() >> shift) == 0)
+        shift -= 8;
+    for (auto iter = limbs.rbegin(); iter != limbs.rend(); ++iter, shift = 24)
+    {
+        for (; shift >= 0; shift -= 8)
+            result.push_back(static_cast<char>(*iter >> shift));
+    }
     return result;
 }
 
@@ -201,12 +252,7 @@ encodeBase58Token(TokenType type, void const* token, std::size_t size)
     // expanded token includes type + 4 byte checksum
     auto const expanded = 1 + size + 4;
 
-    // We need expanded + expanded * (log(256) / log(58)) which is
-    // bounded by expanded + expanded * (138 / 100 + 1) which works
-    // out to expanded * 3:
-    auto const bufsize = expanded * 3;
-
-    boost::container::small_vector<std::uint8_t, 1024> buf(bufsize);
+    boost::container::small_vector<std::uint8_t, 64> buf(expanded);
 
     // Lay the data out as
     //      <type><token><checksum>
@@ -215,8 +261,7 @@ encodeBase58Token(TokenType type, void const* token, std::size_t size)
         std::memcpy(buf.data() + 1, token, size);
     checksum(buf.data() + 1 + size, buf.data(), 1 + size);
 
-    return detail::encodeBase58(
-        buf.data(), expanded, buf.data() + expanded, bufsize - expanded);
+    return detail::encodeBase58(buf.data(), expanded);
 }
 
 std::string
@@ -163,7 +163,8 @@ JSS(amount);                 // out: AccountChannels, amm_info
 JSS(amount2);                // out: amm_info
 JSS(api_version);            // in: many, out: Version
 JSS(api_version_low);        // out: Version
-JSS(applied);                // out: SubmitTransaction
+JSS(applied);                // out: SubmitTransaction, PerfLog
+JSS(apply);                  // out: PerfLog
 JSS(asks);                   // out: Subscribe
 JSS(asset);                  // in: amm_info
 JSS(asset2);                 // in: amm_info
@@ -245,6 +246,7 @@ JSS(dbKBTransaction);         // out: getCounts
 JSS(debug_signing);           // in: TransactionSign
 JSS(deletion_blockers_only);  // in: AccountObjects
 JSS(delivered_amount);        // out: insertDeliveredAmount
+JSS(deltas);                  // out: LedgerReplayer
 JSS(deposit_authorized);      // out: deposit_authorized
 JSS(deposit_preauth);         // in: AccountObjects, LedgerData
 JSS(deprecated);              // out
@@ -268,6 +270,7 @@ JSS(drops);                   // out: TxQ
 JSS(duration_us);             // out: NetworkOPs
 JSS(effective);               // out: ValidatorList
                               // in: UNL
+JSS(elapsed_ms);              // out: RCLStatePrefetch
 JSS(enabled);                 // out: AmendmentTable
 JSS(engine_result);           // out: NetworkOPs, TransactionSign, Submit
 JSS(engine_result_code);      // out: NetworkOPs, TransactionSign, Submit
@@ -322,6 +325,8 @@ JSS(high);                  // out: BookChanges
 JSS(highest_sequence);      // out: AccountInfo
 JSS(highest_ticket);        // out: AccountInfo
 JSS(historical_perminute);  // historical_perminute.
+JSS(hit_rate);              // out: RCLStatePrefetch
+JSS(hits);                  // out: RCLStatePrefetch
 JSS(hostid);                // out: NetworkOPs
 JSS(hotwallet);             // in: GatewayBalances
 JSS(id);                    // websocket.
@@ -379,7 +384,10 @@ JSS(ledger_index_max);            // in, out: AccountTx*
 JSS(ledger_index_min);            // in, out: AccountTx*
 JSS(ledger_max);                  // in, out: AccountTx*
 JSS(ledger_min);                  // in, out: AccountTx*
+JSS(ledger_replay);               // out: FetchInfo
 JSS(ledger_time);                 // out: NetworkOPs
+JSS(ledgers_built);               // out: LedgerReplayer
+JSS(ledgers_per_sec);             // out: LedgerReplayer
 JSS(levels);                      // LogLevels
 JSS(limit);                       // in/out: AccountTx*, AccountOffers,
                                   //         AccountLines, AccountObjects
@@ -421,6 +429,7 @@ JSS(max_ledger);                  // in/out: LedgerCleaner
 JSS(max_queue_size);              // out: TxQ
 JSS(max_spend_drops);             // out: AccountInfo
 JSS(max_spend_drops_total);       // out: AccountInfo
+JSS(max_spills);                  // out: PerfLog
 JSS(median_fee);                  // out: TxQ
 JSS(median_level);                // out: TxQ
 JSS(message);                     // error.
@@ -498,6 +507,8 @@ JSS(peer_disconnects_resources);  // Severed peer connections because of
                                   // excess resource consumption.
 JSS(port);                        // in: Connect, out: NetworkOPs
 JSS(ports);                       // out: NetworkOPs
+JSS(prefetch);                    // out: RCLConsensus
+JSS(prefetched);                  // out: RCLStatePrefetch
 JSS(previous);                    // out: Reservations
 JSS(previous_ledger);             // out: LedgerPropose
 JSS(price);                       // out: amm_info, AuctionSlot
@@ -513,6 +524,7 @@ JSS(public_key);                  // out: OverlayImpl, PeerImp, WalletPropose,
                                   //      ValidatorInfo
                                   // in/out: Manifest
 JSS(public_key_hex);              // out: WalletPropose
+JSS(published_dropped);           // out: NetworkOPs
 JSS(published_ledger);            // out: NetworkOPs
 JSS(publisher_lists);             // out: ValidatorList
 JSS(quality);                     // out: NetworkOPs
@@ -545,6 +557,10 @@ JSS(ripple_state);          // in: LedgerEntr
 JSS(ripplerpc);             // ripple RPC version
 JSS(role);                  // out: Ping.cpp
 JSS(rpc);
+JSS(rpc_cache_bytes);       // out: GetCounts
+JSS(rpc_cache_hits);        // out: GetCounts
+JSS(rpc_cache_misses);      // out: GetCounts
+JSS(rpc_cache_size);        // out: GetCounts
 JSS(rt_accounts);  // in: Subscribe, Unsubscribe
 JSS(running_duration_us);
 JSS(search_depth);              // in: RipplePathFind
@@ -581,6 +597,7 @@ JSS(source_account);            // in: PathRequest, RipplePathFind
 JSS(source_amount);             // in: PathRequest, RipplePathFind
 JSS(source_currencies);         // in: PathRequest, RipplePathFind
 JSS(source_tag);                // out: AccountChannels
+JSS(spills);                    // out: PerfLog
 JSS(stand_alone);               // out: NetworkOPs
 JSS(start);                     // in: TxHistory
 JSS(started);
@@ -604,6 +621,7 @@ JSS(taker_gets);            // in: Subscribe, Unsubscribe, BookOffers
 JSS(taker_gets_funded);     // out: NetworkOPs
 JSS(taker_pays);            // in: Subscribe, Unsubscribe, BookOffers
 JSS(taker_pays_funded);     // out: NetworkOPs
+JSS(tasks);                 // out: LedgerReplayer
 JSS(threshold);             // in: Blacklist
 JSS(ticket);                // in: AccountObjects
 JSS(ticket_count);          // out: AccountInfo
@@ -611,6 +629,7 @@ JSS(ticket_seq);            // in: LedgerEntry
 JSS(time);
 JSS(timeouts);                // out: InboundLedger
 JSS(time_interval);           // out: AMM Auction Slot
+JSS(touched);                 // out: RCLStatePrefetch
 JSS(track);                   // out: PeerImp
 JSS(traffic);                 // out: Overlay
 JSS(total);                   // out: counters
@@ -70,6 +70,24 @@ encodeBase58Token(TokenType type, void const* token, std::size_t size);
 std::string
 decodeBase58Token(std::string const& s, TokenType type);
 
+namespace detail {
+
+/** Encode and decode plain base58, without a type or checksum.
+
+    Leading zero bytes are encoded as leading zero digits, and decode back
+    to them. Decoding returns an empty string if the input has a character
+    outside the alphabet, or too many digits.
+*/
+/** @{ */
+std::string
+encodeBase58(void const* message, std::size_t size);
+
+std::string
+decodeBase58(std::string const& s);
+/** @} */
+
+}  // namespace detail
+
 }  // namespace ripple
 
 #endif
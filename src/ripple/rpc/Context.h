@@ -27,11 +27,14 @@
 
 #include <ripple/beast/utility/Journal.h>
 
+#include <functional>
+
 namespace ripple {
 
 class Application;
 class NetworkOPs;
 class LedgerMaster;
+class ReadView;
 
 namespace RPC {
 
@@ -48,6 +51,10 @@ struct Context
     std::shared_ptr<JobQueue::Coro> coro{};
     InfoSub::pointer infoSub{};
     unsigned int apiVersion;
+
+    // For a result that's written as it's produced: whether the client has
+    // gone away, so that the rest needn't be produced.
+    std::function<bool()> stopped{};
 };
 
 struct JsonContext : public Context
@@ -64,6 +71,12 @@ struct JsonContext : public Context
     Json::Value params;
 
     Headers headers{};
+
+    /** The ledger the request is against, if it was looked up before the
+        handler was called. The handler's lookupLedger takes it, rather
+        than looking it up again.
+    */
+    std::shared_ptr<ReadView const> ledger{};
 };
 
 template <class RequestType>
@@ -20,10 +20,16 @@
 #ifndef RIPPLE_RPC_RPCHANDLER_H_INCLUDED
 #define RIPPLE_RPC_RPCHANDLER_H_INCLUDED
 
+#include <ripple/basics/Slice.h>
 #include <ripple/core/Config.h>
 #include <ripple/net/InfoSub.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/Status.h>
+#include <functional>
+
+namespace Json {
+class Object;
+}
 
 namespace ripple {
 namespace RPC {
@@ -34,6 +40,55 @@ struct JsonContext;
 Status
 doCommand(RPC::JsonContext&, Json::Value&);
 
+/** Whether an RPC command's result is large enough to be streamed.
+
+    If so, doCommand can write the result to a Json::Object as it's
+    produced, rather than build it in memory.
+*/
+bool
+isStreamed(RPC::JsonContext&);
+
+/** Adds members to a streamed result, given the command's status, once the
+    request has been checked.
+*/
+using StreamedMembers = std::function<void(Status const&, Json::Value&)>;
+
+/** Execute an RPC command that isStreamed, writing its result as it goes.
+
+    The result's members are written in key order, as they are from a
+    Json::Value, so that either way the reply is the same. The members
+    that aren't written as they're produced are gathered first, for
+    members to add to.
+
+    Exceptions thrown by the command are not caught, since by then part of
+    the result may have been written.
+*/
+Status
+doCommand(RPC::JsonContext&, Json::Object&, StreamedMembers const& members);
+
+/** Where an RPC command whose result is raw bytes writes them. */
+struct BinaryOutput
+{
+    /** Called once the request has been checked, before any is written. */
+    std::function<void()> start;
+
+    /** Write part of the result. Returns false if the rest isn't wanted. */
+    std::function<bool(Slice)> write;
+};
+
+/** Whether an RPC command's result is raw bytes rather than JSON. */
+bool
+isBinary(RPC::JsonContext&);
+
+/** Execute an RPC command that isBinary, writing its result as it goes.
+
+    A request that fails its checks is reported before output.start is
+    called, and nothing is written. Exceptions thrown by the command are not
+    caught.
+*/
+Status
+doCommand(RPC::JsonContext&, BinaryOutput const&);
+
 Role
 roleRequired(unsigned int version, bool betaEnabled, std::string const& method);
 
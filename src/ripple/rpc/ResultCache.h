@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_RESULTCACHE_H_INCLUDED
+#define RIPPLE_RPC_RESULTCACHE_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/hardened_hash.h>
+#include <ripple/json/json_value.h>
+#include <ripple/resource/Charge.h>
+#include <ripple/rpc/Role.h>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ripple {
+namespace RPC {
+
+/** Keeps the results of commands against validated ledgers.
+
+    Such a result depends only on the ledger and the request, so the same
+    request against the same ledger can be answered with it. Results for
+    other ledgers are never found, so nothing has to be invalidated: the
+    results used least recently are dropped to stay within the budget.
+*/
+class ResultCache
+{
+public:
+    struct Result
+    {
+        std::shared_ptr<Json::Value const> value;
+
+        // What producing the result was charged, to charge whenever it's
+        // used instead.
+        Resource::Charge loadType;
+    };
+
+    struct Stats
+    {
+        std::size_t entries = 0;
+        std::size_t bytes = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+    };
+
+    /** Create a cache.
+
+        @param budget The approximate bytes results may take. 0 disables
+                      the cache.
+        @param commands The commands whose results are kept.
+    */
+    ResultCache(std::size_t budget, std::vector<std::string> const& commands);
+
+    ResultCache(ResultCache const&) = delete;
+    ResultCache&
+    operator=(ResultCache const&) = delete;
+
+    /** Whether results of the command are kept. */
+    bool
+    enabled(std::string_view command) const;
+
+    /** The key of a request's result.
+
+        The members that select the ledger or identify the request are
+        left out of the parameters, so requests that differ only in those
+        share a result.
+    */
+    static uint256
+    key(uint256 const& ledgerHash,
+        std::string const& command,
+        Json::Value const& params,
+        unsigned apiVersion,
+        Role role);
+
+    /** The result kept under the key, if there is one. */
+    std::optional<Result>
+    find(uint256 const& key);
+
+    /** Keep a result, and what producing it was charged. */
+    void
+    insert(
+        uint256 const& key,
+        Json::Value const& result,
+        Resource::Charge const& loadType);
+
+    Stats
+    stats() const;
+
+    /** The approximate bytes a value takes. */
+    static std::size_t
+    footprint(Json::Value const& value);
+
+private:
+    struct Entry
+    {
+        uint256 key;
+        Result result;
+        std::size_t bytes;
+    };
+
+    using List = std::list<Entry>;
+
+    std::size_t const budget_;
+    std::set<std::string, std::less<>> const commands_;
+
+    mutable std::mutex mutex_;
+    // Most recently used first.
+    List list_;
+    std::unordered_map<uint256, List::iterator, hardened_hash<>> map_;
+    Stats stats_;
+};
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
@@ -34,6 +34,7 @@
 #include <condition_variable>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 namespace ripple {
@@ -201,8 +202,11 @@ private:
         std::shared_ptr<Session> const&,
         std::shared_ptr<JobQueue::Coro> coro);
 
-    void
+    // Returns whether the reply was streamed, in which case the request
+    // has been completed.
+    bool
     processRequest(
+        Session& session,
         Port const& port,
         std::string const& request,
         beast::IP::Endpoint const& remoteIPAddress,
@@ -211,6 +215,50 @@ private:
         boost::string_view forwardedFor,
         boost::string_view user);
 
+    // Returns the reply to a request, or to one entry of a batch. A request
+    // that isn't a batch may be answered here instead, and then there's no
+    // reply: streamed says whether it was answered.
+    std::optional<Json::Value>
+    processCommand(
+        Session& session,
+        Port const& port,
+        Json::Value const& jsonRPC,
+        bool batch,
+        beast::IP::Endpoint const& remoteIPAddress,
+        Output const& output,
+        std::shared_ptr<JobQueue::Coro> const& coro,
+        boost::string_view forwardedFor,
+        boost::string_view user,
+        bool& streamed);
+
+    // Returns the replies to the entries of a batch, in order. Entries that
+    // don't change state are evaluated several at a time.
+    std::vector<Json::Value>
+    processBatch(
+        Session& session,
+        Port const& port,
+        Json::Value const& entries,
+        beast::IP::Endpoint const& remoteIPAddress,
+        Output const& output,
+        std::shared_ptr<JobQueue::Coro> const& coro,
+        boost::string_view forwardedFor,
+        boost::string_view user);
+
+    void
+    streamReply(
+        Session& session,
+        std::shared_ptr<JobQueue::Coro> const& coro,
+        RPC::JsonContext& context);
+
+    // Returns false if the request failed its checks, with the failure in
+    // result and nothing sent.
+    bool
+    binaryReply(
+        Session& session,
+        std::shared_ptr<JobQueue::Coro> const& coro,
+        RPC::JsonContext& context,
+        Json::Value& result);
+
     Handoff
     statusResponse(http_request_type const& request) const;
 };
@@ -175,63 +175,75 @@ doAccountLines(RPC::JsonContext& context)
     auto count = 0;
     std::optional<uint256> marker = {};
     std::uint64_t nextHint = 0;
+    auto visit = [&visitData, &count, &marker, &limit, &nextHint](
+                     std::shared_ptr<SLE const> const& sleCur) {
+        if (!sleCur)
+        {
+            assert(false);
+            return false;
+        }
+
+        if (++count == limit)
+        {
+            marker = sleCur->key();
+            nextHint = RPC::getStartHint(sleCur, visitData.accountID);
+        }
+
+        if (sleCur->getType() != ltRIPPLE_STATE)
+            return true;
+
+        bool ignore = false;
+        if (visitData.ignoreDefault)
+        {
+            if (sleCur->getFieldAmount(sfLowLimit).getIssuer() ==
+                visitData.accountID)
+                ignore = !(sleCur->getFieldU32(sfFlags) & lsfLowReserve);
+            else
+                ignore = !(sleCur->getFieldU32(sfFlags) & lsfHighReserve);
+        }
+
+        if (!ignore && count <= limit)
+        {
+            auto const line =
+                RPCTrustLine::makeItem(visitData.accountID, sleCur);
+
+            if (line &&
+                (!visitData.raPeerAccount ||
+                 *visitData.raPeerAccount == line->getAccountIDPeer()))
+            {
+                visitData.items.emplace_back(*line);
+            }
+        }
+
+        return true;
+    };
+
+    // The index looks at the same entries of the directory as the walk,
+    // and the limit counts all of them, but only the trust lines among them
+    // are read.
+    if (auto const owned = RPC::readOwned(
+            context.app.getOwnerIndex(),
+            *ledger,
+            accountID,
+            {ltRIPPLE_STATE},
+            startAfter,
+            startHint,
+            limit))
     {
-        if (!forEachItemAfter(
-                *ledger,
-                accountID,
-                startAfter,
-                startHint,
-                limit + 1,
-                [&visitData, &count, &marker, &limit, &nextHint](
-                    std::shared_ptr<SLE const> const& sleCur) {
-                    if (!sleCur)
-                    {
-                        assert(false);
-                        return false;
-                    }
-
-                    if (++count == limit)
-                    {
-                        marker = sleCur->key();
-                        nextHint =
-                            RPC::getStartHint(sleCur, visitData.accountID);
-                    }
-
-                    if (sleCur->getType() != ltRIPPLE_STATE)
-                        return true;
-
-                    bool ignore = false;
-                    if (visitData.ignoreDefault)
-                    {
-                        if (sleCur->getFieldAmount(sfLowLimit).getIssuer() ==
-                            visitData.accountID)
-                            ignore =
-                                !(sleCur->getFieldU32(sfFlags) & lsfLowReserve);
-                        else
-                            ignore = !(
-                                sleCur->getFieldU32(sfFlags) & lsfHighReserve);
-                    }
-
-                    if (!ignore && count <= limit)
-                    {
-                        auto const line =
-                            RPCTrustLine::makeItem(visitData.accountID, sleCur);
-
-                        if (line &&
-                            (!visitData.raPeerAccount ||
-                             *visitData.raPeerAccount ==
-                                 line->getAccountIDPeer()))
-                        {
-                            visitData.items.emplace_back(*line);
-                        }
-                    }
-
-                    return true;
-                }))
+        for (auto const& sle : owned->entries)
+            visit(sle);
+        if (auto const& resume = owned->resume)
         {
-            return rpcError(rpcINVALID_PARAMS);
+            count = limit + 1;
+            marker = resume->key;
+            nextHint = resume->page;
         }
     }
+    else if (!forEachItemAfter(
+                 *ledger, accountID, startAfter, startHint, limit + 1, visit))
+    {
+        return rpcError(rpcINVALID_PARAMS);
+    }
 
     // Both conditions need to be checked because marker is set on the limit-th
     // item, but if there is no item on the limit + 1 iteration, then there is
@@ -255,7 +255,19 @@ doAccountObjects(RPC::JsonContext& context)
             return RPC::invalid_field_error(jss::marker);
     }
 
-    if (!RPC::getAccountObjects(
+    bool const indexed = typeFilter &&
+        RPC::getIndexedAccountObjects(
+            context.app.getOwnerIndex(),
+            *ledger,
+            accountID,
+            *typeFilter,
+            dirIndex,
+            entryIndex,
+            limit,
+            result);
+
+    if (!indexed &&
+        !RPC::getAccountObjects(
             *ledger,
             accountID,
             typeFilter,
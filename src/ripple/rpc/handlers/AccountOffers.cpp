@@ -132,33 +132,51 @@ doAccountOffers(RPC::JsonContext& context)
     auto count = 0;
     std::optional<uint256> marker = {};
     std::uint64_t nextHint = 0;
-    if (!forEachItemAfter(
+    auto visit = [&offers, &count, &marker, &limit, &nextHint, &accountID](
+                     std::shared_ptr<SLE const> const& sle) {
+        if (!sle)
+        {
+            assert(false);
+            return false;
+        }
+
+        if (++count == limit)
+        {
+            marker = sle->key();
+            nextHint = RPC::getStartHint(sle, accountID);
+        }
+
+        if (count <= limit && sle->getType() == ltOFFER)
+        {
+            offers.emplace_back(sle);
+        }
+
+        return true;
+    };
+
+    // The index looks at the same entries of the directory as the walk,
+    // and the limit counts all of them, but only the offers among them
+    // are read.
+    if (auto const owned = RPC::readOwned(
+            context.app.getOwnerIndex(),
             *ledger,
             accountID,
+            {ltOFFER},
             startAfter,
             startHint,
-            limit + 1,
-            [&offers, &count, &marker, &limit, &nextHint, &accountID](
-                std::shared_ptr<SLE const> const& sle) {
-                if (!sle)
-                {
-                    assert(false);
-                    return false;
-                }
-
-                if (++count == limit)
-                {
-                    marker = sle->key();
-                    nextHint = RPC::getStartHint(sle, accountID);
-                }
-
-                if (count <= limit && sle->getType() == ltOFFER)
-                {
-                    offers.emplace_back(sle);
-                }
-
-                return true;
-            }))
+            limit))
+    {
+        for (auto const& sle : owned->entries)
+            visit(sle);
+        if (auto const& resume = owned->resume)
+        {
+            count = limit + 1;
+            marker = resume->key;
+            nextHint = resume->page;
+        }
+    }
+    else if (!forEachItemAfter(
+                 *ledger, accountID, startAfter, startHint, limit + 1, visit))
     {
         return rpcError(rpcINVALID_PARAMS);
     }
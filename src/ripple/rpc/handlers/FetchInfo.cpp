@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/LedgerReplayer.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/json/json_value.h>
@@ -44,6 +45,9 @@ doFetchInfo(RPC::JsonContext& context)
 
     ret[jss::info] = context.netOps.getLedgerFetchInfo();
 
+    if (context.app.config().LEDGER_REPLAY)
+        ret[jss::ledger_replay] = context.app.getLedgerReplayer().getJson();
+
     return ret;
 }
 
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/OwnerIndex.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/paths/TrustLine.h>
 #include <ripple/ledger/ReadView.h>
@@ -28,6 +29,7 @@
 #include <ripple/resource/Fees.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
+#include <limits>
 
 namespace ripple {
 
@@ -128,67 +130,84 @@ doGatewayBalances(RPC::JsonContext& context)
 
     // Traverse the cold wallet's trust lines
     {
-        forEachItem(
-            *ledger, accountID, [&](std::shared_ptr<SLE const> const& sle) {
-                auto rs = PathFindTrustLine::makeItem(accountID, sle);
+        auto visit = [&](std::shared_ptr<SLE const> const& sle) {
+            auto rs = PathFindTrustLine::makeItem(accountID, sle);
 
-                if (!rs)
-                    return;
+            if (!rs)
+                return;
 
-                int balSign = rs->getBalance().signum();
-                if (balSign == 0)
-                    return;
+            int balSign = rs->getBalance().signum();
+            if (balSign == 0)
+                return;
 
-                auto const& peer = rs->getAccountIDPeer();
+            auto const& peer = rs->getAccountIDPeer();
 
-                // Here, a negative balance means the cold wallet owes (normal)
-                // A positive balance means the cold wallet has an asset
-                // (unusual)
+            // Here, a negative balance means the cold wallet owes (normal)
+            // A positive balance means the cold wallet has an asset
+            // (unusual)
 
-                if (hotWallets.count(peer) > 0)
-                {
-                    // This is a specified hot wallet
-                    hotBalances[peer].push_back(-rs->getBalance());
-                }
-                else if (balSign > 0)
-                {
-                    // This is a gateway asset
-                    assets[peer].push_back(rs->getBalance());
-                }
-                else if (rs->getFreeze())
+            if (hotWallets.count(peer) > 0)
+            {
+                // This is a specified hot wallet
+                hotBalances[peer].push_back(-rs->getBalance());
+            }
+            else if (balSign > 0)
+            {
+                // This is a gateway asset
+                assets[peer].push_back(rs->getBalance());
+            }
+            else if (rs->getFreeze())
+            {
+                // An obligation the gateway has frozen
+                frozenBalances[peer].push_back(-rs->getBalance());
+            }
+            else
+            {
+                // normal negative balance, obligation to customer
+                auto& bal = sums[rs->getBalance().getCurrency()];
+                if (bal == beast::zero)
                 {
-                    // An obligation the gateway has frozen
-                    frozenBalances[peer].push_back(-rs->getBalance());
+                    // This is needed to set the currency code correctly
+                    bal = -rs->getBalance();
                 }
                 else
                 {
-                    // normal negative balance, obligation to customer
-                    auto& bal = sums[rs->getBalance().getCurrency()];
-                    if (bal == beast::zero)
+                    try
                     {
-                        // This is needed to set the currency code correctly
-                        bal = -rs->getBalance();
+                        bal -= rs->getBalance();
                     }
-                    else
+                    catch (std::runtime_error const&)
                     {
-                        try
-                        {
-                            bal -= rs->getBalance();
-                        }
-                        catch (std::runtime_error const&)
-                        {
-                            // Presumably the exception was caused by overflow.
-                            // On overflow return the largest valid STAmount.
-                            // Very large sums of STAmount are approximations
-                            // anyway.
-                            bal = STAmount(
-                                bal.issue(),
-                                STAmount::cMaxValue,
-                                STAmount::cMaxOffset);
-                        }
+                        // Presumably the exception was caused by overflow.
+                        // On overflow return the largest valid STAmount.
+                        // Very large sums of STAmount are approximations
+                        // anyway.
+                        bal = STAmount(
+                            bal.issue(),
+                            STAmount::cMaxValue,
+                            STAmount::cMaxOffset);
                     }
                 }
-            });
+            }
+        };
+
+        // The index has the lines of the largest accounts without the rest
+        // of what they own.
+        if (auto const lines = context.app.getOwnerIndex().find(
+                *ledger,
+                accountID,
+                {ltRIPPLE_STATE},
+                {},
+                true,
+                std::numeric_limits<std::size_t>::max()))
+        {
+            for (auto const& line : lines->found)
+                visit(ledger->read(keylet::child(line.key)));
+        }
+        else
+        {
+            forEachItem(*ledger, accountID, visit);
+        }
     }
 
     if (!sums.empty())
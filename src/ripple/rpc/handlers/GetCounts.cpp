@@ -32,6 +32,7 @@
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/rpc/ResultCache.h>
 #include <ripple/shamap/ShardFamily.h>
 
 namespace ripple {
@@ -112,6 +113,14 @@ getCountsJson(Application& app, int minObjectCount)
     ret[jss::AL_size] = Json::UInt(app.getAcceptedLedgerCache().size());
     ret[jss::AL_hit_rate] = app.getAcceptedLedgerCache().getHitRate();
 
+    {
+        auto const rpc = app.getRPCResultCache().stats();
+        ret[jss::rpc_cache_size] = Json::UInt(rpc.entries);
+        ret[jss::rpc_cache_bytes] = Json::UInt(rpc.bytes);
+        ret[jss::rpc_cache_hits] = Json::UInt(rpc.hits);
+        ret[jss::rpc_cache_misses] = Json::UInt(rpc.misses);
+    }
+
     ret[jss::fullbelow_size] =
         static_cast<int>(app.getNodeFamily().getFullBelowCache(0)->size());
     ret[jss::treenode_cache_size] =
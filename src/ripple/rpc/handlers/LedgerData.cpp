@@ -17,10 +17,12 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/LedgerFormats.h>
+#include <ripple/protocol/STObjectView.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/GRPCHandlers.h>
@@ -99,33 +101,73 @@ doLedgerData(RPC::JsonContext& context)
         nodes = Json::Value(Json::arrayValue);
     }
 
-    auto e = lpLedger->sles.end();
-    for (auto i = lpLedger->sles.upper_bound(key); i != e; ++i)
-    {
-        auto sle = lpLedger->read(keylet::unchecked((*i)->key()));
-        if (limit-- <= 0)
+    auto addEntry = [&](SLE const& sle) {
+        if (isBinary)
         {
-            // Stop processing before the current key.
-            auto k = sle->key();
-            jvResult[jss::marker] = to_string(--k);
-            break;
+            Json::Value& entry = nodes.append(Json::objectValue);
+            entry[jss::data] = serializeHex(sle);
+            entry[jss::index] = to_string(sle.key());
+        }
+        else
+        {
+            Json::Value& entry = nodes.append(sle.getJson(JsonOptions::none));
+            entry[jss::index] = to_string(sle.key());
         }
+    };
 
-        if (type == ltANY || sle->getType() == type)
+    // A ledger's state map can be walked directly, so entries are only
+    // deserialized if they pass the type filter, and not at all when the
+    // result is binary.
+    if (auto const ledger = std::dynamic_pointer_cast<Ledger const>(lpLedger))
+    {
+        auto const& map = ledger->stateMap();
+        for (auto i = map.upper_bound(key); i != map.end(); ++i)
         {
+            if (limit-- <= 0)
+            {
+                // Stop processing before the current key.
+                auto k = i->key();
+                jvResult[jss::marker] = to_string(--k);
+                break;
+            }
+
+            if (type != ltANY)
+            {
+                STObjectView const view(i->slice(), nullptr);
+                if (safe_cast<LedgerEntryType>(view[sfLedgerEntryType]) !=
+                    type)
+                    continue;
+            }
+
             if (isBinary)
             {
                 Json::Value& entry = nodes.append(Json::objectValue);
-                entry[jss::data] = serializeHex(*sle);
-                entry[jss::index] = to_string(sle->key());
+                entry[jss::data] = strHex(i->slice());
+                entry[jss::index] = to_string(i->key());
             }
             else
             {
-                Json::Value& entry =
-                    nodes.append(sle->getJson(JsonOptions::none));
-                entry[jss::index] = to_string(sle->key());
+                addEntry(SLE{SerialIter{i->slice()}, i->key()});
             }
         }
+
+        return jvResult;
+    }
+
+    auto e = lpLedger->sles.end();
+    for (auto i = lpLedger->sles.upper_bound(key); i != e; ++i)
+    {
+        auto const sle = *i;
+        if (limit-- <= 0)
+        {
+            // Stop processing before the current key.
+            auto k = sle->key();
+            jvResult[jss::marker] = to_string(--k);
+            break;
+        }
+
+        if (type == ltANY || sle->getType() == type)
+            addEntry(*sle);
     }
 
     return jvResult;
@@ -184,7 +226,7 @@ doLedgerDataGrpc(
 
     for (auto i = ledger->sles.upper_bound(startKey); i != e; ++i)
     {
-        auto sle = ledger->read(keylet::unchecked((*i)->key()));
+        auto const sle = *i;
         if (maxLimit-- <= 0)
         {
             // Stop processing before the current key.
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/StateExport.h>
+#include <ripple/basics/Log.h>
+#include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/resource/Fees.h>
+#include <ripple/rpc/handlers/LedgerExport.h>
+#include <ripple/rpc/impl/RPCHelpers.h>
+#include <chrono>
+
+namespace ripple {
+namespace RPC {
+
+LedgerExportHandler::LedgerExportHandler(JsonContext& context)
+    : context_(context)
+{
+}
+
+Status
+LedgerExportHandler::check()
+{
+    auto const& params = context_.params;
+
+    std::shared_ptr<ReadView const> view;
+    Json::Value result;
+    if (auto s = lookupLedger(view, context_, result))
+        return s;
+
+    // An open ledger has no state map to walk.
+    ledger_ = std::dynamic_pointer_cast<Ledger const>(view);
+    if (!ledger_ || ledger_->open())
+        return {rpcINVALID_PARAMS, "Only closed ledgers can be exported."};
+
+    if (params.isMember(jss::marker))
+    {
+        Json::Value const& jMarker = params[jss::marker];
+        if (!(jMarker.isString() && marker_.emplace().parseHex(
+                                        jMarker.asString())))
+            return {
+                rpcINVALID_PARAMS,
+                expected_field_message(jss::marker, "valid")};
+    }
+
+    context_.loadType = Resource::feeHighBurdenRPC;
+    return Status::OK;
+}
+
+void
+LedgerExportHandler::writeResult(Json::Value& result)
+{
+    inject_error(
+        rpcNOT_SUPPORTED, "ledger_export is only available over HTTP.", result);
+}
+
+void
+LedgerExportHandler::writeBinary(BinaryOutput const& output)
+{
+    using namespace std::chrono;
+    auto const start = steady_clock::now();
+
+    std::size_t bytes = 0;
+    bool more = true;
+    if (!marker_)
+    {
+        Serializer s;
+        addRaw(ledger_->info(), s);
+        std::string header;
+        StateExport::append(header, ledger_->info().hash, s.slice());
+        bytes += header.size();
+        more = output.write(makeSlice(header));
+    }
+
+    StateExport state(
+        context_.app.getJobQueue(),
+        ledger_->stateMap(),
+        marker_.value_or(uint256{}));
+    while (more)
+    {
+        auto const block = state.next();
+        if (block.empty())
+            break;
+        bytes += block.size();
+        more = output.write(makeSlice(block));
+    }
+
+    auto const elapsed =
+        duration_cast<milliseconds>(steady_clock::now() - start);
+    JLOG(context_.j.info())
+        << "ledger_export of ledger " << ledger_->info().seq << ": "
+        << state.entries() << " entries, " << bytes << " bytes in "
+        << elapsed.count() << "ms, "
+        << bytes / 1000 / std::max<std::int64_t>(elapsed.count(), 1)
+        << "MB/s" << (more ? "" : ", until the client went away");
+}
+
+}  // namespace RPC
+}  // namespace ripple
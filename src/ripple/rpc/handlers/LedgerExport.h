@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_HANDLERS_LEDGEREXPORT_H_INCLUDED
+#define RIPPLE_RPC_HANDLERS_LEDGEREXPORT_H_INCLUDED
+
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/rpc/Context.h>
+#include <ripple/rpc/Role.h>
+#include <ripple/rpc/Status.h>
+#include <ripple/rpc/impl/Handler.h>
+
+namespace ripple {
+namespace RPC {
+
+// ledger_export [id|index|closed|validated] [marker]
+// {
+//    ledger_hash: <uint256>,  // optional
+//    ledger_index: 'closed' | 'validated' | <number>,  // optional
+//    marker: <uint256>  // optional, the last key received
+// }
+//
+// Sends the state of a closed ledger as raw binary over HTTP, in key order:
+// each entry is a record laid out as StateExport describes. Unless there's
+// a marker, the state is preceded by a record of the ledger's header, keyed
+// by the ledger's hash. A reply that was cut short can be resumed with the
+// last key received as the marker.
+
+class LedgerExportHandler
+{
+public:
+    explicit LedgerExportHandler(JsonContext&);
+
+    Status
+    check();
+
+    // Over websockets, or in a batch, there's no way to send the state.
+    void
+    writeResult(Json::Value&);
+
+    void
+    writeBinary(BinaryOutput const&);
+
+    static char const*
+    name()
+    {
+        return "ledger_export";
+    }
+
+    static Role
+    role()
+    {
+        return Role::ADMIN;
+    }
+
+    static Condition
+    condition()
+    {
+        return NO_CONDITION;
+    }
+
+private:
+    JsonContext& context_;
+    std::shared_ptr<Ledger const> ledger_;
+    std::optional<uint256> marker_;
+};
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
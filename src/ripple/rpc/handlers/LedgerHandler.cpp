@@ -28,6 +28,7 @@
 #include <ripple/rpc/Role.h>
 #include <ripple/rpc/handlers/LedgerHandler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
+#include <ripple/rpc/impl/Tuning.h>
 
 namespace ripple {
 namespace RPC {
@@ -99,6 +100,61 @@ LedgerHandler::check()
     return Status::OK;
 }
 
+void
+LedgerHandler::writeResult(Json::Object& value, Json::Value members)
+{
+    if (!ledger_)
+    {
+        writeResult(members);
+        Json::copyFrom(value, members);
+        return;
+    }
+
+    Json::copyFrom(members, result_);
+    addJson(
+        value,
+        {*ledger_, &context_, options_, queueTxs_, type_},
+        std::move(members));
+}
+
+bool
+LedgerHandler::streamed(JsonContext& context)
+{
+    auto const& params = context.params;
+    bool const full = params[jss::full].asBool();
+    bool const state = full || params[jss::accounts].asBool();
+    bool const txs = full ||
+        (params[jss::transactions].asBool() && params[jss::expand].asBool());
+    bool const needsLedger = params.isMember(jss::ledger) ||
+        params.isMember(jss::ledger_hash) ||
+        params.isMember(jss::ledger_index) || context.app.config().reporting();
+    if (!needsLedger || (!state && !txs))
+        return false;
+
+    // A request that can't be answered is reported when it's checked.
+    std::shared_ptr<ReadView const> ledger;
+    Json::Value result;
+    if (lookupLedger(ledger, context, result))
+        return false;
+
+    // The reply to a small ledger is built like any other. Counting the
+    // entries doesn't read them.
+    int entries = 0;
+    auto const large = [&](auto const& range) {
+        for (auto iter = range.begin(); iter != range.end(); ++iter)
+        {
+            if (++entries > Tuning::minStreamedEntries)
+                return true;
+        }
+        return false;
+    };
+    if (!(state && large(ledger->sles)) && !(txs && large(ledger->txs)))
+        return false;
+
+    context.ledger = std::move(ledger);
+    return true;
+}
+
 }  // namespace RPC
 
 std::pair<org::xrpl::rpc::v1::GetLedgerResponse, grpc::Status>
@@ -58,6 +58,10 @@ public:
     void
     writeResult(Object&);
 
+    /** Write a streamed result, with other members in key order. */
+    void
+    writeResult(Json::Object&, Json::Value members);
+
     static char const*
     name()
     {
@@ -76,6 +80,14 @@ public:
         return NO_CONDITION;
     }
 
+    /** Whether the result of a request is streamed rather than built: a
+        large ledger with its state, or with all of its transactions in
+        full. The ledger that's looked up to tell is kept in the context
+        for the handler.
+    */
+    static bool
+    streamed(JsonContext& context);
+
 private:
     JsonContext& context_;
     std::shared_ptr<ReadView const> ledger_;
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/json/Object.h>
 #include <ripple/rpc/handlers/Handlers.h>
 #include <ripple/rpc/handlers/Version.h>
 #include <ripple/rpc/impl/Handler.h>
@@ -57,6 +58,49 @@ handle(JsonContext& context, Object& object)
     return status;
 };
 
+// Like handle, for a result that's written as it's produced. What's
+// reported on a failure, and the members of the result that the handler
+// builds, are gathered with the caller's, so that all can be written in
+// key order.
+template <class HandlerImpl>
+Status
+handleStreamed(
+    JsonContext& context,
+    Json::Object& object,
+    StreamedMembers const& members)
+{
+    HandlerImpl handler(context);
+
+    Json::Value value(Json::objectValue);
+    auto status = handler.check();
+    if (status)
+        status.inject(value);
+    members(status, value);
+
+    if (status)
+        Json::copyFrom(object, value);
+    else
+        handler.writeResult(object, std::move(value));
+    return status;
+}
+
+// Like handle, for a result that's raw bytes: a failure is reported
+// instead of any result.
+template <class HandlerImpl>
+Status
+handleBinary(JsonContext& context, BinaryOutput const& output)
+{
+    HandlerImpl handler(context);
+
+    auto status = handler.check();
+    if (!status)
+    {
+        output.start();
+        handler.writeBinary(output);
+    }
+    return status;
+}
+
 Handler const handlerArray[]{
     // Some handlers not specified here are added to the table via addHandler()
     // Request-response methods
@@ -186,6 +230,7 @@ private:
 
         // This is where the new-style handlers are added.
         addHandler<LedgerHandler>();
+        addHandler<LedgerExportHandler>();
         addHandler<VersionHandler>();
     }
 
@@ -234,6 +279,22 @@ private:
         h.role_ = HandlerImpl::role();
         h.condition_ = HandlerImpl::condition();
 
+        if constexpr (requires(JsonContext& context) {
+                          HandlerImpl::streamed(context);
+                      })
+        {
+            h.streamed_ = &HandlerImpl::streamed;
+            h.objectMethod_ = &handleStreamed<HandlerImpl>;
+        }
+
+        if constexpr (requires(
+                          HandlerImpl & handler, BinaryOutput const& output) {
+                          handler.writeBinary(output);
+                      })
+        {
+            h.binaryMethod_ = &handleBinary<HandlerImpl>;
+        }
+
         table_[HandlerImpl::name()] = h;
     }
 };
@@ -52,6 +52,16 @@ struct Handler
     Method<Json::Value> valueMethod_;
     Role role_;
     RPC::Condition condition_;
+
+    // For handlers whose results can be too large to build in memory:
+    // which requests to stream, and the method that writes their results
+    // as they're produced.
+    bool (*streamed_)(JsonContext& context) = nullptr;
+    std::function<Status(JsonContext&, Json::Object&, StreamedMembers const&)>
+        objectMethod_;
+
+    // For handlers whose results are raw bytes rather than JSON.
+    Method<BinaryOutput const> binaryMethod_;
 };
 
 Handler const*
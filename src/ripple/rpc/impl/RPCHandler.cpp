@@ -37,11 +37,14 @@
 #include <ripple/resource/Fees.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/RPCHandler.h>
+#include <ripple/rpc/ResultCache.h>
 #include <ripple/rpc/Role.h>
 #include <ripple/rpc/impl/Handler.h>
+#include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/rpc/impl/Tuning.h>
 #include <atomic>
 #include <chrono>
+#include <optional>
 #include <variant>
 
 namespace ripple {
@@ -224,6 +227,49 @@ callMethod(
     }
 }
 
+// Calls the handler, or answers with the result it gave the same request
+// against the same ledger, if that's kept.
+Status
+callCached(JsonContext& context, Handler const& handler, Json::Value& result)
+{
+    auto& cache = context.app.getRPCResultCache();
+    std::optional<uint256> key;
+    if (cache.enabled(handler.name_) && !context.app.config().reporting())
+    {
+        // Only a validated ledger's results are final. The handler takes
+        // the ledger found here, rather than looking it up again.
+        std::shared_ptr<ReadView const> ledger;
+        auto const status = lookupLedger(ledger, context);
+        if (ledger && status[jss::validated].asBool())
+            key = ResultCache::key(
+                ledger->info().hash,
+                handler.name_,
+                context.params,
+                context.apiVersion,
+                context.role);
+        context.ledger = std::move(ledger);
+    }
+
+    if (key)
+    {
+        if (auto const cached = cache.find(*key))
+        {
+            // A result costs the same whether it's produced or kept.
+            context.loadType = cached->loadType;
+            result = *cached->value;
+            context.ledger.reset();
+            return rpcSUCCESS;
+        }
+    }
+
+    auto const ret =
+        callMethod(context, handler.valueMethod_, handler.name_, result);
+    context.ledger.reset();
+    if (key && !ret && !result.isMember(jss::error))
+        cache.insert(*key, result, context.loadType);
+    return ret;
+}
+
 }  // namespace
 
 void
@@ -263,7 +309,7 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
         return error;
     }
 
-    if (auto method = handler->valueMethod_)
+    if (handler->valueMethod_)
     {
         if (!context.headers.user.empty() ||
             !context.headers.forwardedFor.empty())
@@ -273,7 +319,7 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
                 << ", user: " << context.headers.user
                 << ", forwarded for: " << context.headers.forwardedFor;
 
-            auto ret = callMethod(context, method, handler->name_, result);
+            auto ret = callCached(context, *handler, result);
 
             JLOG(context.j.debug())
                 << "finish command: " << handler->name_
@@ -284,7 +330,7 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
         }
         else
         {
-            auto ret = callMethod(context, method, handler->name_, result);
+            auto ret = callCached(context, *handler, result);
             injectReportingWarning(context, result);
             return ret;
         }
@@ -293,6 +339,94 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
     return rpcUNKNOWN_COMMAND;
 }
 
+namespace {
+
+// The handler that runs a command here, if there is one.
+Handler const*
+localHandler(RPC::JsonContext& context)
+{
+    if (shouldForwardToP2p(context))
+        return nullptr;
+
+    // Failures are left for the other doCommand to report.
+    Handler const* handler = nullptr;
+    if (fillHandler(context, handler))
+        return nullptr;
+
+    return handler;
+}
+
+// Run a method of a handler that writes its result as it goes, and so
+// can't have its exceptions turned into errors.
+template <class Output>
+Status
+callWriter(
+    RPC::JsonContext& context,
+    Handler const& handler,
+    Handler::Method<Output> const& method,
+    Output& result)
+{
+    static std::atomic<std::uint64_t> requestId{0};
+    auto& perfLog = context.app.getPerfLog();
+    std::uint64_t const curId = ++requestId;
+    perfLog.rpcStart(handler.name_, curId);
+    auto const v = context.app.getJobQueue().makeLoadEvent(
+        jtGENERIC, std::string("cmd:") + handler.name_);
+
+    auto const ret = method(context, result);
+    perfLog.rpcFinish(handler.name_, curId);
+    return ret;
+}
+
+}  // namespace
+
+bool
+isStreamed(RPC::JsonContext& context)
+{
+    auto const handler = localHandler(context);
+    return handler && handler->streamed_ && handler->streamed_(context);
+}
+
+Status
+doCommand(
+    RPC::JsonContext& context,
+    Json::Object& result,
+    StreamedMembers const& members)
+{
+    Handler const* handler = nullptr;
+    if (auto error = fillHandler(context, handler))
+    {
+        Json::Value value(Json::objectValue);
+        inject_error(error, value);
+        members(error, value);
+        Json::copyFrom(result, value);
+        return error;
+    }
+
+    Handler::Method<Json::Object> const method =
+        [&](JsonContext& context, Json::Object& result) {
+            return handler->objectMethod_(context, result, members);
+        };
+    return callWriter(context, *handler, method, result);
+}
+
+bool
+isBinary(RPC::JsonContext& context)
+{
+    auto const handler = localHandler(context);
+    return handler && handler->binaryMethod_;
+}
+
+Status
+doCommand(RPC::JsonContext& context, BinaryOutput const& output)
+{
+    Handler const* handler = nullptr;
+    if (auto error = fillHandler(context, handler))
+        return error;
+
+    return callWriter(context, *handler, handler->binaryMethod_, output);
+}
+
 Role
 roleRequired(unsigned int version, bool betaEnabled, std::string const& method)
 {
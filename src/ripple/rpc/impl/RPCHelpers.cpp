@@ -17,9 +17,11 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/app/ledger/OpenLedger.h>
+#include <ripple/app/ledger/OwnerIndex.h>
 #include <ripple/app/misc/Transaction.h>
 #include <ripple/app/paths/TrustLine.h>
 #include <ripple/app/rdb/RelationalDatabase.h>
@@ -244,6 +246,9 @@ getAccountObjects(
         found = true;
     }
 
+    // Entries of a ledger can be read lazily.
+    auto const lazyLedger = dynamic_cast<Ledger const*>(&ledger);
+
     auto dir = ledger.read({ltDIR_NODE, dirIndex});
     if (!dir)
     {
@@ -279,12 +284,30 @@ getAccountObjects(
 
         for (; iter != entries.end(); ++iter)
         {
-            auto const sleNode = ledger.read(keylet::child(*iter));
-
-            if (!typeFilter.has_value() ||
-                typeMatchesFilter(typeFilter.value(), sleNode->getType()))
+            if (typeFilter.has_value() && lazyLedger)
             {
-                jvObjects.append(sleNode->getJson(JsonOptions::none));
+                // Check the type without deserializing the entry, and only
+                // deserialize the entries that are returned.
+                auto const view = lazyLedger->readLazy(keylet::child(*iter));
+                if (view &&
+                    typeMatchesFilter(
+                        typeFilter.value(),
+                        safe_cast<LedgerEntryType>(
+                            (*view)[sfLedgerEntryType])))
+                {
+                    SLE const sleNode{SerialIter{view->slice()}, *iter};
+                    jvObjects.append(sleNode.getJson(JsonOptions::none));
+                }
+            }
+            else
+            {
+                auto const sleNode = ledger.read(keylet::child(*iter));
+
+                if (!typeFilter.has_value() ||
+                    typeMatchesFilter(typeFilter.value(), sleNode->getType()))
+                {
+                    jvObjects.append(sleNode->getJson(JsonOptions::none));
+                }
             }
 
             if (++i == mlimit)
@@ -325,6 +348,91 @@ getAccountObjects(
     }
 }
 
+bool
+getIndexedAccountObjects(
+    OwnerIndex const& index,
+    ReadView const& ledger,
+    AccountID const& account,
+    std::vector<LedgerEntryType> const& types,
+    uint256 const& dirIndex,
+    uint256 const& entryIndex,
+    std::uint32_t const limit,
+    Json::Value& jvResult)
+{
+    // NFT pages aren't in the directory.
+    if (std::find(types.begin(), types.end(), ltNFTOKEN_PAGE) != types.end())
+        return false;
+
+    // The marker is the page and the entry to start at.
+    OwnerIndex::Position start;
+    if (dirIndex.isNonZero())
+    {
+        auto const page = index.page(ledger, account, dirIndex);
+        if (!page)
+            return false;
+        start = {*page, entryIndex};
+    }
+
+    // The limit counts every entry of the directory looked at, as it does
+    // when the directory is walked.
+    auto const found = index.find(ledger, account, types, start, true, limit);
+    if (!found)
+        return false;
+
+    Json::Value jvObjects(Json::arrayValue);
+    for (auto const& position : found->found)
+    {
+        auto const sle = ledger.read(keylet::child(position.key));
+        if (!sle)
+            return false;
+        jvObjects.append(sle->getJson(JsonOptions::none));
+    }
+
+    if (auto const& next = found->next)
+    {
+        jvResult[jss::limit] = limit;
+        jvResult[jss::marker] =
+            to_string(keylet::page(keylet::ownerDir(account), next->page).key) +
+            ',' + to_string(next->key);
+    }
+    jvResult[jss::account_objects] = std::move(jvObjects);
+    return true;
+}
+
+std::optional<OwnedEntries>
+readOwned(
+    OwnerIndex const& index,
+    ReadView const& ledger,
+    AccountID const& account,
+    std::vector<LedgerEntryType> const& types,
+    uint256 const& after,
+    std::uint64_t hint,
+    std::size_t limit)
+{
+    auto const found = index.find(
+        ledger,
+        account,
+        types,
+        {after.isZero() ? 0 : hint, after},
+        after.isZero(),
+        limit);
+    if (!found)
+        return std::nullopt;
+
+    OwnedEntries owned;
+    owned.entries.reserve(found->found.size());
+    for (auto const& position : found->found)
+    {
+        auto sle = ledger.read(keylet::child(position.key));
+        if (!sle)
+            return std::nullopt;
+        owned.entries.push_back(std::move(sle));
+    }
+    if (found->next)
+        owned.resume = found->last;
+    return owned;
+}
+
 namespace {
 
 bool
@@ -677,7 +785,9 @@ lookupLedger(
     JsonContext& context,
     Json::Value& result)
 {
-    if (auto status = ledgerFromRequest(ledger, context))
+    if (context.ledger)
+        ledger = std::move(context.ledger);
+    else if (auto status = ledgerFromRequest(ledger, context))
         return status;
 
     auto& info = ledger->info();
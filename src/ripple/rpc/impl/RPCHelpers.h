@@ -23,6 +23,7 @@
 #include <ripple/beast/core/SemanticVersion.h>
 #include <ripple/protocol/TxMeta.h>
 
+#include <ripple/app/ledger/OwnerIndex.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/protocol/SecretKey.h>
@@ -110,6 +111,51 @@ getAccountObjects(
     std::uint32_t const limit,
     Json::Value& jvResult);
 
+/** Gathers objects of some types for an account from the owner index, the
+    way getAccountObjects gathers them from the account's directory.
+    @return Whether the index could answer. If not, getAccountObjects must
+            be used instead.
+*/
+bool
+getIndexedAccountObjects(
+    OwnerIndex const& index,
+    ReadView const& ledger,
+    AccountID const& account,
+    std::vector<LedgerEntryType> const& types,
+    uint256 const& dirIndex,
+    uint256 const& entryIndex,
+    std::uint32_t const limit,
+    Json::Value& jvResult);
+
+/** What an account owns of some types among a stretch of its directory. */
+struct OwnedEntries
+{
+    // The entries of the types, in directory order.
+    std::vector<std::shared_ptr<SLE const>> entries;
+
+    // The last entry of the stretch, of any type, if entries follow it.
+    std::optional<OwnerIndex::Position> resume;
+};
+
+/** Reads what an account owns of some types from the owner index, for the
+    handlers that page through its directory with forEachItemAfter.
+    @param after The entry to read after, or zero to read from the start.
+    @param hint The page of the directory after is on.
+    @param limit The entries of the directory to look at, of any type, as
+                 forEachItemAfter would visit them.
+    @return What the entries looked at hold of the types, or nothing if the
+            index can't answer and the directory must be walked instead.
+*/
+std::optional<OwnedEntries>
+readOwned(
+    OwnerIndex const& index,
+    ReadView const& ledger,
+    AccountID const& account,
+    std::vector<LedgerEntryType> const& types,
+    uint256 const& after,
+    std::uint64_t hint,
+    std::size_t limit);
+
 /** Get ledger by hash
     If there is no error in the return value, the ledger pointer will have
     been filled
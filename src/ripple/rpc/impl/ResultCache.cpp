@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/json/to_string.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/ResultCache.h>
+#include <cstring>
+
+namespace ripple {
+namespace RPC {
+
+ResultCache::ResultCache(
+    std::size_t budget,
+    std::vector<std::string> const& commands)
+    : budget_(budget), commands_(commands.begin(), commands.end())
+{
+}
+
+bool
+ResultCache::enabled(std::string_view command) const
+{
+    return budget_ != 0 && commands_.find(command) != commands_.end();
+}
+
+uint256
+ResultCache::key(
+    uint256 const& ledgerHash,
+    std::string const& command,
+    Json::Value const& params,
+    unsigned apiVersion,
+    Role role)
+{
+    Json::Value normal(params);
+    if (normal.isObject())
+    {
+        for (auto const& name :
+             {jss::api_version,
+              jss::command,
+              jss::id,
+              jss::jsonrpc,
+              jss::ledger,
+              jss::ledger_hash,
+              jss::ledger_index,
+              jss::method,
+              jss::ripplerpc})
+            normal.removeMember(name);
+    }
+    return sha512Half(
+        ledgerHash,
+        command,
+        apiVersion,
+        static_cast<int>(role),
+        to_string(normal));
+}
+
+std::optional<ResultCache::Result>
+ResultCache::find(uint256 const& key)
+{
+    std::lock_guard lock(mutex_);
+    auto const it = map_.find(key);
+    if (it == map_.end())
+    {
+        ++stats_.misses;
+        return std::nullopt;
+    }
+    ++stats_.hits;
+    list_.splice(list_.begin(), list_, it->second);
+    return it->second->result;
+}
+
+void
+ResultCache::insert(
+    uint256 const& key,
+    Json::Value const& result,
+    Resource::Charge const& loadType)
+{
+    auto const bytes = footprint(result);
+    if (bytes > budget_)
+        return;
+    Result value{std::make_shared<Json::Value const>(result), loadType};
+
+    std::lock_guard lock(mutex_);
+    if (map_.count(key) != 0)
+        return;
+    list_.push_front({key, std::move(value), bytes});
+    map_.emplace(key, list_.begin());
+    stats_.bytes += bytes;
+    while (stats_.bytes > budget_)
+    {
+        auto const& last = list_.back();
+        stats_.bytes -= last.bytes;
+        map_.erase(last.key);
+        list_.pop_back();
+    }
+    stats_.entries = list_.size();
+}
+
+ResultCache::Stats
+ResultCache::stats() const
+{
+    std::lock_guard lock(mutex_);
+    return stats_;
+}
+
+std::size_t
+ResultCache::footprint(Json::Value const& value)
+{
+    std::size_t bytes = sizeof(Json::Value);
+    if (value.isString())
+    {
+        bytes += std::strlen(value.asCString()) + 1;
+    }
+    else if (value.isObject())
+    {
+        for (auto it = value.begin(); it != value.end(); ++it)
+            bytes += std::strlen(it.memberName()) + 1 + footprint(*it);
+    }
+    else if (value.isArray())
+    {
+        for (auto const& element : value)
+            bytes += footprint(element);
+    }
+    return bytes;
+}
+
+}  // namespace RPC
+}  // namespace ripple
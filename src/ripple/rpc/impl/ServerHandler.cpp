@@ -28,6 +28,7 @@
 #include <ripple/beast/net/IPAddressConversion.h>
 #include <ripple/beast/rfc2616.h>
 #include <ripple/core/JobQueue.h>
+#include <ripple/json/Object.h>
 #include <ripple/json/json_reader.h>
 #include <ripple/json/to_string.h>
 #include <ripple/net/RPCErr.h>
@@ -37,18 +38,23 @@
 #include <ripple/resource/ResourceManager.h>
 #include <ripple/rpc/RPCHandler.h>
 #include <ripple/rpc/Role.h>
+#include <ripple/rpc/impl/Handler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/rpc/impl/Tuning.h>
 #include <ripple/rpc/json_body.h>
 #include <ripple/server/Server.h>
 #include <ripple/server/SimpleWriter.h>
+#include <ripple/server/StreamWriter.h>
 #include <ripple/server/impl/JSONRPCUtil.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/beast/http/fields.hpp>
 #include <boost/beast/http/string_body.hpp>
 #include <boost/type_traits.hpp>
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
 
 namespace ripple {
@@ -320,7 +326,8 @@ ServerHandler::onWSMessage(
     Json::Value jv;
     auto const size = boost::asio::buffer_size(buffers);
     if (size > RPC::Tuning::maxRequestSize ||
-        !Json::Reader{}.parse(jv, buffers) || !jv.isObject())
+        !(Json::readStrict(jv, buffers) || Json::Reader{}.parse(jv, buffers)) ||
+        !jv.isObject())
     {
         Json::Value jvResult(Json::objectValue);
         jvResult[jss::type] = jss::error;
@@ -550,7 +557,8 @@ ServerHandler::processSession(
     std::shared_ptr<Session> const& session,
     std::shared_ptr<JobQueue::Coro> coro)
 {
-    processRequest(
+    auto const streamed = processRequest(
+        *session,
         session->port(),
         buffers_to_string(session->request().body().data()),
         session->remoteAddress().at_port(0),
@@ -564,6 +572,10 @@ ServerHandler::processSession(
             return boost::beast::string_view{};
         }());
 
+    // A streamed reply has already completed the request.
+    if (streamed)
+        return;
+
     if (beast::rfc2616::is_keep_alive(session->request()))
         session->complete();
     else
@@ -586,8 +598,31 @@ Json::Int constexpr server_overloaded = -32604;
 Json::Int constexpr forbidden = -32605;
 Json::Int constexpr wrong_version = -32606;
 
-void
+// A request as it's echoed with an error, with anything that might be
+// sensitive masked.
+static Json::Value
+maskedRequest(Json::Value const& params)
+{
+    auto rq = params;
+
+    if (rq.isObject())
+    {
+        if (rq.isMember(jss::passphrase.c_str()))
+            rq[jss::passphrase.c_str()] = "<masked>";
+        if (rq.isMember(jss::secret.c_str()))
+            rq[jss::secret.c_str()] = "<masked>";
+        if (rq.isMember(jss::seed.c_str()))
+            rq[jss::seed.c_str()] = "<masked>";
+        if (rq.isMember(jss::seed_hex.c_str()))
+            rq[jss::seed_hex.c_str()] = "<masked>";
+    }
+
+    return rq;
+}
+
+bool
 ServerHandler::processRequest(
+    Session& session,
     Port const& port,
     std::string const& request,
     beast::IP::Endpoint const& remoteIPAddress,
@@ -602,7 +637,9 @@ ServerHandler::processRequest(
     {
         Json::Reader reader;
         if ((request.size() > RPC::Tuning::maxRequestSize) ||
-            !reader.parse(request, jsonOrig) || !jsonOrig ||
+            !(Json::readStrict(request, jsonOrig) ||
+              reader.parse(request, jsonOrig)) ||
+            !jsonOrig ||
             !jsonOrig.isObject())
         {
             HTTPReply(
@@ -610,410 +647,745 @@ ServerHandler::processRequest(
                 "Unable to parse request: " + reader.getFormatedErrorMessages(),
                 output,
                 rpcJ);
-            return;
+            return false;
         }
     }
 
     bool batch = false;
-    unsigned size = 1;
     if (jsonOrig.isMember(jss::method) && jsonOrig[jss::method] == "batch")
     {
         batch = true;
         if (!jsonOrig.isMember(jss::params) || !jsonOrig[jss::params].isArray())
         {
             HTTPReply(400, "Malformed batch request", output, rpcJ);
-            return;
+            return false;
         }
-        size = jsonOrig[jss::params].size();
     }
 
     Json::Value reply(batch ? Json::arrayValue : Json::objectValue);
     auto const start(std::chrono::high_resolution_clock::now());
-    for (unsigned i = 0; i < size; ++i)
+    if (batch)
     {
-        Json::Value const& jsonRPC =
-            batch ? jsonOrig[jss::params][i] : jsonOrig;
+        for (auto& r : processBatch(
+                 session,
+                 port,
+                 jsonOrig[jss::params],
+                 remoteIPAddress,
+                 output,
+                 coro,
+                 forwardedFor,
+                 user))
+            reply.append(std::move(r));
+    }
+    else
+    {
+        bool streamed = false;
+        auto r = processCommand(
+            session,
+            port,
+            jsonOrig,
+            false,
+            remoteIPAddress,
+            output,
+            coro,
+            forwardedFor,
+            user,
+            streamed);
+        if (!r)
+            return streamed;
+        reply = std::move(*r);
 
-        if (!jsonRPC.isObject())
+        if (reply.isMember(jss::result) &&
+            reply[jss::result].isMember(jss::result))
         {
-            Json::Value r(Json::objectValue);
-            r[jss::request] = jsonRPC;
-            r[jss::error] =
-                make_json_error(method_not_found, "Method not found");
-            reply.append(r);
-            continue;
+            reply = reply[jss::result];
+            if (reply.isMember(jss::status))
+            {
+                reply[jss::result][jss::status] = reply[jss::status];
+                reply.removeMember(jss::status);
+            }
         }
+    }
 
-        auto apiVersion = RPC::apiVersionIfUnspecified;
-        if (jsonRPC.isMember(jss::params) && jsonRPC[jss::params].isArray() &&
-            jsonRPC[jss::params].size() > 0 &&
-            jsonRPC[jss::params][0u].isObject())
+    // If we're returning an error_code, use that to determine the HTTP status.
+    int const httpStatus = [&reply]() {
+        // This feature is enabled with ripplerpc version 3.0 and above.
+        // Before ripplerpc version 3.0 always return 200.
+        if (reply.isMember(jss::ripplerpc) &&
+            reply[jss::ripplerpc].isString() &&
+            reply[jss::ripplerpc].asString() >= "3.0")
         {
-            apiVersion = RPC::getAPIVersionNumber(
-                jsonRPC[jss::params][Json::UInt(0)],
-                app_.config().BETA_RPC_API);
+            // If there's an error_code, use that to determine the HTTP Status.
+            if (reply.isMember(jss::error) &&
+                reply[jss::error].isMember(jss::error_code) &&
+                reply[jss::error][jss::error_code].isInt())
+            {
+                int const errCode = reply[jss::error][jss::error_code].asInt();
+                return RPC::error_code_http_status(
+                    static_cast<error_code_i>(errCode));
+            }
         }
+        // Return OK.
+        return 200;
+    }();
+
+    auto response = to_string(reply);
+
+    rpc_time_.notify(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - start));
+    ++rpc_requests_;
+    rpc_size_.notify(beast::insight::Event::value_type{response.size()});
+
+    response += '\n';
+
+    if (auto stream = m_journal.debug())
+    {
+        static const int maxSize = 10000;
+        if (response.size() <= maxSize)
+            stream << "Reply: " << response;
+        else
+            stream << "Reply: " << response.substr(0, maxSize);
+    }
+
+    HTTPReply(httpStatus, response, output, rpcJ);
+    return false;
+}
+
+std::optional<Json::Value>
+ServerHandler::processCommand(
+    Session& session,
+    Port const& port,
+    Json::Value const& jsonRPC,
+    bool batch,
+    beast::IP::Endpoint const& remoteIPAddress,
+    Output const& output,
+    std::shared_ptr<JobQueue::Coro> const& coro,
+    boost::string_view forwardedFor,
+    boost::string_view user,
+    bool& streamed)
+{
+    auto rpcJ = app_.journal("RPC");
+
+    if (!jsonRPC.isObject())
+    {
+        Json::Value r(Json::objectValue);
+        r[jss::request] = jsonRPC;
+        r[jss::error] = make_json_error(method_not_found, "Method not found");
+        return r;
+    }
+
+    auto apiVersion = RPC::apiVersionIfUnspecified;
+    if (jsonRPC.isMember(jss::params) && jsonRPC[jss::params].isArray() &&
+        jsonRPC[jss::params].size() > 0 && jsonRPC[jss::params][0u].isObject())
+    {
+        apiVersion = RPC::getAPIVersionNumber(
+            jsonRPC[jss::params][Json::UInt(0)], app_.config().BETA_RPC_API);
+    }
+
+    if (apiVersion == RPC::apiVersionIfUnspecified && batch)
+    {
+        // for batch request, api_version may be at a different level
+        apiVersion =
+            RPC::getAPIVersionNumber(jsonRPC, app_.config().BETA_RPC_API);
+    }
 
-        if (apiVersion == RPC::apiVersionIfUnspecified && batch)
+    if (apiVersion == RPC::apiInvalidVersion)
+    {
+        if (!batch)
         {
-            // for batch request, api_version may be at a different level
-            apiVersion =
-                RPC::getAPIVersionNumber(jsonRPC, app_.config().BETA_RPC_API);
+            HTTPReply(400, jss::invalid_API_version.c_str(), output, rpcJ);
+            return std::nullopt;
         }
+        Json::Value r(Json::objectValue);
+        r[jss::request] = jsonRPC;
+        r[jss::error] = make_json_error(
+            wrong_version, jss::invalid_API_version.c_str());
+        return r;
+    }
+
+    /* ------------------------------------------------------------------ */
+    auto role = Role::FORBID;
+    auto required = Role::FORBID;
+    if (jsonRPC.isMember(jss::method) && jsonRPC[jss::method].isString())
+        required = RPC::roleRequired(
+            apiVersion,
+            app_.config().BETA_RPC_API,
+            jsonRPC[jss::method].asString());
+
+    if (jsonRPC.isMember(jss::params) && jsonRPC[jss::params].isArray() &&
+        jsonRPC[jss::params].size() > 0 &&
+        jsonRPC[jss::params][Json::UInt(0)].isObjectOrNull())
+    {
+        role = requestRole(
+            required,
+            port,
+            jsonRPC[jss::params][Json::UInt(0)],
+            remoteIPAddress,
+            user);
+    }
+    else
+    {
+        role = requestRole(
+            required, port, Json::objectValue, remoteIPAddress, user);
+    }
 
-        if (apiVersion == RPC::apiInvalidVersion)
+    Resource::Consumer usage;
+    if (isUnlimited(role))
+    {
+        usage = m_resourceManager.newUnlimitedEndpoint(remoteIPAddress);
+    }
+    else
+    {
+        usage = m_resourceManager.newInboundEndpoint(
+            remoteIPAddress, role == Role::PROXY, forwardedFor);
+        if (usage.disconnect(m_journal))
         {
             if (!batch)
             {
-                HTTPReply(400, jss::invalid_API_version.c_str(), output, rpcJ);
-                return;
+                HTTPReply(503, "Server is overloaded", output, rpcJ);
+                return std::nullopt;
             }
-            Json::Value r(Json::objectValue);
-            r[jss::request] = jsonRPC;
-            r[jss::error] = make_json_error(
-                wrong_version, jss::invalid_API_version.c_str());
-            reply.append(r);
-            continue;
+            Json::Value r = jsonRPC;
+            r[jss::error] =
+                make_json_error(server_overloaded, "Server is overloaded");
+            return r;
         }
+    }
 
-        /* ------------------------------------------------------------------ */
-        auto role = Role::FORBID;
-        auto required = Role::FORBID;
-        if (jsonRPC.isMember(jss::method) && jsonRPC[jss::method].isString())
-            required = RPC::roleRequired(
-                apiVersion,
-                app_.config().BETA_RPC_API,
-                jsonRPC[jss::method].asString());
-
-        if (jsonRPC.isMember(jss::params) && jsonRPC[jss::params].isArray() &&
-            jsonRPC[jss::params].size() > 0 &&
-            jsonRPC[jss::params][Json::UInt(0)].isObjectOrNull())
-        {
-            role = requestRole(
-                required,
-                port,
-                jsonRPC[jss::params][Json::UInt(0)],
-                remoteIPAddress,
-                user);
-        }
-        else
+    if (role == Role::FORBID)
+    {
+        usage.charge(Resource::feeInvalidRPC);
+        if (!batch)
         {
-            role = requestRole(
-                required, port, Json::objectValue, remoteIPAddress, user);
+            HTTPReply(403, "Forbidden", output, rpcJ);
+            return std::nullopt;
         }
+        Json::Value r = jsonRPC;
+        r[jss::error] = make_json_error(forbidden, "Forbidden");
+        return r;
+    }
 
-        Resource::Consumer usage;
-        if (isUnlimited(role))
+    if (!jsonRPC.isMember(jss::method) || jsonRPC[jss::method].isNull())
+    {
+        usage.charge(Resource::feeInvalidRPC);
+        if (!batch)
         {
-            usage = m_resourceManager.newUnlimitedEndpoint(remoteIPAddress);
+            HTTPReply(400, "Null method", output, rpcJ);
+            return std::nullopt;
         }
-        else
+        Json::Value r = jsonRPC;
+        r[jss::error] = make_json_error(method_not_found, "Null method");
+        return r;
+    }
+
+    Json::Value const& method = jsonRPC[jss::method];
+    if (!method.isString())
+    {
+        usage.charge(Resource::feeInvalidRPC);
+        if (!batch)
         {
-            usage = m_resourceManager.newInboundEndpoint(
-                remoteIPAddress, role == Role::PROXY, forwardedFor);
-            if (usage.disconnect(m_journal))
-            {
-                if (!batch)
-                {
-                    HTTPReply(503, "Server is overloaded", output, rpcJ);
-                    return;
-                }
-                Json::Value r = jsonRPC;
-                r[jss::error] =
-                    make_json_error(server_overloaded, "Server is overloaded");
-                reply.append(r);
-                continue;
-            }
+            HTTPReply(400, "method is not string", output, rpcJ);
+            return std::nullopt;
         }
+        Json::Value r = jsonRPC;
+        r[jss::error] =
+            make_json_error(method_not_found, "method is not string");
+        return r;
+    }
 
-        if (role == Role::FORBID)
+    std::string strMethod = method.asString();
+    if (strMethod.empty())
+    {
+        usage.charge(Resource::feeInvalidRPC);
+        if (!batch)
         {
-            usage.charge(Resource::feeInvalidRPC);
-            if (!batch)
-            {
-                HTTPReply(403, "Forbidden", output, rpcJ);
-                return;
-            }
-            Json::Value r = jsonRPC;
-            r[jss::error] = make_json_error(forbidden, "Forbidden");
-            reply.append(r);
-            continue;
+            HTTPReply(400, "method is empty", output, rpcJ);
+            return std::nullopt;
         }
+        Json::Value r = jsonRPC;
+        r[jss::error] = make_json_error(method_not_found, "method is empty");
+        return r;
+    }
+
+    // Extract request parameters from the request Json as `params`.
+    //
+    // If the field "params" is empty, `params` is an empty object.
+    //
+    // Otherwise, that field must be an array of length 1 (why?)
+    // and we take that first entry and validate that it's an object.
+    Json::Value params;
+    if (!batch)
+    {
+        params = jsonRPC[jss::params];
+        if (!params)
+            params = Json::Value(Json::objectValue);
 
-        if (!jsonRPC.isMember(jss::method) || jsonRPC[jss::method].isNull())
+        else if (!params.isArray() || params.size() != 1)
         {
             usage.charge(Resource::feeInvalidRPC);
-            if (!batch)
-            {
-                HTTPReply(400, "Null method", output, rpcJ);
-                return;
-            }
-            Json::Value r = jsonRPC;
-            r[jss::error] = make_json_error(method_not_found, "Null method");
-            reply.append(r);
-            continue;
+            HTTPReply(400, "params unparseable", output, rpcJ);
+            return std::nullopt;
         }
-
-        Json::Value const& method = jsonRPC[jss::method];
-        if (!method.isString())
+        else
         {
-            usage.charge(Resource::feeInvalidRPC);
-            if (!batch)
+            params = std::move(params[0u]);
+            if (!params.isObjectOrNull())
             {
-                HTTPReply(400, "method is not string", output, rpcJ);
-                return;
+                usage.charge(Resource::feeInvalidRPC);
+                HTTPReply(400, "params unparseable", output, rpcJ);
+                return std::nullopt;
             }
-            Json::Value r = jsonRPC;
-            r[jss::error] =
-                make_json_error(method_not_found, "method is not string");
-            reply.append(r);
-            continue;
         }
+    }
+    else  // batch
+    {
+        params = jsonRPC;
+    }
 
-        std::string strMethod = method.asString();
-        if (strMethod.empty())
+    std::string ripplerpc = "1.0";
+    if (params.isMember(jss::ripplerpc))
+    {
+        if (!params[jss::ripplerpc].isString())
         {
             usage.charge(Resource::feeInvalidRPC);
             if (!batch)
             {
-                HTTPReply(400, "method is empty", output, rpcJ);
-                return;
+                HTTPReply(400, "ripplerpc is not a string", output, rpcJ);
+                return std::nullopt;
             }
+
             Json::Value r = jsonRPC;
-            r[jss::error] =
-                make_json_error(method_not_found, "method is empty");
-            reply.append(r);
-            continue;
+            r[jss::error] = make_json_error(
+                method_not_found, "ripplerpc is not a string");
+            return r;
         }
+        ripplerpc = params[jss::ripplerpc].asString();
+    }
 
-        // Extract request parameters from the request Json as `params`.
-        //
-        // If the field "params" is empty, `params` is an empty object.
-        //
-        // Otherwise, that field must be an array of length 1 (why?)
-        // and we take that first entry and validate that it's an object.
-        Json::Value params;
-        if (!batch)
-        {
-            params = jsonRPC[jss::params];
-            if (!params)
-                params = Json::Value(Json::objectValue);
+    /**
+     * Clear header-assigned values if not positively identified from a
+     * secure_gateway.
+     */
+    if (role != Role::IDENTIFIED && role != Role::PROXY)
+    {
+        forwardedFor.clear();
+        user.clear();
+    }
 
-            else if (!params.isArray() || params.size() != 1)
-            {
-                usage.charge(Resource::feeInvalidRPC);
-                HTTPReply(400, "params unparseable", output, rpcJ);
-                return;
-            }
-            else
-            {
-                params = std::move(params[0u]);
-                if (!params.isObjectOrNull())
-                {
-                    usage.charge(Resource::feeInvalidRPC);
-                    HTTPReply(400, "params unparseable", output, rpcJ);
-                    return;
-                }
-            }
-        }
-        else  // batch
-        {
-            params = jsonRPC;
-        }
+    JLOG(m_journal.debug()) << "Query: " << strMethod << params;
 
-        std::string ripplerpc = "1.0";
-        if (params.isMember(jss::ripplerpc))
+    // Provide the JSON-RPC method as the field "command" in the request.
+    params[jss::command] = strMethod;
+    JLOG(m_journal.trace())
+        << "doRpcCommand:" << strMethod << ":" << params;
+
+    Resource::Charge loadType = Resource::feeReferenceRPC;
+
+    RPC::JsonContext context{
+        {m_journal,
+         app_,
+         loadType,
+         m_networkOPs,
+         app_.getLedgerMaster(),
+         usage,
+         role,
+         coro,
+         InfoSub::pointer(),
+         apiVersion},
+        params,
+        {user, forwardedFor}};
+
+    // Results too large to build are written while they're produced.
+    if (!batch && ripplerpc < "2.0" && RPC::isStreamed(context))
+    {
+        streamReply(session, coro, context);
+        streamed = true;
+        return std::nullopt;
+    }
+
+    Json::Value result;
+
+    auto start = std::chrono::system_clock::now();
+
+    try
+    {
+        // Raw bytes are sent while they're produced, once the request
+        // has been checked.
+        if (!batch && RPC::isBinary(context))
         {
-            if (!params[jss::ripplerpc].isString())
+            if (binaryReply(session, coro, context, result))
             {
-                usage.charge(Resource::feeInvalidRPC);
-                if (!batch)
-                {
-                    HTTPReply(400, "ripplerpc is not a string", output, rpcJ);
-                    return;
-                }
-
-                Json::Value r = jsonRPC;
-                r[jss::error] = make_json_error(
-                    method_not_found, "ripplerpc is not a string");
-                reply.append(r);
-                continue;
+                streamed = true;
+                return std::nullopt;
             }
-            ripplerpc = params[jss::ripplerpc].asString();
         }
-
-        /**
-         * Clear header-assigned values if not positively identified from a
-         * secure_gateway.
-         */
-        if (role != Role::IDENTIFIED && role != Role::PROXY)
+        else
         {
-            forwardedFor.clear();
-            user.clear();
+            RPC::doCommand(context, result);
         }
+    }
+    catch (std::exception const& ex)
+    {
+        result = RPC::make_error(rpcINTERNAL);
+        JLOG(m_journal.error()) << "Internal error : " << ex.what()
+                                << " when processing request: "
+                                << Json::Compact{Json::Value{params}};
+    }
 
-        JLOG(m_journal.debug()) << "Query: " << strMethod << params;
+    auto end = std::chrono::system_clock::now();
 
-        // Provide the JSON-RPC method as the field "command" in the request.
-        params[jss::command] = strMethod;
-        JLOG(m_journal.trace())
-            << "doRpcCommand:" << strMethod << ":" << params;
-
-        Resource::Charge loadType = Resource::feeReferenceRPC;
-
-        RPC::JsonContext context{
-            {m_journal,
-             app_,
-             loadType,
-             m_networkOPs,
-             app_.getLedgerMaster(),
-             usage,
-             role,
-             coro,
-             InfoSub::pointer(),
-             apiVersion},
-            params,
-            {user, forwardedFor}};
-        Json::Value result;
-
-        auto start = std::chrono::system_clock::now();
+    logDuration(params, end - start, m_journal);
 
-        try
+    usage.charge(loadType);
+    if (usage.warn())
+        result[jss::warning] = jss::load;
+
+    Json::Value r(Json::objectValue);
+    if (ripplerpc >= "2.0")
+    {
+        if (result.isMember(jss::error))
         {
-            RPC::doCommand(context, result);
+            result[jss::status] = jss::error;
+            result["code"] = result[jss::error_code];
+            result["message"] = result[jss::error_message];
+            result.removeMember(jss::error_message);
+            JLOG(m_journal.debug()) << "rpcError: " << result[jss::error]
+                                    << ": " << result[jss::error_message];
+            r[jss::error] = std::move(result);
+        }
+        else
+        {
+            result[jss::status] = jss::success;
+            r[jss::result] = std::move(result);
+        }
+    }
+    else
+    {
+        // Always report "status".  On an error report the request as
+        // received.
+        if (result.isMember(jss::error))
+        {
+            result[jss::status] = jss::error;
+            result[jss::request] = maskedRequest(params);
+
+            JLOG(m_journal.debug()) << "rpcError: " << result[jss::error]
+                                    << ": " << result[jss::error_message];
         }
-        catch (std::exception const& ex)
+        else
         {
-            result = RPC::make_error(rpcINTERNAL);
-            JLOG(m_journal.error()) << "Internal error : " << ex.what()
-                                    << " when processing request: "
-                                    << Json::Compact{Json::Value{params}};
+            result[jss::status] = jss::success;
         }
+        r[jss::result] = std::move(result);
+    }
 
-        auto end = std::chrono::system_clock::now();
+    if (params.isMember(jss::jsonrpc))
+        r[jss::jsonrpc] = params[jss::jsonrpc];
+    if (params.isMember(jss::ripplerpc))
+        r[jss::ripplerpc] = params[jss::ripplerpc];
+    if (params.isMember(jss::id))
+        r[jss::id] = params[jss::id];
+    return r;
+}
 
-        logDuration(params, end - start, m_journal);
+// Whether a batch entry may change what the server or a later entry sees.
+// Such an entry is evaluated on its own, after every entry before it and
+// before any entry after it.
+static bool
+changesState(Json::Value const& entry)
+{
+    if (!entry.isObject() || !entry[jss::method].isString())
+        return false;
 
-        usage.charge(loadType);
-        if (usage.warn())
-            result[jss::warning] = jss::load;
+    auto const method = entry[jss::method].asString();
+    if (method == "submit" || method == "submit_multisigned" ||
+        method == "subscribe" || method == "unsubscribe" ||
+        method == "path_find")
+        return true;
 
-        Json::Value r(Json::objectValue);
-        if (ripplerpc >= "2.0")
+    // Every admin method is treated as changing state.
+    auto const handler =
+        RPC::getHandler(RPC::apiMinimumSupportedVersion, true, method);
+    return handler && handler->role_ != Role::USER;
+}
+
+// Run as a coroutine. Runs of entries that don't change state are shared
+// out among this coroutine and up to Tuning::batchConcurrency - 1 others.
+// Entries that do are evaluated in order, between the runs. The replies
+// are returned in the order of the entries.
+std::vector<Json::Value>
+ServerHandler::processBatch(
+    Session& session,
+    Port const& port,
+    Json::Value const& entries,
+    beast::IP::Endpoint const& remoteIPAddress,
+    Output const& output,
+    std::shared_ptr<JobQueue::Coro> const& coro,
+    boost::string_view forwardedFor,
+    boost::string_view user)
+{
+    std::vector<Json::Value> replies(entries.size());
+
+    auto evaluate = [&](unsigned i,
+                        std::shared_ptr<JobQueue::Coro> const& c) {
+        bool streamed = false;
+        auto r = processCommand(
+            session,
+            port,
+            entries[i],
+            true,
+            remoteIPAddress,
+            output,
+            c,
+            forwardedFor,
+            user,
+            streamed);
+        assert(r && !streamed);
+        replies[i] = std::move(*r);
+    };
+
+    // Evaluate the entries [first, last) concurrently.
+    auto evaluateRun = [&](unsigned first, unsigned last) {
+        std::atomic<unsigned> next{first};
+        std::mutex mutex;
+        unsigned running = 0;
+        bool waiting = false;
+
+        auto share = [&](std::shared_ptr<JobQueue::Coro> const& c) {
+            for (unsigned i; (i = next++) < last;)
+                evaluate(i, c);
+        };
+
+        auto const helpers = std::min<unsigned>(
+            RPC::Tuning::batchConcurrency - 1, last - first - 1);
+        for (unsigned i = 0; i < helpers; ++i)
         {
-            if (result.isMember(jss::error))
             {
-                result[jss::status] = jss::error;
-                result["code"] = result[jss::error_code];
-                result["message"] = result[jss::error_message];
-                result.removeMember(jss::error_message);
-                JLOG(m_journal.debug()) << "rpcError: " << result[jss::error]
-                                        << ": " << result[jss::error_message];
-                r[jss::error] = std::move(result);
+                std::lock_guard lock(mutex);
+                ++running;
             }
-            else
+            auto const posted = m_jobQueue.postCoro(
+                jtCLIENT_RPC,
+                "RPC-Batch",
+                [&, coro](std::shared_ptr<JobQueue::Coro> const& helper) {
+                    share(helper);
+                    bool wake = false;
+                    {
+                        std::lock_guard lock(mutex);
+                        wake = --running == 0 && waiting;
+                    }
+                    // Nothing above may be used once the batch is woken.
+                    if (wake && !coro->post())
+                        coro->resume();
+                });
+            if (!posted)
             {
-                result[jss::status] = jss::success;
-                r[jss::result] = std::move(result);
+                // The rest is evaluated here.
+                std::lock_guard lock(mutex);
+                --running;
+                break;
             }
         }
-        else
+
+        share(coro);
+
+        std::unique_lock lock(mutex);
+        if (running != 0)
         {
-            // Always report "status".  On an error report the request as
-            // received.
-            if (result.isMember(jss::error))
-            {
-                auto rq = params;
-
-                if (rq.isObject())
-                {  // But mask potentially sensitive information.
-                    if (rq.isMember(jss::passphrase.c_str()))
-                        rq[jss::passphrase.c_str()] = "<masked>";
-                    if (rq.isMember(jss::secret.c_str()))
-                        rq[jss::secret.c_str()] = "<masked>";
-                    if (rq.isMember(jss::seed.c_str()))
-                        rq[jss::seed.c_str()] = "<masked>";
-                    if (rq.isMember(jss::seed_hex.c_str()))
-                        rq[jss::seed_hex.c_str()] = "<masked>";
-                }
-
-                result[jss::status] = jss::error;
-                result[jss::request] = rq;
-
-                JLOG(m_journal.debug()) << "rpcError: " << result[jss::error]
-                                        << ": " << result[jss::error_message];
-            }
-            else
-            {
-                result[jss::status] = jss::success;
-            }
-            r[jss::result] = std::move(result);
+            waiting = true;
+            lock.unlock();
+            coro->yield();
         }
+    };
 
-        if (params.isMember(jss::jsonrpc))
-            r[jss::jsonrpc] = params[jss::jsonrpc];
-        if (params.isMember(jss::ripplerpc))
-            r[jss::ripplerpc] = params[jss::ripplerpc];
-        if (params.isMember(jss::id))
-            r[jss::id] = params[jss::id];
-        if (batch)
-            reply.append(std::move(r));
-        else
-            reply = std::move(r);
-
-        if (reply.isMember(jss::result) &&
-            reply[jss::result].isMember(jss::result))
+    unsigned const size = replies.size();
+    for (unsigned first = 0; first < size;)
+    {
+        if (changesState(entries[first]))
         {
-            reply = reply[jss::result];
-            if (reply.isMember(jss::status))
-            {
-                reply[jss::result][jss::status] = reply[jss::status];
-                reply.removeMember(jss::status);
-            }
+            evaluate(first++, coro);
+            continue;
         }
+
+        auto last = first + 1;
+        while (last < size && !changesState(entries[last]))
+            ++last;
+        if (last - first == 1)
+            evaluate(first, coro);
+        else
+            evaluateRun(first, last);
+        first = last;
     }
+    return replies;
+}
 
-    // If we're returning an error_code, use that to determine the HTTP status.
-    int const httpStatus = [&reply]() {
-        // This feature is enabled with ripplerpc version 3.0 and above.
-        // Before ripplerpc version 3.0 always return 200.
-        if (reply.isMember(jss::ripplerpc) &&
-            reply[jss::ripplerpc].isString() &&
-            reply[jss::ripplerpc].asString() >= "3.0")
+// A reply sent while a coroutine produces it. The coroutine is suspended
+// whenever the client falls too far behind, and resumed once it has caught
+// up.
+static StreamWriter
+makeStream(std::string head, std::shared_ptr<JobQueue::Coro> const& coro)
+{
+    return StreamWriter(
+        std::move(head),
+        [coro] { coro->yield(); },
+        [coro] {
+            if (!coro->post())
+                coro->resume();
+        });
+}
+
+// Run as a coroutine.
+void
+ServerHandler::streamReply(
+    Session& session,
+    std::shared_ptr<JobQueue::Coro> const& coro,
+    RPC::JsonContext& context)
+{
+    auto const& params = context.params;
+    auto const start = std::chrono::high_resolution_clock::now();
+
+    // The chunked body marks its own end, so the connection can be kept.
+    auto stream = makeStream(HTTPChunkedReplyHead(), coro);
+    session.write(
+        stream.body(), beast::rfc2616::is_keep_alive(session.request()));
+    context.stopped = [&stream] { return stream.closed(); };
+
+    std::size_t size = 0;
+    try
+    {
+        Json::Writer writer([&](boost::beast::string_view const& bytes) {
+            // Don't close what's open while unwinding: the reply is cut
+            // short below.
+            if (std::uncaught_exceptions())
+                return;
+            size += bytes.size();
+            stream.write(bytes);
+        });
+
+        // The reply is written in key order, as processCommand's would be,
+        // so that it's the same.
+        Json::Object::Root r(writer);
+        if (params.isMember(jss::id))
+            r[jss::id] = params[jss::id];
+        if (params.isMember(jss::jsonrpc))
+            r[jss::jsonrpc] = params[jss::jsonrpc];
         {
-            // If there's an error_code, use that to determine the HTTP Status.
-            if (reply.isMember(jss::error) &&
-                reply[jss::error].isMember(jss::error_code) &&
-                reply[jss::error][jss::error_code].isInt())
-            {
-                int const errCode = reply[jss::error][jss::error_code].asInt();
-                return RPC::error_code_http_status(
-                    static_cast<error_code_i>(errCode));
-            }
+            auto result = Json::addObject(r, jss::result);
+            RPC::doCommand(
+                context,
+                result,
+                [&](RPC::Status const& status, Json::Value& members) {
+                    context.consumer.charge(context.loadType);
+                    if (context.consumer.warn())
+                        members[jss::warning] = jss::load;
+
+                    // Always report "status".  On an error report the
+                    // request as received.
+                    if (status)
+                    {
+                        members[jss::status] = jss::error;
+                        members[jss::request] = maskedRequest(params);
+                        JLOG(m_journal.debug())
+                            << "rpcError: " << status.codeString();
+                    }
+                    else
+                    {
+                        members[jss::status] = jss::success;
+                    }
+                });
         }
-        // Return OK.
-        return 200;
-    }();
+        if (params.isMember(jss::ripplerpc))
+            r[jss::ripplerpc] = params[jss::ripplerpc];
+    }
+    catch (std::exception const& ex)
+    {
+        // Part of the reply may have been sent: cut it short, and close
+        // the connection once it's sent, so the client can't mistake it
+        // for all of it.
+        session.close(false);
+        stream.abort();
+        JLOG(m_journal.error()) << "Internal error : " << ex.what()
+                                << " when streaming request: "
+                                << Json::Compact{Json::Value{params}};
+        return;
+    }
 
-    auto response = to_string(reply);
+    stream.write("\n");
+    stream.finish();
 
-    rpc_time_.notify(std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::high_resolution_clock::now() - start));
+    auto const duration = std::chrono::high_resolution_clock::now() - start;
+    logDuration(params, duration, m_journal);
+    rpc_time_.notify(
+        std::chrono::duration_cast<std::chrono::milliseconds>(duration));
     ++rpc_requests_;
-    rpc_size_.notify(beast::insight::Event::value_type{response.size()});
+    rpc_size_.notify(beast::insight::Event::value_type{size});
 
-    response += '\n';
+    JLOG(m_journal.debug()) << "Streamed reply: " << size << " bytes"
+                            << (stream.closed() ? ", client went away" : "");
+}
 
-    if (auto stream = m_journal.debug())
+// Run as a coroutine.
+bool
+ServerHandler::binaryReply(
+    Session& session,
+    std::shared_ptr<JobQueue::Coro> const& coro,
+    RPC::JsonContext& context,
+    Json::Value& result)
+{
+    auto const start = std::chrono::high_resolution_clock::now();
+
+    // Nothing is sent unless the request passes its checks.
+    auto stream =
+        makeStream(HTTPChunkedReplyHead("application/octet-stream"), coro);
+    bool started = false;
+    std::size_t size = 0;
+    RPC::BinaryOutput const output{
+        [&] {
+            started = true;
+            session.write(
+                stream.body(),
+                beast::rfc2616::is_keep_alive(session.request()));
+        },
+        [&](Slice bytes) {
+            size += bytes.size();
+            stream.write(
+                {reinterpret_cast<char const*>(bytes.data()), bytes.size()});
+            return !stream.closed();
+        }};
+
+    try
     {
-        static const int maxSize = 10000;
-        if (response.size() <= maxSize)
-            stream << "Reply: " << response;
-        else
-            stream << "Reply: " << response.substr(0, maxSize);
+        if (auto const status = RPC::doCommand(context, output))
+        {
+            status.inject(result);
+            return false;
+        }
+    }
+    catch (std::exception const& ex)
+    {
+        if (!started)
+            throw;
+
+        // Part of the reply may have been sent: cut it short, and close
+        // the connection once it's sent, so the client can't mistake it
+        // for all of it.
+        session.close(false);
+        stream.abort();
+        JLOG(m_journal.error()) << "Internal error : " << ex.what()
+                                << " when sending request: "
+                                << Json::Compact{Json::Value{context.params}};
+        return true;
     }
 
-    HTTPReply(httpStatus, response, output, rpcJ);
+    stream.finish();
+    context.consumer.charge(context.loadType);
+
+    auto const duration = std::chrono::high_resolution_clock::now() - start;
+    logDuration(context.params, duration, m_journal);
+    rpc_time_.notify(
+        std::chrono::duration_cast<std::chrono::milliseconds>(duration));
+    ++rpc_requests_;
+    rpc_size_.notify(beast::insight::Event::value_type{size});
+    return true;
 }
 
 //------------------------------------------------------------------------------
@@ -1117,6 +1489,7 @@ to_Port(ParsedPort const& parsed, std::ostream& log)
     p.ssl_ciphers = parsed.ssl_ciphers;
     p.pmd_options = parsed.pmd_options;
     p.ws_queue_limit = parsed.ws_queue_limit;
+    p.ws_queue_drop = parsed.ws_queue_drop;
     p.limit = parsed.limit;
     p.admin_nets_v4 = parsed.admin_nets_v4;
     p.admin_nets_v6 = parsed.admin_nets_v6;
@@ -65,6 +65,13 @@ static int constexpr maxJobQueueClients = 500;
 auto constexpr maxValidatedLedgerAge = std::chrono::minutes{2};
 static int constexpr maxRequestSize = 1000000;
 
+/** State entries or transactions a ledger reply must have more of to be
+    streamed rather than built. */
+static int constexpr minStreamedEntries = 256;
+
+/** Most entries of one batch request evaluated at once. */
+static int constexpr batchConcurrency = 8;
+
 /** Maximum number of pages in one response from a binary LedgerData request. */
 static int constexpr binaryPageLength = 2048;
 
@@ -79,7 +79,16 @@ public:
                 sb.prepare(n), boost::asio::buffer(data, n)));
         });
         auto m = std::make_shared<StreambufWSMsg<decltype(sb)>>(std::move(sb));
-        sp->send(m);
+        sp->publish(m);
+    }
+
+    void
+    send(PublishedJson const& msg, bool) override
+    {
+        auto sp = ws_.lock();
+        if (!sp)
+            return;
+        sp->publish(std::make_shared<SharedWSMsg>(msg.text()));
     }
 };
 
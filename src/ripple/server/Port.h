@@ -75,6 +75,10 @@ struct Port
     // Websocket disconnects if send queue exceeds this limit
     std::uint16_t ws_queue_limit;
 
+    // Websocket drops its oldest queued messages, rather than disconnect,
+    // when its send queue exceeds the limit
+    bool ws_queue_drop = false;
+
     // Returns `true` if any websocket protocols are specified
     bool
     websockets() const;
@@ -110,6 +114,7 @@ struct ParsedPort
     boost::beast::websocket::permessage_deflate pmd_options;
     int limit = 0;
     std::uint16_t ws_queue_limit;
+    bool ws_queue_drop = false;
 
     std::optional<boost::asio::ip::address> ip;
     std::optional<std::uint16_t> port;
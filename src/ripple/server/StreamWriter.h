@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_SERVER_STREAMWRITER_H_INCLUDED
+#define RIPPLE_SERVER_STREAMWRITER_H_INCLUDED
+
+#include <ripple/server/Writer.h>
+#include <boost/beast/core/string.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace ripple {
+
+/** Sends an HTTP body in chunks while it's being produced.
+
+    The producer writes the body, and the session pulls it from body() as
+    the connection takes it. A producer that gets too far ahead is
+    suspended until the session has caught up, so only a bounded part of
+    the body is ever held in memory.
+
+    If the session goes away, the rest of the body is discarded.
+*/
+class StreamWriter
+{
+public:
+    /** Bytes written before they're sent as a chunk. */
+    static constexpr std::size_t chunkSize = 16 * 1024;
+
+    /** Bytes held for the session before the producer is suspended. */
+    static constexpr std::size_t limit = 256 * 1024;
+
+    /** Create a writer.
+
+        @param head Sent ahead of the body as it is: the HTTP head.
+        @param suspend Called by the producer to wait until wake is called.
+        @param wake Called to let a suspended producer continue. It may be
+                    called, from any thread, before the producer has called
+                    suspend.
+    */
+    StreamWriter(
+        std::string head,
+        std::function<void()> suspend,
+        std::function<void()> wake);
+
+    /** Ends the body where it is if it wasn't finished. */
+    ~StreamWriter();
+
+    StreamWriter(StreamWriter const&) = delete;
+    StreamWriter&
+    operator=(StreamWriter const&) = delete;
+
+    /** The body, for the session to write. Call this once. */
+    std::shared_ptr<Writer>
+    body();
+
+    /** Add to the body. */
+    void
+    write(boost::beast::string_view data);
+
+    /** End the body. */
+    void
+    finish();
+
+    /** End the body where it is, so the client can tell it was cut short. */
+    void
+    abort();
+
+    /** Whether the session has gone away. */
+    bool
+    closed() const;
+
+private:
+    struct State;
+    class Body;
+
+    void
+    flush(bool last);
+
+    std::shared_ptr<State> state_;
+    std::string pending_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -104,6 +105,37 @@ public:
     }
 };
 
+/** A message that shares its text with other messages.
+
+    This lets one rendering of a message be sent to many sessions, each of
+    which needs its own WSMsg to track how much of it has been written.
+*/
+class SharedWSMsg : public WSMsg
+{
+    std::shared_ptr<std::string const> text_;
+    std::size_t pos_ = 0;
+    std::size_t n_ = 0;
+
+public:
+    explicit SharedWSMsg(std::shared_ptr<std::string const> text)
+        : text_(std::move(text))
+    {
+    }
+
+    std::pair<boost::tribool, std::vector<boost::asio::const_buffer>>
+    prepare(std::size_t bytes, std::function<void(void)>) override
+    {
+        pos_ += n_;
+        auto const remaining = text_->size() - pos_;
+        if (remaining == 0)
+            return {true, {}};
+        n_ = std::min(bytes, remaining);
+        return {
+            boost::tribool(n_ == remaining),
+            {boost::asio::const_buffer(text_->data() + pos_, n_)}};
+    }
+};
+
 struct WSSession
 {
     std::shared_ptr<void> appDefined;
@@ -130,6 +162,14 @@ struct WSSession
     virtual void
     send(std::shared_ptr<WSMsg> w) = 0;
 
+    /** Send a message published to a stream.
+
+        Unlike a reply, it may be dropped if the client falls behind and
+        the port's send_queue_policy is "drop".
+    */
+    virtual void
+    publish(std::shared_ptr<WSMsg> w) = 0;
+
     virtual void
     close() = 0;
 
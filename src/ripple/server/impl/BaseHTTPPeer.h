@@ -22,11 +22,13 @@
 
 #include <ripple/basics/Log.h>
 #include <ripple/beast/net/IPAddressConversion.h>
+#include <ripple/beast/rfc2616.h>
 #include <ripple/server/Session.h>
 #include <ripple/server/impl/io_list.h>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/spawn.hpp>
 #include <boost/asio/ssl/stream.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/streambuf.hpp>
 #include <boost/beast/core/stream_traits.hpp>
 #include <boost/beast/http/dynamic_body.hpp>
@@ -36,15 +38,20 @@
 #include <atomic>
 #include <cassert>
 #include <chrono>
+#include <deque>
 #include <functional>
 #include <memory>
-#include <mutex>
 #include <type_traits>
 #include <vector>
 
 namespace ripple {
 
-/** Represents an active connection. */
+/** Represents an active connection.
+
+    Requests are read while earlier ones are still being answered, up to
+    maxInFlight at a time, and each is handed to the Handler as a Session of
+    its own. Responses are sent in the order the requests arrived.
+*/
 template <class Handler, class Impl>
 class BaseHTTPPeer : public io_list::work, public Session
 {
@@ -60,7 +67,10 @@ protected:
 
         // Max seconds without completing a message
         timeoutSeconds = 30,
-        timeoutSecondsLocal = 3  // used for localhost clients
+        timeoutSecondsLocal = 3,  // used for localhost clients
+
+        // Max requests read and not yet answered
+        maxInFlight = 8
     };
 
     struct buffer
@@ -76,6 +86,18 @@ protected:
         std::size_t used;
     };
 
+    // What's sent in answer to one request. Only used on the strand.
+    struct Response
+    {
+        std::vector<buffer> output;
+        std::shared_ptr<Writer> writer;
+        bool complete = false;
+        bool keep_alive = true;
+        bool graceful = true;
+    };
+
+    class Request;
+
     Port const& port_;
     Handler& handler_;
     boost::asio::executor_work_guard<boost::asio::executor> work_;
@@ -88,11 +110,15 @@ protected:
 
     boost::asio::streambuf read_buf_;
     http_request_type message_;
+    std::deque<std::shared_ptr<Response>> responses_;
     std::vector<buffer> wq_;
-    std::vector<buffer> wq2_;
-    std::mutex mutex_;
-    bool graceful_ = false;
-    bool complete_ = false;
+    boost::asio::steady_timer timer_;
+    bool reading_ = false;
+    bool arriving_ = false;
+    bool writing_ = false;
+    bool held_ = false;
+    bool more_ = true;
+    bool closing_ = false;
     boost::system::error_code ec_;
 
     int request_count_ = 0;
@@ -141,17 +167,30 @@ protected:
     void
     on_timer();
 
+    void
+    start_idle();
+
+    void
+    wait_read();
+
     void
     do_read(yield_context do_yield);
 
+    std::shared_ptr<Request>
+    pipeline();
+
+    template <class F>
+    void
+    respond(std::shared_ptr<Response> const& response, F&& f);
+
+    void
+    send();
+
     void
     on_write(error_code const& ec, std::size_t bytes_transferred);
 
     void
-    do_writer(
-        std::shared_ptr<Writer> const& writer,
-        bool keep_alive,
-        yield_context do_yield);
+    do_writer(std::shared_ptr<Writer> const& writer, yield_context do_yield);
 
     virtual void
     do_request() = 0;
@@ -160,6 +199,11 @@ protected:
     do_close() = 0;
 
     // Session
+    //
+    // The connection is the session for a request only while the request
+    // is handed off. Whatever answers it does so through the Request the
+    // request is then read as, so the connection's own write, detach,
+    // complete and close must not be called.
 
     beast::Journal
     journal() override
@@ -203,6 +247,124 @@ protected:
 
 //------------------------------------------------------------------------------
 
+/** One request read from a connection.
+
+    What's written is sent once the responses to the requests before it have
+    been. A request that's abandoned without being completed or closed
+    closes the connection when its turn comes.
+*/
+template <class Handler, class Impl>
+class BaseHTTPPeer<Handler, Impl>::Request
+    : public Session,
+      public std::enable_shared_from_this<Request>
+{
+    std::shared_ptr<BaseHTTPPeer> peer_;
+    std::shared_ptr<Response> response_;
+    http_request_type message_;
+    std::atomic<bool> done_{false};
+
+public:
+    Request(
+        std::shared_ptr<BaseHTTPPeer> peer,
+        std::shared_ptr<Response> response,
+        http_request_type&& message)
+        : peer_(std::move(peer))
+        , response_(std::move(response))
+        , message_(std::move(message))
+    {
+    }
+
+    ~Request() override
+    {
+        if (!done_)
+            peer_->respond(response_, [](Response& r) {
+                r.complete = true;
+                r.keep_alive = false;
+                r.graceful = false;
+            });
+    }
+
+    beast::Journal
+    journal() override
+    {
+        return peer_->journal_;
+    }
+
+    Port const&
+    port() override
+    {
+        return peer_->port_;
+    }
+
+    beast::IP::Endpoint
+    remoteAddress() override
+    {
+        return beast::IPAddressConversion::from_asio(peer_->remote_address_);
+    }
+
+    http_request_type&
+    request() override
+    {
+        return message_;
+    }
+
+    void
+    write(void const* buf, std::size_t bytes) override
+    {
+        if (bytes == 0)
+            return;
+        peer_->respond(
+            response_, [b = std::make_shared<buffer>(buf, bytes)](Response& r) {
+                r.output.push_back(std::move(*b));
+            });
+    }
+
+    void
+    write(std::shared_ptr<Writer> const& writer, bool keep_alive) override
+    {
+        done_ = true;
+        peer_->respond(response_, [writer, keep_alive](Response& r) {
+            r.writer = writer;
+            r.complete = true;
+            r.keep_alive = keep_alive;
+        });
+    }
+
+    std::shared_ptr<Session>
+    detach() override
+    {
+        return this->shared_from_this();
+    }
+
+    void
+    complete() override
+    {
+        done_ = true;
+        peer_->respond(response_, [](Response& r) { r.complete = true; });
+    }
+
+    void
+    close(bool graceful) override
+    {
+        done_ = true;
+        peer_->respond(response_, [graceful](Response& r) {
+            r.complete = true;
+            r.keep_alive = false;
+            r.graceful = graceful;
+        });
+    }
+
+    // A request that takes over the connection is handed off before it's
+    // read as one of these.
+    std::shared_ptr<WSSession>
+    websocketUpgrade() override
+    {
+        return nullptr;
+    }
+};
+
+//------------------------------------------------------------------------------
+
 template <class Handler, class Impl>
 template <class ConstBufferSequence>
 BaseHTTPPeer<Handler, Impl>::BaseHTTPPeer(
@@ -218,6 +380,7 @@ BaseHTTPPeer<Handler, Impl>::BaseHTTPPeer(
     , strand_(executor)
     , remote_address_(remote_address)
     , journal_(journal)
+    , timer_(executor)
 {
     read_buf_.commit(boost::asio::buffer_copy(
         read_buf_.prepare(boost::asio::buffer_size(buffers)), buffers));
@@ -260,6 +423,9 @@ BaseHTTPPeer<Handler, Impl>::fail(error_code ec, char const* what)
         ec_ = ec;
         JLOG(journal_.trace())
             << id_ << std::string(what) << ": " << ec.message();
+        closing_ = true;
+        more_ = false;
+        responses_.clear();
         boost::beast::get_lowest_layer(impl().stream_).close();
     }
 }
@@ -292,29 +458,241 @@ BaseHTTPPeer<Handler, Impl>::on_timer()
     fail(ec, "timer");
 }
 
+// Waiting for a request to start isn't timed by the stream, since it can
+// be waiting while earlier requests take as long as they take. Instead the
+// connection is closed if it's left waiting with none being answered.
+template <class Handler, class Impl>
+void
+BaseHTTPPeer<Handler, Impl>::start_idle()
+{
+    // A request that has started arriving keeps its deadline.
+    if (arriving_)
+        return;
+    if (!reading_ || !responses_.empty())
+    {
+        timer_.cancel();
+        return;
+    }
+    wait_read();
+}
+
+// Close the connection unless the read finishes in time.
+template <class Handler, class Impl>
+void
+BaseHTTPPeer<Handler, Impl>::wait_read()
+{
+    timer_.expires_after(std::chrono::seconds(
+        remote_address_.address().is_loopback() ? timeoutSecondsLocal
+                                                : timeoutSeconds));
+    timer_.async_wait(bind_executor(
+        strand_,
+        [wp = impl().weak_from_this()](error_code const& ec) {
+            auto const sp = wp.lock();
+            if (!sp || ec || !sp->reading_ ||
+                sp->timer_.expiry() > std::chrono::steady_clock::now())
+                return;
+            if (!sp->arriving_ && !sp->responses_.empty())
+                return;
+            sp->on_timer();
+        }));
+}
+
 //------------------------------------------------------------------------------
 
 template <class Handler, class Impl>
 void
 BaseHTTPPeer<Handler, Impl>::do_read(yield_context do_yield)
 {
-    complete_ = false;
-    error_code ec;
-    start_timer();
-    boost::beast::http::async_read(
-        impl().stream_, read_buf_, message_, do_yield[ec]);
-    cancel_timer();
-    if (ec == boost::beast::http::error::end_of_stream)
-        return do_close();
-    if (ec == boost::beast::error::timeout)
-        return on_timer();
-    if (ec)
-        return fail(ec, "http::read");
-    do_request();
+    reading_ = true;
+    while (more_ && responses_.size() < maxInFlight)
+    {
+        if (!held_)
+        {
+            error_code ec;
+            message_ = {};
+            cancel_timer();
+            start_idle();
+            if (read_buf_.size() == 0)
+            {
+                // Waiting for a request to start isn't timed by the stream.
+                auto const bytes = impl().stream_.async_read_some(
+                    read_buf_.prepare(bufferSize), do_yield[ec]);
+                read_buf_.commit(bytes);
+                if (ec == boost::asio::error::eof)
+                    ec = boost::beast::http::error::end_of_stream;
+            }
+            timer_.cancel();
+            if (!ec)
+            {
+                // But once one has started, it has to arrive in time,
+                // however many requests are being answered.
+                arriving_ = true;
+                wait_read();
+                boost::beast::http::async_read(
+                    impl().stream_, read_buf_, message_, do_yield[ec]);
+                arriving_ = false;
+                timer_.cancel();
+            }
+            if (ec == boost::beast::http::error::end_of_stream)
+                more_ = false;
+            else if (ec && more_)
+            {
+                reading_ = false;
+                return fail(ec, "http::read");
+            }
+            if (!more_)
+                break;
+
+            // A request that may take the connection over waits for the
+            // ones before it to be answered.
+            if (!responses_.empty() &&
+                message_.count(boost::beast::http::field::upgrade) != 0)
+            {
+                held_ = true;
+                break;
+            }
+        }
+        held_ = false;
+
+        auto const inFlight = responses_.size();
+        do_request();
+        if (responses_.size() == inFlight)
+        {
+            // Handed off, or failed: there's nothing more to read.
+            more_ = false;
+            reading_ = false;
+            return;
+        }
+    }
+    reading_ = false;
+    send();
+}
+
+// The request just read, to be answered after those before it.
+template <class Handler, class Impl>
+std::shared_ptr<typename BaseHTTPPeer<Handler, Impl>::Request>
+BaseHTTPPeer<Handler, Impl>::pipeline()
+{
+    if (!beast::rfc2616::is_keep_alive(message_))
+        more_ = false;
+    responses_.push_back(std::make_shared<Response>());
+    auto request = std::make_shared<Request>(
+        impl().shared_from_this(), responses_.back(), std::move(message_));
+    return request;
+}
+
+// Change a response on the strand, then send what's ready.
+template <class Handler, class Impl>
+template <class F>
+void
+BaseHTTPPeer<Handler, Impl>::respond(
+    std::shared_ptr<Response> const& response,
+    F&& f)
+{
+    post(
+        strand_,
+        [self = impl().shared_from_this(),
+         response,
+         f = std::forward<F>(f)]() mutable {
+            f(*response);
+            self->send();
+        });
+}
+
+// Send what's ready of the responses, in the order the requests arrived,
+// and read or close as that allows.
+template <class Handler, class Impl>
+void
+BaseHTTPPeer<Handler, Impl>::send()
+{
+    while (!writing_ && !closing_ && !responses_.empty())
+    {
+        auto& response = *responses_.front();
+        if (!response.output.empty())
+        {
+            wq_ = std::move(response.output);
+            response.output.clear();
+            std::vector<boost::asio::const_buffer> v;
+            v.reserve(wq_.size());
+            for (auto const& b : wq_)
+                v.emplace_back(b.data.get(), b.bytes);
+            writing_ = true;
+            start_timer();
+            boost::asio::async_write(
+                impl().stream_,
+                v,
+                bind_executor(
+                    strand_,
+                    std::bind(
+                        &BaseHTTPPeer::on_write,
+                        impl().shared_from_this(),
+                        std::placeholders::_1,
+                        std::placeholders::_2)));
+            break;
+        }
+        if (response.writer)
+        {
+            writing_ = true;
+            boost::asio::spawn(
+                strand_,
+                std::bind(
+                    &BaseHTTPPeer<Handler, Impl>::do_writer,
+                    impl().shared_from_this(),
+                    std::move(response.writer),
+                    std::placeholders::_1));
+            break;
+        }
+        if (!response.complete)
+            break;
+
+        auto const keep_alive = response.keep_alive;
+        auto const graceful = response.graceful;
+        responses_.pop_front();
+        if (!keep_alive)
+        {
+            // Requests after this one go unanswered.
+            more_ = false;
+            responses_.clear();
+            if (!graceful)
+            {
+                closing_ = true;
+                boost::beast::get_lowest_layer(impl().stream_).close();
+            }
+        }
+    }
+
+    if (closing_)
+        return;
+
+    if (more_)
+    {
+        if (!reading_ &&
+            (held_ ? responses_.empty() : responses_.size() < maxInFlight))
+        {
+            reading_ = true;
+            boost::asio::spawn(
+                strand_,
+                std::bind(
+                    &BaseHTTPPeer<Handler, Impl>::do_read,
+                    impl().shared_from_this(),
+                    std::placeholders::_1));
+        }
+        else if (responses_.empty())
+        {
+            start_idle();
+        }
+        return;
+    }
+
+    if (writing_ || !responses_.empty())
+        return;
+    // The read coroutine closes once it's been cancelled.
+    if (reading_)
+        return boost::beast::get_lowest_layer(impl().stream_).cancel();
+    closing_ = true;
+    do_close();
 }
 
-// Send everything in the write queue.
-// The write queue must not be empty upon entry.
 template <class Handler, class Impl>
 void
 BaseHTTPPeer<Handler, Impl>::on_write(
@@ -322,65 +700,32 @@ BaseHTTPPeer<Handler, Impl>::on_write(
     std::size_t bytes_transferred)
 {
     cancel_timer();
+    writing_ = false;
     if (ec == boost::beast::error::timeout)
         return on_timer();
     if (ec)
         return fail(ec, "write");
     bytes_out_ += bytes_transferred;
-    {
-        std::lock_guard lock(mutex_);
-        wq2_.clear();
-        wq2_.reserve(wq_.size());
-        std::swap(wq2_, wq_);
-    }
-    if (!wq2_.empty())
-    {
-        std::vector<boost::asio::const_buffer> v;
-        v.reserve(wq2_.size());
-        for (auto const& b : wq2_)
-            v.emplace_back(b.data.get(), b.bytes);
-        start_timer();
-        return boost::asio::async_write(
-            impl().stream_,
-            v,
-            bind_executor(
-                strand_,
-                std::bind(
-                    &BaseHTTPPeer::on_write,
-                    impl().shared_from_this(),
-                    std::placeholders::_1,
-                    std::placeholders::_2)));
-    }
-    if (!complete_)
-        return;
-    if (graceful_)
-        return do_close();
-    boost::asio::spawn(
-        strand_,
-        std::bind(
-            &BaseHTTPPeer<Handler, Impl>::do_read,
-            impl().shared_from_this(),
-            std::placeholders::_1));
+    wq_.clear();
+    send();
 }
 
 template <class Handler, class Impl>
 void
 BaseHTTPPeer<Handler, Impl>::do_writer(
     std::shared_ptr<Writer> const& writer,
-    bool keep_alive,
     yield_context do_yield)
 {
     std::function<void(void)> resume;
     {
         auto const p = impl().shared_from_this();
-        resume = std::function<void(void)>([this, p, writer, keep_alive]() {
+        resume = std::function<void(void)>([this, p, writer]() {
             boost::asio::spawn(
                 strand_,
                 std::bind(
                     &BaseHTTPPeer<Handler, Impl>::do_writer,
                     p,
                     writer,
-                    keep_alive,
                     std::placeholders::_1));
         });
     }
@@ -396,135 +741,55 @@ BaseHTTPPeer<Handler, Impl>::do_writer(
             boost::asio::transfer_at_least(1),
             do_yield[ec]);
         if (ec)
+        {
+            writing_ = false;
             return fail(ec, "writer");
+        }
         writer->consume(bytes_transferred);
         if (writer->complete())
             break;
     }
 
-    if (!keep_alive)
-        return do_close();
-
-    boost::asio::spawn(
-        strand_,
-        std::bind(
-            &BaseHTTPPeer<Handler, Impl>::do_read,
-            impl().shared_from_this(),
-            std::placeholders::_1));
+    writing_ = false;
+    send();
 }
 
 //------------------------------------------------------------------------------
 
-// Send a copy of the data.
 template <class Handler, class Impl>
 void
-BaseHTTPPeer<Handler, Impl>::write(void const* buf, std::size_t bytes)
+BaseHTTPPeer<Handler, Impl>::write(void const*, std::size_t)
 {
-    if (bytes == 0)
-        return;
-    if ([&] {
-            std::lock_guard lock(mutex_);
-            wq_.emplace_back(buf, bytes);
-            return wq_.size() == 1 && wq2_.size() == 0;
-        }())
-    {
-        if (!strand_.running_in_this_thread())
-            return post(
-                strand_,
-                std::bind(
-                    &BaseHTTPPeer::on_write,
-                    impl().shared_from_this(),
-                    error_code{},
-                    0));
-        else
-            return on_write(error_code{}, 0);
-    }
+    assert(false);
 }
 
 template <class Handler, class Impl>
 void
-BaseHTTPPeer<Handler, Impl>::write(
-    std::shared_ptr<Writer> const& writer,
-    bool keep_alive)
+BaseHTTPPeer<Handler, Impl>::write(std::shared_ptr<Writer> const&, bool)
 {
-    boost::asio::spawn(bind_executor(
-        strand_,
-        std::bind(
-            &BaseHTTPPeer<Handler, Impl>::do_writer,
-            impl().shared_from_this(),
-            writer,
-            keep_alive,
-            std::placeholders::_1)));
+    assert(false);
 }
 
-// DEPRECATED
-// Make the Session asynchronous
 template <class Handler, class Impl>
 std::shared_ptr<Session>
 BaseHTTPPeer<Handler, Impl>::detach()
 {
-    return impl().shared_from_this();
+    assert(false);
+    return nullptr;
 }
 
-// DEPRECATED
-// Called to indicate the response has been written(but not sent)
 template <class Handler, class Impl>
 void
 BaseHTTPPeer<Handler, Impl>::complete()
 {
-    if (!strand_.running_in_this_thread())
-        return post(
-            strand_,
-            std::bind(
-                &BaseHTTPPeer<Handler, Impl>::complete,
-                impl().shared_from_this()));
-
-    message_ = {};
-    complete_ = true;
-
-    {
-        std::lock_guard lock(mutex_);
-        if (!wq_.empty() && !wq2_.empty())
-            return;
-    }
-
-    // keep-alive
-    boost::asio::spawn(bind_executor(
-        strand_,
-        std::bind(
-            &BaseHTTPPeer<Handler, Impl>::do_read,
-            impl().shared_from_this(),
-            std::placeholders::_1)));
+    assert(false);
 }
 
-// DEPRECATED
-// Called from the Handler to close the session.
 template <class Handler, class Impl>
 void
-BaseHTTPPeer<Handler, Impl>::close(bool graceful)
+BaseHTTPPeer<Handler, Impl>::close(bool)
 {
-    if (!strand_.running_in_this_thread())
-        return post(
-            strand_,
-            std::bind(
-                (void (BaseHTTPPeer::*)(bool)) &
-                    BaseHTTPPeer<Handler, Impl>::close,
-                impl().shared_from_this(),
-                graceful));
-
-    complete_ = true;
-    if (graceful)
-    {
-        graceful_ = true;
-        {
-            std::lock_guard lock(mutex_);
-            if (!wq_.empty() || !wq2_.empty())
-                return;
-        }
-        return do_close();
-    }
-
-    boost::beast::get_lowest_layer(impl().stream_).close();
+    assert(false);
 }
 
 }  // namespace ripple
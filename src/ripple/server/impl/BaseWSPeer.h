@@ -29,6 +29,7 @@
 #include <boost/beast/core/multi_buffer.hpp>
 #include <boost/beast/http/message.hpp>
 #include <boost/beast/websocket.hpp>
+#include <algorithm>
 #include <cassert>
 #include <functional>
 
@@ -51,7 +52,9 @@ private:
     http_request_type request_;
     boost::beast::multi_buffer rb_;
     boost::beast::multi_buffer wb_;
-    std::list<std::shared_ptr<WSMsg>> wq_;
+    // Messages waiting to be written, and whether each was published to a
+    // stream. The front one is being written.
+    std::list<std::pair<std::shared_ptr<WSMsg>, bool>> wq_;
     bool do_close_ = false;
     boost::beast::websocket::close_reason cr_;
     waitable_timer timer_;
@@ -102,6 +105,9 @@ public:
     void
     send(std::shared_ptr<WSMsg> w) override;
 
+    void
+    publish(std::shared_ptr<WSMsg> w) override;
+
     void
     close() override;
 
@@ -121,6 +127,9 @@ protected:
     void
     on_ws_handshake(error_code const& ec);
 
+    void
+    enqueue(std::shared_ptr<WSMsg> const& w, bool published);
+
     void
     do_write();
 
@@ -223,8 +232,50 @@ BaseWSPeer<Handler, Impl>::send(std::shared_ptr<WSMsg> w)
             strand_,
             std::bind(
                 &BaseWSPeer::send, impl().shared_from_this(), std::move(w)));
+    enqueue(w, false);
+}
+
+template <class Handler, class Impl>
+void
+BaseWSPeer<Handler, Impl>::publish(std::shared_ptr<WSMsg> w)
+{
+    if (!strand_.running_in_this_thread())
+        return post(
+            strand_,
+            std::bind(
+                &BaseWSPeer::publish,
+                impl().shared_from_this(),
+                std::move(w)));
+    enqueue(w, true);
+}
+
+template <class Handler, class Impl>
+void
+BaseWSPeer<Handler, Impl>::enqueue(
+    std::shared_ptr<WSMsg> const& w,
+    bool published)
+{
     if (do_close_)
         return;
+    if (wq_.size() > port().ws_queue_limit && port().ws_queue_drop)
+    {
+        // Drop the oldest published message that isn't being written, or
+        // this one. Replies are never dropped.
+        auto const it = std::find_if(
+            std::next(wq_.begin()), wq_.end(), [](auto const& queued) {
+                return queued.second;
+            });
+        if (it != wq_.end())
+        {
+            JLOG(this->j_.trace()) << "Dropping message: client is too slow.";
+            wq_.erase(it);
+        }
+        else if (published)
+        {
+            JLOG(this->j_.trace()) << "Dropping message: client is too slow.";
+            return;
+        }
+    }
     if (wq_.size() > port().ws_queue_limit)
     {
         cr_.code = safe_cast<decltype(cr_.code)>(
@@ -235,7 +286,7 @@ BaseWSPeer<Handler, Impl>::send(std::shared_ptr<WSMsg> w)
         close(cr_);
         return;
     }
-    wq_.emplace_back(std::move(w));
+    wq_.emplace_back(w, published);
     if (wq_.size() == 1)
         on_write({});
 }
@@ -312,7 +363,7 @@ BaseWSPeer<Handler, Impl>::on_write(error_code const& ec)
 {
     if (ec)
         return fail(ec, "write");
-    auto& w = *wq_.front();
+    auto& w = *wq_.front().first;
     auto const result = w.prepare(
         65536, std::bind(&BaseWSPeer::do_write, impl().shared_from_this()));
     if (boost::indeterminate(result.first))
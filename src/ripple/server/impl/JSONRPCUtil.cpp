@@ -156,4 +156,18 @@ HTTPReply(
     output("\r\n");
 }
 
+std::string
+HTTPChunkedReplyHead(std::string const& contentType)
+{
+    return "HTTP/1.1 200 OK\r\n" + getHTTPHeaderTimestamp() +
+        "Transfer-Encoding: chunked\r\n"
+        "Content-Type: " +
+        contentType +
+        "\r\n"
+        "Server: " +
+        systemName() + "-json-rpc/" + BuildInfo::getFullVersionString() +
+        "\r\n"
+        "\r\n";
+}
+
 }  // namespace ripple
@@ -32,6 +32,14 @@ HTTPReply(
     Json::Output const&,
     beast::Journal j);
 
+/** The head of a successful reply whose body is sent in chunks, as it's
+    produced. The last chunk marks the end of the body, so the connection
+    can be kept for more requests.
+*/
+std::string
+HTTPChunkedReplyHead(
+    std::string const& contentType = "application/json; charset=UTF-8");
+
 }  // namespace ripple
 
 #endif
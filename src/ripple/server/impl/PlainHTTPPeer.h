@@ -151,7 +151,7 @@ PlainHTTPPeer<Handler>::do_request()
             socket_.shutdown(socket_type::shutdown_receive, ec);
         if (ec)
             return this->fail(ec, "request");
-        return this->write(what.response, what.keep_alive);
+        return this->pipeline()->write(what.response, what.keep_alive);
     }
 
     // Perform half-close when Connection: close and not SSL
@@ -160,7 +160,7 @@ PlainHTTPPeer<Handler>::do_request()
     if (ec)
         return this->fail(ec, "request");
     // legacy
-    this->handler_.onRequest(this->session());
+    this->handler_.onRequest(*this->pipeline());
 }
 
 template <class Handler>
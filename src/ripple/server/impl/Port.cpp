@@ -292,6 +292,18 @@ parse_Port(ParsedPort& port, Section const& section, std::ostream& log)
         }
     }
 
+    if (auto const policy = section.get("send_queue_policy"))
+    {
+        if (boost::iequals(*policy, "drop"))
+            port.ws_queue_drop = true;
+        else if (!boost::iequals(*policy, "close"))
+        {
+            log << "Invalid value '" << *policy << "' for key "
+                << "'send_queue_policy' in [" << section.name() << "]";
+            Throw<std::exception>();
+        }
+    }
+
     populate(section, "admin", log, port.admin_nets_v4, port.admin_nets_v6);
     populate(
         section,
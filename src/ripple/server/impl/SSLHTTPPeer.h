@@ -186,9 +186,9 @@ SSLHTTPPeer<Handler>::do_request()
     if (what.moved)
         return;
     if (what.response)
-        return this->write(what.response, what.keep_alive);
+        return this->pipeline()->write(what.response, what.keep_alive);
     // legacy
-    this->handler_.onRequest(this->session());
+    this->handler_.onRequest(*this->pipeline());
 }
 
 template <class Handler>
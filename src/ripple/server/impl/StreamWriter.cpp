@@ -0,0 +1,226 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/server/StreamWriter.h>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace ripple {
+
+struct StreamWriter::State
+{
+    std::function<void()> suspend;
+    std::function<void()> wake;
+
+    std::mutex mutex;
+
+    // Chunks ready to send. The session's buffers point into them, so
+    // they're only ever added at the back and removed from the front.
+    std::deque<std::string> chunks;
+    std::size_t offset = 0;
+    std::size_t buffered = 0;
+
+    // Lets the session continue once there's something to send.
+    std::function<void(void)> resume;
+
+    bool suspended = false;
+    bool done = false;
+    bool closed = false;
+};
+
+class StreamWriter::Body : public Writer
+{
+    std::shared_ptr<State> const state_;
+
+public:
+    explicit Body(std::shared_ptr<State> state) : state_(std::move(state))
+    {
+    }
+
+    ~Body() override
+    {
+        bool wake;
+        {
+            std::lock_guard lock(state_->mutex);
+            state_->closed = true;
+            state_->chunks.clear();
+            wake = std::exchange(state_->suspended, false);
+        }
+        if (wake)
+            state_->wake();
+    }
+
+    bool
+    complete() override
+    {
+        std::lock_guard lock(state_->mutex);
+        return state_->done && state_->chunks.empty();
+    }
+
+    void
+    consume(std::size_t bytes) override
+    {
+        bool wake = false;
+        {
+            std::lock_guard lock(state_->mutex);
+            auto& chunks = state_->chunks;
+            state_->buffered -= bytes;
+            state_->offset += bytes;
+            while (!chunks.empty() && state_->offset >= chunks.front().size())
+            {
+                state_->offset -= chunks.front().size();
+                chunks.pop_front();
+            }
+            if (state_->suspended && state_->buffered <= limit / 2)
+            {
+                state_->suspended = false;
+                wake = true;
+            }
+        }
+        if (wake)
+            state_->wake();
+    }
+
+    bool
+    prepare(std::size_t, std::function<void(void)> resume) override
+    {
+        std::lock_guard lock(state_->mutex);
+        if (!state_->chunks.empty() || state_->done)
+            return true;
+        state_->resume = std::move(resume);
+        return false;
+    }
+
+    std::vector<boost::asio::const_buffer>
+    data() override
+    {
+        std::lock_guard lock(state_->mutex);
+        std::vector<boost::asio::const_buffer> result;
+        result.reserve(state_->chunks.size());
+        auto offset = state_->offset;
+        for (auto const& chunk : state_->chunks)
+        {
+            result.emplace_back(chunk.data() + offset, chunk.size() - offset);
+            offset = 0;
+        }
+        return result;
+    }
+};
+
+StreamWriter::StreamWriter(
+    std::string head,
+    std::function<void()> suspend,
+    std::function<void()> wake)
+    : state_(std::make_shared<State>())
+{
+    state_->suspend = std::move(suspend);
+    state_->wake = std::move(wake);
+    state_->buffered = head.size();
+    if (!head.empty())
+        state_->chunks.push_back(std::move(head));
+    pending_.reserve(chunkSize);
+}
+
+StreamWriter::~StreamWriter()
+{
+    abort();
+}
+
+std::shared_ptr<Writer>
+StreamWriter::body()
+{
+    return std::make_shared<Body>(state_);
+}
+
+void
+StreamWriter::write(boost::beast::string_view data)
+{
+    pending_.append(data.data(), data.size());
+    if (pending_.size() >= chunkSize)
+        flush(false);
+}
+
+void
+StreamWriter::finish()
+{
+    flush(true);
+}
+
+void
+StreamWriter::abort()
+{
+    std::function<void(void)> resume;
+    {
+        std::lock_guard lock(state_->mutex);
+        if (state_->done)
+            return;
+        state_->done = true;
+        resume = std::move(state_->resume);
+    }
+    if (resume)
+        resume();
+}
+
+bool
+StreamWriter::closed() const
+{
+    std::lock_guard lock(state_->mutex);
+    return state_->closed;
+}
+
+void
+StreamWriter::flush(bool last)
+{
+    std::string chunk;
+    if (!pending_.empty())
+    {
+        char size[20];
+        auto const n =
+            std::snprintf(size, sizeof(size), "%zx\r\n", pending_.size());
+        chunk.reserve(n + pending_.size() + 7);
+        chunk.append(size, n);
+        chunk += pending_;
+        chunk += "\r\n";
+        pending_.clear();
+    }
+    if (last)
+        chunk += "0\r\n\r\n";
+
+    std::function<void(void)> resume;
+    bool suspend = false;
+    {
+        std::lock_guard lock(state_->mutex);
+        if (state_->closed || state_->done)
+            return;
+        state_->buffered += chunk.size();
+        state_->chunks.push_back(std::move(chunk));
+        state_->done = last;
+        resume = std::move(state_->resume);
+        suspend = state_->suspended = !last && state_->buffered >= limit;
+    }
+
+    if (resume)
+        resume();
+    if (suspend)
+        state_->suspend();
+}
+
+}  // namespace ripple
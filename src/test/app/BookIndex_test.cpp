@@ -0,0 +1,368 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/AcceptedLedger.h>
+#include <ripple/app/ledger/BookIndex.h>
+#include <ripple/app/ledger/OrderBookDB.h>
+#include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/ledger/View.h>
+#include <ripple/protocol/TxFlags.h>
+#include <ripple/protocol/jss.h>
+#include <test/jtx.h>
+#include <chrono>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+// Waits for the server to have published the last closed ledger to its
+// book index.
+inline bool
+published(jtx::Env& env, Book const& book)
+{
+    using namespace std::chrono_literals;
+    auto& index = env.app().getOrderBookDB().bookIndex();
+    for (int i = 0; i < 500; ++i)
+    {
+        if (index.find(*env.closed(), book))
+            return true;
+        std::this_thread::sleep_for(10ms);
+    }
+    return false;
+}
+
+class BookIndex_test : public beast::unit_test::suite
+{
+    // The offers of a book, in order.
+    static std::vector<std::shared_ptr<SLE const>>
+    offers(BookIndex::Levels const& levels)
+    {
+        std::vector<std::shared_ptr<SLE const>> result;
+        for (auto const& [dir, level] : levels)
+        {
+            for (auto const& offer : level->offers)
+                result.push_back(offer->sle);
+        }
+        return result;
+    }
+
+    static std::size_t
+    countOffers(BookIndex::Levels const& levels)
+    {
+        return offers(levels).size();
+    }
+
+    // The kept book matches the ledger's, and so does anything kept of
+    // what its owners hold.
+    void
+    expectBook(
+        BookIndex& index,
+        ReadView const& ledger,
+        Book const& book,
+        std::vector<jtx::Account> const& owners)
+    {
+        auto const kept = index.find(ledger, book);
+        if (!BEAST_EXPECT(kept))
+            return;
+
+        auto const expected = offers(*BookIndex::read(ledger, book));
+        auto const actual = offers(*kept->levels);
+        if (BEAST_EXPECT(actual.size() == expected.size()))
+        {
+            for (std::size_t i = 0; i < actual.size(); ++i)
+                BEAST_EXPECT(*actual[i] == *expected[i]);
+        }
+
+        for (auto const& owner : owners)
+        {
+            auto holds = accountHolds(
+                ledger,
+                owner,
+                book.out,
+                fhZERO_IF_FROZEN,
+                beast::Journal{beast::Journal::getNullSink()});
+            if (holds < beast::zero)
+                holds.clear();
+            BEAST_EXPECT(
+                kept->funds->get(owner, [&] { return holds; }) == holds);
+        }
+    }
+
+    void
+    testUpdate()
+    {
+        testcase("update");
+
+        using namespace jtx;
+        Env env{*this};
+        Account const gw{"gw"};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const carol{"carol"};
+        Account const dan{"dan"};
+        auto const USD = gw["USD"];
+        std::vector<Account> const owners{alice, bob, carol, dan};
+
+        env.fund(XRP(100000), gw, alice, bob, carol, dan);
+        env.close();
+        env.trust(USD(100000), alice, bob, carol, dan);
+        env.close();
+        for (auto const& owner : {alice, bob, carol})
+            env(pay(gw, owner, USD(1000)));
+        env.close();
+
+        Book const book{xrpIssue(), USD.issue()};
+        BookIndex index(env.journal);
+        auto step = [&] {
+            env.close();
+            index.update(AcceptedLedger(env.closed(), env.app()));
+            expectBook(index, *env.closed(), book, owners);
+        };
+        step();
+
+        // Offers at two qualities, two of them at the same one.
+        auto const aliceSeq = env.seq(alice);
+        env(offer(alice, XRP(100), USD(10)));
+        auto const bobSeq = env.seq(bob);
+        env(offer(bob, XRP(200), USD(10)));
+        env(offer(carol, XRP(100), USD(10)));
+        env(offer(carol, XRP(150), USD(10)));
+        step();
+        if (auto const kept = index.find(*env.closed(), book);
+            BEAST_EXPECT(kept))
+            BEAST_EXPECT(offers(*kept->levels).size() == 4);
+
+        // Partly taken, cancelled, and the owners' balances change.
+        env(offer(dan, USD(5), XRP(50)));
+        env(offer_cancel(bob, bobSeq));
+        env(pay(alice, carol, USD(500)));
+        step();
+
+        // Created and cancelled in the same ledger, and offers replaced.
+        auto const carolSeq = env.seq(carol);
+        env(offer(carol, XRP(90), USD(10)));
+        env(offer_cancel(carol, carolSeq));
+        env(offer(alice, XRP(120), USD(20)),
+            json(sfOfferSequence.fieldName, aliceSeq));
+        step();
+
+        // Frozen, one and all.
+        env(trust(gw, carol["USD"](0), tfSetFreeze));
+        step();
+        env(fset(gw, asfGlobalFreeze));
+        step();
+        env(fclear(gw, asfGlobalFreeze));
+        step();
+
+        // Taken entirely.
+        env(offer(dan, USD(100), XRP(10000)));
+        step();
+
+        // Only the last published ledger is answered for.
+        auto const previous = env.closed();
+        step();
+        BEAST_EXPECT(!index.find(*previous, book));
+        BEAST_EXPECT(!index.find(*env.current(), book));
+
+        // A ledger that doesn't follow starts over.
+        env.close();
+        env.close();
+        index.update(AcceptedLedger(env.closed(), env.app()));
+        expectBook(index, *env.closed(), book, owners);
+    }
+
+    void
+    testFunds()
+    {
+        testcase("funds");
+
+        using namespace jtx;
+        Env env{*this};
+        Account const gw{"gw"};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(100000), gw, alice, bob);
+        env.trust(USD(1000), alice, bob);
+        env.close();
+        env(pay(gw, alice, USD(100)));
+        env(pay(gw, bob, USD(100)));
+        env(offer(alice, XRP(100), USD(10)));
+        env.close();
+
+        Book const book{xrpIssue(), USD.issue()};
+        BookIndex index(env.journal);
+        index.update(AcceptedLedger(env.closed(), env.app()));
+        auto const previous = env.closed();
+        auto const before = index.find(*previous, book);
+        if (!BEAST_EXPECT(before))
+            return;
+
+        // Alice's balance changes before anyone asked what she holds. The
+        // issuer isn't touched, so what's known of the others is kept.
+        env(pay(bob, alice, USD(50)));
+        env.close();
+        index.update(AcceptedLedger(env.closed(), env.app()));
+
+        // A reader of the previous ledger learns what she held then, which
+        // mustn't carry over to the new one.
+        auto const held = accountHolds(
+            *previous,
+            alice,
+            USD.currency,
+            gw,
+            fhZERO_IF_FROZEN,
+            beast::Journal{beast::Journal::getNullSink()});
+        BEAST_EXPECT(before->funds->get(alice, [&] { return held; }) == held);
+        expectBook(index, *env.closed(), book, {alice});
+    }
+
+    void
+    testBounds()
+    {
+        testcase("bounds");
+
+        using namespace jtx;
+        Env env{*this};
+        Account const gw{"gw"};
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+        auto const JPY = gw["JPY"];
+        auto const CAD = gw["CAD"];
+
+        env.fund(XRP(100000), gw);
+        env.close();
+        auto place = [&](IOU const& iou, int count) {
+            for (int i = 0; i < count; ++i)
+                env(offer(gw, XRP(100 + i), iou(10)));
+        };
+        place(USD, 2);
+        place(EUR, 2);
+        place(JPY, 1);
+        place(CAD, 6);
+        env.close();
+
+        auto book = [](IOU const& iou) {
+            return Book{xrpIssue(), iou.issue()};
+        };
+        using Size = std::pair<std::size_t, std::size_t>;
+
+        // At most two books and five offers.
+        BookIndex index(env.journal, 2, 5);
+        auto step = [&] {
+            env.close();
+            index.update(AcceptedLedger(env.closed(), env.app()));
+        };
+        auto find = [&](IOU const& iou, std::size_t offers) {
+            auto const kept = index.find(*env.closed(), book(iou));
+            if (BEAST_EXPECT(kept))
+                BEAST_EXPECT(countOffers(*kept->levels) == offers);
+        };
+        step();
+
+        find(USD, 2);
+        step();
+        find(EUR, 2);
+        BEAST_EXPECT((index.size() == Size{2, 4}));
+
+        // A book with too many offers is answered, but not kept.
+        find(CAD, 6);
+        BEAST_EXPECT((index.size() == Size{2, 4}));
+
+        // A third book replaces the one asked about least recently.
+        find(JPY, 1);
+        BEAST_EXPECT((index.size() == Size{2, 3}));
+        step();
+        find(JPY, 1);
+        step();
+        find(USD, 2);
+        BEAST_EXPECT((index.size() == Size{2, 3}));
+
+        // The books grow past the offers they may keep, so the one asked
+        // about least recently goes.
+        place(USD, 3);
+        step();
+        BEAST_EXPECT((index.size() == Size{1, 5}));
+        find(USD, 5);
+    }
+
+    void
+    testBookOffers()
+    {
+        testcase("book_offers");
+
+        using namespace jtx;
+        Env env{*this};
+        Account const gw{"gw"};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(100000), gw, alice, bob);
+        env.trust(USD(1000), alice, bob);
+        env.close();
+        env(pay(gw, alice, USD(50)));
+        env(pay(gw, bob, USD(100)));
+        env(offer(alice, XRP(500), USD(100)));
+        env(offer(bob, XRP(1000), USD(100)));
+        env(offer(alice, XRP(200), USD(20)));
+        env.close();
+
+        Book const book{xrpIssue(), USD.issue()};
+        BEAST_EXPECT(published(env, book));
+
+        // The kept book answers as the ledger would.
+        auto request = [&](char const* ledger) {
+            Json::Value params;
+            params[jss::ledger_index] = ledger;
+            params[jss::taker_pays][jss::currency] = "XRP";
+            params[jss::taker_gets][jss::currency] = "USD";
+            params[jss::taker_gets][jss::issuer] = gw.human();
+            return env.rpc(
+                "json", "book_offers", to_string(params))[jss::result];
+        };
+        for (int i = 0; i < 3; ++i)
+        {
+            auto const kept = request("validated");
+            auto const read = request("current");
+            BEAST_EXPECT(kept[jss::offers].size() == 3);
+            BEAST_EXPECT(kept[jss::offers] == read[jss::offers]);
+
+            env(pay(gw, alice, USD(10)));
+            env.close();
+            BEAST_EXPECT(published(env, book));
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testUpdate();
+        testFunds();
+        testBounds();
+        testBookOffers();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(BookIndex, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
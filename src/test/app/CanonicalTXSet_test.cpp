@@ -0,0 +1,351 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/misc/CanonicalTXSet.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+static std::shared_ptr<STTx const>
+makeTx(AccountID const& account, std::uint32_t seq, std::uint32_t ticket = 0)
+{
+    return std::make_shared<STTx const>(ttACCOUNT_SET, [&](STObject& obj) {
+        obj.setAccountID(sfAccount, account);
+        obj.setFieldU32(sfSequence, seq);
+        if (ticket != 0)
+            obj.setFieldU32(sfTicketSequence, ticket);
+    });
+}
+
+// Build transactions for the given number of accounts, each with the given
+// number of sequential transactions, in a random order.
+static std::vector<std::shared_ptr<STTx const>>
+makeTxs(std::size_t accounts, std::size_t perAccount)
+{
+    std::vector<std::shared_ptr<STTx const>> txs;
+    txs.reserve(accounts * perAccount);
+    for (std::size_t a = 0; a < accounts; ++a)
+    {
+        AccountID const account{static_cast<std::uint64_t>(a + 1)};
+        for (std::size_t s = 0; s < perAccount; ++s)
+            txs.push_back(makeTx(account, s + 1));
+    }
+    std::shuffle(txs.begin(), txs.end(), default_prng());
+    return txs;
+}
+
+class CanonicalTXSet_test : public beast::unit_test::suite
+{
+    // Check that transactions are grouped by account and that, within an
+    // account, they come in SeqProxy order.
+    void
+    expectCanonical(CanonicalTXSet& set)
+    {
+        std::set<AccountID> seen;
+        std::optional<AccountID> account;
+        std::optional<SeqProxy> last;
+        std::size_t count = 0;
+
+        for (auto const& [key, tx] : set)
+        {
+            ++count;
+            auto const id = tx->getAccountID(sfAccount);
+            BEAST_EXPECT(key.getTXID() == tx->getTransactionID());
+
+            if (id != account)
+            {
+                BEAST_EXPECT(seen.insert(id).second);
+                account = id;
+                last.reset();
+            }
+            if (last)
+                BEAST_EXPECT(*last < tx->getSeqProxy());
+            last = tx->getSeqProxy();
+        }
+
+        BEAST_EXPECT(count == set.size());
+    }
+
+    void
+    testOrdering()
+    {
+        testcase("ordering");
+
+        CanonicalTXSet set{uint256{42}};
+        BEAST_EXPECT(set.empty());
+
+        auto const txs = makeTxs(20, 8);
+        for (auto const& tx : txs)
+            set.insert(tx);
+        BEAST_EXPECT(set.size() == txs.size());
+        expectCanonical(set);
+
+        // Transactions with a sequence come before tickets.
+        AccountID const alice{1000};
+        set.insert(makeTx(alice, 0, 3));
+        set.insert(makeTx(alice, 7));
+        set.insert(makeTx(alice, 0, 1));
+        expectCanonical(set);
+
+        std::vector<SeqProxy> seqs;
+        for (auto const& [_, tx] : set)
+        {
+            if (tx->getAccountID(sfAccount) == alice)
+                seqs.push_back(tx->getSeqProxy());
+        }
+        BEAST_EXPECT(seqs.size() == 3);
+        BEAST_EXPECT(seqs[0] == SeqProxy::sequence(7));
+        BEAST_EXPECT((seqs[1] == SeqProxy{SeqProxy::ticket, 1}));
+        BEAST_EXPECT((seqs[2] == SeqProxy{SeqProxy::ticket, 3}));
+
+        // The salt changes the order of accounts, but not their grouping.
+        set.reset(uint256{7});
+        BEAST_EXPECT(set.empty());
+        for (auto const& tx : txs)
+            set.insert(tx);
+        expectCanonical(set);
+    }
+
+    void
+    testDuplicates()
+    {
+        testcase("duplicates");
+
+        CanonicalTXSet set{uint256{1}};
+        auto const tx = makeTx(AccountID{1}, 5);
+
+        set.insert(tx);
+        set.insert(tx);
+        BEAST_EXPECT(set.size() == 1);
+
+        // Once sorted, a duplicate insert is still ignored.
+        set.insert(tx);
+        set.insert(makeTx(AccountID{1}, 6));
+        BEAST_EXPECT(set.size() == 2);
+
+        // But a transaction that was erased can be inserted again.
+        set.erase(set.begin());
+        BEAST_EXPECT(set.size() == 1);
+        set.insert(tx);
+        BEAST_EXPECT(set.size() == 2);
+        BEAST_EXPECT(set.begin()->second == tx);
+    }
+
+    void
+    testErase()
+    {
+        testcase("erase");
+
+        CanonicalTXSet set{uint256{3}};
+        auto const txs = makeTxs(10, 10);
+        for (auto const& tx : txs)
+            set.insert(tx);
+
+        // Erase every other transaction, in several passes, the way
+        // buildLedger does.
+        std::set<uint256> remaining;
+        for (auto const& tx : txs)
+            remaining.insert(tx->getTransactionID());
+
+        for (int pass = 0; pass < 3; ++pass)
+        {
+            bool odd = false;
+            auto it = set.begin();
+            while (it != set.end())
+            {
+                if ((odd = !odd))
+                {
+                    remaining.erase(it->first.getTXID());
+                    it = set.erase(it);
+                }
+                else
+                    ++it;
+            }
+
+            BEAST_EXPECT(set.size() == remaining.size());
+            expectCanonical(set);
+
+            std::set<uint256> left;
+            for (auto const& entry : set)
+                left.insert(entry.first.getTXID());
+            BEAST_EXPECT(left == remaining);
+        }
+
+        while (!set.empty())
+            set.erase(set.begin());
+        BEAST_EXPECT(set.begin() == set.end());
+    }
+
+    void
+    testPopAcctTransaction()
+    {
+        testcase("popAcctTransaction");
+
+        CanonicalTXSet set{uint256{9}};
+        AccountID const alice{1};
+        AccountID const bob{2};
+
+        auto const a1 = makeTx(alice, 1);
+        auto const a2 = makeTx(alice, 2);
+        auto const a3 = makeTx(alice, 3);
+        auto const at = makeTx(alice, 0, 10);
+        auto const b1 = makeTx(bob, 1);
+
+        // a1 was just applied, so it's not in the set.
+        for (auto const& tx : {at, a3, b1, a2})
+            set.insert(tx);
+
+        BEAST_EXPECT(set.popAcctTransaction(a1) == a2);
+        BEAST_EXPECT(set.size() == 3);
+
+        // Erased entries are skipped.
+        for (auto it = set.begin(); it != set.end(); ++it)
+        {
+            if (it->second == a3)
+            {
+                set.erase(it);
+                break;
+            }
+        }
+        BEAST_EXPECT(set.popAcctTransaction(a2) == at);
+        BEAST_EXPECT(!set.popAcctTransaction(at));
+        BEAST_EXPECT(set.popAcctTransaction(b1) == b1);
+        BEAST_EXPECT(set.empty());
+    }
+
+    void
+    testAccounts()
+    {
+        testcase("accounts");
+
+        CanonicalTXSet set{uint256{5}};
+        BEAST_EXPECT(set.accounts().empty());
+
+        auto const txs = makeTxs(25, 4);
+        for (auto const& tx : txs)
+            set.insert(tx);
+
+        // Leave one account with a single transaction.
+        std::size_t erased = 0;
+        for (auto it = set.begin(); it != set.end();)
+        {
+            if (it->second->getAccountID(sfAccount) == AccountID{3} &&
+                erased++ < 3)
+                it = set.erase(it);
+            else
+                ++it;
+        }
+
+        auto const groups = set.accounts();
+        BEAST_EXPECT(groups.size() == 25);
+
+        std::size_t total = 0;
+        std::set<AccountID> seen;
+        for (auto const& [first, last] : groups)
+        {
+            auto const account = first->second->getAccountID(sfAccount);
+            BEAST_EXPECT(seen.insert(account).second);
+
+            auto const n = std::distance(first, last);
+            BEAST_EXPECT(n == (account == AccountID{3} ? 1 : 4));
+            total += n;
+
+            for (auto it = first; it != last; ++it)
+                BEAST_EXPECT(it->second->getAccountID(sfAccount) == account);
+        }
+        BEAST_EXPECT(total == set.size());
+    }
+
+    void
+    testInterleaved()
+    {
+        testcase("interleaved");
+
+        // Mix inserts, erases and iteration without letting the set settle
+        // in between, and compare against the transactions that should be
+        // there.
+        CanonicalTXSet set{uint256{11}};
+        std::map<uint256, std::shared_ptr<STTx const>> expected;
+        auto const pool = makeTxs(30, 6);
+        auto& prng = default_prng();
+
+        for (int round = 0; round < 200; ++round)
+        {
+            // Insert a few transactions, some of which may already be in
+            // the set or may have been erased earlier.
+            auto const inserts = rand_int(prng, 0, 5);
+            for (int i = 0; i < inserts; ++i)
+            {
+                auto const& tx = pool[rand_int(prng, pool.size() - 1)];
+                set.insert(tx);
+                expected.emplace(tx->getTransactionID(), tx);
+            }
+
+            // Erase some of what's there, then insert again before the
+            // erased entries are removed.
+            auto const erases = rand_int(prng, 0, 4);
+            for (int i = 0; i < erases && !set.empty(); ++i)
+            {
+                auto it = set.begin();
+                if (set.size() > 1)
+                    std::advance(it, rand_int(prng, set.size() - 1));
+                BEAST_EXPECT(expected.erase(it->first.getTXID()) == 1);
+                set.erase(it);
+            }
+            if (rand_int(prng, 1) == 0)
+            {
+                auto const& tx = pool[rand_int(prng, pool.size() - 1)];
+                set.insert(tx);
+                expected.emplace(tx->getTransactionID(), tx);
+            }
+
+            BEAST_EXPECT(set.size() == expected.size());
+            BEAST_EXPECT(set.empty() == expected.empty());
+            expectCanonical(set);
+
+            std::map<uint256, std::shared_ptr<STTx const>> actual;
+            for (auto const& [key, tx] : set)
+                BEAST_EXPECT(actual.emplace(key.getTXID(), tx).second);
+            BEAST_EXPECT(actual == expected);
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testOrdering();
+        testDuplicates();
+        testErase();
+        testPopAcctTransaction();
+        testAccounts();
+        testInterleaved();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CanonicalTXSet, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -718,6 +718,21 @@ public:
         return i->second.lock();
     }
 
+    std::vector<std::shared_ptr<LedgerDeltaAcquire>> const&
+    getDeltas(std::shared_ptr<LedgerReplayTask> const& task)
+    {
+        return task->deltas_;
+    }
+
+    std::size_t
+    countStartedDeltas(std::shared_ptr<LedgerReplayTask> const& task)
+    {
+        return std::count_if(
+            task->deltas_.begin(), task->deltas_.end(), [](auto const& d) {
+                return d->started_;
+            });
+    }
+
     template <typename T>
     TaskStatus
     taskStatus(std::shared_ptr<T> const& t)
@@ -1075,6 +1090,26 @@ struct LedgerReplayer_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testFetchInfo()
+    {
+        testcase("fetch_info");
+        for (bool const replay : {false, true})
+        {
+            jtx::Env env(*this, jtx::envconfig([&](std::unique_ptr<Config> c) {
+                c->LEDGER_REPLAY = replay;
+                return c;
+            }));
+            auto const result = env.rpc("fetch_info")[jss::result];
+            BEAST_EXPECT(result[jss::info].isObject());
+            BEAST_EXPECT(!result[jss::info].isMember(jss::ledger_replay));
+            BEAST_EXPECT(result.isMember(jss::ledger_replay) == replay);
+            if (replay)
+                BEAST_EXPECT(
+                    result[jss::ledger_replay][jss::ledgers_built] == 0);
+        }
+    }
+
     void
     testHandshake()
     {
@@ -1351,6 +1386,51 @@ struct LedgerReplayer_test : public beast::unit_test::suite
                 finalHash, totalReplay + 1)) == TaskStatus::Failed);
     }
 
+    void
+    testDeltaWindow()
+    {
+        testcase("bounded number of deltas in flight");
+        std::uint32_t const window =
+            LedgerReplayParameters::MAX_DELTAS_IN_FLIGHT;
+        int totalReplay = window + 10;
+        NetworkOfTwo net(
+            *this,
+            {totalReplay + 1},
+            PeerSetBehavior::DropLedgerDeltaReply,
+            InboundLedgersBehavior::Good,
+            PeerFeature::LedgerReplayEnabled);
+
+        auto l = net.server.ledgerMaster.getClosedLedger();
+        uint256 finalHash = l->info().hash;
+        net.client.replayer.replay(
+            InboundLedger::Reason::GENERIC, finalHash, totalReplay);
+
+        auto task = net.client.findTask(finalHash, totalReplay);
+        if (!BEAST_EXPECT(
+                task && net.client.getDeltas(task).size() == totalReplay - 1))
+            return;
+
+        // Only the deltas closest to the start ledger are acquired.
+        BEAST_EXPECT(net.client.countStartedDeltas(task) == window);
+
+        // Once the first ledgers are built, the next deltas are acquired.
+        int const built = 5;
+        for (int i = 0; i < built; ++i)
+        {
+            net.client.addLedger(net.server.ledgerMaster.getLedgerBySeq(
+                l->info().seq - totalReplay + 2 + i));
+        }
+        bool moved = false;
+        for (int i = 0; i < 20 && !moved; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            moved = net.client.countStartedDeltas(task) == window + built;
+        }
+        BEAST_EXPECT(moved);
+        BEAST_EXPECT(
+            net.client.replayer.getJson()[jss::ledgers_built] == built);
+    }
+
     void
     testLedgerReplayOverlap()
     {
@@ -1444,6 +1524,7 @@ struct LedgerReplayer_test : public beast::unit_test::suite
         testReplayDelta();
         testTaskParameter();
         testConfig();
+        testFetchInfo();
         testHandshake();
         testAllLocal(1);
         testAllLocal(3);
@@ -1456,6 +1537,7 @@ struct LedgerReplayer_test : public beast::unit_test::suite
         testStop();
         testSkipListBadReply();
         testLedgerDeltaBadReply();
+        testDeltaWindow();
         testLedgerReplayOverlap();
     }
 };
@@ -1586,6 +1668,11 @@ struct LedgerReplayerLong_test : public beast::unit_test::suite
         BEAST_EXPECT(net.client.countsAsExpected(
             rounds, rounds, rounds * (totalReplay - 1)));
 
+        auto const info = net.client.replayer.getJson();
+        log << "Replayed " << info[jss::ledgers_built].asUInt()
+            << " ledgers, " << info[jss::ledgers_per_sec].asDouble()
+            << " ledgers/sec" << std::endl;
+
         // sweep
         net.client.replayer.sweep();
         BEAST_EXPECT(net.client.countsAsExpected(0, 0, 0));
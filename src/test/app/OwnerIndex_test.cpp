@@ -0,0 +1,354 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/AcceptedLedger.h>
+#include <ripple/app/ledger/OwnerIndex.h>
+#include <ripple/ledger/View.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/impl/RPCHelpers.h>
+#include <test/jtx.h>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class OwnerIndex_test : public beast::unit_test::suite
+{
+    static constexpr std::size_t all = std::numeric_limits<std::size_t>::max();
+
+    // The entries of the types in an account's directory, in order, or
+    // all of them if no types are given.
+    static std::vector<uint256>
+    walk(
+        ReadView const& ledger,
+        AccountID const& account,
+        std::vector<LedgerEntryType> const& types)
+    {
+        std::vector<uint256> keys;
+        forEachItem(
+            ledger, account, [&](std::shared_ptr<SLE const> const& sle) {
+                if (types.empty() ||
+                    std::find(types.begin(), types.end(), sle->getType()) !=
+                        types.end())
+                    keys.push_back(sle->key());
+            });
+        return keys;
+    }
+
+    // The index answers as the directory would, all at once and a few at a
+    // time.
+    void
+    expectOwner(
+        OwnerIndex const& index,
+        ReadView const& ledger,
+        AccountID const& account)
+    {
+        for (auto const& types : std::vector<std::vector<LedgerEntryType>>{
+                 {ltRIPPLE_STATE}, {ltOFFER}, {ltOFFER, ltRIPPLE_STATE}})
+        {
+            auto const expected = walk(ledger, account, types);
+
+            auto const found =
+                index.find(ledger, account, types, {}, true, all);
+            if (!BEAST_EXPECT(found))
+                return;
+            BEAST_EXPECT(!found->next);
+            std::vector<uint256> keys;
+            for (auto const& position : found->found)
+            {
+                keys.push_back(position.key);
+                auto const sle = ledger.read(keylet::child(position.key));
+                if (BEAST_EXPECT(sle))
+                    BEAST_EXPECT(
+                        RPC::getStartHint(sle, account) == position.page);
+            }
+            BEAST_EXPECT(keys == expected);
+
+            // A few entries of the directory at a time, of any type, from
+            // the entry after each stretch or after the last in it.
+            for (bool const inclusive : {true, false})
+            {
+                auto const entries = walk(ledger, account, {});
+                keys.clear();
+                std::size_t visited = 0;
+                OwnerIndex::Position start;
+                for (bool first = true;; first = false)
+                {
+                    auto const some = index.find(
+                        ledger, account, types, start, first || inclusive, 7);
+                    if (!BEAST_EXPECT(some && some->last))
+                        break;
+                    for (auto const& position : some->found)
+                        keys.push_back(position.key);
+                    visited += 7;
+                    if (!some->next)
+                        break;
+                    BEAST_EXPECT(
+                        visited < entries.size() &&
+                        some->last->key == entries[visited - 1] &&
+                        some->next->key == entries[visited]);
+                    start = inclusive ? *some->next : *some->last;
+                }
+                BEAST_EXPECT(keys == expected);
+            }
+        }
+    }
+
+    void
+    testUpdate()
+    {
+        testcase("update");
+
+        using namespace jtx;
+        Env env{*this};
+        Account const gw{"gw"};
+        Account const alice{"alice"};
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(100000), gw, alice);
+        std::vector<Account> holders;
+        for (int i = 0; i < 60; ++i)
+        {
+            holders.emplace_back("holder" + std::to_string(i));
+            env.fund(XRP(10000), holders.back());
+        }
+        env.close();
+        for (auto const& holder : holders)
+            env.trust(USD(1000), holder);
+        env.trust(USD(1000), alice);
+        std::vector<std::uint32_t> offers;
+        for (int i = 0; i < 10; ++i)
+        {
+            offers.push_back(env.seq(gw));
+            env(offer(gw, XRP(100 + i), USD(10)));
+        }
+        env.close();
+
+        OwnerIndex index(env.app(), 40, env.journal);
+        auto step = [&] {
+            env.close();
+            index.update(
+                std::make_shared<AcceptedLedger>(env.closed(), env.app()));
+            expectOwner(index, *env.closed(), gw);
+        };
+        step();
+
+        // Only the large directory is indexed.
+        BEAST_EXPECT(index.size() == 1);
+        BEAST_EXPECT(!index.find(
+            *env.closed(), alice, {ltRIPPLE_STATE}, {}, true, all));
+
+        // Lines and offers come and go, emptying pages and adding them.
+        for (int i = 0; i < 20; ++i)
+            env(trust(holders[i], USD(0)));
+        for (int i = 0; i < 5; ++i)
+            env(offer_cancel(gw, offers[i]));
+        step();
+        for (int i = 0; i < 10; ++i)
+            env.trust(USD(1000), holders[i]);
+        env(offer(gw, XRP(500), USD(10)));
+        step();
+
+        // Created and removed in the same ledger.
+        env(offer(gw, XRP(600), USD(10)));
+        env(offer_cancel(gw, env.seq(gw) - 1));
+        env(trust(holders[30], USD(0)));
+        env.trust(USD(1000), holders[30]);
+        step();
+
+        // A marker that isn't one of the entries isn't answered, and one
+        // of another type is.
+        auto const found =
+            index.find(*env.closed(), gw, {ltOFFER}, {}, true, all);
+        if (BEAST_EXPECT(found && !found->found.empty()))
+        {
+            auto const offer = found->found.front();
+            BEAST_EXPECT(index.find(
+                *env.closed(), gw, {ltRIPPLE_STATE}, offer, false, 10));
+            BEAST_EXPECT(!index.find(
+                *env.closed(),
+                gw,
+                {ltRIPPLE_STATE},
+                {offer.page, keylet::account(gw).key},
+                false,
+                10));
+        }
+
+        // Only the last published ledger is answered for.
+        auto const previous = env.closed();
+        step();
+        BEAST_EXPECT(
+            !index.find(*previous, gw, {ltRIPPLE_STATE}, {}, true, all));
+        BEAST_EXPECT(
+            !index.find(*env.current(), gw, {ltRIPPLE_STATE}, {}, true, all));
+
+        // A ledger that doesn't follow builds the index again.
+        for (int i = 20; i < 30; ++i)
+            env(trust(holders[i], USD(0)));
+        env.close();
+        env.close();
+        index.update(
+            std::make_shared<AcceptedLedger>(env.closed(), env.app()));
+        expectOwner(index, *env.closed(), gw);
+    }
+
+    void
+    testHandlers()
+    {
+        testcase("handlers");
+
+        using namespace jtx;
+        Env env{*this, envconfig([](std::unique_ptr<Config> cfg) {
+                    cfg->OWNER_INDEX_MIN_ENTRIES = 40;
+                    return cfg;
+                })};
+        Account const gw{"gw"};
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+
+        env.fund(XRP(100000), gw);
+        std::vector<Account> holders;
+        for (int i = 0; i < 45; ++i)
+        {
+            holders.emplace_back("holder" + std::to_string(i));
+            env.fund(XRP(10000), holders.back());
+        }
+        env.close();
+        for (auto const& holder : holders)
+        {
+            env.trust(USD(1000), holder);
+            env(offer(gw, XRP(100), EUR(10)));
+        }
+        env.close();
+        for (int i = 0; i < 10; ++i)
+            env(pay(gw, holders[i], USD(10 + i)));
+        env.close();
+
+        // Wait for the last closed ledger to be published to the index.
+        auto indexed = [&] {
+            using namespace std::chrono_literals;
+            for (int i = 0; i < 500; ++i)
+            {
+                if (env.app().getOwnerIndex().find(
+                        *env.closed(), gw, {ltOFFER}, {}, true, 1))
+                    return true;
+                std::this_thread::sleep_for(10ms);
+            }
+            return false;
+        };
+        if (!BEAST_EXPECT(indexed()))
+            return;
+
+        // The pages of a paged request, from the index against the closed
+        // ledger, and from the directory against the open one. The two must
+        // be the same page for page: the limit counts every entry of the
+        // directory looked at, whatever its type, on both.
+        auto pages = [&](char const* command,
+                         Json::Value params,
+                         Json::StaticString field,
+                         Json::Value const& ledger) {
+            Json::Value replies(Json::arrayValue);
+            params[jss::account] = gw.human();
+            params[jss::ledger_index] = ledger;
+            params[jss::limit] = 10;
+            for (int n = 0; n < 100; ++n)
+            {
+                auto const result =
+                    env.rpc("json", command, to_string(params))[jss::result];
+                Json::Value& page = replies.append(Json::objectValue);
+                page[field] = result[field];
+                if (!result.isMember(jss::marker))
+                    break;
+                BEAST_EXPECT(result[field].size() <= 10);
+                page[jss::marker] = params[jss::marker] = result[jss::marker];
+            }
+            return replies;
+        };
+        // Everything a paged request returns.
+        auto request = [&](char const* command,
+                           Json::Value params,
+                           Json::StaticString field,
+                           Json::Value const& ledger) {
+            Json::Value items(Json::arrayValue);
+            for (auto const& page : pages(command, params, field, ledger))
+                for (auto const& item : page[field])
+                    items.append(item);
+            return items;
+        };
+        Json::Value const closed = env.closed()->seq();
+
+        Json::Value params(Json::objectValue);
+        for (auto const& [command, field] :
+             {std::pair{"account_lines", jss::lines},
+              std::pair{"account_offers", jss::offers}})
+        {
+            auto const kept = request(command, params, field, closed);
+            BEAST_EXPECT(kept.size() == 45);
+            BEAST_EXPECT(
+                pages(command, params, field, closed) ==
+                pages(command, params, field, "current"));
+        }
+
+        for (auto const type : {jss::state, jss::offer})
+        {
+            params[jss::type] = type;
+            auto const kept = request(
+                "account_objects", params, jss::account_objects, closed);
+            BEAST_EXPECT(kept.size() == 45);
+            BEAST_EXPECT(
+                pages(
+                    "account_objects",
+                    params,
+                    jss::account_objects,
+                    closed) ==
+                pages(
+                    "account_objects",
+                    params,
+                    jss::account_objects,
+                    "current"));
+        }
+
+        auto balances = [&](Json::Value const& ledger) {
+            Json::Value params;
+            params[jss::account] = gw.human();
+            params[jss::ledger_index] = ledger;
+            return env.rpc(
+                "json", "gateway_balances", to_string(params))[jss::result];
+        };
+        auto const kept = balances(closed);
+        BEAST_EXPECT(kept[jss::obligations]["USD"] == "145");
+        BEAST_EXPECT(
+            kept[jss::obligations] == balances("current")[jss::obligations]);
+    }
+
+public:
+    void
+    run() override
+    {
+        testUpdate();
+        testHandlers();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(OwnerIndex, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
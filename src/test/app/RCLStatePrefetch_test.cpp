@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/consensus/RCLStatePrefetch.h>
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/protocol/jss.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class RCLStatePrefetch_test : public beast::unit_test::suite
+{
+    // A transaction set holding some transactions.
+    static std::shared_ptr<SHAMap const>
+    makeSet(jtx::Env& env, std::vector<jtx::JTx> const& txs)
+    {
+        auto set = std::make_shared<SHAMap>(
+            SHAMapType::TRANSACTION, env.app().getNodeFamily());
+        for (auto const& jt : txs)
+        {
+            Serializer s;
+            jt.stx->add(s);
+            set->addItem(
+                SHAMapNodeType::tnTRANSACTION_NM,
+                make_shamapitem(jt.stx->getTransactionID(), s.slice()));
+        }
+        return set->snapShot(false);
+    }
+
+    void
+    testRounds()
+    {
+        testcase("rounds");
+
+        using namespace jtx;
+        Env env{*this};
+        Account const gw{"gw"};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(10000), gw, alice, bob);
+        env.trust(USD(1000), alice, bob);
+        env(pay(gw, alice, USD(100)));
+        env(pay(gw, bob, USD(100)));
+        env(offer(bob, XRP(10), USD(10)));
+        env.close();
+
+        auto& ledgerMaster = env.app().getLedgerMaster();
+        auto& jobQueue = env.app().getJobQueue();
+        RCLStatePrefetch prefetch(env.app(), env.journal);
+        BEAST_EXPECT(prefetch.getJson().size() == 0);
+
+        // Everything a payment modifies was prefetched.
+        auto const prev = ledgerMaster.getClosedLedger();
+        auto const payment = env.jt(pay(alice, bob, USD(10)));
+        prefetch.startRound(prev);
+        prefetch.prefetch(makeSet(env, {payment}));
+        prefetch.prefetch(makeSet(env, {payment}));
+        jobQueue.rendezvous();
+        env(payment);
+        env.close();
+
+        auto const built = ledgerMaster.getClosedLedger();
+        BEAST_EXPECT(built->info().parentHash == prev->info().hash);
+        prefetch.finishRound(*built);
+        {
+            auto const jv = prefetch.getJson();
+            BEAST_EXPECT(jv[jss::ledger_index] == built->info().seq);
+            BEAST_EXPECT(jv[jss::transactions] == 1);
+            BEAST_EXPECT(jv[jss::touched].asUInt() > 0);
+            BEAST_EXPECT(jv[jss::hits] == jv[jss::touched]);
+            BEAST_EXPECT(jv[jss::hit_rate] == 1.0);
+            BEAST_EXPECT(jv[jss::prefetched].asUInt() >= 3);
+        }
+
+        // An offer that crosses: the front of the book it crosses is
+        // prefetched, but not the directory of the offer's owner.
+        auto const cross = env.jt(offer(alice, USD(10), XRP(10)));
+        prefetch.startRound(built);
+        prefetch.prefetch(makeSet(env, {cross}));
+        jobQueue.rendezvous();
+        env(cross);
+        env.close();
+
+        auto const crossed = ledgerMaster.getClosedLedger();
+        BEAST_EXPECT(
+            !crossed->exists(keylet::offer(bob.id(), env.seq(bob) - 1)));
+        prefetch.finishRound(*crossed);
+        {
+            auto const jv = prefetch.getJson();
+            BEAST_EXPECT(jv[jss::ledger_index] == crossed->info().seq);
+            BEAST_EXPECT(jv[jss::transactions] == 1);
+            BEAST_EXPECT(jv[jss::hits].asUInt() >= 5);
+            BEAST_EXPECT(jv[jss::hits].asUInt() < jv[jss::touched].asUInt());
+        }
+
+        // A round that was superseded before its ledger was built isn't
+        // reported.
+        prefetch.startRound(crossed);
+        prefetch.prefetch(makeSet(env, {env.jt(pay(bob, alice, USD(1)))}));
+        prefetch.startRound(prev);
+        jobQueue.rendezvous();
+        env(pay(bob, alice, USD(1)));
+        env.close();
+        prefetch.finishRound(*ledgerMaster.getClosedLedger());
+        BEAST_EXPECT(
+            prefetch.getJson()[jss::ledger_index] == crossed->info().seq);
+    }
+
+public:
+    void
+    run() override
+    {
+        testRounds();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(RCLStatePrefetch, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/StateExport.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <test/jtx.h>
+#include <test/shamap/common.h>
+#include <test/unit_test/SuiteJournal.h>
+#include <cstring>
+
+namespace ripple {
+
+class StateExport_test : public beast::unit_test::suite
+{
+    beast::xor_shift_engine rng_{11};
+
+    // The records of the entries after a key, one at a time.
+    static std::string
+    expected(SHAMap const& map, uint256 const& after)
+    {
+        std::string records;
+        for (auto i = map.upper_bound(after); i != map.end(); ++i)
+            StateExport::append(records, i->key(), i->slice());
+        return records;
+    }
+
+    static std::string
+    exported(JobQueue& jobQueue, SHAMap const& map, uint256 const& after)
+    {
+        std::string records;
+        StateExport state(jobQueue, map, after);
+        for (auto block = state.next(); !block.empty(); block = state.next())
+            records += block;
+        return records;
+    }
+
+    void
+    testRecord()
+    {
+        testcase("record");
+
+        std::string block;
+        StateExport::append(block, uint256(5), makeSlice(std::string("abc")));
+        BEAST_EXPECT(block.size() == 32 + 4 + 3);
+        BEAST_EXPECT(block[31] == 5);
+        BEAST_EXPECT(block.substr(32, 4) == std::string("\0\0\0\3", 4));
+        BEAST_EXPECT(block.substr(36) == "abc");
+    }
+
+    void
+    testExport(beast::Journal journal)
+    {
+        testcase("export");
+
+        test::jtx::Env env{*this};
+        auto& jobQueue = env.app().getJobQueue();
+        tests::TestNodeFamily f(journal);
+        SHAMap map(SHAMapType::STATE, f);
+
+        // Nothing to export.
+        BEAST_EXPECT(exported(jobQueue, map, uint256{}).empty());
+
+        // Entries of all sizes, with enough of them to fill several blocks
+        // in each subtree, and some keys at the edges of subtrees.
+        std::vector<uint256> keys;
+        for (int i = 0; i < 20000; ++i)
+        {
+            uint256 key;
+            for (auto& b : key)
+                b = rng_() & 0xFF;
+            if (i % 1000 == 0)
+                std::memset(key.data() + 1, i % 2000 ? 0xFF : 0, 31);
+            std::string const data(rng_() % 300 + 12, static_cast<char>(i));
+            if (map.addItem(
+                    SHAMapNodeType::tnACCOUNT_STATE,
+                    make_shamapitem(key, makeSlice(data))))
+                keys.push_back(key);
+        }
+
+        // All of it, in key order, and then resumed from keys that are in
+        // the map and keys that aren't.
+        BEAST_EXPECT(
+            exported(jobQueue, map, uint256{}) == expected(map, uint256{}));
+        std::size_t mismatches = 0;
+        for (int i = 0; i < 20; ++i)
+        {
+            auto after = keys[rng_() % keys.size()];
+            if (i % 2)
+                ++after;
+            if (exported(jobQueue, map, after) != expected(map, after))
+                ++mismatches;
+        }
+        BEAST_EXPECT(mismatches == 0);
+        BEAST_EXPECT(exported(jobQueue, map, ~uint256{}).empty());
+
+        // Counting what's taken, and stopping part way.
+        {
+            StateExport state(jobQueue, map, uint256{});
+            BEAST_EXPECT(!state.next().empty());
+            BEAST_EXPECT(state.entries() > 0);
+            BEAST_EXPECT(state.entries() < keys.size());
+        }
+        {
+            StateExport state(jobQueue, map, uint256{});
+            while (!state.next().empty())
+                ;
+            BEAST_EXPECT(state.entries() == keys.size());
+        }
+
+        // More exports at once than there are jobs to read them.
+        {
+            std::vector<std::unique_ptr<StateExport>> states;
+            std::vector<std::string> records(8);
+            for (std::size_t i = 0; i < records.size(); ++i)
+                states.push_back(
+                    std::make_unique<StateExport>(jobQueue, map, uint256{}));
+            for (bool more = true; more;)
+            {
+                more = false;
+                for (std::size_t i = 0; i < records.size(); ++i)
+                {
+                    auto const block = states[i]->next();
+                    records[i] += block;
+                    more = more || !block.empty();
+                }
+            }
+            auto const all = expected(map, uint256{});
+            for (auto const& r : records)
+                BEAST_EXPECT(r == all);
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        test::SuiteJournal journal("StateExport_test", *this);
+
+        testRecord();
+        testExport(journal);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(StateExport, app, ripple);
+
+}  // namespace ripple
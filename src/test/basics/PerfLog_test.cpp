@@ -987,6 +987,29 @@ public:
         }
     }
 
+    void
+    testApply()
+    {
+        // Verify the counters of applied transactions.
+        Fixture fixture{env_.app(), j_};
+        auto perfLog{fixture.perfLog(WithFile::no)};
+        perfLog->start();
+
+        // Nothing is reported until a transaction is applied.
+        BEAST_EXPECT(!perfLog->countersJson().isMember(jss::apply));
+
+        perfLog->txApply(3);
+        perfLog->txApply(0);
+        perfLog->txApply(12);
+
+        Json::Value const apply{perfLog->countersJson()[jss::apply]};
+        BEAST_EXPECT(jsonToUint64(apply[jss::applied]) == 3);
+        BEAST_EXPECT(jsonToUint64(apply[jss::spills]) == 15);
+        BEAST_EXPECT(jsonToUint64(apply[jss::max_spills]) == 12);
+
+        perfLog->stop();
+    }
+
     void
     testRotate(WithFile withFile)
     {
@@ -1053,6 +1076,7 @@ public:
         testJobs(WithFile::yes);
         testInvalidID(WithFile::no);
         testInvalidID(WithFile::yes);
+        testApply();
         testRotate(WithFile::no);
         testRotate(WithFile::yes);
     }
@@ -23,6 +23,7 @@
 #include <ripple/beast/unit_test.h>
 #include <boost/endian/conversion.hpp>
 #include <complex>
+#include <random>
 
 #include <type_traits>
 
@@ -128,9 +129,43 @@ struct base_uint_test : beast::unit_test::suite
         }
     }
 
+    // Comparisons must order values like their bytes do, whatever size
+    // of word they're compared in.
+    template <class T>
+    void
+    testComparison()
+    {
+        std::mt19937 rng(T::bytes);
+        std::size_t wrong = 0;
+        for (int i = 0; i < 10000; ++i)
+        {
+            T a, b;
+            for (auto& x : a)
+                x = rng() & 0xFF;
+            b = a;
+            // Differ in one byte, if any, so every position is exercised.
+            if (auto const pos = rng() % (T::bytes + 1); pos < T::bytes)
+                b.data()[pos] = rng() & 0xFF;
+
+            auto const expected = std::memcmp(a.data(), b.data(), T::bytes);
+            auto const c = a <=> b;
+            if ((expected < 0) != (c < 0) || (expected == 0) != (c == 0) ||
+                (expected == 0) != (a == b) || (a < b) != (b > a))
+                ++wrong;
+            if (a.signum() != (a != beast::zero))
+                ++wrong;
+        }
+        BEAST_EXPECT(wrong == 0);
+    }
+
     void
     run() override
     {
+        testcase("base_uint: comparison");
+        testComparison<test96>();
+        testComparison<uint160>();
+        testComparison<uint256>();
+
         testcase("base_uint: general purpose tests");
 
         static_assert(
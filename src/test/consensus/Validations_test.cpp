@@ -753,6 +753,19 @@ class Validations_test : public beast::unit_test::suite
         harness.clock().advance(harness.parms().validationSET_EXPIRES);
         harness.vals().expire(j);
         BEAST_EXPECT(harness.vals().numTrustedForLedger(ledgerC.id()) == 0);
+
+        // Reading a ledger's validations keeps them from expiring
+        Ledger const ledgerD = h["abcd"];
+        BEAST_EXPECT(ValStatus::current == harness.add(a.validate(ledgerD)));
+        harness.clock().advance(harness.parms().validationSET_EXPIRES / 2);
+        BEAST_EXPECT(harness.vals().numTrustedForLedger(ledgerD.id()) == 1);
+        harness.vals().expire(j);
+        harness.clock().advance(harness.parms().validationSET_EXPIRES / 2);
+        harness.vals().expire(j);
+        BEAST_EXPECT(harness.vals().numTrustedForLedger(ledgerD.id()) == 1);
+        harness.clock().advance(harness.parms().validationSET_EXPIRES);
+        harness.vals().expire(j);
+        BEAST_EXPECT(harness.vals().numTrustedForLedger(ledgerD.id()) == 0);
     }
 
     void
@@ -1125,6 +1138,104 @@ class Validations_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testSnapshot()
+    {
+        // The queries answered from the published snapshot see each update
+        testcase("Snapshot");
+        using namespace std::chrono;
+        SuiteJournal j("Validations_test", *this);
+        LedgerHistoryHelper h;
+        TestHarness harness(h.oracle);
+        auto& vals = harness.vals();
+        Node a = harness.makeNode();
+        Node b = harness.makeNode();
+        Node c = harness.makeNode();
+        c.untrust();
+        Ledger const ledgerAB = h["ab"];
+        Ledger const ledgerABC = h["abc"];
+
+        auto preferred = [&]() -> std::optional<Ledger::ID> {
+            if (auto const p = vals.getPreferred(genesisLedger))
+                return p->second;
+            return std::nullopt;
+        };
+
+        BEAST_EXPECT(vals.numTrustedForLedger(ledgerAB.id()) == 0);
+        BEAST_EXPECT(preferred() == std::nullopt);
+
+        Validation const v = a.validate(ledgerAB);
+        BEAST_EXPECT(ValStatus::current == harness.add(v));
+        BEAST_EXPECT(vals.numTrustedForLedger(ledgerAB.id()) == 1);
+        BEAST_EXPECT(
+            vals.getTrustedForLedger(ledgerAB.id(), ledgerAB.seq()) ==
+            std::vector<Validation>{v});
+        BEAST_EXPECT(preferred() == ledgerAB.id());
+
+        b.setLoadFee(12);
+        BEAST_EXPECT(ValStatus::current == harness.add(b.validate(ledgerAB)));
+        BEAST_EXPECT(vals.numTrustedForLedger(ledgerAB.id()) == 2);
+        auto fees = vals.fees(ledgerAB.id(), 10);
+        std::sort(fees.begin(), fees.end());
+        BEAST_EXPECT(fees == std::vector<std::uint32_t>({10, 12}));
+
+        // Untrusted, and then trusted
+        BEAST_EXPECT(
+            ValStatus::current == harness.add(c.validate(ledgerABC)));
+        BEAST_EXPECT(vals.numTrustedForLedger(ledgerABC.id()) == 0);
+        vals.trustChanged({c.nodeID()}, {});
+        BEAST_EXPECT(vals.numTrustedForLedger(ledgerABC.id()) == 1);
+
+        // A newer validation moves the preferred branch
+        harness.clock().advance(1s);
+        BEAST_EXPECT(
+            ValStatus::current == harness.add(a.validate(ledgerABC)));
+        BEAST_EXPECT(vals.numTrustedForLedger(ledgerABC.id()) == 2);
+        BEAST_EXPECT(preferred() == ledgerABC.id());
+
+        // And losing trust moves it back
+        vals.trustChanged({}, {a.nodeID()});
+        BEAST_EXPECT(vals.numTrustedForLedger(ledgerABC.id()) == 1);
+        BEAST_EXPECT(vals.numTrustedForLedger(ledgerAB.id()) == 1);
+        BEAST_EXPECT(preferred() == ledgerAB.id());
+
+        // Validations going stale as time passes
+        harness.clock().advance(harness.parms().validationCURRENT_EARLY + 1s);
+        BEAST_EXPECT(preferred() == std::nullopt);
+
+        harness.clock().advance(harness.parms().validationSET_EXPIRES);
+        vals.expire(j);
+        BEAST_EXPECT(vals.numTrustedForLedger(ledgerAB.id()) == 0);
+        BEAST_EXPECT(vals.numTrustedForLedger(ledgerABC.id()) == 0);
+
+        // Each snapshot shares the validations of the ledgers that didn't
+        // change since an earlier one, and sees those of the ledgers that
+        // did.
+        {
+            TestHarness fresh(h.oracle);
+            Node d = fresh.makeNode();
+            Node e = fresh.makeNode();
+            std::string const chain = "abcdefghijklmnopqrstuvwxyz";
+            for (std::size_t i = 4; i <= chain.size(); ++i)
+            {
+                fresh.clock().advance(1s);
+                Ledger const ledger = h[chain.substr(0, i)];
+                BEAST_EXPECT(
+                    ValStatus::current == fresh.add(d.validate(ledger)));
+                BEAST_EXPECT(
+                    fresh.vals().numTrustedForLedger(ledger.id()) == 1);
+                BEAST_EXPECT(
+                    ValStatus::current == fresh.add(e.validate(ledger)));
+                for (std::size_t k = 4; k <= i; ++k)
+                {
+                    auto const& prior = h[chain.substr(0, k)];
+                    BEAST_EXPECT(
+                        fresh.vals().numTrustedForLedger(prior.id()) == 2);
+                }
+            }
+        }
+    }
+
     void
     run() override
     {
@@ -1142,6 +1253,7 @@ class Validations_test : public beast::unit_test::suite
         testNumTrustedForLedger();
         testSeqEnforcer();
         testTrustChanged();
+        testSnapshot();
     }
 };
 
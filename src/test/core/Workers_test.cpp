@@ -74,6 +74,11 @@ class PerfLogTest : public PerfLog
     {
     }
 
+    void
+    txApply(std::uint64_t spills) override
+    {
+    }
+
     Json::Value
     countersJson() const override
     {
@@ -0,0 +1,318 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/json/json_reader.h>
+#include <ripple/json/json_writer.h>
+#include <ripple/json/to_string.h>
+#include <boost/asio/buffer.hpp>
+#include <vector>
+
+namespace ripple {
+
+class ReadStrict_test : public beast::unit_test::suite
+{
+    beast::xor_shift_engine rng_{19};
+
+    std::size_t
+    pick(std::size_t n)
+    {
+        return rng_() % n;
+    }
+
+    // Random text that is mostly JSON, in all the forms that Reader reads
+    // and some that it doesn't.
+    void
+    addSpaces(std::string& s)
+    {
+        static char const spaces[] = {' ', '\n', '\r', '\t'};
+        while (pick(4) == 0)
+            s += spaces[pick(4)];
+    }
+
+    void
+    addString(std::string& s)
+    {
+        static char const* const pieces[] = {
+            "a",       "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh",
+            "0123456789abcdefABCDEF",
+            "\\\"",    "\\\\",
+            "\\/",     "\\b",
+            "\\f",     "\\n",
+            "\\r",     "\\t",
+            "\\u0041", "\\u00e9",
+            "\\u20AC", "\\ud83d\\ude00",
+            "\\uDC00", "\\ud800x",
+            "\\u12",   "\\x",
+            "\xC3\xA9", "\x01",
+            "\t",      " "};
+        s += '"';
+        auto const count = pick(6);
+        for (std::size_t i = 0; i < count; ++i)
+            s += pieces[pick(std::size(pieces))];
+        s += '"';
+    }
+
+    void
+    addNumber(std::string& s)
+    {
+        static char const* const numbers[] = {
+            "0",           "-0",          "7",           "-12",
+            "2147483647",  "2147483648",  "-2147483648", "-2147483649",
+            "4294967295",  "4294967296",  "99999999999", "1.5",
+            "-0.25",       "1e5",         "1E+2",        "2.5e-3",
+            "1e999",       "01",          "1.",          ".5",
+            "1.5.3",       "-",           "1e",          "12345678901234.5",
+            "3.14159265358979323846"};
+        s += numbers[pick(std::size(numbers))];
+    }
+
+    void
+    addValue(std::string& s, unsigned depth)
+    {
+        addSpaces(s);
+        auto const kind = depth > 6 ? 3 + pick(4) : pick(7);
+        switch (kind)
+        {
+            case 0:
+            case 1: {
+                s += '{';
+                auto const count = pick(5);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (i != 0)
+                        s += ',';
+                    addSpaces(s);
+                    addString(s);
+                    addSpaces(s);
+                    s += ':';
+                    addValue(s, depth + 1);
+                }
+                addSpaces(s);
+                s += '}';
+                break;
+            }
+            case 2: {
+                s += '[';
+                auto const count = pick(5);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (i != 0)
+                        s += ',';
+                    addValue(s, depth + 1);
+                }
+                addSpaces(s);
+                s += ']';
+                break;
+            }
+            case 3:
+                addString(s);
+                break;
+            case 4:
+                addNumber(s);
+                break;
+            default: {
+                static char const* const words[] = {"true", "false", "null"};
+                s += words[pick(3)];
+                break;
+            }
+        }
+        addSpaces(s);
+    }
+
+    // Damage the text the ways that clients do.
+    void
+    mutate(std::string& s)
+    {
+        static char const chars[] = "{}[]\",:/*\\0-e. \x00xtn";
+        switch (pick(4))
+        {
+            case 0:
+                s.resize(pick(s.size() + 1));
+                break;
+            case 1:
+                s.insert(s.begin() + pick(s.size() + 1), chars[pick(20)]);
+                break;
+            case 2:
+                if (!s.empty())
+                    s.erase(s.begin() + pick(s.size()));
+                break;
+            default:
+                if (!s.empty())
+                    s[pick(s.size())] = chars[pick(20)];
+                break;
+        }
+    }
+
+    // Whatever readStrict reads, Reader reads the same way. Returns
+    // whether readStrict read it.
+    bool
+    agrees(std::string const& text, bool& ok)
+    {
+        Json::Value strict(Json::arrayValue);
+        strict.append("unchanged");
+        auto const before = strict;
+        if (!Json::readStrict(text, strict))
+        {
+            ok = ok && strict == before;
+            return false;
+        }
+
+        Json::Value lenient;
+        ok = ok && Json::Reader().parse(text, lenient) && strict == lenient &&
+            to_string(strict) == to_string(lenient) &&
+            strict.type() == lenient.type();
+        return true;
+    }
+
+    void
+    testDifferential()
+    {
+        testcase("differential");
+
+        bool ok = true;
+        std::size_t read = 0;
+        std::size_t mutatedRead = 0;
+        for (int i = 0; i < 20000; ++i)
+        {
+            std::string text;
+            addSpaces(text);
+            text += pick(2) ? "{\"id\":" : "[";
+            addValue(text, 1);
+            text += text[text.find_first_not_of(" \n\r\t")] == '{' ? '}' : ']';
+            addSpaces(text);
+
+            read += agrees(text, ok);
+            for (int j = 0; j < 3; ++j)
+            {
+                mutate(text);
+                mutatedRead += agrees(text, ok);
+            }
+        }
+        BEAST_EXPECT(ok);
+
+        // Enough of the documents were strict for the comparison to mean
+        // something.
+        BEAST_EXPECT(read > 2000);
+        BEAST_EXPECT(mutatedRead > 500);
+    }
+
+    void
+    testWritten()
+    {
+        testcase("written");
+
+        // What the writers write is strict.
+        Json::Value jv(Json::objectValue);
+        jv["command"] = "submit";
+        jv["id"] = 7;
+        jv["big"] = Json::Value::maxUInt;
+        jv["negative"] = Json::Value::minInt;
+        jv["double"] = 0.125;
+        jv["flags"] = Json::arrayValue;
+        jv["flags"].append(true);
+        jv["flags"].append(false);
+        jv["flags"].append(Json::Value());
+        jv["text"] = "quote \" backslash \\ tab \t control \x01 \xC3\xA9";
+        jv["nested"]["deeper"]["deepest"] = Json::objectValue;
+
+        for (auto const& text :
+             {to_string(jv),
+              Json::FastWriter().write(jv),
+              Json::StyledWriter().write(jv)})
+        {
+            Json::Value read;
+            BEAST_EXPECT(Json::readStrict(text, read));
+            BEAST_EXPECT(read == jv);
+        }
+
+        // From buffers, whole or in pieces.
+        auto const text = to_string(jv);
+        Json::Value read;
+        BEAST_EXPECT(Json::readStrict(read, boost::asio::buffer(text)));
+        BEAST_EXPECT(read == jv);
+
+        std::vector<boost::asio::const_buffer> pieces;
+        for (std::size_t i = 0; i < text.size(); i += 5)
+            pieces.emplace_back(
+                text.data() + i, std::min<std::size_t>(5, text.size() - i));
+        read.clear();
+        BEAST_EXPECT(Json::readStrict(read, pieces));
+        BEAST_EXPECT(read == jv);
+    }
+
+    void
+    testDeclined()
+    {
+        testcase("declined");
+
+        auto declines = [](std::string const& text) {
+            Json::Value jv;
+            return !Json::readStrict(text, jv) && jv.isNull();
+        };
+
+        // What Reader accepts, but only it should.
+        BEAST_EXPECT(declines("{\"a\":1 // comment\n}"));
+        BEAST_EXPECT(declines("/* comment */ {}"));
+        BEAST_EXPECT(declines("{} trailing"));
+        BEAST_EXPECT(declines("[01]"));
+        BEAST_EXPECT(declines("[1.5.3]"));
+        BEAST_EXPECT(declines("null"));
+        BEAST_EXPECT(declines("{\"\":1,}"));
+
+        // What Reader rejects, with its errors.
+        BEAST_EXPECT(declines(""));
+        BEAST_EXPECT(declines("7"));
+        BEAST_EXPECT(declines("\"text\""));
+        BEAST_EXPECT(declines("{\"a\":1,\"a\":2}"));
+        BEAST_EXPECT(declines("[4294967296]"));
+        BEAST_EXPECT(declines("[-2147483649]"));
+        BEAST_EXPECT(declines("[\"\\x\"]"));
+        BEAST_EXPECT(declines("[\"\\ud800\"]"));
+        BEAST_EXPECT(declines("[1,]"));
+        BEAST_EXPECT(declines("{\"a\"}"));
+        BEAST_EXPECT(declines("[\"open"));
+
+        // Values up to the nesting limit are read, and no deeper.
+        auto nested = [](unsigned depth) {
+            return std::string(depth, '[') + "1" + std::string(depth, ']');
+        };
+        Json::Value jv;
+        BEAST_EXPECT(Json::readStrict(nested(Json::Reader::nest_limit), jv));
+        BEAST_EXPECT(
+            Json::Reader().parse(nested(Json::Reader::nest_limit), jv));
+        BEAST_EXPECT(declines(nested(Json::Reader::nest_limit + 1)));
+        BEAST_EXPECT(
+            !Json::Reader().parse(nested(Json::Reader::nest_limit + 1), jv));
+    }
+
+public:
+    void
+    run() override
+    {
+        testDifferential();
+        testWritten();
+        testDeclined();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ReadStrict, json, ripple);
+
+}  // namespace ripple
@@ -25,6 +25,8 @@
 #include <ripple/json/json_writer.h>
 
 #include <algorithm>
+#include <map>
+#include <random>
 #include <regex>
 
 namespace ripple {
@@ -1372,6 +1374,106 @@ struct json_value_test : beast::unit_test::suite
         }
     }
 
+    void
+    test_members()
+    {
+        auto const name = [](int i) {
+            return std::string(i < 10 ? "k0" : "k") + std::to_string(i);
+        };
+
+        {
+            // Members don't move as more are added, past the first few.
+            Json::Value v;
+            auto& first = v[name(20)];
+            first = 20;
+            for (int i = 19; i >= 0; --i)
+                v[name(i)] = i;
+            BEAST_EXPECT(&v[name(20)] == &first);
+            BEAST_EXPECT(first == 20);
+            BEAST_EXPECT(v.size() == 21);
+
+            // Nor as others are erased.
+            for (int i = 0; i < 20; i += 2)
+                v.removeMember(name(i));
+            BEAST_EXPECT(&v[name(20)] == &first);
+            BEAST_EXPECT(v.size() == 11);
+
+            // The place of an erased member is used for the next one.
+            auto const place = &v[name(1)];
+            v.removeMember(name(1));
+            BEAST_EXPECT(&v["x"] == place);
+        }
+
+        {
+            // Add and erase members in random order, and check the
+            // object against a map, both ways round.
+            std::mt19937 gen(1);
+            std::uniform_int_distribution<int> dist(0, 99);
+            Json::Value v{Json::objectValue};
+            std::map<std::string, int> expected;
+            auto const same = [&] {
+                if (v.size() != expected.size())
+                    return false;
+                auto it = v.begin();
+                for (auto const& [key, value] : expected)
+                {
+                    if (it.key().asString() != key || *it != value)
+                        return false;
+                    ++it;
+                }
+                if (it != v.end())
+                    return false;
+                for (auto e = expected.rbegin(); e != expected.rend(); ++e)
+                {
+                    --it;
+                    if (it.key().asString() != e->first || *it != e->second)
+                        return false;
+                }
+                return it == v.begin();
+            };
+
+            for (int step = 0; step < 2000; ++step)
+            {
+                auto const i = dist(gen);
+                // Grow to most of the keys, then erase more than is added.
+                if (dist(gen) < (step < 1000 ? 25 : 60))
+                {
+                    v.removeMember(name(i));
+                    expected.erase(name(i));
+                }
+                else
+                {
+                    v[name(i)] = step;
+                    expected[name(i)] = step;
+                }
+                if (step % 50 == 0 && !BEAST_EXPECT(same()))
+                    break;
+                BEAST_EXPECT(v.isMember(name(i)) == expected.count(name(i)));
+            }
+            BEAST_EXPECT(same());
+
+            // Copy and compare after erasing.
+            Json::Value copy = v;
+            BEAST_EXPECT(copy == v);
+            BEAST_EXPECT(!(copy < v) && !(v < copy));
+            auto const key = v.begin().key().asString();
+            auto const value = v[key];
+            copy.removeMember(key);
+            BEAST_EXPECT(copy != v);
+            BEAST_EXPECT(copy.size() + 1 == v.size());
+            copy[key] = value;
+            BEAST_EXPECT(copy == v);
+
+            // Erase the rest.
+            for (auto const& [k, _] : expected)
+                v.removeMember(k);
+            BEAST_EXPECT(v.size() == 0);
+            BEAST_EXPECT(v.begin() == v.end());
+            v["a"] = 1;
+            BEAST_EXPECT(v.size() == 1 && v["a"] == 1);
+        }
+    }
+
     void
     run() override
     {
@@ -1391,6 +1493,7 @@ struct json_value_test : beast::unit_test::suite
         test_iterator();
         test_nest_limits();
         test_leak();
+        test_members();
     }
 };
 
@@ -21,7 +21,10 @@
 #define RIPPLE_TEST_HTTPCLIENT_H_INCLUDED
 
 #include <ripple/core/Config.h>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/string_body.hpp>
 #include <memory>
+#include <vector>
 #include <test/jtx/AbstractClient.h>
 
 namespace ripple {
@@ -31,6 +34,20 @@ namespace test {
 std::unique_ptr<AbstractClient>
 makeJSONRPCClient(Config const& cfg, unsigned rpc_version = 2);
 
+/** Sends a request over HTTP and returns the reply as it was received.
+
+    Unlike a client's invoke(), the reply isn't parsed, so replies that
+    aren't JSON, or whose exact bytes matter, can be checked.
+*/
+boost::beast::http::response<boost::beast::http::string_body>
+sendJSONRPC(Config const& cfg, Json::Value const& request);
+
+/** Sends requests one after another over one connection, and returns the
+    replies as they were received.
+*/
+std::vector<boost::beast::http::response<boost::beast::http::string_body>>
+sendJSONRPC(Config const& cfg, std::vector<Json::Value> const& requests);
+
 }  // namespace test
 }  // namespace ripple
 
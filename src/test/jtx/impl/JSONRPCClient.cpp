@@ -21,7 +21,7 @@
 #include <ripple/protocol/jss.h>
 #include <ripple/server/Port.h>
 #include <boost/asio.hpp>
-#include <boost/beast/http/dynamic_body.hpp>
+#include <boost/beast/core/multi_buffer.hpp>
 #include <boost/beast/http/message.hpp>
 #include <boost/beast/http/read.hpp>
 #include <boost/beast/http/string_body.hpp>
@@ -58,17 +58,6 @@ class JSONRPCClient : public AbstractClient
         return {};  // Silence compiler control paths return value warning
     }
 
-    template <class ConstBufferSequence>
-    static std::string
-    buffer_string(ConstBufferSequence const& b)
-    {
-        using namespace boost::asio;
-        std::string s;
-        s.resize(buffer_size(b));
-        buffer_copy(buffer(&s[0], s.size()), b);
-        return s;
-    }
-
     boost::asio::ip::tcp::endpoint ep_;
     boost::asio::io_service ios_;
     boost::asio::ip::tcp::socket stream_;
@@ -89,18 +78,11 @@ public:
         // stream_.close();
     }
 
-    /*
-        Return value is an Object type with up to three keys:
-            status
-            error
-            result
-    */
-    Json::Value
-    invoke(std::string const& cmd, Json::Value const& params) override
+    // Send a request, and return the reply as it was received.
+    boost::beast::http::response<boost::beast::http::string_body>
+    send(std::string body)
     {
         using namespace boost::beast::http;
-        using namespace boost::asio;
-        using namespace std::string_literals;
 
         request<string_body> req;
         req.method(boost::beast::http::verb::post);
@@ -112,8 +94,26 @@ public:
             ostr << ep_;
             req.insert("Host", ostr.str());
         }
+        req.body() = std::move(body);
+        req.prepare_payload();
+        write(stream_, req);
+
+        response<string_body> res;
+        read(stream_, bin_, res);
+        return res;
+    }
+
+    /*
+        Return value is an Object type with up to three keys:
+            status
+            error
+            result
+    */
+    Json::Value
+    invoke(std::string const& cmd, Json::Value const& params) override
+    {
+        Json::Value jr;
         {
-            Json::Value jr;
             jr[jss::method] = cmd;
             if (rpc_version_ == 2)
             {
@@ -126,17 +126,11 @@ public:
                 Json::Value& ja = jr[jss::params] = Json::arrayValue;
                 ja.append(params);
             }
-            req.body() = to_string(jr);
         }
-        req.prepare_payload();
-        write(stream_, req);
-
-        response<dynamic_body> res;
-        read(stream_, bin_, res);
+        auto const res = send(to_string(jr));
 
-        Json::Reader jr;
         Json::Value jv;
-        jr.parse(buffer_string(res.body().data()), jv);
+        Json::Reader().parse(res.body(), jv);
         if (jv["result"].isMember("error"))
             jv["error"] = jv["result"]["error"];
         if (jv["result"].isMember("status"))
@@ -157,5 +151,22 @@ makeJSONRPCClient(Config const& cfg, unsigned rpc_version)
     return std::make_unique<JSONRPCClient>(cfg, rpc_version);
 }
 
+boost::beast::http::response<boost::beast::http::string_body>
+sendJSONRPC(Config const& cfg, Json::Value const& request)
+{
+    return JSONRPCClient(cfg, 1).send(to_string(request));
+}
+
+std::vector<boost::beast::http::response<boost::beast::http::string_body>>
+sendJSONRPC(Config const& cfg, std::vector<Json::Value> const& requests)
+{
+    JSONRPCClient client(cfg, 1);
+    std::vector<boost::beast::http::response<boost::beast::http::string_body>>
+        replies;
+    for (auto const& request : requests)
+        replies.push_back(client.send(to_string(request)));
+    return replies;
+}
+
 }  // namespace test
 }  // namespace ripple
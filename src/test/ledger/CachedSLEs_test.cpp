@@ -0,0 +1,234 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/ledger/CachedSLEs.h>
+#include <ripple/ledger/CachedView.h>
+#include <ripple/protocol/digest.h>
+#include <test/jtx.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class CachedSLEs_test : public beast::unit_test::suite
+{
+    static std::shared_ptr<SLE const>
+    makeSLE(std::uint32_t i)
+    {
+        return std::make_shared<SLE const>(
+            keylet::account(AccountID(i)));
+    }
+
+    void
+    testFetch()
+    {
+        testcase("fetch");
+
+        using namespace std::chrono_literals;
+        TestStopwatch clock;
+        CachedSLEs cache(1min, clock);
+
+        BEAST_EXPECT(cache.size() == 0);
+        BEAST_EXPECT(cache.rate() == 0);
+
+        uint256 const digest = sha512Half(1);
+        auto const sle = makeSLE(1);
+
+        // A miss calls the handler and keeps what it returned.
+        int calls = 0;
+        auto const load = [&]() {
+            ++calls;
+            return sle;
+        };
+        BEAST_EXPECT(cache.fetch(digest, load) == sle);
+        BEAST_EXPECT(calls == 1);
+        BEAST_EXPECT(cache.size() == 1);
+
+        // A hit doesn't.
+        BEAST_EXPECT(cache.fetch(digest, load) == sle);
+        BEAST_EXPECT(calls == 1);
+        BEAST_EXPECT(cache.rate() == 0.5);
+
+        // Nothing is cached when the handler finds nothing.
+        BEAST_EXPECT(!cache.fetch(sha512Half(2), []() {
+            return std::shared_ptr<SLE const>{};
+        }));
+        BEAST_EXPECT(cache.size() == 1);
+    }
+
+    void
+    testSweep()
+    {
+        testcase("sweep");
+
+        using namespace std::chrono_literals;
+        TestStopwatch clock;
+        CachedSLEs cache(16s, clock);
+
+        uint256 const fresh = sha512Half(1);
+        uint256 const stale = sha512Half(2);
+        cache.fetch(fresh, []() { return makeSLE(1); });
+        cache.fetch(stale, []() { return makeSLE(2); });
+        BEAST_EXPECT(cache.size() == 2);
+
+        // Nothing has expired yet.
+        clock.advance(10s);
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 2);
+
+        // Fetching an entry keeps it.
+        int calls = 0;
+        cache.fetch(fresh, [&]() {
+            ++calls;
+            return makeSLE(1);
+        });
+        BEAST_EXPECT(calls == 0);
+
+        clock.advance(10s);
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 1);
+        cache.fetch(fresh, [&]() {
+            ++calls;
+            return makeSLE(1);
+        });
+        BEAST_EXPECT(calls == 0);
+
+        clock.advance(1min);
+        cache.sweep();
+        BEAST_EXPECT(cache.size() == 0);
+    }
+
+    void
+    testConcurrentFetch()
+    {
+        testcase("concurrent fetch");
+
+        using namespace std::chrono_literals;
+        TestStopwatch clock;
+        CachedSLEs cache(1min, clock);
+
+        std::size_t const count = 1000;
+        std::vector<uint256> digests;
+        for (std::uint32_t i = 0; i < count; ++i)
+            digests.push_back(sha512Half(i));
+
+        // Every thread loads its own copy of each entry, but they must all
+        // end up with the one that was cached first.
+        std::size_t const threadCount = 8;
+        std::vector<std::vector<std::shared_ptr<SLE const>>> results(
+            threadCount);
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]() {
+                auto& result = results[t];
+                result.resize(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    auto const n = (i + t * count / threadCount) % count;
+                    result[n] = cache.fetch(digests[n], [n]() {
+                        return makeSLE(static_cast<std::uint32_t>(n));
+                    });
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        BEAST_EXPECT(cache.size() == count);
+
+        bool same = true;
+        for (std::size_t t = 1; t < threadCount; ++t)
+            same = same && results[t] == results[0];
+        BEAST_EXPECT(same);
+    }
+
+    void
+    testCachedView()
+    {
+        testcase("CachedView");
+
+        using namespace jtx;
+        Env env(*this);
+
+        std::vector<Account> accounts;
+        for (int i = 0; i < 100; ++i)
+        {
+            accounts.emplace_back("a" + std::to_string(i));
+            env.fund(XRP(1000), accounts.back());
+        }
+        env.close();
+
+        auto const ledger = env.app().getLedgerMaster().getClosedLedger();
+        CachedView<Ledger> view(ledger, env.app().cachedSLEs());
+
+        // Read every account from several threads at once, and check that
+        // they all see what is in the ledger.
+        std::atomic<int> wrong = 0;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&]() {
+                for (int round = 0; round < 3; ++round)
+                {
+                    for (auto const& account : accounts)
+                    {
+                        auto const k = keylet::account(account);
+                        auto const sle = view.read(k);
+                        auto const expected = ledger->read(k);
+                        if (!sle || !expected ||
+                            sle->getSerializer().peekData() !=
+                                expected->getSerializer().peekData())
+                            ++wrong;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        BEAST_EXPECT(wrong == 0);
+
+        // Entries that don't exist, or have a different type, aren't found.
+        BEAST_EXPECT(!view.read(keylet::account(Account("missing"))));
+        BEAST_EXPECT(!view.read(keylet::offer(accounts[0], 1)));
+        BEAST_EXPECT(
+            !view.read(Keylet(ltOFFER, keylet::account(accounts[0]).key)));
+    }
+
+public:
+    void
+    run() override
+    {
+        testFetch();
+        testSweep();
+        testConcurrentFetch();
+        testCachedView();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(CachedSLEs, ledger, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,191 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/basics/random.h>
+#include <ripple/net/AccountSubscriptions.h>
+#include <map>
+#include <set>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+namespace {
+
+class Listener : public InfoSub
+{
+public:
+    explicit Listener(Source& source) : InfoSub(source)
+    {
+    }
+
+    void
+    send(Json::Value const&, bool) override
+    {
+    }
+};
+
+std::vector<AccountID>
+randomAccounts(std::size_t count)
+{
+    std::vector<AccountID> accounts(count);
+    for (auto& account : accounts)
+    {
+        for (auto& byte : account)
+            byte = rand_byte<std::uint8_t>();
+    }
+    return accounts;
+}
+
+}  // namespace
+
+class AccountSubscriptions_test : public beast::unit_test::suite
+{
+    static hash_set<InfoSub::pointer>
+    find(AccountSubscriptions const& index, AccountID const& account)
+    {
+        hash_set<InfoSub::pointer> notify;
+        index.find(account, notify);
+        return notify;
+    }
+
+    void
+    testCompact()
+    {
+        testcase("compact");
+
+        jtx::Env env(*this);
+        auto const few = std::make_shared<Listener>(env.app().getOPs());
+        auto const many = std::make_shared<Listener>(env.app().getOPs());
+        auto const accounts = randomAccounts(1000);
+        auto const others = randomAccounts(1000);
+
+        AccountSubscriptions index;
+        BEAST_EXPECT(index.empty());
+        BEAST_EXPECT(index.insert(few, {accounts[0], accounts[1]}) == 2);
+        BEAST_EXPECT(index.insert(few, {accounts[1]}) == 0);
+        BEAST_EXPECT(index.insert(many, accounts) == accounts.size());
+        BEAST_EXPECT(index.size() == accounts.size() + 2);
+        BEAST_EXPECT(index.compactSubscribers() == 1);
+
+        auto const both = hash_set<InfoSub::pointer>{few, many};
+        BEAST_EXPECT(find(index, accounts[0]) == both);
+        BEAST_EXPECT(find(index, accounts[2]).count(many) == 1);
+        BEAST_EXPECT(find(index, accounts[2]).count(few) == 0);
+        for (auto const& account : others)
+            BEAST_EXPECT(find(index, account).empty());
+
+        // Following few enough again, the accounts go back to the shared
+        // index.
+        std::vector<AccountID> const leaving(
+            accounts.begin() + 1, accounts.end() - 10);
+        BEAST_EXPECT(index.erase(many->getSeq(), leaving) == leaving.size());
+        BEAST_EXPECT(index.erase(many->getSeq(), leaving) == 0);
+        BEAST_EXPECT(index.compactSubscribers() == 0);
+        BEAST_EXPECT(find(index, accounts[0]) == both);
+        BEAST_EXPECT(find(index, accounts[1]).count(many) == 0);
+        BEAST_EXPECT(find(index, accounts.back()).count(many) == 1);
+
+        index.erase(many->getSeq());
+        index.erase(few->getSeq());
+        BEAST_EXPECT(index.empty());
+        BEAST_EXPECT(index.size() == 0);
+        BEAST_EXPECT(find(index, accounts[0]).empty());
+    }
+
+    void
+    testRandom()
+    {
+        testcase("random");
+
+        // Checked against a model of what each listener follows, through
+        // every size a listener's accounts are kept at.
+        jtx::Env env(*this);
+        std::vector<std::shared_ptr<Listener>> listeners;
+        for (int i = 0; i < 4; ++i)
+            listeners.push_back(
+                std::make_shared<Listener>(env.app().getOPs()));
+        auto const accounts = randomAccounts(2000);
+
+        AccountSubscriptions index;
+        std::map<std::uint64_t, std::set<AccountID>> model;
+        for (int round = 0; round < 200; ++round)
+        {
+            auto const& listener =
+                listeners[rand_int<std::size_t>(listeners.size() - 1)];
+            auto const seq = listener->getSeq();
+            std::vector<AccountID> batch;
+            auto const count = rand_int<std::size_t>(
+                rand_int(3) == 0 ? 800 : 20);
+            for (std::size_t i = 0; i < count; ++i)
+                batch.push_back(
+                    accounts[rand_int<std::size_t>(accounts.size() - 1)]);
+
+            auto& follows = model[seq];
+            std::size_t changed = 0;
+            if (rand_int(9) == 0)
+            {
+                index.erase(seq);
+                follows.clear();
+            }
+            else if (rand_int(1) == 0)
+            {
+                for (auto const& account : batch)
+                    changed += follows.insert(account).second;
+                BEAST_EXPECT(index.insert(listener, batch) == changed);
+            }
+            else
+            {
+                for (auto const& account : batch)
+                    changed += follows.erase(account);
+                BEAST_EXPECT(index.erase(seq, batch) == changed);
+            }
+
+            std::size_t size = 0;
+            for (auto const& [_, followed] : model)
+                size += followed.size();
+            BEAST_EXPECT(index.size() == size);
+
+            for (std::size_t i = 0; i < accounts.size(); i += 7)
+            {
+                hash_set<InfoSub::pointer> expected;
+                for (auto const& l : listeners)
+                {
+                    if (model[l->getSeq()].count(accounts[i]))
+                        expected.insert(l);
+                }
+                BEAST_EXPECT(find(index, accounts[i]) == expected);
+            }
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testCompact();
+        testRandom();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(AccountSubscriptions, net, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/json/json_writer.h>
+#include <ripple/net/InfoSub.h>
+#include <ripple/protocol/STAccount.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/server/WSSession.h>
+#include <boost/beast/core/multi_buffer.hpp>
+
+namespace ripple {
+
+namespace test {
+
+// Everything a session would write of a message, taken the way
+// BaseWSPeer takes it.
+inline std::string
+drain(WSMsg& msg, std::size_t chunk)
+{
+    std::string out;
+    for (;;)
+    {
+        auto const [done, buffers] = msg.prepare(chunk, [] {});
+        for (auto const& b : buffers)
+            out.append(static_cast<char const*>(b.data()), b.size());
+        if (done)
+            return out;
+    }
+}
+
+// What a websocket subscriber was sent before messages were shared.
+inline std::shared_ptr<WSMsg>
+streambufMsg(Json::Value const& jv)
+{
+    boost::beast::multi_buffer sb;
+    Json::stream(jv, [&](void const* data, std::size_t n) {
+        sb.commit(boost::asio::buffer_copy(
+            sb.prepare(n), boost::asio::buffer(data, n)));
+    });
+    return std::make_shared<StreambufWSMsg<decltype(sb)>>(std::move(sb));
+}
+
+// A transaction the way the transaction streams publish it.
+inline Json::Value
+transactionMessage(std::uint32_t seq)
+{
+    STTx const tx(ttPAYMENT, [seq](STObject& obj) {
+        obj.setAccountID(sfAccount, AccountID(seq));
+        obj.setAccountID(sfDestination, AccountID(seq + 1));
+        obj.setFieldAmount(sfAmount, STAmount(XRPAmount(1'000'000 + seq)));
+        obj.setFieldAmount(sfFee, STAmount(XRPAmount(12)));
+        obj.setFieldU32(sfSequence, seq);
+        obj.setFieldVL(sfSigningPubKey, Blob(33, 2));
+        obj.setFieldVL(sfTxnSignature, Blob(71, 3));
+    });
+
+    Json::Value jv(Json::objectValue);
+    jv[jss::type] = "transaction";
+    jv[jss::transaction] = tx.getJson(JsonOptions::none);
+    jv[jss::ledger_index] = 1000 + seq;
+    jv[jss::ledger_hash] = to_string(uint256(seq));
+    jv[jss::validated] = true;
+    jv[jss::status] = "closed";
+    jv[jss::engine_result] = "tesSUCCESS";
+    jv[jss::engine_result_code] = 0;
+    jv[jss::engine_result_message] =
+        "The transaction was applied. Only final in a validated ledger.";
+    return jv;
+}
+
+}  // namespace test
+
+class PublishedJson_test : public beast::unit_test::suite
+{
+    void
+    testText()
+    {
+        testcase("text");
+
+        auto const jv = test::transactionMessage(1);
+        PublishedJson const msg(jv);
+        BEAST_EXPECT(msg.json() == jv);
+
+        // Rendered once, the way it was streamed to each subscriber.
+        auto const& text = msg.text();
+        BEAST_EXPECT(text.get() == msg.text().get());
+        BEAST_EXPECT(*text == test::drain(*test::streambufMsg(jv), 65536));
+    }
+
+    void
+    testSharedMsg()
+    {
+        testcase("shared message");
+
+        auto const text = std::make_shared<std::string const>(
+            test::drain(*test::streambufMsg(test::transactionMessage(2)), 64));
+
+        // Every session writes all of the text, however it's chunked, and
+        // however many other sessions share it.
+        for (std::size_t const chunk : {1, 7, 64, 65536})
+        {
+            SharedWSMsg a(text);
+            SharedWSMsg b(text);
+            BEAST_EXPECT(test::drain(a, chunk) == *text);
+            BEAST_EXPECT(test::drain(b, chunk) == *text);
+        }
+
+        SharedWSMsg empty(std::make_shared<std::string const>());
+        auto const [done, buffers] = empty.prepare(100, [] {});
+        BEAST_EXPECT(done && buffers.empty());
+    }
+
+public:
+    void
+    run() override
+    {
+        testText();
+        testSharedMsg();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PublishedJson, net, ripple);
+
+}  // namespace ripple
@@ -0,0 +1,217 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/net/StreamPublisher.h>
+#include <ripple/net/SubscriberList.h>
+#include <condition_variable>
+#include <mutex>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class StreamPublisher_test : public beast::unit_test::suite
+{
+    // A subscriber that keeps what it's sent.
+    class Sink : public InfoSub
+    {
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::vector<int> received_;
+        bool held_ = false;
+
+    public:
+        explicit Sink(Source& source) : InfoSub(source)
+        {
+        }
+
+        void
+        send(Json::Value const& jv, bool) override
+        {
+            std::unique_lock lock(mutex_);
+            received_.push_back(jv[jss::seq].asInt());
+            cv_.notify_all();
+            cv_.wait_for(lock, std::chrono::seconds(10), [&] {
+                return !held_;
+            });
+        }
+
+        // Keep the next message from being sent until release().
+        void
+        hold()
+        {
+            std::lock_guard lock(mutex_);
+            held_ = true;
+        }
+
+        void
+        release()
+        {
+            std::lock_guard lock(mutex_);
+            held_ = false;
+            cv_.notify_all();
+        }
+
+        std::vector<int>
+        wait(std::size_t count)
+        {
+            std::unique_lock lock(mutex_);
+            cv_.wait_for(lock, std::chrono::seconds(10), [&] {
+                return received_.size() >= count;
+            });
+            return received_;
+        }
+    };
+
+    static std::shared_ptr<PublishedJson const>
+    message(int seq)
+    {
+        Json::Value jv(Json::objectValue);
+        jv[jss::seq] = seq;
+        return std::make_shared<PublishedJson const>(std::move(jv));
+    }
+
+    void
+    testSubscriberList()
+    {
+        testcase("subscriber list");
+
+        jtx::Env env(*this);
+        auto& source = env.app().getOPs();
+        auto const a = std::make_shared<Sink>(source);
+        auto const b = std::make_shared<Sink>(source);
+
+        SubscriberList list;
+        BEAST_EXPECT(list.empty());
+        BEAST_EXPECT(list.insert(b));
+        BEAST_EXPECT(list.insert(a));
+        BEAST_EXPECT(!list.insert(a));
+        BEAST_EXPECT(list.contains(a->getSeq()));
+        BEAST_EXPECT(list.contains(b->getSeq()));
+
+        // A snapshot stays as it was taken.
+        auto const before = list.snapshot();
+        BEAST_EXPECT(list.erase(a->getSeq()));
+        BEAST_EXPECT(!list.erase(a->getSeq()));
+        BEAST_EXPECT(!list.contains(a->getSeq()));
+        BEAST_EXPECT(before->size() == 2);
+        BEAST_EXPECT(list.snapshot()->size() == 1);
+        BEAST_EXPECT(
+            before->front().seq < before->back().seq &&
+            before->front().sub.lock() == a);
+    }
+
+    void
+    testPublish()
+    {
+        testcase("publish");
+
+        jtx::Env env(*this);
+        auto& source = env.app().getOPs();
+        auto const a = std::make_shared<Sink>(source);
+        auto const b = std::make_shared<Sink>(source);
+        auto gone = std::make_shared<Sink>(source);
+
+        SubscriberList both;
+        both.insert(a);
+        both.insert(b);
+        both.insert(gone);
+        SubscriberList one;
+        one.insert(a);
+
+        StreamPublisher publisher(env.app().getJobQueue(), env.journal);
+        auto const withGone = both.snapshot();
+        gone.reset();
+
+        // Whatever stream a message is published to, a subscriber is sent
+        // them in the order they were published.
+        std::vector<int> expectA;
+        std::vector<int> expectB;
+        for (int i = 0; i < 200; ++i)
+        {
+            if (i % 3 == 0)
+            {
+                publisher.publish(one.snapshot(), message(i), {});
+            }
+            else
+            {
+                publisher.publish(withGone, message(i), {});
+                expectB.push_back(i);
+            }
+            expectA.push_back(i);
+        }
+        BEAST_EXPECT(a->wait(expectA.size()) == expectA);
+        BEAST_EXPECT(b->wait(expectB.size()) == expectB);
+        env.app().getJobQueue().rendezvous();
+
+        // Nothing is queued for no one.
+        publisher.publish(SubscriberList().snapshot(), message(0), {});
+        BEAST_EXPECT(publisher.size() == 0);
+    }
+
+    void
+    testLimit()
+    {
+        testcase("limit");
+
+        jtx::Env env(*this);
+        auto& source = env.app().getOPs();
+        auto const a = std::make_shared<Sink>(source);
+        SubscriberList list;
+        list.insert(a);
+
+        StreamPublisher publisher(
+            env.app().getJobQueue(), env.journal, /*limit*/ 4);
+
+        // While the first message is being sent, the rest are queued, and
+        // the oldest of them are dropped to stay within the limit.
+        a->hold();
+        publisher.publish(list.snapshot(), message(0), {});
+        BEAST_EXPECT(a->wait(1) == std::vector<int>{0});
+        for (int i = 1; i <= 10; ++i)
+            publisher.publish(list.snapshot(), message(i), {});
+        BEAST_EXPECT(publisher.size() == 4);
+        BEAST_EXPECT(publisher.dropped() == 6);
+
+        a->release();
+        BEAST_EXPECT(a->wait(5) == (std::vector<int>{0, 7, 8, 9, 10}));
+        env.app().getJobQueue().rendezvous();
+        BEAST_EXPECT(publisher.size() == 0);
+
+        // The server reports what its own publisher dropped.
+        auto const info = env.rpc("server_info")[jss::result][jss::info];
+        BEAST_EXPECT(info[jss::published_dropped] == "0");
+    }
+
+public:
+    void
+    run() override
+    {
+        testSubscriberList();
+        testPublish();
+        testLimit();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(StreamPublisher, net, ripple);
+
+}  // namespace test
+}  // namespace ripple
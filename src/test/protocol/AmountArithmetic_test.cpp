@@ -0,0 +1,758 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/MathUtilities.h>
+#include <ripple/basics/Number.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/STAmount.h>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <optional>
+#include <random>
+
+namespace ripple {
+
+// The arithmetic as it was written before it counted digits to normalize
+// in one step and divided the 128-bit products once. The results of the
+// current arithmetic are checked against these, bit for bit.
+namespace reference {
+
+using uint128_t = boost::multiprecision::uint128_t;
+
+constexpr std::int64_t minMantissa = 1'000'000'000'000'000LL;
+constexpr std::int64_t maxMantissa = 9'999'999'999'999'999LL;
+constexpr int minExponent = -32768;
+constexpr int maxExponent = 32768;
+
+class Guard
+{
+    std::uint64_t digits_ = 0;
+    bool xbit_ = false;
+    bool sbit_ = false;
+
+public:
+    void
+    set_negative()
+    {
+        sbit_ = true;
+    }
+
+    void
+    push(unsigned d)
+    {
+        xbit_ = xbit_ || (digits_ & 0x0000'0000'0000'000F) != 0;
+        digits_ >>= 4;
+        digits_ |= (d & 0x0000'0000'0000'000FULL) << 60;
+    }
+
+    unsigned
+    pop()
+    {
+        unsigned d = (digits_ & 0xF000'0000'0000'0000) >> 60;
+        digits_ <<= 4;
+        return d;
+    }
+
+    int
+    round()
+    {
+        auto mode = Number::getround();
+        if (mode == Number::towards_zero)
+            return -1;
+        if (mode == Number::downward)
+        {
+            if (sbit_ && (digits_ > 0 || xbit_))
+                return 1;
+            return -1;
+        }
+        if (mode == Number::upward)
+        {
+            if (sbit_)
+                return -1;
+            if (digits_ > 0 || xbit_)
+                return 1;
+            return -1;
+        }
+        if (digits_ > 0x5000'0000'0000'0000)
+            return 1;
+        if (digits_ < 0x5000'0000'0000'0000)
+            return -1;
+        if (xbit_)
+            return 1;
+        return 0;
+    }
+};
+
+Number
+normalize(std::int64_t mantissa, int exponent)
+{
+    if (mantissa == 0)
+        return Number{};
+    bool const negative = (mantissa < 0);
+    auto m = static_cast<std::uint64_t>(mantissa);
+    if (negative)
+        m = -m;
+    while ((m < minMantissa) && (exponent > minExponent))
+    {
+        m *= 10;
+        --exponent;
+    }
+    Guard g;
+    if (negative)
+        g.set_negative();
+    while (m > maxMantissa)
+    {
+        if (exponent >= maxExponent)
+            throw std::overflow_error("Number::normalize 1");
+        g.push(m % 10);
+        m /= 10;
+        ++exponent;
+    }
+    std::int64_t r = m;
+    if ((exponent < minExponent) || (r < minMantissa))
+        return Number{};
+
+    auto const dir = g.round();
+    if (dir == 1 || (dir == 0 && (r & 1) == 1))
+    {
+        ++r;
+        if (r > maxMantissa)
+        {
+            r /= 10;
+            ++exponent;
+        }
+    }
+    if (exponent > maxExponent)
+        throw std::overflow_error("Number::normalize 2");
+    return Number{negative ? -r : r, exponent, Number::unchecked{}};
+}
+
+Number
+add(Number const& x, Number const& y)
+{
+    if (y == Number{})
+        return x;
+    if (x == Number{})
+        return y;
+    if (x == -y)
+        return Number{};
+    auto xm = x.mantissa();
+    auto xe = x.exponent();
+    int xn = 1;
+    if (xm < 0)
+    {
+        xm = -xm;
+        xn = -1;
+    }
+    auto ym = y.mantissa();
+    auto ye = y.exponent();
+    int yn = 1;
+    if (ym < 0)
+    {
+        ym = -ym;
+        yn = -1;
+    }
+    Guard g;
+    if (xe < ye)
+    {
+        if (xn == -1)
+            g.set_negative();
+        do
+        {
+            g.push(xm % 10);
+            xm /= 10;
+            ++xe;
+        } while (xe < ye);
+    }
+    else if (xe > ye)
+    {
+        if (yn == -1)
+            g.set_negative();
+        do
+        {
+            g.push(ym % 10);
+            ym /= 10;
+            ++ye;
+        } while (xe > ye);
+    }
+    if (xn == yn)
+    {
+        xm += ym;
+        if (xm > maxMantissa)
+        {
+            g.push(xm % 10);
+            xm /= 10;
+            ++xe;
+        }
+        auto r = g.round();
+        if (r == 1 || (r == 0 && (xm & 1) == 1))
+        {
+            ++xm;
+            if (xm > maxMantissa)
+            {
+                xm /= 10;
+                ++xe;
+            }
+        }
+        if (xe > maxExponent)
+            throw std::overflow_error("Number::addition overflow");
+    }
+    else
+    {
+        if (xm > ym)
+        {
+            xm = xm - ym;
+        }
+        else
+        {
+            xm = ym - xm;
+            xe = ye;
+            xn = yn;
+        }
+        while (xm < minMantissa)
+        {
+            xm *= 10;
+            xm -= g.pop();
+            --xe;
+        }
+        auto r = g.round();
+        if (r == 1 || (r == 0 && (xm & 1) == 1))
+        {
+            --xm;
+            if (xm < minMantissa)
+            {
+                xm *= 10;
+                --xe;
+            }
+        }
+        if (xe < minExponent)
+            return Number{};
+    }
+    return Number{xm * xn, xe, Number::unchecked{}};
+}
+
+Number
+multiply(Number const& x, Number const& y)
+{
+    if (x == Number{} || y == Number{})
+        return Number{};
+    auto xm = x.mantissa();
+    auto xe = x.exponent();
+    int xn = 1;
+    if (xm < 0)
+    {
+        xm = -xm;
+        xn = -1;
+    }
+    auto ym = y.mantissa();
+    auto ye = y.exponent();
+    int yn = 1;
+    if (ym < 0)
+    {
+        ym = -ym;
+        yn = -1;
+    }
+    uint128_t zm = uint128_t(xm) * uint128_t(ym);
+    auto ze = xe + ye;
+    auto zn = xn * yn;
+    Guard g;
+    if (zn == -1)
+        g.set_negative();
+    while (zm > maxMantissa)
+    {
+        g.push(static_cast<unsigned>(zm % 10));
+        zm /= 10;
+        ++ze;
+    }
+    xm = static_cast<std::int64_t>(zm);
+    xe = ze;
+    auto r = g.round();
+    if (r == 1 || (r == 0 && (xm & 1) == 1))
+    {
+        ++xm;
+        if (xm > maxMantissa)
+        {
+            xm /= 10;
+            ++xe;
+        }
+    }
+    if (xe < minExponent)
+        return Number{};
+    if (xe > maxExponent)
+        throw std::overflow_error("Number::multiplication overflow");
+    return Number{xm * zn, xe, Number::unchecked{}};
+}
+
+Number
+divide(Number const& x, Number const& y)
+{
+    if (y == Number{})
+        throw std::overflow_error("Number: divide by 0");
+    if (x == Number{})
+        return x;
+    int np = 1;
+    auto nm = x.mantissa();
+    if (nm < 0)
+    {
+        nm = -nm;
+        np = -1;
+    }
+    int dp = 1;
+    auto dm = y.mantissa();
+    if (dm < 0)
+    {
+        dm = -dm;
+        dp = -1;
+    }
+    uint128_t const f = 100'000'000'000'000'000;
+    auto const m = static_cast<std::int64_t>(
+        uint128_t(nm) * f / uint128_t(dm));
+    return normalize(m * np * dp, x.exponent() - y.exponent() - 17);
+}
+
+// STAmount::canonicalize for issued currencies, as it is without Number.
+std::pair<std::uint64_t, int>
+canonicalize(std::uint64_t value, int offset)
+{
+    if (value == 0)
+        return {0, -100};
+    while ((value < STAmount::cMinValue) && (offset > STAmount::cMinOffset))
+    {
+        value *= 10;
+        --offset;
+    }
+    while (value > STAmount::cMaxValue)
+    {
+        if (offset >= STAmount::cMaxOffset)
+            throw std::runtime_error("value overflow");
+        value /= 10;
+        ++offset;
+    }
+    if ((offset < STAmount::cMinOffset) || (value < STAmount::cMinValue))
+        return {0, -100};
+    if (offset > STAmount::cMaxOffset)
+        throw std::runtime_error("value overflow");
+    return {value, offset};
+}
+
+std::uint64_t
+muldiv(std::uint64_t a, std::uint64_t b, std::uint64_t c, std::uint64_t r = 0)
+{
+    uint128_t ret;
+    boost::multiprecision::multiply(ret, a, b);
+    ret += r;
+    ret /= c;
+    if (ret > std::numeric_limits<std::uint64_t>::max())
+        throw std::overflow_error("overflow");
+    return static_cast<std::uint64_t>(ret);
+}
+
+// The mantissas of native amounts, brought into the range of issued ones.
+std::pair<std::uint64_t, int>
+operand(STAmount const& v)
+{
+    std::uint64_t value = v.mantissa();
+    int offset = v.exponent();
+    if (v.native())
+    {
+        while (value < STAmount::cMinValue)
+        {
+            value *= 10;
+            --offset;
+        }
+    }
+    return {value, offset};
+}
+
+std::uint64_t const tenTo14 = 100'000'000'000'000ull;
+std::uint64_t const tenTo14m1 = tenTo14 - 1;
+std::uint64_t const tenTo17 = tenTo14 * 1000;
+
+STAmount
+multiply(STAmount const& v1, STAmount const& v2, Issue const& issue)
+{
+    if (v1 == beast::zero || v2 == beast::zero)
+        return STAmount(issue);
+    if ((v1.native() && v2.native() && isXRP(issue)) ||
+        getSTNumberSwitchover())
+        return ripple::multiply(v1, v2, issue);
+
+    auto const [value1, offset1] = operand(v1);
+    auto const [value2, offset2] = operand(v2);
+    return STAmount(
+        issue,
+        muldiv(value1, value2, tenTo14) + 7,
+        offset1 + offset2 + 14,
+        v1.negative() != v2.negative());
+}
+
+STAmount
+divide(STAmount const& num, STAmount const& den, Issue const& issue)
+{
+    if (den == beast::zero)
+        throw std::runtime_error("division by zero");
+    if (num == beast::zero)
+        return {issue};
+
+    auto const [numVal, numOffset] = operand(num);
+    auto const [denVal, denOffset] = operand(den);
+    return STAmount(
+        issue,
+        muldiv(numVal, tenTo17, denVal) + 5,
+        numOffset - denOffset - 17,
+        num.negative() != den.negative());
+}
+
+void
+canonicalizeRound(bool native, std::uint64_t& value, int& offset)
+{
+    if (native)
+    {
+        if (offset < 0)
+        {
+            int loops = 0;
+            while (offset < -1)
+            {
+                value /= 10;
+                ++offset;
+                ++loops;
+            }
+            value += (loops >= 2) ? 9 : 10;
+            value /= 10;
+            ++offset;
+        }
+    }
+    else if (value > STAmount::cMaxValue)
+    {
+        while (value > (10 * STAmount::cMaxValue))
+        {
+            value /= 10;
+            ++offset;
+        }
+        value += 9;
+        value /= 10;
+        ++offset;
+    }
+}
+
+STAmount
+mulRound(
+    STAmount const& v1,
+    STAmount const& v2,
+    Issue const& issue,
+    bool roundUp)
+{
+    if (v1 == beast::zero || v2 == beast::zero)
+        return {issue};
+    bool const xrp = isXRP(issue);
+    if (v1.native() && v2.native() && xrp)
+        return ripple::mulRound(v1, v2, issue, roundUp);
+
+    auto const [value1, offset1] = operand(v1);
+    auto const [value2, offset2] = operand(v2);
+    bool const resultNegative = v1.negative() != v2.negative();
+    std::uint64_t amount = muldiv(
+        value1, value2, tenTo14, (resultNegative != roundUp) ? tenTo14m1 : 0);
+    int offset = offset1 + offset2 + 14;
+    if (resultNegative != roundUp)
+        canonicalizeRound(xrp, amount, offset);
+    STAmount result(issue, amount, offset, resultNegative);
+    if (roundUp && !resultNegative && !result)
+    {
+        if (xrp)
+            return STAmount(issue, std::uint64_t{1}, 0, resultNegative);
+        return STAmount(
+            issue, STAmount::cMinValue, STAmount::cMinOffset, resultNegative);
+    }
+    return result;
+}
+
+STAmount
+divRound(
+    STAmount const& num,
+    STAmount const& den,
+    Issue const& issue,
+    bool roundUp)
+{
+    if (den == beast::zero)
+        throw std::runtime_error("division by zero");
+    if (num == beast::zero)
+        return {issue};
+
+    auto const [numVal, numOffset] = operand(num);
+    auto const [denVal, denOffset] = operand(den);
+    bool const resultNegative = (num.negative() != den.negative());
+    std::uint64_t amount = muldiv(
+        numVal, tenTo17, denVal, (resultNegative != roundUp) ? denVal - 1 : 0);
+    int offset = numOffset - denOffset - 17;
+    if (resultNegative != roundUp)
+        canonicalizeRound(isXRP(issue), amount, offset);
+    STAmount result(issue, amount, offset, resultNegative);
+    if (roundUp && !resultNegative && !result)
+    {
+        if (isXRP(issue))
+            return STAmount(issue, std::uint64_t{1}, 0, resultNegative);
+        return STAmount(
+            issue, STAmount::cMinValue, STAmount::cMinOffset, resultNegative);
+    }
+    return result;
+}
+
+}  // namespace reference
+
+//------------------------------------------------------------------------------
+
+class AmountArithmetic_test : public beast::unit_test::suite
+{
+    std::mt19937_64 gen_{default_prng()()};
+
+    template <class Int>
+    Int
+    pick(Int lo, Int hi)
+    {
+        return std::uniform_int_distribution<Int>(lo, hi)(gen_);
+    }
+
+    // A mantissa with the given number of digits, biased towards the
+    // values where rounding is decided: runs of nines and zeros, and
+    // halves.
+    std::uint64_t
+    mantissa(int digits)
+    {
+        auto const lo = digits == 1 ? 1 : powerOfTen(digits - 1);
+        auto const hi = powerOfTen(digits) - 1;
+        switch (pick(0, 7))
+        {
+            case 0:
+                return lo;
+            case 1:
+                return hi;
+            case 2:
+                return 5 * lo;
+            case 3:
+                return lo + pick<std::uint64_t>(0, 9);
+            case 4:
+                return hi - pick<std::uint64_t>(0, 9);
+            default:
+                return pick(lo, hi);
+        }
+    }
+
+    Number
+    number()
+    {
+        auto const e = pick(0, 9) == 0 ? pick(-32768, 32768) : pick(-40, 40);
+        auto const m = static_cast<std::int64_t>(mantissa(16));
+        return Number{pick(0, 1) ? -m : m, e, Number::unchecked{}};
+    }
+
+    STAmount
+    amount(Issue const& issue)
+    {
+        bool const negative = pick(0, 1);
+        if (isXRP(issue))
+            return STAmount(mantissa(pick(1, 17)), negative);
+        return STAmount(
+            issue,
+            mantissa(16),
+            pick(0, 9) == 0 ? pick(-96, 80) : pick(-20, 20),
+            negative);
+    }
+
+    static Number::rounding_mode
+    mode(int i)
+    {
+        return static_cast<Number::rounding_mode>(i);
+    }
+
+    template <class F>
+    static auto
+    attempt(F&& f) -> std::optional<decltype(f())>
+    {
+        try
+        {
+            return f();
+        }
+        catch (std::exception const&)
+        {
+            return std::nullopt;
+        }
+    }
+
+    static bool
+    same(std::optional<Number> const& x, std::optional<Number> const& y)
+    {
+        if (!x || !y)
+            return !x && !y;
+        return x->mantissa() == y->mantissa() &&
+            x->exponent() == y->exponent();
+    }
+
+    static bool
+    same(std::optional<STAmount> const& x, std::optional<STAmount> const& y)
+    {
+        if (!x || !y)
+            return !x && !y;
+        return x->mantissa() == y->mantissa() &&
+            x->exponent() == y->exponent() &&
+            x->negative() == y->negative() && x->native() == y->native();
+    }
+
+    void
+    testNumber()
+    {
+        testcase("Number");
+
+        int const iterations = 20000;
+        for (int m = 0; m < 4; ++m)
+        {
+            saveNumberRoundMode const save(Number::setround(mode(m)));
+
+            int normalized = 0;
+            int added = 0;
+            int multiplied = 0;
+            int divided = 0;
+            for (int i = 0; i < iterations; ++i)
+            {
+                // Normalizing every width of mantissa, at every exponent,
+                // including those that overflow and underflow.
+                auto const digits = pick(1, 19);
+                auto const raw = static_cast<std::int64_t>(
+                    std::min<std::uint64_t>(
+                        mantissa(digits),
+                        std::numeric_limits<std::int64_t>::max()));
+                auto const v = pick(0, 1) ? -raw : raw;
+                auto const e = pick(0, 3) == 0 ? pick(-32790, 32790)
+                                               : pick(-40, 40);
+                normalized += same(
+                    attempt([&] { return Number{v, e}; }),
+                    attempt([&] { return reference::normalize(v, e); }));
+
+                auto const x = number();
+                auto y = number();
+                if (pick(0, 3) == 0)
+                {
+                    // Operands of nearly the same size.
+                    y = Number{
+                        y.mantissa(),
+                        x.exponent() + pick(-20, 20),
+                        Number::unchecked{}};
+                }
+                if (y.exponent() < -32768 || y.exponent() > 32768)
+                    continue;
+
+                added += same(
+                    attempt([&] { return x + y; }),
+                    attempt([&] { return reference::add(x, y); }));
+                multiplied += same(
+                    attempt([&] { return x * y; }),
+                    attempt([&] { return reference::multiply(x, y); }));
+                divided += same(
+                    attempt([&] { return x / y; }),
+                    attempt([&] { return reference::divide(x, y); }));
+            }
+            BEAST_EXPECT(normalized == iterations);
+            BEAST_EXPECT(added == multiplied && added == divided);
+            BEAST_EXPECT(added > iterations * 9 / 10);
+            log << "mode " << m << ": " << added << " of each operation"
+                << std::endl;
+        }
+    }
+
+    void
+    testSTAmount()
+    {
+        testcase("STAmount");
+
+        Issue const usd{Currency(0x5553440000000000), AccountID(1)};
+        Issue const xrp = xrpIssue();
+
+        for (bool const switchover : {false, true})
+        {
+            NumberSO const numberSO(switchover);
+
+            int const iterations = 20000;
+            int checked = 0;
+            int matched = 0;
+            int legacy = 0;
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto const& issue1 = pick(0, 3) == 0 ? xrp : usd;
+                auto const& issue2 = pick(0, 3) == 0 ? xrp : usd;
+                auto const& out = pick(0, 3) == 0 ? xrp : usd;
+                auto const a = amount(issue1);
+                auto const b = amount(issue2);
+                bool const roundUp = pick(0, 1);
+
+                // Products of drops are computed separately, and weren't
+                // changed.
+                if (!a.native() || !b.native() || !isXRP(out))
+                {
+                    matched += same(
+                        attempt([&] { return multiply(a, b, out); }),
+                        attempt(
+                            [&] { return reference::multiply(a, b, out); }));
+                    matched += same(
+                        attempt([&] { return mulRound(a, b, out, roundUp); }),
+                        attempt([&] {
+                            return reference::mulRound(a, b, out, roundUp);
+                        }));
+                    checked += 2;
+                }
+                matched += same(
+                    attempt([&] { return divide(a, b, out); }),
+                    attempt([&] { return reference::divide(a, b, out); }));
+                matched += same(
+                    attempt([&] { return divRound(a, b, out, roundUp); }),
+                    attempt([&] {
+                        return reference::divRound(a, b, out, roundUp);
+                    }));
+                checked += 2;
+
+                if (!switchover)
+                {
+                    // Canonicalizing issued amounts without Number.
+                    auto const v = mantissa(pick(1, 19));
+                    auto const e = pick(-120, 100);
+                    auto const actual = attempt([&] {
+                        STAmount const s(usd, v, e);
+                        return std::make_pair(s.mantissa(), s.exponent());
+                    });
+                    auto const expected =
+                        attempt([&] { return reference::canonicalize(v, e); });
+                    legacy += (actual == expected);
+                }
+            }
+            BEAST_EXPECT(matched == checked);
+            BEAST_EXPECT(legacy == (switchover ? 0 : iterations));
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testNumber();
+        testSTAmount();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(AmountArithmetic, protocol, ripple);
+
+}  // namespace ripple
@@ -20,6 +20,7 @@
 #include <ripple/beast/unit_test.h>
 #include <ripple/protocol/PublicKey.h>
 #include <ripple/protocol/SecretKey.h>
+#include <algorithm>
 #include <vector>
 
 namespace ripple {
@@ -453,12 +454,102 @@ public:
         BEAST_EXPECT(pk1 == pk3);
     }
 
+    void
+    testVerifyBatch()
+    {
+        testcase("Batch verification");
+
+        // Enough Ed25519 signatures that some of them are checked in
+        // full batches and some are left over, mixed with secp256k1.
+        std::vector<std::pair<PublicKey, SecretKey>> keys;
+        std::vector<std::string> messages;
+        std::vector<Buffer> sigs;
+        for (int i = 0; i < 150; ++i)
+        {
+            auto const type =
+                (i % 5 == 0) ? KeyType::secp256k1 : KeyType::ed25519;
+            keys.push_back(randomKeyPair(type));
+            messages.push_back("message " + std::to_string(i));
+            sigs.push_back(sign(
+                keys.back().first,
+                keys.back().second,
+                makeSlice(messages.back())));
+        }
+
+        auto const makeBatch = [&]() {
+            std::vector<SignedMessage> batch;
+            for (std::size_t i = 0; i < keys.size(); ++i)
+                batch.push_back(
+                    {keys[i].first, makeSlice(messages[i]), sigs[i]});
+            return batch;
+        };
+
+        {
+            auto const batch = makeBatch();
+            auto const valid = verifyBatch(batch);
+            BEAST_EXPECT(valid.size() == batch.size());
+            BEAST_EXPECT(std::all_of(
+                valid.begin(), valid.end(), [](bool v) { return v; }));
+        }
+
+        {
+            BEAST_EXPECT(verifyBatch({}).empty());
+        }
+
+        {
+            // Corrupt a few signatures of each type and sign a message
+            // with the wrong key: only those must be reported invalid.
+            auto batch = makeBatch();
+            std::vector<Buffer> bad;
+            for (std::size_t i : {3, 10, 64, 65, 149})
+            {
+                bad.emplace_back(sigs[i].data(), sigs[i].size());
+                bad.back().data()[7] ^= 0x01;
+                batch[i].signature = bad.back();
+            }
+            batch[42].publicKey = keys[43].first;
+
+            auto const valid = verifyBatch(batch);
+            BEAST_EXPECT(valid.size() == batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                BEAST_EXPECT(
+                    valid[i] ==
+                    verify(
+                        batch[i].publicKey,
+                        batch[i].message,
+                        batch[i].signature,
+                        batch[i].mustBeFullyCanonical));
+                BEAST_EXPECT(
+                    valid[i] !=
+                    (i == 3 || i == 10 || i == 42 || i == 64 || i == 65 ||
+                     i == 149));
+            }
+        }
+
+        {
+            // A non-canonical Ed25519 signature is rejected without
+            // affecting the rest of the batch.
+            auto batch = makeBatch();
+            Buffer nonCanonical(sigs[1].data(), sigs[1].size());
+            std::memset(nonCanonical.data() + 32, 0xFF, 32);
+            batch[1].signature = nonCanonical;
+
+            auto const valid = verifyBatch(batch);
+            BEAST_EXPECT(!valid[1]);
+            BEAST_EXPECT(
+                std::count(valid.begin(), valid.end(), true) ==
+                static_cast<std::ptrdiff_t>(batch.size() - 1));
+        }
+    }
+
     void
     run() override
     {
         testBase58();
         testCanonical();
         testMiscOperations();
+        testVerifyBatch();
     }
 };
 
@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/SField.h>
+
+namespace ripple {
+
+class SField_test : public beast::unit_test::suite
+{
+    void
+    testLookupByCode()
+    {
+        testcase("lookup by code");
+
+        BEAST_EXPECT(SField::getField(sfAccount.fieldCode) == sfAccount);
+        BEAST_EXPECT(SField::getField(STI_AMOUNT, 1) == sfAmount);
+        BEAST_EXPECT(SField::getField(STI_UINT16, 1) == sfLedgerEntryType);
+
+        // The special fields.
+        BEAST_EXPECT(&SField::getField(-1) == &sfInvalid);
+        BEAST_EXPECT(&SField::getField(0) == &sfGeneric);
+
+        // Fields that can't be serialized, and fields whose type doesn't
+        // fit in a byte.
+        for (auto const name : {"hash", "index"})
+        {
+            auto const& f = SField::getField(name);
+            BEAST_EXPECT(f.isDiscardable());
+            BEAST_EXPECT(&SField::getField(f.fieldCode) == &f);
+        }
+        BEAST_EXPECT(
+            &SField::getField(sfLedgerEntry.fieldCode) == &sfLedgerEntry);
+        BEAST_EXPECT(
+            &SField::getField(sfTransaction.fieldCode) == &sfTransaction);
+
+        // Codes that don't name a field.
+        BEAST_EXPECT(SField::getField(STI_UINT32, 200).isInvalid());
+        BEAST_EXPECT(SField::getField(200, 1).isInvalid());
+        BEAST_EXPECT(SField::getField(STI_UINT32, 1000).isInvalid());
+        BEAST_EXPECT(SField::getField(-2).isInvalid());
+        BEAST_EXPECT(SField::getField(field_code(60000, 1)).isInvalid());
+
+        // Every field that can appear in serialized data is found, and
+        // is the one that was asked for.
+        int found = 0;
+        bool consistent = true;
+        for (int type = 1; type < 256; ++type)
+        {
+            for (int value = 1; value < 256; ++value)
+            {
+                auto const& f = SField::getField(type, value);
+                if (f.isInvalid())
+                    continue;
+                ++found;
+                consistent = consistent && f.fieldType == type &&
+                    f.fieldValue == value &&
+                    SField::getField(f.getName()) == f;
+            }
+        }
+        BEAST_EXPECT(consistent);
+        BEAST_EXPECT(found > 100 && found < SField::getNumFields());
+    }
+
+    void
+    testLookupByName()
+    {
+        testcase("lookup by name");
+
+        BEAST_EXPECT(SField::getField("Account") == sfAccount);
+        BEAST_EXPECT(SField::getField("hash").fieldValue == 257);
+        BEAST_EXPECT(SField::getField("LedgerEntry") == sfLedgerEntry);
+        BEAST_EXPECT(SField::getField("NoSuchField").isInvalid());
+    }
+
+public:
+    void
+    run() override
+    {
+        testLookupByCode();
+        testLookupByName();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SField, protocol, ripple);
+
+}  // namespace ripple
@@ -0,0 +1,467 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/rngfill.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/protocol/STArray.h>
+#include <ripple/protocol/STObject.h>
+#include <ripple/protocol/TxFormats.h>
+#include <ripple/protocol/digest.h>
+#include <algorithm>
+
+namespace ripple {
+
+namespace {
+
+// Builds objects of a given format with random contents.
+class ObjectGenerator
+{
+    beast::xor_shift_engine g_;
+
+    template <class Integral>
+    Integral
+    nonZero()
+    {
+        return static_cast<Integral>(rand_int(
+            g_,
+            std::uint64_t{1},
+            std::uint64_t{std::numeric_limits<Integral>::max()}));
+    }
+
+    template <class T>
+    T
+    randomUint()
+    {
+        T t;
+        beast::rngfill(t.data(), t.size(), g_);
+        // Keep it from being the default value.
+        *t.begin() |= 1;
+        return t;
+    }
+
+    Blob
+    randomBlob()
+    {
+        Blob b(rand_int(g_, 1, 40));
+        beast::rngfill(b.data(), b.size(), g_);
+        return b;
+    }
+
+    STAmount
+    randomAmount()
+    {
+        if (rand_int(g_, 1) == 0)
+            return STAmount(rand_int(
+                g_, std::uint64_t{1}, std::uint64_t{100'000'000'000}));
+        return STAmount(
+            Issue{randomUint<Currency>(), randomUint<AccountID>()},
+            rand_int(
+                g_, std::int64_t{1}, std::int64_t{9'999'999'999'999'999}),
+            rand_int(g_, -20, 20));
+    }
+
+    // Fills in the field, if it has a type this knows how to build.
+    void
+    setRandom(STObject& obj, SField const& f)
+    {
+        switch (f.fieldType)
+        {
+            case STI_UINT8:
+                obj.setFieldU8(f, nonZero<std::uint8_t>());
+                break;
+            case STI_UINT16:
+                obj.setFieldU16(f, nonZero<std::uint16_t>());
+                break;
+            case STI_UINT32:
+                obj.setFieldU32(f, nonZero<std::uint32_t>());
+                break;
+            case STI_UINT64:
+                obj.setFieldU64(f, nonZero<std::uint64_t>());
+                break;
+            case STI_UINT128:
+                obj.setFieldH128(f, randomUint<uint128>());
+                break;
+            case STI_UINT160:
+                obj.setFieldH160(f, randomUint<uint160>());
+                break;
+            case STI_UINT256:
+                obj.setFieldH256(f, randomUint<uint256>());
+                break;
+            case STI_AMOUNT:
+                obj.setFieldAmount(f, randomAmount());
+                break;
+            case STI_VL:
+                obj.setFieldVL(f, randomBlob());
+                break;
+            case STI_ACCOUNT:
+                obj.setAccountID(f, randomUint<AccountID>());
+                break;
+            case STI_VECTOR256: {
+                std::vector<uint256> v(rand_int(g_, 1, 4));
+                for (auto& h : v)
+                    h = randomUint<uint256>();
+                obj.setFieldV256(f, STVector256(f, v));
+                break;
+            }
+            case STI_ARRAY:
+                if (f == sfMemos)
+                {
+                    STArray memos(sfMemos);
+                    for (int i = rand_int(g_, 1, 3); i > 0; --i)
+                    {
+                        STObject memo(sfMemo);
+                        memo.setFieldVL(sfMemoData, randomBlob());
+                        memos.push_back(std::move(memo));
+                    }
+                    obj.setFieldArray(f, memos);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+public:
+    explicit ObjectGenerator(std::uint64_t seed) : g_(seed)
+    {
+    }
+
+    beast::xor_shift_engine&
+    engine()
+    {
+        return g_;
+    }
+
+    STObject
+    operator()(
+        SOTemplate const& type,
+        SField const& name,
+        SField const& typeField,
+        std::uint16_t typeValue)
+    {
+        STObject obj(type, name);
+        for (auto const& e : type)
+        {
+            if (e.sField() == typeField)
+                continue;
+            if (e.style() == soeREQUIRED || rand_int(g_, 1) == 0)
+                setRandom(obj, e.sField());
+        }
+        obj.setFieldU16(typeField, typeValue);
+        return obj;
+    }
+};
+
+// Serializes an object the way STObject always has: collect the fields
+// that are present and sort them by field code.
+Blob
+referenceSerialize(STObject const& obj, bool withSigningFields = true)
+{
+    std::vector<STBase const*> fields;
+    for (auto const& field : obj)
+    {
+        if (field.getSType() != STI_NOTPRESENT &&
+            field.getFName().shouldInclude(withSigningFields))
+            fields.push_back(&field);
+    }
+    std::sort(
+        fields.begin(), fields.end(), [](STBase const* a, STBase const* b) {
+            return a->getFName().fieldCode < b->getFName().fieldCode;
+        });
+
+    Serializer s;
+    for (auto const field : fields)
+    {
+        field->addFieldID(s);
+        field->add(s);
+        if (field->getSType() == STI_ARRAY || field->getSType() == STI_OBJECT)
+            s.addFieldID(field->getSType(), 1);
+    }
+    return s.peekData();
+}
+
+// Deserializes an object without a template, then checks it against the
+// template the way STObject::applyTemplate always has. Returns what the
+// templated object would serialize to, or nothing if it would be
+// rejected.
+std::optional<Blob>
+referenceDeserialize(SOTemplate const& type, Slice data)
+{
+    try
+    {
+        SerialIter sit(data);
+        STObject const raw(sit, sfGeneric);
+
+        // No field may appear twice.
+        std::vector<int> codes;
+        for (auto const& field : raw)
+            codes.push_back(field.getFName().fieldCode);
+        std::sort(codes.begin(), codes.end());
+        if (std::adjacent_find(codes.begin(), codes.end()) != codes.end())
+            return std::nullopt;
+
+        // Anything not in the template must be discardable, and is
+        // dropped.
+        STObject kept(sfGeneric);
+        for (auto const& field : raw)
+        {
+            if (type.getIndex(field.getFName()) != -1)
+                kept.emplace_back(field);
+            else if (!field.getFName().isDiscardable())
+                return std::nullopt;
+        }
+
+        for (auto const& e : type)
+        {
+            auto const field = raw.peekAtPField(e.sField());
+            if (!field && e.style() == soeREQUIRED)
+                return std::nullopt;
+            if (field && e.style() == soeDEFAULT && field->isDefault())
+                return std::nullopt;
+        }
+
+        return referenceSerialize(kept);
+    }
+    catch (std::exception const&)
+    {
+        return std::nullopt;
+    }
+}
+
+std::optional<Blob>
+deserialize(SOTemplate const& type, Slice data)
+{
+    try
+    {
+        SerialIter sit(data);
+        STObject const obj(type, sit, sfGeneric);
+        return obj.getSerializer().peekData();
+    }
+    catch (std::exception const&)
+    {
+        return std::nullopt;
+    }
+}
+
+struct Format
+{
+    std::string name;
+    SOTemplate const* type;
+    SField const* objectField;
+    SField const* typeField;
+    std::uint16_t typeValue;
+};
+
+std::vector<Format>
+allFormats()
+{
+    std::vector<Format> formats;
+    for (auto const& f : TxFormats::getInstance())
+        formats.push_back(
+            {f.getName(),
+             &f.getSOTemplate(),
+             &sfTransaction,
+             &sfTransactionType,
+             static_cast<std::uint16_t>(f.getType())});
+    for (auto const& f : LedgerFormats::getInstance())
+        formats.push_back(
+            {f.getName(),
+             &f.getSOTemplate(),
+             &sfLedgerEntry,
+             &sfLedgerEntryType,
+             static_cast<std::uint16_t>(f.getType())});
+    return formats;
+}
+
+}  // namespace
+
+class STObjectTemplate_test : public beast::unit_test::suite
+{
+    // Objects that have a template must serialize to the same bytes as
+    // the generic, sorting serializer produces.
+    void
+    testSerialize()
+    {
+        testcase("serialize");
+
+        ObjectGenerator gen(6071);
+        for (auto const& f : allFormats())
+        {
+            for (int i = 0; i < 50; ++i)
+            {
+                auto const obj =
+                    gen(*f.type, *f.objectField, *f.typeField, f.typeValue);
+
+                auto const data = obj.getSerializer().peekData();
+                BEAST_EXPECTS(data == referenceSerialize(obj), f.name);
+
+                BEAST_EXPECTS(
+                    obj.getSigningHash(HashPrefix::txSign) ==
+                        sha512Half(
+                            HashPrefix::txSign,
+                            makeSlice(referenceSerialize(obj, false))),
+                    f.name);
+
+                // And read back into the same object.
+                SerialIter sit(makeSlice(data));
+                STObject const copy(*f.type, sit, *f.objectField);
+                BEAST_EXPECTS(copy == obj, f.name);
+                BEAST_EXPECTS(copy.getSerializer().peekData() == data, f.name);
+            }
+        }
+    }
+
+    // Damaged objects must be accepted or rejected exactly as the generic
+    // deserializer and template check would.
+    void
+    testDeserializeFuzz()
+    {
+        testcase("deserialize fuzz");
+
+        ObjectGenerator gen(2381);
+        auto& g = gen.engine();
+        auto const pick = [&g](std::size_t low, std::size_t high) {
+            return std::uniform_int_distribution<std::size_t>(low, high)(g);
+        };
+
+        std::size_t accepted = 0;
+        std::size_t total = 0;
+        for (auto const& f : allFormats())
+        {
+            for (int i = 0; i < 50; ++i)
+            {
+                auto const data =
+                    gen(*f.type, *f.objectField, *f.typeField, f.typeValue)
+                        .getSerializer()
+                        .peekData();
+
+                auto mutated = data;
+                switch (rand_int(g, 3))
+                {
+                    case 0:
+                        // Change a byte.
+                        mutated[pick(0, mutated.size() - 1)] ^=
+                            static_cast<std::uint8_t>(rand_int(g, 1, 255));
+                        break;
+                    case 1:
+                        // Cut it short.
+                        mutated.resize(pick(0, mutated.size() - 1));
+                        break;
+                    case 2: {
+                        // Repeat a run of bytes, which may repeat fields.
+                        auto const start = pick(0, mutated.size() - 1);
+                        auto const size =
+                            pick(1, mutated.size() - start);
+                        Blob const run(
+                            mutated.begin() + start,
+                            mutated.begin() + start + size);
+                        mutated.insert(
+                            mutated.begin() + start, run.begin(), run.end());
+                        break;
+                    }
+                    default:
+                        // Move a field ahead of the ones before it.
+                        std::rotate(
+                            mutated.begin(),
+                            mutated.begin() + pick(0, mutated.size() - 1),
+                            mutated.end());
+                        break;
+                }
+
+                for (auto const& d : {data, mutated})
+                {
+                    auto const expected =
+                        referenceDeserialize(*f.type, makeSlice(d));
+                    auto const actual = deserialize(*f.type, makeSlice(d));
+                    BEAST_EXPECTS(actual == expected, f.name);
+                    ++total;
+                    if (actual)
+                        ++accepted;
+                }
+            }
+        }
+
+        // Every unmodified object, and some of the others, are accepted.
+        BEAST_EXPECT(accepted > total / 2 && accepted < total);
+    }
+
+    void
+    testTemplateErrors()
+    {
+        testcase("template errors");
+
+        auto const& type =
+            LedgerFormats::getInstance().findByType(ltOFFER)->getSOTemplate();
+
+        ObjectGenerator gen(11);
+        auto obj = gen(type, sfLedgerEntry, sfLedgerEntryType, ltOFFER);
+
+        auto const expectError = [&](STObject const& o, std::string what) {
+            try
+            {
+                STObject copy(o);
+                copy.applyTemplate(type);
+                fail("expected " + what);
+            }
+            catch (STObject::FieldErr const& e)
+            {
+                BEAST_EXPECTS(e.what() == what, e.what());
+            }
+        };
+
+        // The first problem in template order is the one reported.
+        {
+            STObject o(sfGeneric);
+            for (auto const& field : obj)
+            {
+                if (field.getFName() != sfAccount &&
+                    field.getFName() != sfSequence)
+                    o.emplace_back(field);
+            }
+            expectError(o, "Field 'Account' is required but missing.");
+        }
+
+        // Fields that aren't in the template are only allowed if they're
+        // discardable.
+        {
+            STObject o(sfGeneric);
+            for (auto const& field : obj)
+                o.emplace_back(field);
+            o.emplace_back(STUInt32(sfTransferRate, 5));
+            expectError(
+                o, "Field 'TransferRate' found in disallowed location.");
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testSerialize();
+        testDeserializeFuzz();
+        testTemplateErrors();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(STObjectTemplate, protocol, ripple);
+
+}  // namespace ripple
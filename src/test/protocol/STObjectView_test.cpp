@@ -0,0 +1,333 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/STArray.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/STObjectView.h>
+
+namespace ripple {
+
+namespace {
+
+std::shared_ptr<Serializer>
+serialize(STObject const& obj)
+{
+    auto s = std::make_shared<Serializer>();
+    obj.add(*s);
+    return s;
+}
+
+// The number of fields that were serialized.
+std::size_t
+fieldCount(std::shared_ptr<Serializer> const& s)
+{
+    return STObject(SerialIter{s->slice()}, sfGeneric).getCount();
+}
+
+STObjectView
+makeView(std::shared_ptr<Serializer> const& s)
+{
+    return STObjectView(s->slice(), s);
+}
+
+AccountID const alice{1};
+AccountID const bob{2};
+
+SLE
+makeAccountRoot()
+{
+    SLE sle(keylet::account(alice));
+    sle[sfAccount] = alice;
+    sle[sfBalance] = STAmount{123456789};
+    sle[sfSequence] = 42;
+    sle[sfOwnerCount] = 3;
+    sle[sfFlags] = lsfRequireDestTag;
+    sle.setFieldVL(sfDomain, Slice("example.com", 11));
+    return sle;
+}
+
+SLE
+makeRippleState()
+{
+    Issue const usd{Currency{7}, bob};
+    SLE sle(keylet::line(alice, usd));
+    sle[sfBalance] = STAmount{Issue{usd.currency, noAccount()}, 5, -1};
+    sle[sfLowLimit] = STAmount{Issue{usd.currency, alice}, 100};
+    sle[sfHighLimit] = STAmount{Issue{usd.currency, bob}, 0};
+    sle[sfFlags] = lsfLowReserve;
+    return sle;
+}
+
+SLE
+makeSignerList()
+{
+    SLE sle(keylet::signers(alice));
+    sle[sfSignerQuorum] = 2;
+    sle[sfSignerListID] = 0;
+
+    STArray entries(sfSignerEntries);
+    for (std::uint16_t i = 0; i < 3; ++i)
+    {
+        entries.push_back(STObject(sfSignerEntry));
+        auto& entry = entries.back();
+        entry[sfAccount] = AccountID{i + 10u};
+        entry[sfSignerWeight] = i + 1;
+    }
+    sle.setFieldArray(sfSignerEntries, entries);
+    return sle;
+}
+
+SLE
+makeDirectory()
+{
+    SLE sle(keylet::ownerDir(alice));
+    STVector256 indexes;
+    for (std::uint64_t i = 1; i <= 5; ++i)
+        indexes.push_back(uint256{i});
+    sle.setFieldV256(sfIndexes, indexes);
+    sle[sfRootIndex] = sle.key();
+    sle[sfOwner] = alice;
+    return sle;
+}
+
+}  // namespace
+
+class STObjectView_test : public beast::unit_test::suite
+{
+    void
+    testFields()
+    {
+        testcase("fields");
+
+        auto const sle = makeAccountRoot();
+        auto const s = serialize(sle);
+        auto const view = makeView(s);
+
+        BEAST_EXPECT(view.slice() == s->slice());
+        BEAST_EXPECT(view.size() == fieldCount(s));
+
+        BEAST_EXPECT(view[sfLedgerEntryType] == ltACCOUNT_ROOT);
+        BEAST_EXPECT(view[sfAccount] == alice);
+        BEAST_EXPECT(view[sfBalance] == sle[sfBalance]);
+        BEAST_EXPECT(view[sfSequence] == 42);
+        BEAST_EXPECT(view[sfOwnerCount] == 3);
+        BEAST_EXPECT(view[sfFlags] == lsfRequireDestTag);
+
+        BEAST_EXPECT(view.isFieldPresent(sfDomain));
+        BEAST_EXPECT(!view.isFieldPresent(sfEmailHash));
+        BEAST_EXPECT(!view[~sfEmailHash]);
+        BEAST_EXPECT(view[~sfSequence] == 42);
+
+        // Blobs are returned in place.
+        auto const domain = view[sfDomain];
+        BEAST_EXPECT(domain == Slice("example.com", 11));
+        BEAST_EXPECT(
+            domain.data() > s->slice().data() &&
+            domain.data() + domain.size() <=
+                s->slice().data() + s->slice().size());
+
+        // The serialized value of a field, without its field ID.
+        auto const seq = view.peekField(sfSequence);
+        BEAST_EXPECT(seq && seq->size() == 4 && (*seq)[3] == 42);
+        BEAST_EXPECT(!view.peekField(sfEmailHash));
+    }
+
+    void
+    testAmounts()
+    {
+        testcase("amounts");
+
+        auto const sle = makeRippleState();
+        auto const s = serialize(sle);
+        auto const view = makeView(s);
+
+        BEAST_EXPECT(view.size() == fieldCount(s));
+        BEAST_EXPECT(view[sfBalance] == sle[sfBalance]);
+        BEAST_EXPECT(view[sfLowLimit] == sle[sfLowLimit]);
+        BEAST_EXPECT(view[sfHighLimit] == sle[sfHighLimit]);
+        BEAST_EXPECT(view[sfLowLimit].getIssuer() == alice);
+        BEAST_EXPECT(view[sfFlags] == lsfLowReserve);
+    }
+
+    void
+    testNested()
+    {
+        testcase("arrays and vectors");
+
+        {
+            // The fields after the array are found.
+            auto const sle = makeSignerList();
+            auto const s = serialize(sle);
+            auto const view = makeView(s);
+
+            BEAST_EXPECT(view.size() == fieldCount(s));
+            BEAST_EXPECT(view[sfSignerQuorum] == 2);
+            BEAST_EXPECT(view[sfSignerListID] == 0);
+            BEAST_EXPECT(view.isFieldPresent(sfSignerEntries));
+            BEAST_EXPECT(view[sfOwnerNode] == 0);
+
+            auto const obj = view.toObject(sfLedgerEntry);
+            BEAST_EXPECT(obj.getFieldArray(sfSignerEntries).size() == 3);
+            BEAST_EXPECT(obj == sle);
+        }
+
+        {
+            auto const sle = makeDirectory();
+            auto const s = serialize(sle);
+            auto const view = makeView(s);
+
+            BEAST_EXPECT(view.size() == fieldCount(s));
+            BEAST_EXPECT(
+                view[sfIndexes] == sle.getFieldV256(sfIndexes).value());
+            BEAST_EXPECT(view[sfRootIndex] == sle.key());
+            BEAST_EXPECT(view[sfOwner] == alice);
+            BEAST_EXPECT(!view[~sfIndexNext]);
+        }
+    }
+
+    void
+    testTemplate()
+    {
+        testcase("template");
+
+        auto const sle = makeAccountRoot();
+        auto const s = serialize(sle);
+        auto view = makeView(s);
+
+        // Without the template, absent fields have no value.
+        BEAST_EXPECT(!view.isFieldPresent(sfMintedNFTokens));
+        try
+        {
+            (void)view[sfMintedNFTokens];
+            fail();
+        }
+        catch (STObject::FieldErr const&)
+        {
+            pass();
+        }
+
+        auto const type =
+            LedgerFormats::getInstance().findByType(ltACCOUNT_ROOT);
+        if (!BEAST_EXPECT(type))
+            return;
+        view.setTemplate(type->getSOTemplate());
+
+        // With it, fields that have a default read as that default, like
+        // they do in the ledger entry.
+        BEAST_EXPECT(view[sfMintedNFTokens] == sle[sfMintedNFTokens]);
+        BEAST_EXPECT(view[sfMintedNFTokens] == 0);
+        BEAST_EXPECT(!view[~sfMintedNFTokens]);
+
+        // But optional ones don't.
+        try
+        {
+            (void)view[sfEmailHash];
+            fail();
+        }
+        catch (STObject::FieldErr const&)
+        {
+            pass();
+        }
+
+        BEAST_EXPECT(view.toObject(sfLedgerEntry) == sle);
+    }
+
+    void
+    testMalformed()
+    {
+        testcase("malformed");
+
+        auto const sle = makeRippleState();
+        auto const s = serialize(sle);
+
+        auto expectThrow = [this](Slice slice) {
+            STObjectView const view(slice, nullptr);
+            try
+            {
+                (void)view.isFieldPresent(sfFlags);
+                fail();
+            }
+            catch (std::runtime_error const&)
+            {
+                pass();
+            }
+        };
+
+        // Truncated data.
+        expectThrow(Slice(s->data(), s->size() - 1));
+        expectThrow(Slice(s->data(), s->size() - 30));
+
+        // A field that appears twice.
+        Serializer dup;
+        dup.addFieldID(STI_UINT32, sfFlags.fieldValue);
+        dup.add32(1);
+        dup.addFieldID(STI_UINT32, sfFlags.fieldValue);
+        dup.add32(2);
+        expectThrow(dup.slice());
+
+        // An end of object marker at the top level.
+        Serializer marker;
+        marker.addFieldID(STI_OBJECT, 1);
+        expectThrow(marker.slice());
+
+        // An empty view has no fields.
+        STObjectView const empty(Slice{}, nullptr);
+        BEAST_EXPECT(empty.size() == 0);
+        BEAST_EXPECT(!empty.isFieldPresent(sfFlags));
+    }
+
+    void
+    testOrder()
+    {
+        testcase("non-canonical order");
+
+        // Fields out of order are still found.
+        Serializer s;
+        s.addFieldID(STI_UINT32, sfSequence.fieldValue);
+        s.add32(7);
+        s.addFieldID(STI_UINT16, sfLedgerEntryType.fieldValue);
+        s.add16(ltACCOUNT_ROOT);
+        s.addFieldID(STI_UINT32, sfFlags.fieldValue);
+        s.add32(9);
+
+        STObjectView const view(s.slice(), nullptr);
+        BEAST_EXPECT(view.size() == 3);
+        BEAST_EXPECT(view[sfSequence] == 7);
+        BEAST_EXPECT(view[sfLedgerEntryType] == ltACCOUNT_ROOT);
+        BEAST_EXPECT(view[sfFlags] == 9);
+    }
+
+public:
+    void
+    run() override
+    {
+        testFields();
+        testAmounts();
+        testNested();
+        testTemplate();
+        testMalformed();
+        testOrder();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(STObjectView, protocol, ripple);
+
+}  // namespace ripple
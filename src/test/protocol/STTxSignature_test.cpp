@@ -0,0 +1,237 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/StringUtilities.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/Feature.h>
+#include <ripple/protocol/STAccount.h>
+#include <ripple/protocol/STArray.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/protocol/Sign.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/protocol/jss.h>
+
+namespace ripple {
+
+namespace test {
+
+struct Signer
+{
+    PublicKey publicKey;
+    SecretKey secretKey;
+    AccountID id;
+
+    Signer(KeyType type, std::string const& passphrase)
+    {
+        std::tie(publicKey, secretKey) =
+            generateKeyPair(type, generateSeed(passphrase));
+        id = calcAccountID(publicKey);
+    }
+};
+
+inline std::vector<Signer>
+makeSigners(std::size_t count, KeyType type)
+{
+    std::vector<Signer> signers;
+    for (std::size_t i = 0; i < count; ++i)
+        signers.emplace_back(type, "signer" + std::to_string(i));
+    std::sort(signers.begin(), signers.end(), [](auto const& a, auto const& b) {
+        return a.id < b.id;
+    });
+    return signers;
+}
+
+inline void
+addPayment(STObject& obj, std::uint32_t seq)
+{
+    obj.setAccountID(sfAccount, AccountID(1));
+    obj.setAccountID(sfDestination, AccountID(2));
+    obj.setFieldAmount(sfAmount, STAmount(XRPAmount(1'000'000 + seq)));
+    obj.setFieldAmount(sfFee, STAmount(XRPAmount(100)));
+    obj.setFieldU32(sfSequence, seq);
+    obj.setFieldVL(sfSigningPubKey, Slice{});
+}
+
+// A payment signed by all of the signers.
+inline STTx
+makeMultiSigned(std::vector<Signer> const& signers, std::uint32_t seq)
+{
+    STTx const unsigned_(ttPAYMENT, [&](STObject& obj) {
+        addPayment(obj, seq);
+    });
+
+    STArray array(sfSigners);
+    for (auto const& signer : signers)
+    {
+        Serializer s = startMultiSigningData(unsigned_);
+        finishMultiSigningData(signer.id, s);
+        STObject entry(sfSigner);
+        entry.setAccountID(sfAccount, signer.id);
+        entry.setFieldVL(sfSigningPubKey, signer.publicKey.slice());
+        entry.setFieldVL(
+            sfTxnSignature,
+            sign(signer.publicKey, signer.secretKey, s.slice()));
+        array.push_back(std::move(entry));
+    }
+
+    return STTx(ttPAYMENT, [&](STObject& obj) {
+        addPayment(obj, seq);
+        obj.setFieldArray(sfSigners, array);
+    });
+}
+
+}  // namespace test
+
+class STTxSignature_test : public beast::unit_test::suite
+{
+    // Rules refer to their presets, rather than copying them.
+    std::unordered_set<uint256, beast::uhash<>> const presets_{
+        featureExpandedSignerList};
+    Rules const rules_{presets_};
+
+    bool
+    checks(STTx const& tx)
+    {
+        return bool(tx.checkSign(STTx::RequireFullyCanonicalSig::yes, rules_));
+    }
+
+    // The transaction that a changed copy of a transaction serializes to.
+    static STTx
+    reparse(STObject const& obj)
+    {
+        Serializer s;
+        obj.add(s);
+        return STTx{SerialIter{s.slice()}};
+    }
+
+    void
+    testSerialized()
+    {
+        testcase("serialized");
+
+        auto const [pk, sk] =
+            generateKeyPair(KeyType::secp256k1, generateSeed("alice"));
+        STTx tx(ttACCOUNT_SET, [&](STObject& obj) {
+            obj.setAccountID(sfAccount, calcAccountID(pk));
+            obj.setFieldAmount(sfFee, STAmount(XRPAmount(10)));
+            obj.setFieldU32(sfSequence, 7);
+            obj.setFieldVL(sfSigningPubKey, pk.slice());
+        });
+
+        auto serialized = [](STTx const& tx) {
+            Serializer s;
+            tx.add(s);
+            return s;
+        };
+        // Binary JSON and the SQL reflect the fields as they are now.
+        auto matches = [&](STTx const& tx) {
+            auto const s = serialized(tx);
+            auto const json = tx.getJson(JsonOptions::none, true);
+            return json[jss::tx] == strHex(s.slice()) &&
+                tx.getMetaSQL(1, "''").find(sqlBlobLiteral(s.peekData())) !=
+                std::string::npos;
+        };
+        BEAST_EXPECT(matches(tx));
+        BEAST_EXPECT(
+            tx.getTransactionID() ==
+            sha512Half(HashPrefix::transactionID, serialized(tx).slice()));
+
+        // Signing adds a field, and refreshes the transaction ID.
+        auto const before = tx.getJson(JsonOptions::none, true);
+        tx.sign(pk, sk);
+        BEAST_EXPECT(matches(tx));
+        BEAST_EXPECT(
+            before[jss::tx] != tx.getJson(JsonOptions::none, true)[jss::tx]);
+        BEAST_EXPECT(
+            tx.getTransactionID() == tx.getHash(HashPrefix::transactionID));
+        BEAST_EXPECT(checks(tx));
+
+        // Changing fields after the transaction was serialized, through
+        // the setters, a proxy or a reference to the field.
+        tx.setFieldU32(sfSequence, 8);
+        BEAST_EXPECT(matches(tx));
+        tx[sfSequence] = 9;
+        BEAST_EXPECT(matches(tx));
+        dynamic_cast<STAmount&>(tx.getField(sfFee)) = XRPAmount(12);
+        BEAST_EXPECT(matches(tx));
+        tx.makeFieldAbsent(sfTxnSignature);
+        BEAST_EXPECT(matches(tx));
+        BEAST_EXPECT(!checks(tx));
+
+        // A transaction read from the serialization has the same one.
+        STTx const copy{SerialIter{serialized(tx).slice()}};
+        BEAST_EXPECT(matches(copy));
+        BEAST_EXPECT(
+            copy.getJson(JsonOptions::none, true)[jss::tx] ==
+            tx.getJson(JsonOptions::none, true)[jss::tx]);
+    }
+
+    void
+    testMultiSign(KeyType type, std::size_t count)
+    {
+        testcase << "multisign " << count << " " << to_string(type);
+
+        auto const signers = test::makeSigners(count, type);
+        auto const tx = test::makeMultiSigned(signers, 1);
+        BEAST_EXPECT(checks(tx));
+
+        // Every signature is checked against its own signer's account.
+        for (std::size_t bad : {std::size_t{0}, count / 2, count - 1})
+        {
+            STObject obj(tx);
+            auto& array = obj.peekFieldArray(sfSigners);
+            auto const other = test::makeMultiSigned(signers, 2);
+            array[bad].setFieldVL(
+                sfTxnSignature,
+                other.getFieldArray(sfSigners)[bad].getFieldVL(
+                    sfTxnSignature));
+            BEAST_EXPECT(!checks(reparse(obj)));
+        }
+
+        // Signatures are over the signer's account ID, so swapping the
+        // signatures of two signers invalidates both.
+        if (count > 1)
+        {
+            STObject obj(tx);
+            auto& array = obj.peekFieldArray(sfSigners);
+            auto const first = array[0].getFieldVL(sfTxnSignature);
+            array[0].setFieldVL(
+                sfTxnSignature, array[1].getFieldVL(sfTxnSignature));
+            array[1].setFieldVL(sfTxnSignature, first);
+            BEAST_EXPECT(!checks(reparse(obj)));
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testSerialized();
+        for (auto const type : {KeyType::secp256k1, KeyType::ed25519})
+        {
+            testMultiSign(type, 1);
+            testMultiSign(type, 8);
+            testMultiSign(type, 32);
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(STTxSignature, protocol, ripple);
+
+}  // namespace ripple
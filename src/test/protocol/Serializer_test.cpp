@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/Serializer.h>
+
+namespace ripple {
+
+class Serializer_test : public beast::unit_test::suite
+{
+    void
+    testReuse()
+    {
+        testcase("buffer reuse");
+
+        std::size_t capacity;
+        {
+            Serializer s;
+            for (int i = 0; i < 1000; ++i)
+                s.add32(i);
+            capacity = s.capacity();
+        }
+
+        // The next serializer gets the buffer back, empty.
+        {
+            Serializer s;
+            BEAST_EXPECT(s.size() == 0);
+            BEAST_EXPECT(s.capacity() == capacity);
+            s.add8(7);
+            BEAST_EXPECT(s.peekData() == Blob{7});
+        }
+
+        // Very large buffers aren't kept.
+        {
+            Serializer s(4 * 1024 * 1024);
+            s.addRaw(Blob(4 * 1024 * 1024, 1));
+        }
+        {
+            Serializer s;
+            BEAST_EXPECT(s.capacity() < 4 * 1024 * 1024);
+        }
+
+        // A buffer taken from a serializer belongs to the taker.
+        Blob taken;
+        {
+            Serializer s;
+            s.add32(0x01020304);
+            taken = std::move(s.modData());
+        }
+        {
+            Serializer s;
+            s.add32(0x05060708);
+            BEAST_EXPECT(s.size() == 4);
+        }
+        BEAST_EXPECT((taken == Blob{1, 2, 3, 4}));
+    }
+
+    void
+    testCopyAndMove()
+    {
+        testcase("copy and move");
+
+        Serializer a;
+        a.add64(0x0102030405060708);
+
+        Serializer b(a);
+        BEAST_EXPECT(b == a);
+        b.add8(9);
+        BEAST_EXPECT(b != a);
+        BEAST_EXPECT(a.size() == 8);
+
+        Serializer c(std::move(b));
+        BEAST_EXPECT(c.size() == 9);
+
+        Serializer d;
+        d = c;
+        BEAST_EXPECT(d == c);
+        d = std::move(c);
+        BEAST_EXPECT(d.size() == 9);
+
+        std::vector<Serializer> v;
+        for (int i = 0; i < 100; ++i)
+        {
+            v.emplace_back();
+            v.back().add32(i);
+        }
+        bool ok = true;
+        for (int i = 0; i < 100; ++i)
+        {
+            std::uint32_t n;
+            ok = ok && v[i].getInteger(n, 0) && n == i;
+        }
+        BEAST_EXPECT(ok);
+    }
+
+    void
+    testFromData()
+    {
+        testcase("construct from data");
+
+        {
+            Serializer s;
+            for (int i = 0; i < 100; ++i)
+                s.add32(i);
+        }
+
+        Blob const data{1, 2, 3, 4, 5};
+        Serializer s(data.data(), data.size());
+        BEAST_EXPECT(s.peekData() == data);
+
+        Serializer empty(nullptr, 0);
+        BEAST_EXPECT(empty.size() == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testReuse();
+        testCopyAndMove();
+        testFromData();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(Serializer, protocol, ripple);
+
+}  // namespace ripple
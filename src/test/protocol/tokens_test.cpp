@@ -0,0 +1,267 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/StringUtilities.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/tokens.h>
+#include <boost/algorithm/hex.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <vector>
+
+namespace ripple {
+
+namespace test {
+
+// The digit at a time conversions that tokens.cpp used to do, which the
+// current ones must agree with.
+namespace reference {
+
+static constexpr char const* alphabet =
+    "rpshnaf39wBUDNEGHJKLM4PQRST7VWXYZ2bcdeCg65jkm8oFqi1tuvAxyz";
+
+inline int
+digitOf(unsigned char c)
+{
+    auto const p = std::strchr(alphabet, c);
+    return (c == 0 || p == nullptr) ? -1 : static_cast<int>(p - alphabet);
+}
+
+inline std::string
+encodeBase58(void const* message, std::size_t size)
+{
+    auto pbegin = reinterpret_cast<unsigned char const*>(message);
+    auto const pend = pbegin + size;
+
+    int zeroes = 0;
+    while (pbegin != pend && *pbegin == 0)
+    {
+        pbegin++;
+        zeroes++;
+    }
+
+    std::vector<unsigned char> b58(size * 2 + 1);
+    while (pbegin != pend)
+    {
+        int carry = *pbegin;
+        for (auto iter = b58.rbegin(); iter != b58.rend(); ++iter)
+        {
+            carry += 256 * *iter;
+            *iter = carry % 58;
+            carry /= 58;
+        }
+        pbegin++;
+    }
+
+    auto iter = std::find_if(
+        b58.begin(), b58.end(), [](unsigned char c) { return c != 0; });
+    std::string str(zeroes, alphabet[0]);
+    while (iter != b58.end())
+        str += alphabet[*(iter++)];
+    return str;
+}
+
+inline std::string
+decodeBase58(std::string const& s)
+{
+    auto psz = reinterpret_cast<unsigned char const*>(s.c_str());
+    auto remain = s.size();
+    int zeroes = 0;
+    while (remain > 0 && digitOf(*psz) == 0)
+    {
+        ++zeroes;
+        ++psz;
+        --remain;
+    }
+
+    if (remain > 64)
+        return {};
+
+    std::vector<unsigned char> b256(remain * 733 / 1000 + 1);
+    while (remain > 0)
+    {
+        auto carry = digitOf(*psz);
+        if (carry == -1)
+            return {};
+        for (auto iter = b256.rbegin(); iter != b256.rend(); ++iter)
+        {
+            carry += 58 * *iter;
+            *iter = carry % 256;
+            carry /= 256;
+        }
+        ++psz;
+        --remain;
+    }
+    auto iter = std::find_if(
+        b256.begin(), b256.end(), [](unsigned char c) { return c != 0; });
+    std::string result(zeroes, 0x00);
+    while (iter != b256.end())
+        result.push_back(*(iter++));
+    return result;
+}
+
+}  // namespace reference
+
+}  // namespace test
+
+class tokens_test : public beast::unit_test::suite
+{
+    beast::xor_shift_engine rng_{42};
+
+    std::string
+    randomBytes(std::size_t size, std::size_t zeroes)
+    {
+        std::string s(size, 0);
+        for (std::size_t i = zeroes; i < size; ++i)
+            s[i] = static_cast<char>(rng_() & 0xFF);
+        return s;
+    }
+
+    void
+    testEncode()
+    {
+        testcase("encode");
+
+        BEAST_EXPECT(detail::encodeBase58(nullptr, 0).empty());
+        BEAST_EXPECT(detail::encodeBase58("\0\0", 2) == "rr");
+        BEAST_EXPECT(detail::encodeBase58("\x39", 1) == "z");
+        BEAST_EXPECT(detail::encodeBase58("\x3A", 1) == "pr");
+
+        // Anything up to 46 bytes encodes to few enough digits to decode.
+        std::size_t mismatches = 0;
+        std::size_t roundTrips = 0;
+        for (int i = 0; i < 20000; ++i)
+        {
+            auto const size = rng_() % 47;
+            auto const data =
+                randomBytes(size, std::min<std::size_t>(rng_() % 4, size));
+            auto const encoded = detail::encodeBase58(data.data(), size);
+            if (encoded != test::reference::encodeBase58(data.data(), size))
+                ++mismatches;
+            if (detail::decodeBase58(encoded) == data)
+                ++roundTrips;
+        }
+        BEAST_EXPECT(mismatches == 0);
+        BEAST_EXPECT(roundTrips == 20000);
+    }
+
+    void
+    testDecode()
+    {
+        testcase("decode");
+
+        BEAST_EXPECT(detail::decodeBase58("").empty());
+        BEAST_EXPECT(detail::decodeBase58("rr") == std::string(2, 0));
+        BEAST_EXPECT(detail::decodeBase58("r0").empty());
+        BEAST_EXPECT(detail::decodeBase58(std::string(65, 'p')).empty());
+        BEAST_EXPECT(
+            detail::decodeBase58(std::string(100, 'r')) ==
+            std::string(100, 0));
+
+        // Strings of digits, some with leading zero digits and a few with
+        // characters that aren't digits, including ones that aren't ASCII.
+        std::size_t mismatches = 0;
+        for (int i = 0; i < 20000; ++i)
+        {
+            auto const size = rng_() % 70;
+            std::string s(size, 'r');
+            auto const zeroes = std::min<std::size_t>(rng_() % 4, size);
+            for (std::size_t j = zeroes; j < size; ++j)
+                s[j] = test::reference::alphabet[rng_() % 58];
+            if (size && rng_() % 8 == 0)
+                s[rng_() % size] = static_cast<char>(rng_() & 0xFF);
+            if (detail::decodeBase58(s) != test::reference::decodeBase58(s))
+                ++mismatches;
+        }
+        BEAST_EXPECT(mismatches == 0);
+    }
+
+    void
+    testTokens()
+    {
+        testcase("tokens");
+
+        std::size_t roundTrips = 0;
+        for (int i = 0; i < 1000; ++i)
+        {
+            AccountID id;
+            auto const bytes = randomBytes(id.size(), rng_() % 3);
+            std::memcpy(id.data(), bytes.data(), id.size());
+            auto const encoded = toBase58(id);
+            if (encoded.size() >= 25 && encoded.size() <= 35 &&
+                encoded[0] == 'r' && parseBase58<AccountID>(encoded) == id)
+                ++roundTrips;
+        }
+        BEAST_EXPECT(roundTrips == 1000);
+
+        auto const genesis = toBase58(AccountID{});
+        BEAST_EXPECT(genesis == "rrrrrrrrrrrrrrrrrrrrrhoLvTp");
+        BEAST_EXPECT(
+            decodeBase58Token(genesis, TokenType::NodePublic).empty());
+    }
+
+    void
+    testHex()
+    {
+        testcase("hex");
+
+        std::size_t mismatches = 0;
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto const data = randomBytes(rng_() % 64, 0);
+            std::string expected;
+            boost::algorithm::hex(
+                data.begin(), data.end(), std::back_inserter(expected));
+            auto const hex = strHex(data);
+            if (hex != expected)
+                ++mismatches;
+            auto lower = hex;
+            std::transform(
+                lower.begin(), lower.end(), lower.begin(), [](char c) {
+                    return static_cast<char>(std::tolower(c));
+                });
+            auto const back = strUnHex(lower);
+            if (!back || std::string(back->begin(), back->end()) != data)
+                ++mismatches;
+        }
+        BEAST_EXPECT(mismatches == 0);
+
+        // Characters past the end of ASCII aren't digits.
+        BEAST_EXPECT(!strUnHex(std::string("\xC0\x80")));
+        BEAST_EXPECT(!strUnHex(std::string("0g")));
+        BEAST_EXPECT(strHex(std::vector<std::uint16_t>{1, 0xAB}) == "000100AB");
+    }
+
+public:
+    void
+    run() override
+    {
+        testEncode();
+        testDecode();
+        testTokens();
+        testHex();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(tokens, protocol, ripple);
+
+}  // namespace ripple
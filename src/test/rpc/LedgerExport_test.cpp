@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/StateExport.h>
+#include <ripple/json/json_reader.h>
+#include <ripple/protocol/jss.h>
+#include <test/jtx.h>
+#include <test/jtx/JSONRPCClient.h>
+#include <cstring>
+
+namespace ripple {
+
+class LedgerExport_test : public beast::unit_test::suite
+{
+    struct Record
+    {
+        uint256 key;
+        std::string data;
+    };
+
+    static boost::beast::http::response<boost::beast::http::string_body>
+    ledgerExport(test::jtx::Env& env, Json::Value const& params)
+    {
+        Json::Value request;
+        request[jss::method] = "ledger_export";
+        request[jss::params] = Json::arrayValue;
+        request[jss::params].append(params);
+        return test::sendJSONRPC(env.app().config(), request);
+    }
+
+    // Split a reply into its records, or fail if it isn't made of whole
+    // records.
+    std::vector<Record>
+    records(std::string const& body)
+    {
+        std::vector<Record> result;
+        std::size_t pos = 0;
+        while (pos != body.size())
+        {
+            if (!BEAST_EXPECT(body.size() - pos >= 36))
+                break;
+            Record& r = result.emplace_back();
+            std::memcpy(r.key.data(), body.data() + pos, 32);
+            std::size_t size = 0;
+            for (int i = 0; i < 4; ++i)
+                size = size << 8 |
+                    static_cast<unsigned char>(body[pos + 32 + i]);
+            pos += 36;
+            if (!BEAST_EXPECT(body.size() - pos >= size))
+                break;
+            r.data = body.substr(pos, size);
+            pos += size;
+        }
+        return result;
+    }
+
+    // The state records of a ledger, after a key.
+    static std::vector<Record>
+    expected(Ledger const& ledger, uint256 const& after)
+    {
+        std::vector<Record> result;
+        auto const& map = ledger.stateMap();
+        for (auto i = map.upper_bound(after); i != map.end(); ++i)
+            result.push_back(
+                {i->key(), std::string(i->slice().begin(), i->slice().end())});
+        return result;
+    }
+
+    static bool
+    same(
+        std::vector<Record>::const_iterator first,
+        std::vector<Record>::const_iterator last,
+        std::vector<Record> const& want)
+    {
+        return std::equal(
+            first,
+            last,
+            want.begin(),
+            want.end(),
+            [](Record const& a, Record const& b) {
+                return a.key == b.key && a.data == b.data;
+            });
+    }
+
+    void
+    testExport()
+    {
+        testcase("export");
+
+        using namespace test::jtx;
+        Env env{*this};
+        for (int i = 0; i < 50; ++i)
+            env.fund(XRP(1000), Account{"bob" + std::to_string(i)});
+        env.close();
+
+        auto const ledger = env.app().getLedgerMaster().getClosedLedger();
+        Json::Value params;
+        params[jss::ledger_index] = "closed";
+
+        // The whole ledger: its header, then each state entry in key order.
+        {
+            auto const reply = ledgerExport(env, params);
+            BEAST_EXPECT(reply.result_int() == 200);
+            BEAST_EXPECT(
+                reply[boost::beast::http::field::content_type] ==
+                "application/octet-stream");
+
+            auto const got = records(reply.body());
+            auto const want = expected(*ledger, uint256{});
+            if (BEAST_EXPECT(got.size() == want.size() + 1))
+            {
+                Serializer s;
+                addRaw(ledger->info(), s);
+                BEAST_EXPECT(got[0].key == ledger->info().hash);
+                BEAST_EXPECT(
+                    got[0].data ==
+                    std::string(s.slice().begin(), s.slice().end()));
+                BEAST_EXPECT(same(got.begin() + 1, got.end(), want));
+            }
+        }
+
+        // The connection is kept for another request.
+        {
+            Json::Value request;
+            request[jss::method] = "ledger_export";
+            request[jss::params] = Json::arrayValue;
+            request[jss::params].append(params);
+            auto const replies =
+                test::sendJSONRPC(env.app().config(), {request, request});
+            if (BEAST_EXPECT(replies.size() == 2))
+            {
+                BEAST_EXPECT(replies[0].keep_alive());
+                BEAST_EXPECT(replies[0].body() == replies[1].body());
+                BEAST_EXPECT(
+                    records(replies[1].body()).size() ==
+                    expected(*ledger, uint256{}).size() + 1);
+            }
+        }
+
+        // Resume after a marker: no header, and only the later entries.
+        {
+            auto const all = expected(*ledger, uint256{});
+            if (!BEAST_EXPECT(all.size() > 10))
+                return;
+            auto const marker = all[all.size() / 2].key;
+            params[jss::marker] = to_string(marker);
+            auto const reply = ledgerExport(env, params);
+            BEAST_EXPECT(reply.result_int() == 200);
+
+            auto const got = records(reply.body());
+            auto const want = expected(*ledger, marker);
+            BEAST_EXPECT(want.size() == all.size() - all.size() / 2 - 1);
+            BEAST_EXPECT(same(got.begin(), got.end(), want));
+        }
+    }
+
+    void
+    testErrors()
+    {
+        testcase("errors");
+
+        using namespace test::jtx;
+        Env env{*this};
+        env.close();
+
+        auto const error = [&](Json::Value const& params) {
+            auto const reply = ledgerExport(env, params);
+            Json::Value jv;
+            if (!BEAST_EXPECT(Json::Reader().parse(reply.body(), jv)))
+                return std::string{};
+            return jv[jss::result][jss::error].asString();
+        };
+
+        // The open ledger has no state map to export.
+        Json::Value params;
+        params[jss::ledger_index] = "current";
+        BEAST_EXPECT(error(params) == "invalidParams");
+
+        params[jss::ledger_index] = "closed";
+        params[jss::marker] = "zz";
+        BEAST_EXPECT(error(params) == "invalidParams");
+
+        params.removeMember(jss::marker);
+        params[jss::ledger_index] = 1000;
+        BEAST_EXPECT(error(params) == "lgrNotFound");
+    }
+
+public:
+    void
+    run() override
+    {
+        testExport();
+        testErrors();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerExport, rpc, ripple);
+
+}  // namespace ripple
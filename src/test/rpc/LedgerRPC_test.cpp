@@ -21,10 +21,13 @@
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/basics/StringUtilities.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/json/json_reader.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
+#include <ripple/server/StreamWriter.h>
 #include <test/jtx.h>
+#include <test/jtx/JSONRPCClient.h>
 
 namespace ripple {
 
@@ -1712,6 +1715,123 @@ class LedgerRPC_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testStreamed()
+    {
+        testcase("Ledger Request, Streamed");
+        using namespace test::jtx;
+
+        Env env{*this};
+
+        // A ledger request over JSON-RPC. One in a batch is built as a
+        // Json::Value, and one on its own may be streamed.
+        auto const request = [&](Json::Value params, bool batch) {
+            params[jss::ledger_index] = env.closed()->seq();
+            Json::Value request;
+            request[jss::params] = Json::arrayValue;
+            if (batch)
+            {
+                params[jss::method] = "ledger";
+                request[jss::method] = "batch";
+            }
+            else
+            {
+                request[jss::method] = "ledger";
+            }
+            request[jss::params].append(params);
+            return request;
+        };
+        auto const send = [&](Json::Value const& params, bool batch) {
+            return test::sendJSONRPC(
+                env.app().config(), request(params, batch));
+        };
+
+        Json::Value full;
+        full[jss::full] = true;
+
+        // A small ledger's reply is built like any other.
+        {
+            auto const reply = send(full, false);
+            BEAST_EXPECT(!reply.chunked() && reply.keep_alive());
+        }
+
+        // Enough entries and transactions for the reply to be streamed, in
+        // several chunks.
+        for (int i = 0; i < 300; ++i)
+            env.fund(XRP(1000), Account("a" + std::to_string(i)));
+        env.close();
+
+        auto const check = [&](Json::Value const& params) {
+            auto const reply = send(params, false);
+            auto const streamed = reply.body();
+            auto const built = send(params, true).body();
+            BEAST_EXPECT(reply.chunked() && reply.keep_alive());
+
+            // The batch's one reply, as it would be on its own.
+            if (!BEAST_EXPECT(
+                    built.size() > 3 && built.front() == '[' &&
+                    built.substr(built.size() - 2) == "]\n"))
+                return std::string{};
+            BEAST_EXPECT(streamed == built.substr(1, built.size() - 3) + "\n");
+
+            Json::Value json;
+            BEAST_EXPECT(
+                Json::Reader{}.parse(streamed, json) &&
+                json[jss::result][jss::status] == jss::success);
+            return streamed;
+        };
+
+        {
+            Json::Value params;
+            params[jss::full] = true;
+            auto const streamed = check(params);
+            BEAST_EXPECT(streamed.size() > 2 * StreamWriter::chunkSize);
+        }
+        {
+            Json::Value params;
+            params[jss::accounts] = true;
+            params[jss::expand] = true;
+            params[jss::id] = 7;
+            params[jss::jsonrpc] = "2.0";
+            params[jss::ripplerpc] = "1.0";
+            check(params);
+        }
+        {
+            Json::Value params;
+            params[jss::transactions] = true;
+            params[jss::expand] = true;
+            params[jss::owner_funds] = true;
+            check(params);
+        }
+        {
+            Json::Value params;
+            params[jss::accounts] = true;
+            params[jss::transactions] = true;
+            params[jss::expand] = true;
+            params[jss::binary] = true;
+            check(params);
+        }
+        {
+            Json::Value params;
+            params[jss::accounts] = true;
+            params[jss::type] = jss::account;
+            check(params);
+        }
+
+        // The connection is kept for the requests after a streamed reply.
+        {
+            auto const replies = test::sendJSONRPC(
+                env.app().config(),
+                {request(full, false), request(Json::objectValue, false)});
+            Json::Value next;
+            BEAST_EXPECT(
+                replies.size() == 2 && replies[0].chunked() &&
+                Json::Reader{}.parse(replies[1].body(), next) &&
+                next[jss::result][jss::status] == jss::success &&
+                next[jss::result][jss::ledger_index] == env.closed()->seq());
+        }
+    }
+
 public:
     void
     run() override
@@ -1736,6 +1856,7 @@ public:
         testNoQueue();
         testQueue();
         testLedgerAccountsOption();
+        testStreamed();
 
         // version specific tests
         for (auto testVersion = RPC::apiMinimumSupportedVersion;
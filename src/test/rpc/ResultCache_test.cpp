@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/resource/Fees.h>
+#include <ripple/resource/ResourceManager.h>
+#include <ripple/resource/impl/Entry.h>
+#include <ripple/resource/impl/Tuning.h>
+#include <ripple/rpc/ResultCache.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace RPC {
+
+class ResultCache_test : public beast::unit_test::suite
+{
+    static Json::Value
+    request(std::string const& account)
+    {
+        Json::Value params(Json::objectValue);
+        params[jss::account] = account;
+        params[jss::strict] = true;
+        return params;
+    }
+
+    void
+    testEnabled()
+    {
+        testcase("enabled");
+
+        ResultCache const cache(1024, {"account_info", "book_offers"});
+        BEAST_EXPECT(cache.enabled("account_info"));
+        BEAST_EXPECT(cache.enabled("book_offers"));
+        BEAST_EXPECT(!cache.enabled("account_tx"));
+
+        ResultCache const off(0, {"account_info"});
+        BEAST_EXPECT(!off.enabled("account_info"));
+    }
+
+    void
+    testKey()
+    {
+        testcase("key");
+
+        uint256 const ledger(1);
+        auto const params = request("rA");
+        auto const key =
+            ResultCache::key(ledger, "account_info", params, 1, Role::USER);
+
+        // What selects the ledger or identifies the request doesn't matter.
+        auto same = params;
+        same[jss::ledger_index] = "validated";
+        same[jss::id] = 7;
+        same[jss::command] = "account_info";
+        same[jss::api_version] = 1;
+        BEAST_EXPECT(
+            ResultCache::key(ledger, "account_info", same, 1, Role::USER) ==
+            key);
+
+        // Anything else does.
+        BEAST_EXPECT(
+            ResultCache::key(
+                uint256(2), "account_info", params, 1, Role::USER) != key);
+        BEAST_EXPECT(
+            ResultCache::key(ledger, "account_lines", params, 1, Role::USER) !=
+            key);
+        BEAST_EXPECT(
+            ResultCache::key(
+                ledger, "account_info", request("rB"), 1, Role::USER) != key);
+        BEAST_EXPECT(
+            ResultCache::key(ledger, "account_info", params, 2, Role::USER) !=
+            key);
+        BEAST_EXPECT(
+            ResultCache::key(ledger, "account_info", params, 1, Role::ADMIN) !=
+            key);
+    }
+
+    void
+    testBudget()
+    {
+        testcase("budget");
+
+        Json::Value result(Json::objectValue);
+        result[jss::account] = std::string(100, 'x');
+        auto const bytes = ResultCache::footprint(result);
+        BEAST_EXPECT(bytes > 100);
+
+        ResultCache cache(3 * bytes, {"account_info"});
+        for (int i = 0; i < 3; ++i)
+            cache.insert(uint256(i), result, Resource::feeReferenceRPC);
+        BEAST_EXPECT(cache.stats().entries == 3);
+        BEAST_EXPECT(cache.stats().bytes == 3 * bytes);
+
+        // The result used least recently is the one dropped for a new one.
+        BEAST_EXPECT(cache.find(uint256(0)));
+        cache.insert(uint256(3), result, Resource::feeMediumBurdenRPC);
+        BEAST_EXPECT(cache.stats().entries == 3);
+        BEAST_EXPECT(!cache.find(uint256(1)));
+        BEAST_EXPECT(cache.find(uint256(0)));
+        BEAST_EXPECT(cache.find(uint256(2)));
+        if (auto const found = cache.find(uint256(3)); BEAST_EXPECT(found))
+        {
+            BEAST_EXPECT(*found->value == result);
+            BEAST_EXPECT(found->loadType == Resource::feeMediumBurdenRPC);
+        }
+
+        auto const stats = cache.stats();
+        BEAST_EXPECT(stats.hits == 4);
+        BEAST_EXPECT(stats.misses == 1);
+
+        // A result bigger than the whole budget isn't kept.
+        Json::Value big(Json::objectValue);
+        big[jss::account] = std::string(4 * bytes, 'x');
+        cache.insert(uint256(4), big, Resource::feeReferenceRPC);
+        BEAST_EXPECT(!cache.find(uint256(4)));
+        BEAST_EXPECT(cache.stats().entries == 3);
+    }
+
+    void
+    testServer()
+    {
+        testcase("server");
+
+        using namespace test::jtx;
+        Env env{*this, envconfig([](std::unique_ptr<Config> cfg) {
+                    cfg = no_admin(std::move(cfg));
+                    cfg->RPC_CACHE_SIZE = 1 << 20;
+                    cfg->RPC_CACHE_COMMANDS = {"gateway_balances"};
+                    return cfg;
+                })};
+        auto& cache = env.app().getRPCResultCache();
+
+        Account const gw{"gw"};
+        Account const alice{"alice"};
+        env.fund(XRP(10000), gw, alice);
+        env.close();
+        env.trust(gw["USD"](100), alice);
+        env(pay(gw, alice, gw["USD"](10)));
+        env.close();
+
+        auto const balances = [&](char const* ledger) {
+            Json::Value params;
+            params[jss::account] = gw.human();
+            params[jss::ledger_index] = ledger;
+            auto result = env.rpc(
+                "json", "gateway_balances", to_string(params))[jss::result];
+            result.removeMember(jss::warning);
+            return result;
+        };
+
+        // Requests from here are charged to this endpoint. Start it afresh,
+        // so that none are dropped.
+        auto consumer = env.app().getResourceManager().newInboundEndpoint(
+            beast::IP::Endpoint::from_string(test::getEnvLocalhostAddr()));
+        {
+            using namespace std::chrono;
+            using clock = beast::abstract_clock<steady_clock>;
+            consumer.entry().local_balance =
+                DecayingSample<Resource::decayWindowSeconds, clock>{
+                    steady_clock::now()};
+        }
+
+        auto const first = balances("validated");
+        BEAST_EXPECT(first[jss::status] == "success");
+        BEAST_EXPECT(first[jss::obligations].isMember("USD"));
+        BEAST_EXPECT(cache.stats().entries == 1);
+        BEAST_EXPECT(cache.stats().misses == 1);
+        BEAST_EXPECT(cache.stats().hits == 0);
+
+        // The same request is answered from the cache, and charged what
+        // producing the result was, rather than what a reference request
+        // is.
+        auto const before = consumer.balance();
+        BEAST_EXPECT(balances("validated") == first);
+        BEAST_EXPECT(cache.stats().hits == 1);
+        BEAST_EXPECT(
+            consumer.balance() - before >
+            Resource::feeHighBurdenRPC.cost() / 2);
+
+        // Results against the open ledger aren't kept.
+        BEAST_EXPECT(balances("current")[jss::status] == "success");
+        BEAST_EXPECT(cache.stats().entries == 1);
+
+        // A new validated ledger has results of its own.
+        env.close();
+        BEAST_EXPECT(balances("validated")[jss::status] == "success");
+        BEAST_EXPECT(cache.stats().entries == 2);
+        BEAST_EXPECT(cache.stats().misses == 2);
+    }
+
+public:
+    void
+    run() override
+    {
+        testEnabled();
+        testKey();
+        testBudget();
+        testServer();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ResultCache, rpc, ripple);
+
+}  // namespace RPC
+}  // namespace ripple
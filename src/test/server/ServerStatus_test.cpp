@@ -1181,6 +1181,76 @@ class ServerStatus_test : public beast::unit_test::suite,
         }
     }
 
+    void
+    testBatch(boost::asio::yield_context& yield)
+    {
+        testcase("RPC client sends a batch");
+
+        using namespace test::jtx;
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        env.fund(XRP(10000), alice, bob);
+        env.close();
+
+        auto const seq = env.seq(alice);
+        auto const balance = env.balance(bob);
+        auto const jt = env.jt(pay(alice, bob, XRP(10)));
+
+        // Reads around a submit and a ledger_accept, which must see what
+        // the entries before them did, with some errors and enough pings
+        // to be evaluated several at a time.
+        Json::Value jv;
+        jv[jss::method] = "batch";
+        auto& entries = jv[jss::params] = Json::arrayValue;
+        auto add = [&](char const* method) -> Json::Value& {
+            auto& entry = entries.append(Json::objectValue);
+            entry[jss::method] = method;
+            entry[jss::id] = entries.size() - 1;
+            return entry;
+        };
+        add("account_info")[jss::account] = alice.human();
+        add("account_info")[jss::account] = Account{"carol"}.human();
+        add("no_such_method");
+        add("submit")[jss::tx_blob] = strHex(jt.stx->getSerializer().slice());
+        add("account_info")[jss::account] = alice.human();
+        add("ledger_accept");
+        for (int i = 0; i < 10; ++i)
+            add("ping");
+        auto& closed = add("account_info");
+        closed[jss::account] = bob.human();
+        closed[jss::ledger_index] = "closed";
+
+        boost::beast::http::response<boost::beast::http::string_body> resp;
+        boost::system::error_code ec;
+        doHTTPRequest(env, yield, false, resp, ec, to_string(jv));
+        if (!BEAST_EXPECT(resp.result() == boost::beast::http::status::ok))
+            return;
+
+        Json::Value replies;
+        Json::Reader().parse(resp.body(), replies);
+        if (!BEAST_EXPECT(
+                replies.isArray() && replies.size() == entries.size()))
+            return;
+        for (Json::UInt i = 0; i < replies.size(); ++i)
+            BEAST_EXPECT(replies[i][jss::id] == i);
+
+        auto result = [&](Json::UInt i) { return replies[i][jss::result]; };
+        BEAST_EXPECT(
+            result(0)[jss::account_data][sfSequence.fieldName] == seq);
+        BEAST_EXPECT(result(1)[jss::error] == "actNotFound");
+        BEAST_EXPECT(result(2)[jss::error] == "unknownCmd");
+        BEAST_EXPECT(result(3)[jss::engine_result] == "tesSUCCESS");
+        BEAST_EXPECT(
+            result(4)[jss::account_data][sfSequence.fieldName] == seq + 1);
+        BEAST_EXPECT(result(5)[jss::status] == jss::success);
+        for (Json::UInt i = 6; i < 16; ++i)
+            BEAST_EXPECT(result(i)[jss::status] == jss::success);
+        BEAST_EXPECT(
+            result(16)[jss::account_data][sfBalance.fieldName] ==
+            (balance + XRP(10)).value().getText());
+    }
+
     void
     testStatusNotOkay(boost::asio::yield_context& yield)
     {
@@ -1239,6 +1309,7 @@ public:
             testNoRPC(yield);
             testWSRequests(yield);
             testRPCRequests(yield);
+            testBatch(yield);
             testStatusNotOkay(yield);
         });
     }
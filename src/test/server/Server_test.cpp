@@ -35,9 +35,11 @@
 #include <boost/utility/in_place_factory.hpp>
 
 #include <chrono>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <thread>
+#include <vector>
 
 namespace ripple {
 namespace test {
@@ -102,6 +104,15 @@ public:
 
     struct TestHandler
     {
+        std::mutex mutex;
+        std::vector<std::thread> threads;
+
+        ~TestHandler()
+        {
+            for (auto& t : threads)
+                t.join();
+        }
+
         bool
         onAccept(Session& session, boost::asio::ip::tcp::endpoint endpoint)
         {
@@ -130,6 +141,22 @@ public:
         void
         onRequest(Session& session)
         {
+            // A request for /wait is answered later, from another thread,
+            // and one for /hold much later.
+            auto const target = session.request().target();
+            if (target == "/wait" || target == "/hold")
+            {
+                std::lock_guard lock(mutex);
+                auto const delay = std::chrono::milliseconds(
+                    target == "/wait" ? 100 : 5000);
+                threads.emplace_back([detached = session.detach(), delay] {
+                    std::this_thread::sleep_for(delay);
+                    detached->write(std::string("Waited!\n"));
+                    detached->complete();
+                });
+                return;
+            }
+
             session.write(std::string("Hello, world!\n"));
             if (beast::rfc2616::is_keep_alive(session.request()))
                 session.complete();
@@ -283,6 +310,69 @@ public:
         s.shutdown(socket::shutdown_both, ec);
     }
 
+    void
+    test_pipelining(boost::asio::ip::tcp::endpoint const& ep)
+    {
+        boost::asio::io_service ios;
+        using socket = boost::asio::ip::tcp::socket;
+        socket s(ios);
+
+        if (!connect(s, ep))
+            return;
+
+        // More requests than are answered at once, sent together. Those
+        // answered later are still answered in order.
+        std::string requests;
+        std::string expected;
+        for (int i = 0; i < 20; ++i)
+        {
+            bool const wait = i % 3 == 0;
+            requests += wait ? "GET /wait HTTP/1.1\r\n" : "GET / HTTP/1.1\r\n";
+            if (i == 19)
+                requests += "Connection: close\r\n";
+            requests += "\r\n";
+            expected += wait ? "Waited!\n" : "Hello, world!\n";
+        }
+        if (!write(s, requests))
+            return;
+
+        std::string got;
+        boost::system::error_code ec;
+        boost::asio::read(s, boost::asio::dynamic_buffer(got), ec);
+        BEAST_EXPECT(ec == boost::asio::error::eof);
+        BEAST_EXPECT(got == expected);
+    }
+
+    void
+    test_partial(boost::asio::ip::tcp::endpoint const& ep)
+    {
+        boost::asio::io_service ios;
+        using socket = boost::asio::ip::tcp::socket;
+        socket s(ios);
+
+        if (!connect(s, ep))
+            return;
+
+        // A request that's started but never finished times out, even
+        // while an earlier one is still being answered.
+        auto const start = std::chrono::steady_clock::now();
+        if (!write(
+                s,
+                "GET /hold HTTP/1.1\r\n"
+                "\r\n"
+                "GET / HTTP/1.1\r\n"))
+            return;
+
+        std::string got;
+        boost::system::error_code ec;
+        boost::asio::read(s, boost::asio::dynamic_buffer(got), ec);
+        BEAST_EXPECT(ec);
+        BEAST_EXPECT(got.empty());
+        BEAST_EXPECT(
+            std::chrono::steady_clock::now() - start <
+            std::chrono::seconds(5));
+    }
+
     void
     basicTests()
     {
@@ -301,6 +391,8 @@ public:
         auto eps = s->ports(serverPort);
         test_request(eps[0]);
         test_keepalive(eps[0]);
+        test_pipelining(eps[0]);
+        test_partial(eps[0]);
         // s->close();
         s = nullptr;
         pass();
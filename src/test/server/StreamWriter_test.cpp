@@ -0,0 +1,256 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/server/StreamWriter.h>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace ripple {
+
+class StreamWriter_test : public beast::unit_test::suite
+{
+    // Lets one thread wait for another, the way a coroutine is suspended
+    // and posted.
+    class Gate
+    {
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool open_ = false;
+
+    public:
+        void
+        wait()
+        {
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [this] { return open_; });
+            open_ = false;
+        }
+
+        void
+        open()
+        {
+            std::lock_guard lock(mutex_);
+            open_ = true;
+            cv_.notify_all();
+        }
+    };
+
+    struct Sent
+    {
+        std::string bytes;
+        std::size_t mostHeld = 0;
+    };
+
+    // Everything a session would write of a body, taken the way
+    // BaseHTTPPeer::do_writer takes it.
+    static Sent
+    drain(Writer& body, std::size_t chunk)
+    {
+        Sent sent;
+        Gate ready;
+        for (;;)
+        {
+            while (!body.prepare(chunk, [&] { ready.open(); }))
+                ready.wait();
+            std::size_t held = 0;
+            std::size_t taken = 0;
+            for (auto const& b : body.data())
+            {
+                held += b.size();
+                auto const n = std::min(b.size(), chunk - taken);
+                sent.bytes.append(static_cast<char const*>(b.data()), n);
+                taken += n;
+            }
+            sent.mostHeld = std::max(sent.mostHeld, held);
+            body.consume(taken);
+            if (body.complete())
+                return sent;
+        }
+    }
+
+    // The body of a chunked message, if it's all there.
+    static std::optional<std::string>
+    dechunk(std::string const& s)
+    {
+        std::string body;
+        std::size_t pos = 0;
+        for (;;)
+        {
+            auto const eol = s.find("\r\n", pos);
+            if (eol == std::string::npos)
+                return std::nullopt;
+            auto const size =
+                std::strtoul(s.substr(pos, eol - pos).c_str(), nullptr, 16);
+            pos = eol + 2;
+            if (s.size() < pos + size + 2 ||
+                s.compare(pos + size, 2, "\r\n") != 0)
+                return std::nullopt;
+            body.append(s, pos, size);
+            pos += size + 2;
+            if (size == 0)
+                return pos == s.size() ? std::optional(body) : std::nullopt;
+        }
+    }
+
+    void
+    testChunks()
+    {
+        testcase("chunks");
+
+        bool suspended = false;
+        StreamWriter stream(
+            "head\r\n\r\n", [&] { suspended = true; }, [] {});
+        auto body = stream.body();
+        stream.write("hello, ");
+        stream.write("world");
+
+        // Nothing is sent until there's a chunk's worth.
+        BEAST_EXPECT(!body->complete());
+        BEAST_EXPECT(body->prepare(1, [] {}));
+        BEAST_EXPECT(boost::asio::buffer_size(body->data()) == 8);
+        body->consume(8);
+        BEAST_EXPECT(!body->prepare(1, [] {}));
+
+        stream.finish();
+        auto const sent = drain(*body, 3);
+        BEAST_EXPECT(sent.bytes == "c\r\nhello, world\r\n0\r\n\r\n");
+        BEAST_EXPECT(body->complete());
+        BEAST_EXPECT(!suspended);
+
+        // Writes after the end are dropped.
+        stream.write("more");
+        stream.finish();
+        BEAST_EXPECT(body->complete());
+    }
+
+    void
+    testFlowControl()
+    {
+        testcase("flow control");
+
+        std::string expected;
+        for (std::size_t i = 0; expected.size() < 4 * 1024 * 1024; ++i)
+            expected += std::to_string(i) + ',';
+
+        for (std::size_t const chunk : {100, 4096, 65536})
+        {
+            Gate gate;
+            int suspends = 0;
+            StreamWriter stream(
+                "head\r\n\r\n",
+                [&] {
+                    ++suspends;
+                    gate.wait();
+                },
+                [&] { gate.open(); });
+            auto body = stream.body();
+
+            std::thread producer([&] {
+                for (std::size_t i = 0; i < expected.size(); i += 1000)
+                    stream.write(
+                        boost::beast::string_view(expected).substr(i, 1000));
+                stream.finish();
+            });
+            auto const sent = drain(*body, chunk);
+            producer.join();
+
+            // The producer waited for the session rather than get far
+            // ahead of it.
+            BEAST_EXPECT(suspends > 0);
+            BEAST_EXPECT(
+                sent.mostHeld <=
+                StreamWriter::limit + 2 * StreamWriter::chunkSize);
+            BEAST_EXPECT(sent.bytes.substr(0, 8) == "head\r\n\r\n");
+            BEAST_EXPECT(dechunk(sent.bytes.substr(8)) == expected);
+        }
+    }
+
+    void
+    testClosed()
+    {
+        testcase("closed");
+
+        // A producer suspended when the session goes away continues, and
+        // what it writes after that is discarded.
+        Gate gate;
+        StreamWriter stream("", [&] { gate.wait(); }, [&] { gate.open(); });
+        auto body = stream.body();
+
+        std::thread producer([&] {
+            std::string const data(1000, 'x');
+            for (int i = 0; i < 4000; ++i)
+                stream.write(data);
+            stream.finish();
+        });
+        while (!body->prepare(1, [] {}) ||
+               boost::asio::buffer_size(body->data()) == 0)
+            std::this_thread::yield();
+        body->consume(1);
+        body.reset();
+        producer.join();
+        BEAST_EXPECT(stream.closed());
+    }
+
+    void
+    testAbort()
+    {
+        testcase("abort");
+
+        // The session is resumed, and the body ends without its last chunk.
+        StreamWriter stream("", [] {}, [] {});
+        auto body = stream.body();
+        stream.write(std::string(StreamWriter::chunkSize, 'x'));
+        BEAST_EXPECT(body->prepare(1, [] {}));
+        body->consume(boost::asio::buffer_size(body->data()));
+
+        bool resumed = false;
+        stream.write("more");
+        BEAST_EXPECT(!body->prepare(1, [&] { resumed = true; }));
+        stream.abort();
+        BEAST_EXPECT(resumed);
+        BEAST_EXPECT(body->prepare(1, [] {}));
+        BEAST_EXPECT(boost::asio::buffer_size(body->data()) == 0);
+        BEAST_EXPECT(body->complete());
+
+        // Destroying an unfinished writer aborts it.
+        std::optional<StreamWriter> unfinished(std::in_place, "", [] {}, [] {});
+        body = unfinished->body();
+        unfinished->write("partial");
+        unfinished.reset();
+        BEAST_EXPECT(drain(*body, 65536).bytes.empty());
+    }
+
+public:
+    void
+    run() override
+    {
+        testChunks();
+        testFlowControl();
+        testClosed();
+        testAbort();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(StreamWriter, server, ripple);
+
+}  // namespace ripple